@@ -440,28 +440,27 @@ class Array {
     DataType element_type_ = DataType::NONE;
 };
 
+// ArrayView doesn't own any memory, both the element data and the element
+// offsets (for variable length element types) are read in place, so it is
+// cheap to construct on demand from the packed layout of a chunk.
 class ArrayView {
  public:
     ArrayView() = default;
 
     ArrayView(char* data,
+              int len,
               size_t size,
               DataType element_type,
-              std::vector<uint64_t>&& element_offsets)
-        : size_(size),
-          element_type_(element_type),
-          offsets_(std::move(element_offsets)) {
-        data_ = data;
+              const uint64_t* offsets_ptr)
+        : data_(data),
+          length_(len),
+          size_(size),
+          offsets_ptr_(offsets_ptr),
+          element_type_(element_type) {
         if (IsVariableDataType(element_type_)) {
-            length_ = offsets_.size();
-        } else {
-            // int8, int16, int32 are all promoted to int32
-            if (element_type_ == DataType::INT8 ||
-                element_type_ == DataType::INT16) {
-                length_ = size / sizeof(int32_t);
-            } else {
-                length_ = size / GetDataTypeSize(element_type_);
-            }
+            AssertInfo(length_ == 0 || offsets_ptr_ != nullptr,
+                       "element offsets are required for variable length "
+                       "element type");
         }
     }
 
@@ -475,10 +474,11 @@ class ArrayView {
 
         if constexpr (std::is_same_v<T, std::string> ||
                       std::is_same_v<T, std::string_view>) {
-            size_t element_length = (index == length_ - 1)
-                                        ? size_ - offsets_.back()
-                                        : offsets_[index + 1] - offsets_[index];
-            return T(data_ + offsets_[index], element_length);
+            size_t element_length =
+                (index == length_ - 1)
+                    ? size_ - offsets_ptr_[index]
+                    : offsets_ptr_[index + 1] - offsets_ptr_[index];
+            return T(data_ + offsets_ptr_[index], element_length);
         }
         if constexpr (std::is_same_v<T, int> || std::is_same_v<T, int64_t> ||
                       std::is_same_v<T, float> || std::is_same_v<T, double>) {
@@ -580,10 +580,18 @@ class ArrayView {
     data() const {
         return data_;
     }
+    const uint64_t*
+    get_offsets_data() const {
+        return offsets_ptr_;
+    }
+
     // copy to result
     std::vector<uint64_t>
     get_offsets_in_copy() const {
-        return offsets_;
+        if (offsets_ptr_ == nullptr) {
+            return {};
+        }
+        return std::vector<uint64_t>(offsets_ptr_, offsets_ptr_ + length_);
     }
 
     bool
@@ -661,7 +669,7 @@ class ArrayView {
     char* data_{nullptr};
     int length_ = 0;
     int size_ = 0;
-    std::vector<uint64_t> offsets_{};
+    const uint64_t* offsets_ptr_{nullptr};
     DataType element_type_ = DataType::NONE;
 };
 
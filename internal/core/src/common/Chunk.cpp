@@ -21,44 +21,51 @@ namespace milvus {
 std::pair<std::vector<std::string_view>, FixedVector<bool>>
 StringChunk::StringViews() {
     std::vector<std::string_view> ret;
+    ret.reserve(row_nums_);
     for (int i = 0; i < row_nums_; i++) {
         ret.emplace_back(data_ + offsets_[i], offsets_[i + 1] - offsets_[i]);
     }
     return {ret, valid_};
 }
 
-void
-ArrayChunk::ConstructViews() {
-    views_.reserve(row_nums_);
-
-    for (int i = 0; i < row_nums_; ++i) {
-        int offset = offsets_lens_[2 * i];
-        int next_offset = offsets_lens_[2 * (i + 1)];
-        int len = offsets_lens_[2 * i + 1];
-
-        auto data_ptr = data_ + offset;
-        auto offsets_len = 0;
-        std::vector<uint64_t> element_indices = {};
-        if (IsStringDataType(element_type_)) {
-            offsets_len = len * sizeof(uint64_t);
-            std::vector<uint64_t> tmp(
-                reinterpret_cast<uint64_t*>(data_ptr),
-                reinterpret_cast<uint64_t*>(data_ptr + offsets_len));
-            element_indices = std::move(tmp);
-        }
-        views_.emplace_back(data_ptr + offsets_len,
-                            next_offset - offset - offsets_len,
-                            element_type_,
-                            std::move(element_indices));
+std::pair<std::vector<Json>, FixedVector<bool>>
+JSONChunk::Views(int64_t start_offset, int64_t length) const {
+    AssertInfo(start_offset >= 0 && start_offset + length <= row_nums_,
+               "views out of range, start_offset={}, length={}, row_nums={}",
+               start_offset,
+               length,
+               row_nums_);
+    std::vector<Json> views;
+    views.reserve(length);
+    for (int64_t i = start_offset; i < start_offset + length; ++i) {
+        views.emplace_back(View(i));
+    }
+    FixedVector<bool> valid_data;
+    if (nullable_) {
+        valid_data.assign(valid_.begin() + start_offset,
+                          valid_.begin() + start_offset + length);
     }
+    return {std::move(views), std::move(valid_data)};
 }
 
-SpanBase
-ArrayChunk::Span() const {
-    return SpanBase(views_.data(),
-                    nullable_ ? valid_.data() : nullptr,
-                    views_.size(),
-                    sizeof(ArrayView));
+std::pair<std::vector<ArrayView>, FixedVector<bool>>
+ArrayChunk::Views(int64_t start_offset, int64_t length) const {
+    AssertInfo(start_offset >= 0 && start_offset + length <= row_nums_,
+               "views out of range, start_offset={}, length={}, row_nums={}",
+               start_offset,
+               length,
+               row_nums_);
+    std::vector<ArrayView> views;
+    views.reserve(length);
+    for (int64_t i = start_offset; i < start_offset + length; ++i) {
+        views.emplace_back(View(i));
+    }
+    FixedVector<bool> valid_data;
+    if (nullable_) {
+        valid_data.assign(valid_.begin() + start_offset,
+                          valid_.begin() + start_offset + length);
+    }
+    return {std::move(views), std::move(valid_data)};
 }
 
 }  // namespace milvus
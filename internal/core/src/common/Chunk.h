@@ -21,6 +21,7 @@
 #include "arrow/record_batch.h"
 #include "common/Array.h"
 #include "common/ChunkTarget.h"
+#include "common/Common.h"
 #include "common/EasyAssert.h"
 #include "common/FieldDataInterface.h"
 #include "common/Json.h"
@@ -31,6 +32,7 @@
 #include "common/Types.h"
 namespace milvus {
 constexpr uint64_t MMAP_STRING_PADDING = 1;
+constexpr uint64_t JSON_BINARY_ALIGNMENT = 8;
 constexpr uint64_t MMAP_ARRAY_PADDING = 1;
 class Chunk {
  public:
@@ -76,6 +78,12 @@ class Chunk {
         return valid_[offset];
     };
 
+    // nullptr if the chunk is not nullable
+    const bool*
+    ValidData() const {
+        return nullable_ ? valid_.data() : nullptr;
+    }
+
  protected:
     char* data_;
     int64_t row_nums_;
@@ -145,6 +153,19 @@ class StringChunk : public Chunk {
     std::pair<std::vector<std::string_view>, FixedVector<bool>>
     StringViews();
 
+    // values of rows in [start_offset, start_offset + length) in place,
+    // offsets are relative to Data()
+    StringBatchView
+    StringBatch(int64_t start_offset, int64_t length) const {
+        AssertInfo(start_offset >= 0 && start_offset + length <= row_nums_,
+                   "string batch out of range, start_offset={}, length={}, "
+                   "row_nums={}",
+                   start_offset,
+                   length,
+                   row_nums_);
+        return StringBatchView{data_, offsets_ + start_offset, 0};
+    }
+
     int
     binary_search_string(std::string_view target) {
         // only supported sorted pk
@@ -184,7 +205,40 @@ class StringChunk : public Chunk {
     uint64_t* offsets_;
 };
 
-using JSONChunk = StringChunk;
+// JSONChunk has the layout of StringChunk followed by the pre-parsed
+// representation of the rows (see JsonBinary.h) written by JSONChunkWriter:
+// simdjson padding aligned to JSON_BINARY_ALIGNMENT, binary offsets
+// (row_nums + 1, relative to the binary data) and the binary data, empty
+// for null rows or rows which are not valid json.
+class JSONChunk : public StringChunk {
+ public:
+    JSONChunk(int32_t row_nums, char* data, uint64_t size, bool nullable)
+        : StringChunk(row_nums, data, size, nullable) {
+        auto binary_pos = offsets_[row_nums_] + simdjson::SIMDJSON_PADDING;
+        binary_pos = (binary_pos + JSON_BINARY_ALIGNMENT - 1) /
+                     JSON_BINARY_ALIGNMENT * JSON_BINARY_ALIGNMENT;
+        binary_offsets_ = reinterpret_cast<uint64_t*>(data_ + binary_pos);
+        binary_data_ = data_ + binary_pos + sizeof(uint64_t) * (row_nums_ + 1);
+    }
+
+    Json
+    View(int64_t idx) const {
+        auto binary = binary_offsets_[idx + 1] == binary_offsets_[idx]
+                          ? nullptr
+                          : binary_data_ + binary_offsets_[idx];
+        return Json(
+            data_ + offsets_[idx], offsets_[idx + 1] - offsets_[idx], binary);
+    }
+
+    // json views of rows in [start_offset, start_offset + length),
+    // second is the valid data of the rows, empty if not nullable
+    std::pair<std::vector<Json>, FixedVector<bool>>
+    Views(int64_t start_offset, int64_t length) const;
+
+ private:
+    const uint64_t* binary_offsets_;
+    const char* binary_data_;
+};
 
 class ArrayChunk : public Chunk {
  public:
@@ -197,19 +251,33 @@ class ArrayChunk : public Chunk {
         auto null_bitmap_bytes_num = (row_nums + 7) / 8;
         offsets_lens_ =
             reinterpret_cast<uint64_t*>(data + null_bitmap_bytes_num);
-        ConstructViews();
     }
 
-    SpanBase
-    Span() const;
-
+    // views are built on demand from offsets_lens_, element offsets of
+    // string arrays are read in place from the chunk buffer.
     ArrayView
     View(int64_t idx) const {
-        return views_[idx];
+        auto offset = offsets_lens_[2 * idx];
+        auto len = static_cast<int>(offsets_lens_[2 * idx + 1]);
+        auto next_offset = offsets_lens_[2 * (idx + 1)];
+
+        auto data_ptr = data_ + offset;
+        uint64_t offsets_bytes_len = 0;
+        const uint64_t* offsets_ptr = nullptr;
+        if (IsStringDataType(element_type_)) {
+            offsets_bytes_len = len * sizeof(uint64_t);
+            offsets_ptr = reinterpret_cast<const uint64_t*>(data_ptr);
+        }
+        return ArrayView(data_ptr + offsets_bytes_len,
+                         len,
+                         next_offset - offset - offsets_bytes_len,
+                         element_type_,
+                         offsets_ptr);
     }
 
-    void
-    ConstructViews();
+    // views of rows in [start_offset, start_offset + length)
+    std::pair<std::vector<ArrayView>, FixedVector<bool>>
+    Views(int64_t start_offset, int64_t length) const;
 
     const char*
     ValueAt(int64_t idx) const override {
@@ -220,7 +288,6 @@ class ArrayChunk : public Chunk {
  private:
     milvus::DataType element_type_;
     uint64_t* offsets_lens_;
-    std::vector<ArrayView> views_;
 };
 
 class SparseFloatVectorChunk : public Chunk {
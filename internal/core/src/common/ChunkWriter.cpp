@@ -95,6 +95,9 @@ JSONChunkWriter::write(std::shared_ptr<arrow::RecordBatchReader> data) {
 
     std::vector<Json> jsons;
     std::vector<std::pair<const uint8_t*, int64_t>> null_bitmaps;
+    // pre-parsed representation of all rows, null or invalid rows are empty
+    std::string binary;
+    std::vector<uint64_t> binary_offsets;
     for (auto batch : *data) {
         auto data = batch.ValueOrDie()->column(0);
         auto array = std::dynamic_pointer_cast<arrow::BinaryArray>(data);
@@ -102,6 +105,8 @@ JSONChunkWriter::write(std::shared_ptr<arrow::RecordBatchReader> data) {
             auto str = array->GetView(i);
             auto json = Json(simdjson::padded_string(str));
             size += json.data().size();
+            binary_offsets.push_back(binary.size());
+            EncodeJsonBinary(json.data(), binary);
             jsons.push_back(std::move(json));
         }
         // AssertInfo(data->length() % 8 == 0,
@@ -111,14 +116,18 @@ JSONChunkWriter::write(std::shared_ptr<arrow::RecordBatchReader> data) {
         size += null_bitmap_n;
         row_nums_ += array->length();
     }
+    binary_offsets.push_back(binary.size());
     size += sizeof(uint64_t) * (row_nums_ + 1) + simdjson::SIMDJSON_PADDING;
+    size += JSON_BINARY_ALIGNMENT + sizeof(uint64_t) * (row_nums_ + 1) +
+            binary.size();
     if (file_) {
         target_ = std::make_shared<MmapChunkTarget>(*file_, file_offset_);
     } else {
         target_ = std::make_shared<MemChunkTarget>(size);
     }
 
-    // chunk layout: null bitmaps, offset1, offset2, ... ,json1, json2, ..., jsonn
+    // chunk layout: null bitmaps, offset1, offset2, ... ,json1, json2, ..., jsonn,
+    // padding, binary offset1, binary offset2, ..., binary1, binary2, ..., binaryn
     // write null bitmaps
     for (auto [data, size] : null_bitmaps) {
         if (data == nullptr) {
@@ -145,13 +154,23 @@ JSONChunkWriter::write(std::shared_ptr<arrow::RecordBatchReader> data) {
     for (auto json : jsons) {
         target_->write(json.data().data(), json.data().size());
     }
+
+    // simdjson padding of the last json, then align the binary offsets
+    char padding[simdjson::SIMDJSON_PADDING + JSON_BINARY_ALIGNMENT] = {0};
+    auto padding_size = simdjson::SIMDJSON_PADDING;
+    padding_size += (JSON_BINARY_ALIGNMENT -
+                     (target_->tell() + padding_size) % JSON_BINARY_ALIGNMENT) %
+                    JSON_BINARY_ALIGNMENT;
+    target_->write(padding, padding_size);
+
+    // write binary
+    target_->write(binary_offsets.data(),
+                   binary_offsets.size() * sizeof(uint64_t));
+    target_->write(binary.data(), binary.size());
 }
 
 std::shared_ptr<Chunk>
 JSONChunkWriter::finish() {
-    char padding[simdjson::SIMDJSON_PADDING];
-    target_->write(padding, simdjson::SIMDJSON_PADDING);
-
     auto [data, size] = target_->get();
     return std::make_shared<JSONChunk>(row_nums_, data, size, nullable_);
 }
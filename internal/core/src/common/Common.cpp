@@ -28,6 +28,7 @@ int64_t LOW_PRIORITY_THREAD_CORE_COEFFICIENT =
     DEFAULT_LOW_PRIORITY_THREAD_CORE_COEFFICIENT;
 int CPU_NUM = DEFAULT_CPU_NUM;
 int64_t EXEC_EVAL_EXPR_BATCH_SIZE = DEFAULT_EXEC_EVAL_EXPR_BATCH_SIZE;
+int64_t LOAD_MEMORY_LIMIT = 0;
 
 void
 SetIndexSliceSize(const int64_t size) {
@@ -62,6 +63,12 @@ SetDefaultExecEvalExprBatchSize(int64_t val) {
     LOG_INFO("set default expr eval batch size: {}", EXEC_EVAL_EXPR_BATCH_SIZE);
 }
 
+void
+SetLoadMemoryLimit(const int64_t size) {
+    LOAD_MEMORY_LIMIT = size << 20;
+    LOG_INFO("set config load memory limit (byte): {}", LOAD_MEMORY_LIMIT);
+}
+
 void
 SetCpuNum(const int num) {
     CPU_NUM = num;
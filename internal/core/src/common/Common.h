@@ -17,6 +17,7 @@
 #pragma once
 
 #include <iostream>
+#include <string_view>
 #include <utility>
 #include <variant>
 #include "common/Consts.h"
@@ -29,6 +30,8 @@ extern int64_t MIDDLE_PRIORITY_THREAD_CORE_COEFFICIENT;
 extern int64_t LOW_PRIORITY_THREAD_CORE_COEFFICIENT;
 extern int CPU_NUM;
 extern int64_t EXEC_EVAL_EXPR_BATCH_SIZE;
+// bytes the loading of segments and indexes may hold at once, 0 for no limit
+extern int64_t LOAD_MEMORY_LIMIT;
 
 void
 SetIndexSliceSize(const int64_t size);
@@ -48,6 +51,9 @@ SetCpuNum(const int core);
 void
 SetDefaultExecEvalExprBatchSize(int64_t val);
 
+void
+SetLoadMemoryLimit(const int64_t size);
+
 struct BufferView {
     struct Element {
         const char* data_;
@@ -59,4 +65,29 @@ struct BufferView {
     std::variant<std::vector<Element>, std::pair<char*, size_t>> data_;
 };
 
+// StringBatchView refers to a batch of variable length values in place,
+// value i is located in [data_ + offsets_[i] + header_size_,
+// data_ + offsets_[i + 1]), header_size_ is the size of the length prefix
+// written before each value, 0 if there is none.
+struct StringBatchView {
+    const char* data_{nullptr};
+    const uint64_t* offsets_{nullptr};
+    uint32_t header_size_{0};
+
+    const char*
+    value_data(int64_t i) const {
+        return data_ + offsets_[i] + header_size_;
+    }
+
+    size_t
+    value_size(int64_t i) const {
+        return offsets_[i + 1] - offsets_[i] - header_size_;
+    }
+
+    std::string_view
+    operator[](int64_t i) const {
+        return std::string_view(value_data(i), value_size(i));
+    }
+};
+
 }  // namespace milvus
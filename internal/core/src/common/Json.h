@@ -26,6 +26,7 @@
 #include <string_view>
 
 #include "common/EasyAssert.h"
+#include "common/JsonBinary.h"
 #include "simdjson.h"
 #include "fmt/core.h"
 #include "simdjson/common_defs.h"
@@ -97,7 +98,13 @@ class Json {
         : data_(data, len, len + simdjson::SIMDJSON_PADDING) {
     }
 
-    Json(const Json& json) {
+    // same as above, binary is the pre-parsed representation of data built
+    // at load time (see JsonBinary.h), nullptr if there is none
+    Json(const char* data, size_t len, const char* binary)
+        : data_(data, len, len + simdjson::SIMDJSON_PADDING), binary_(binary) {
+    }
+
+    Json(const Json& json) : binary_(json.binary_) {
         if (json.own_data_.has_value()) {
             own_data_ = simdjson::padded_string(
                 json.own_data_.value().data(), json.own_data_.value().length());
@@ -106,7 +113,7 @@ class Json {
             data_ = json.data_;
         }
     };
-    Json(Json&& json) noexcept {
+    Json(Json&& json) noexcept : binary_(json.binary_) {
         if (json.own_data_.has_value()) {
             own_data_ = std::move(json.own_data_);
             data_ = own_data_.value();
@@ -124,6 +131,7 @@ class Json {
         } else {
             data_ = json.data_;
         }
+        binary_ = json.binary_;
         return *this;
     }
 
@@ -168,6 +176,11 @@ class Json {
 
     bool
     exist(std::string_view pointer) const {
+        if (binary_ != nullptr) {
+            JsonBinaryValue value;
+            return JsonBinaryValue(binary_).at_pointer(pointer, value) ==
+                   simdjson::SUCCESS;
+        }
         return doc().at_pointer(pointer).error() == simdjson::SUCCESS;
     }
 
@@ -189,6 +202,26 @@ class Json {
     template <typename T>
     value_result<T>
     at(std::string_view pointer) const {
+        if constexpr (std::is_same_v<std::string_view, T> ||
+                      std::is_same_v<std::string, T> ||
+                      std::is_same_v<bool, T> || std::is_same_v<int64_t, T> ||
+                      std::is_same_v<double, T>) {
+            if (binary_ != nullptr) {
+                JsonBinaryValue value;
+                auto error =
+                    JsonBinaryValue(binary_).at_pointer(pointer, value);
+                if (error != simdjson::SUCCESS) {
+                    return error;
+                }
+                T result;
+                error = value.get(result);
+                if (error != simdjson::SUCCESS) {
+                    return error;
+                }
+                return value_result<T>(std::move(result));
+            }
+        }
+
         if (pointer == "") {
             if constexpr (std::is_same_v<std::string_view, T> ||
                           std::is_same_v<std::string, T>) {
@@ -229,9 +262,17 @@ class Json {
         return data_.data();
     }
 
+    // pre-parsed representation, nullptr if the json is not loaded from a
+    // sealed chunk
+    const char*
+    binary() const {
+        return binary_;
+    }
+
  private:
     std::optional<simdjson::padded_string>
         own_data_{};  // this could be empty, then the Json will be just s view on bytes
     simdjson::padded_string_view data_{};
+    const char* binary_{nullptr};
 };
 }  // namespace milvus
@@ -0,0 +1,213 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/JsonBinary.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "simdjson.h"
+
+namespace milvus {
+
+namespace {
+
+void
+AppendU32(std::string& out, uint32_t value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void
+WriteU32(std::string& out, size_t pos, uint32_t value) {
+    std::memcpy(out.data() + pos, &value, sizeof(value));
+}
+
+template <typename T>
+void
+AppendScalar(std::string& out, JsonBinaryType type, T value) {
+    out.push_back(static_cast<char>(type));
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void
+EncodeElement(const simdjson::dom::element& element, std::string& out) {
+    auto start = out.size();
+    switch (element.type()) {
+        case simdjson::dom::element_type::NULL_VALUE: {
+            out.push_back(static_cast<char>(JsonBinaryType::NULL_VALUE));
+            break;
+        }
+        case simdjson::dom::element_type::BOOL: {
+            out.push_back(static_cast<char>(element.get_bool().value_unsafe()
+                                                ? JsonBinaryType::TRUE_VALUE
+                                                : JsonBinaryType::FALSE_VALUE));
+            break;
+        }
+        case simdjson::dom::element_type::INT64: {
+            AppendScalar(out,
+                         JsonBinaryType::INT64,
+                         element.get_int64().value_unsafe());
+            break;
+        }
+        case simdjson::dom::element_type::UINT64: {
+            AppendScalar(out,
+                         JsonBinaryType::UINT64,
+                         element.get_uint64().value_unsafe());
+            break;
+        }
+        case simdjson::dom::element_type::DOUBLE: {
+            AppendScalar(out,
+                         JsonBinaryType::DOUBLE,
+                         element.get_double().value_unsafe());
+            break;
+        }
+        case simdjson::dom::element_type::STRING: {
+            auto str = element.get_string().value_unsafe();
+            out.push_back(static_cast<char>(JsonBinaryType::STRING));
+            AppendU32(out, str.size());
+            out.append(str.data(), str.size());
+            break;
+        }
+        case simdjson::dom::element_type::ARRAY: {
+            auto array = element.get_array().value_unsafe();
+            uint32_t count = array.size();
+            out.push_back(static_cast<char>(JsonBinaryType::ARRAY));
+            AppendU32(out, count);
+            auto table = out.size();
+            out.resize(table + count * sizeof(uint32_t));
+            uint32_t i = 0;
+            for (auto child : array) {
+                WriteU32(out, table + i * sizeof(uint32_t), out.size() - start);
+                EncodeElement(child, out);
+                i++;
+            }
+            break;
+        }
+        case simdjson::dom::element_type::OBJECT: {
+            auto object = element.get_object().value_unsafe();
+            std::vector<std::pair<std::string_view, simdjson::dom::element>>
+                fields;
+            for (auto field : object) {
+                fields.emplace_back(field.key, field.value);
+            }
+            // stable to keep the first one of duplicated keys in front
+            std::stable_sort(fields.begin(),
+                             fields.end(),
+                             [](const auto& lhs, const auto& rhs) {
+                                 return lhs.first < rhs.first;
+                             });
+            uint32_t count = fields.size();
+            out.push_back(static_cast<char>(JsonBinaryType::OBJECT));
+            AppendU32(out, count);
+            auto table = out.size();
+            out.resize(table + count * 2 * sizeof(uint32_t));
+            for (uint32_t i = 0; i < count; i++) {
+                auto entry = table + i * 2 * sizeof(uint32_t);
+                WriteU32(out, entry, out.size() - start);
+                AppendU32(out, fields[i].first.size());
+                out.append(fields[i].first.data(), fields[i].first.size());
+                WriteU32(out, entry + sizeof(uint32_t), out.size() - start);
+                EncodeElement(fields[i].second, out);
+            }
+            break;
+        }
+    }
+}
+
+}  // namespace
+
+bool
+EncodeJsonBinary(std::string_view json, std::string& out) {
+    if (json.empty()) {
+        return false;
+    }
+    thread_local simdjson::dom::parser parser;
+    simdjson::dom::element root;
+    if (parser.parse(json.data(), json.size()).get(root) !=
+        simdjson::SUCCESS) {
+        return false;
+    }
+    EncodeElement(root, out);
+    return true;
+}
+
+simdjson::error_code
+JsonBinaryValue::at_pointer(std::string_view pointer,
+                            JsonBinaryValue& value) const {
+    JsonBinaryValue current = *this;
+    if (pointer.empty()) {
+        value = current;
+        return simdjson::SUCCESS;
+    }
+    if (pointer[0] != '/') {
+        return simdjson::INVALID_JSON_POINTER;
+    }
+
+    std::string unescaped;
+    size_t pos = 1;
+    while (true) {
+        auto end = pointer.find('/', pos);
+        auto token = pointer.substr(
+            pos, end == std::string_view::npos ? end : end - pos);
+        simdjson::error_code error;
+        if (current.type() == JsonBinaryType::OBJECT) {
+            if (token.find('~') != std::string_view::npos) {
+                unescaped.clear();
+                for (size_t i = 0; i < token.size(); i++) {
+                    if (token[i] == '~' && i + 1 < token.size() &&
+                        (token[i + 1] == '0' || token[i + 1] == '1')) {
+                        unescaped.push_back(token[i + 1] == '0' ? '~' : '/');
+                        i++;
+                    } else {
+                        unescaped.push_back(token[i]);
+                    }
+                }
+                token = unescaped;
+            }
+            error = current.find_field(token, current);
+        } else if (current.type() == JsonBinaryType::ARRAY) {
+            if (token.empty() ||
+                !std::all_of(token.begin(), token.end(), [](char c) {
+                    return c >= '0' && c <= '9';
+                })) {
+                return simdjson::INVALID_JSON_POINTER;
+            }
+            // array indexes have no leading zeros (RFC 6901)
+            if (token.size() > 1 && token[0] == '0') {
+                return simdjson::INVALID_JSON_POINTER;
+            }
+            size_t index = 0;
+            for (auto c : token) {
+                index = index * 10 + (c - '0');
+            }
+            error = current.at(index, current);
+        } else {
+            return simdjson::INCORRECT_TYPE;
+        }
+        if (error != simdjson::SUCCESS) {
+            return error;
+        }
+        if (end == std::string_view::npos) {
+            break;
+        }
+        pos = end + 1;
+    }
+    value = current;
+    return simdjson::SUCCESS;
+}
+
+}  // namespace milvus
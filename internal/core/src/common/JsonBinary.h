@@ -0,0 +1,194 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "simdjson/error.h"
+
+namespace milvus {
+
+// Binary representation of a JSON value, built once when a sealed JSON
+// field is loaded so that path lookups are offset hops instead of
+// re-parsing the text for every row of every query.
+//
+// value  := tag:u8 payload
+//   null, true, false      no payload
+//   int64, uint64, double  8 bytes
+//   string                 u32 length, unescaped bytes
+//   array                  u32 count, u32 element_offsets[count], elements
+//   object                 u32 count, {u32 key_offset, u32 value_offset}
+//                          [count] sorted by key, then keys (u32 length,
+//                          bytes) and values
+//
+// Offsets are relative to the tag of the enclosing container and all
+// integers are native (little) endian, the encoded bytes hold no pointers
+// so they can be written to and mapped from a file as is.
+enum class JsonBinaryType : uint8_t {
+    NULL_VALUE = 0,
+    TRUE_VALUE = 1,
+    FALSE_VALUE = 2,
+    INT64 = 3,
+    UINT64 = 4,
+    DOUBLE = 5,
+    STRING = 6,
+    ARRAY = 7,
+    OBJECT = 8,
+};
+
+// append the binary representation of json text to out,
+// return false and leave out untouched if the text is not a valid json
+bool
+EncodeJsonBinary(std::string_view json, std::string& out);
+
+// read only view of an encoded value, error codes returned by the
+// accessors follow the ones simdjson returns for the same lookup on text.
+class JsonBinaryValue {
+ public:
+    JsonBinaryValue() = default;
+
+    explicit JsonBinaryValue(const char* data) : data_(data) {
+    }
+
+    JsonBinaryType
+    type() const {
+        return static_cast<JsonBinaryType>(*data_);
+    }
+
+    // number of elements of array or fields of object
+    uint32_t
+    size() const {
+        return ReadU32(1);
+    }
+
+    simdjson::error_code
+    at(size_t index, JsonBinaryValue& value) const {
+        if (type() != JsonBinaryType::ARRAY) {
+            return simdjson::INCORRECT_TYPE;
+        }
+        if (index >= size()) {
+            return simdjson::INDEX_OUT_OF_BOUNDS;
+        }
+        value = JsonBinaryValue(data_ + ReadU32(5 + index * sizeof(uint32_t)));
+        return simdjson::SUCCESS;
+    }
+
+    // binary search on the sorted key table, the first one is returned
+    // for duplicated keys just like the text lookup
+    simdjson::error_code
+    find_field(std::string_view key, JsonBinaryValue& value) const {
+        if (type() != JsonBinaryType::OBJECT) {
+            return simdjson::INCORRECT_TYPE;
+        }
+        uint32_t left = 0;
+        uint32_t right = size();
+        while (left < right) {
+            auto mid = left + (right - left) / 2;
+            if (key_at(mid) < key) {
+                left = mid + 1;
+            } else {
+                right = mid;
+            }
+        }
+        if (left == size() || key_at(left) != key) {
+            return simdjson::NO_SUCH_FIELD;
+        }
+        value = value_at(left);
+        return simdjson::SUCCESS;
+    }
+
+    // i-th field of object in key order
+    std::string_view
+    key_at(uint32_t i) const {
+        auto key_offset = ReadU32(5 + i * 8);
+        return {data_ + key_offset + sizeof(uint32_t), ReadU32(key_offset)};
+    }
+
+    JsonBinaryValue
+    value_at(uint32_t i) const {
+        return JsonBinaryValue(data_ + ReadU32(5 + i * 8 + 4));
+    }
+
+    // lookup by JSON pointer (RFC 6901), "" refers to the value itself
+    simdjson::error_code
+    at_pointer(std::string_view pointer, JsonBinaryValue& value) const;
+
+    template <typename T>
+    simdjson::error_code
+    get(T& value) const {
+        auto tag = type();
+        if constexpr (std::is_same_v<T, bool>) {
+            if (tag != JsonBinaryType::TRUE_VALUE &&
+                tag != JsonBinaryType::FALSE_VALUE) {
+                return simdjson::INCORRECT_TYPE;
+            }
+            value = tag == JsonBinaryType::TRUE_VALUE;
+        } else if constexpr (std::is_same_v<T, int64_t>) {
+            if (tag == JsonBinaryType::UINT64) {
+                return simdjson::NUMBER_OUT_OF_RANGE;
+            }
+            if (tag != JsonBinaryType::INT64) {
+                return simdjson::INCORRECT_TYPE;
+            }
+            value = ReadScalar<int64_t>();
+        } else if constexpr (std::is_same_v<T, double>) {
+            if (tag == JsonBinaryType::DOUBLE) {
+                value = ReadScalar<double>();
+            } else if (tag == JsonBinaryType::INT64) {
+                value = static_cast<double>(ReadScalar<int64_t>());
+            } else if (tag == JsonBinaryType::UINT64) {
+                value = static_cast<double>(ReadScalar<uint64_t>());
+            } else {
+                return simdjson::INCORRECT_TYPE;
+            }
+        } else if constexpr (std::is_same_v<T, std::string_view> ||
+                             std::is_same_v<T, std::string>) {
+            if (tag != JsonBinaryType::STRING) {
+                return simdjson::INCORRECT_TYPE;
+            }
+            value = T(data_ + 5, ReadU32(1));
+        } else {
+            static_assert(sizeof(T) == 0,
+                          "unsupported type for json binary value");
+        }
+        return simdjson::SUCCESS;
+    }
+
+ private:
+    uint32_t
+    ReadU32(size_t offset) const {
+        uint32_t value;
+        std::memcpy(&value, data_ + offset, sizeof(value));
+        return value;
+    }
+
+    template <typename T>
+    T
+    ReadScalar() const {
+        T value;
+        std::memcpy(&value, data_ + 1, sizeof(value));
+        return value;
+    }
+
+    const char* data_{nullptr};
+};
+
+}  // namespace milvus
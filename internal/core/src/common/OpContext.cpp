@@ -0,0 +1,59 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "common/OpContext.h"
+
+#include "common/EasyAssert.h"
+#include "monitor/prometheus_client.h"
+
+namespace milvus {
+
+OpContext::Clock::time_point
+OpContext::DeadlineFromUnixMs(int64_t deadline_ms) {
+    if (deadline_ms <= 0) {
+        return Clock::time_point::max();
+    }
+    auto remaining = std::chrono::milliseconds(deadline_ms) -
+                     std::chrono::duration_cast<std::chrono::milliseconds>(
+                         std::chrono::system_clock::now().time_since_epoch());
+    return Clock::now() + remaining;
+}
+
+void
+OpContext::ThrowIfCancelled(double progress) const {
+    auto cancelled = cancellation_token_.isCancellationRequested();
+    auto now = Clock::now();
+    if (!cancelled && now < deadline_) {
+        return;
+    }
+
+    if (cancelled) {
+        monitor::internal_core_cancelled_op_count_cancel.Increment();
+    } else {
+        monitor::internal_core_cancelled_op_count_deadline.Increment();
+    }
+    // the rest of the operation would take as long as the done part took
+    // for its share of the work
+    if (progress > 0 && progress < 1) {
+        auto elapsed =
+            std::chrono::duration<double, std::milli>(now - start_).count();
+        monitor::internal_core_cancelled_op_saved_cpu_ms.Increment(
+            elapsed * (1 - progress) / progress);
+    }
+    PanicInfo(FollyCancel,
+              "operation {} after {}ms",
+              cancelled ? "cancelled" : "exceeded its deadline",
+              std::chrono::duration_cast<std::chrono::milliseconds>(now -
+                                                                    start_)
+                  .count());
+}
+
+}  // namespace milvus
@@ -0,0 +1,65 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <chrono>
+
+#include <folly/CancellationToken.h>
+
+namespace milvus {
+
+// OpContext carries the cancellation state of a search or retrieve on a
+// segment. The long running loops of the operation check it at batch
+// boundaries, so the work abandoned by the caller, cancelled or past its
+// deadline, stops promptly.
+class OpContext {
+ public:
+    using Clock = std::chrono::steady_clock;
+
+    OpContext() = default;
+
+    explicit OpContext(folly::CancellationToken cancellation_token,
+                       Clock::time_point deadline = Clock::time_point::max())
+        : cancellation_token_(std::move(cancellation_token)),
+          deadline_(deadline) {
+    }
+
+    // deadline_ms is a unix timestamp in milliseconds, 0 for no deadline
+    static Clock::time_point
+    DeadlineFromUnixMs(int64_t deadline_ms);
+
+    bool
+    IsCancelled() const {
+        return cancellation_token_.isCancellationRequested() ||
+               Clock::now() >= deadline_;
+    }
+
+    // throws a FollyCancel error if the operation is cancelled, progress is
+    // the done fraction of the operation, 0 if unknown, used to estimate
+    // the cpu time saved by stopping it
+    void
+    ThrowIfCancelled(double progress = 0) const;
+
+ private:
+    folly::CancellationToken cancellation_token_;
+    Clock::time_point deadline_ = Clock::time_point::max();
+    Clock::time_point start_ = Clock::now();
+};
+
+inline void
+CheckCancellation(const OpContext* op_context, double progress = 0) {
+    if (op_context != nullptr) {
+        op_context->ThrowIfCancelled(progress);
+    }
+}
+
+}  // namespace milvus
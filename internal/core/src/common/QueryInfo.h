@@ -18,6 +18,7 @@
 
 #include <memory>
 
+#include "common/OpContext.h"
 #include "common/Tracer.h"
 #include "common/Types.h"
 #include "knowhere/config.h"
@@ -35,6 +36,8 @@ struct SearchInfo {
     std::optional<FieldId> group_by_field_id_;
     tracer::TraceContext trace_ctx_;
     bool materialized_view_involved = false;
+    // checked between the chunks searched, nullptr if not cancellable
+    const OpContext* op_context_{nullptr};
 };
 
 using SearchInfoPtr = std::shared_ptr<SearchInfo>;
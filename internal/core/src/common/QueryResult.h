@@ -56,12 +56,11 @@ struct OffsetDisPair {
 
 struct OffsetDisPairComparator {
     bool
-    operator()(const std::shared_ptr<OffsetDisPair>& left,
-               const std::shared_ptr<OffsetDisPair>& right) const {
-        if (left->GetOffDis().second != right->GetOffDis().second) {
-            return left->GetOffDis().second < right->GetOffDis().second;
+    operator()(const OffsetDisPair& left, const OffsetDisPair& right) const {
+        if (left.GetOffDis().second != right.GetOffDis().second) {
+            return left.GetOffDis().second < right.GetOffDis().second;
         }
-        return left->GetOffDis().first < right->GetOffDis().first;
+        return left.GetOffDis().first < right.GetOffDis().first;
     }
 };
 struct VectorIterator {
@@ -74,21 +73,30 @@ struct VectorIterator {
 
     std::optional<std::pair<int64_t, float>>
     Next() {
-        if (!heap_.empty()) {
-            auto top = heap_.top();
-            heap_.pop();
-            if (iterators_[top->GetIteratorIdx()]->HasNext()) {
-                auto origin_pair = iterators_[top->GetIteratorIdx()]->Next();
-                origin_pair.first = convert_to_segment_offset(
-                    origin_pair.first, top->GetIteratorIdx());
-                auto off_dis_pair = std::make_shared<OffsetDisPair>(
-                    origin_pair, top->GetIteratorIdx());
-                heap_.push(off_dis_pair);
+        if (heap_.empty()) {
+            return std::nullopt;
+        }
+        auto top = heap_.top();
+        heap_.pop();
+        PushNext(top.GetIteratorIdx());
+        return top.GetOffDis();
+    }
+
+    // replaces the results with the next batch_size pairs at most, fewer if
+    // the iterator runs out of pairs
+    void
+    NextBatch(int64_t batch_size,
+              std::vector<std::pair<int64_t, float>>& results) {
+        results.clear();
+        while (int64_t(results.size()) < batch_size) {
+            auto next = Next();
+            if (!next.has_value()) {
+                break;
             }
-            return top->GetOffDis();
+            results.push_back(next.value());
         }
-        return std::nullopt;
     }
+
     bool
     HasNext() {
         return !heap_.empty();
@@ -104,20 +112,25 @@ struct VectorIterator {
     void
     seal() {
         sealed = true;
-        int idx = 0;
-        for (auto& iter : iterators_) {
-            if (iter->HasNext()) {
-                auto origin_pair = iter->Next();
-                origin_pair.first =
-                    convert_to_segment_offset(origin_pair.first, idx);
-                auto off_dis_pair =
-                    std::make_shared<OffsetDisPair>(origin_pair, idx++);
-                heap_.push(off_dis_pair);
-            }
+        for (int idx = 0; idx < iterators_.size(); idx++) {
+            PushNext(idx);
         }
     }
 
  private:
+    // the heap holds the next pair of every chunk iterator at most, so it
+    // is bounded by the number of chunks
+    void
+    PushNext(int idx) {
+        auto& iter = iterators_[idx];
+        if (iter->HasNext()) {
+            auto origin_pair = iter->Next();
+            origin_pair.first =
+                convert_to_segment_offset(origin_pair.first, idx);
+            heap_.emplace(origin_pair, idx);
+        }
+    }
+
     int64_t
     convert_to_segment_offset(int64_t chunk_offset, int chunk_idx) {
         if (total_rows_until_chunk_.size() == 0) {
@@ -135,8 +148,8 @@ struct VectorIterator {
 
  private:
     std::vector<knowhere::IndexNode::IteratorPtr> iterators_;
-    std::priority_queue<std::shared_ptr<OffsetDisPair>,
-                        std::vector<std::shared_ptr<OffsetDisPair>>,
+    std::priority_queue<OffsetDisPair,
+                        std::vector<OffsetDisPair>,
                         OffsetDisPairComparator>
         heap_;
     bool sealed = false;
@@ -219,6 +232,9 @@ struct SearchResult {
     //Vector iterators, used for group by
     std::optional<std::vector<std::shared_ptr<VectorIterator>>>
         vector_iterators_;
+
+    // execution stats of the segment as json, set if the plan is profiled
+    std::string profile_;
 };
 
 using SearchResultPtr = std::shared_ptr<SearchResult>;
@@ -233,6 +249,8 @@ struct RetrieveResult {
     std::vector<int64_t> result_offsets_;
     std::vector<DataArray> field_data_;
     bool has_more_result = true;
+    // execution stats of the segment as json, set if the plan is profiled
+    std::string profile_;
 };
 
 using RetrieveResultPtr = std::shared_ptr<RetrieveResult>;
@@ -25,7 +25,7 @@
 #include "common/Tracer.h"
 #include "log/Log.h"
 
-std::once_flag flag1, flag2, flag3, flag4, flag5, flag6;
+std::once_flag flag1, flag2, flag3, flag4, flag5, flag6, flag7;
 std::once_flag traceFlag;
 
 void
@@ -78,6 +78,12 @@ InitDefaultExprEvalBatchSize(int64_t val) {
         val);
 }
 
+void
+InitLoadMemoryLimit(const int64_t size) {
+    std::call_once(
+        flag7, [](int64_t size) { milvus::SetLoadMemoryLimit(size); }, size);
+}
+
 void
 InitTrace(CTraceConfig* config) {
     auto traceConfig = milvus::tracer::TraceConfig{config->exporter,
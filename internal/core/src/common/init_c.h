@@ -39,6 +39,9 @@ InitLowPriorityThreadCoreCoefficient(const int64_t);
 void
 InitDefaultExprEvalBatchSize(int64_t val);
 
+void
+InitLoadMemoryLimit(const int64_t);
+
 void
 InitCpuNum(const int);
 
@@ -17,10 +17,12 @@
 #include "Driver.h"
 
 #include <cassert>
+#include <chrono>
 #include <memory>
 
 #include "common/EasyAssert.h"
 #include "exec/operator/CallbackSink.h"
+#include "exec/operator/AggregationNode.h"
 #include "exec/operator/CountNode.h"
 #include "exec/operator/FilterBitsNode.h"
 #include "exec/operator/MvccNode.h"
@@ -67,6 +69,11 @@ DriverFactory::CreateDriver(std::unique_ptr<DriverContext> ctx,
                            plannode)) {
             operators.push_back(
                 std::make_unique<PhyCountNode>(id, ctx.get(), countnode));
+        } else if (auto aggregationnode =
+                       std::dynamic_pointer_cast<const plan::AggregationNode>(
+                           plannode)) {
+            operators.push_back(std::make_unique<PhyAggregationNode>(
+                id, ctx.get(), aggregationnode));
         } else if (auto vectorsearchnode =
                        std::dynamic_pointer_cast<const plan::VectorSearchNode>(
                            plannode)) {
@@ -145,7 +152,11 @@ Driver::Close() {
         return;
     }
 
+    auto query_context = ctx_->task_->query_context();
     for (auto& op : operators_) {
+        if (query_context->is_profiling()) {
+            query_context->AddOperatorProfile(op->Profile());
+        }
         op->Close();
     }
 
@@ -170,6 +181,9 @@ Driver::Next(std::shared_ptr<BlockingState>& blocking_state) {
     try {                                                                      \
         call_func;                                                             \
     } catch (SegcoreError & e) {                                               \
+        if (e.get_error_code() == FollyCancel) {                               \
+            throw;                                                             \
+        }                                                                      \
         auto err_msg = fmt::format(                                            \
             "Operator::{} failed for [Operator:{}, plan node id: "             \
             "{}] : {}",                                                        \
@@ -189,6 +203,43 @@ Driver::Next(std::shared_ptr<BlockingState>& blocking_state) {
                         e.what()));                                            \
     }
 
+namespace {
+
+// adds the time spent in its scope to the stats of an operator, if the query
+// is profiled
+class OperatorTimer {
+ public:
+    OperatorTimer(Operator* op, bool profiling)
+        : stats_(profiling ? &op->stats() : nullptr) {
+        if (stats_ != nullptr) {
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~OperatorTimer() {
+        if (stats_ != nullptr) {
+            stats_->wall_nanos +=
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start_)
+                    .count();
+        }
+    }
+
+ private:
+    OperatorStats* stats_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+void
+RecordOutput(Operator* op, const RowVectorPtr& result, bool profiling) {
+    if (profiling && result) {
+        ++op->stats().output_batches;
+        op->stats().output_rows += result->size();
+    }
+}
+
+}  // namespace
+
 StopReason
 Driver::RunInternal(std::shared_ptr<Driver>& self,
                     std::shared_ptr<BlockingState>& blocking_state,
@@ -196,8 +247,12 @@ Driver::RunInternal(std::shared_ptr<Driver>& self,
     try {
         int num_operators = operators_.size();
         ContinueFuture future;
+        auto op_context = ctx_->task_->query_context()->get_op_context();
+        auto profiling = ctx_->task_->query_context()->is_profiling();
 
         for (;;) {
+            // every round moves a batch through the pipeline
+            CheckCancellation(op_context);
             for (int32_t i = num_operators - 1; i >= 0; --i) {
                 auto op = operators_[i].get();
 
@@ -230,8 +285,10 @@ Driver::RunInternal(std::shared_ptr<Driver>& self,
                     if (needs_input) {
                         RowVectorPtr result;
                         {
+                            OperatorTimer timer(op, profiling);
                             CALL_OPERATOR(
                                 result = op->GetOutput(), op, "GetOutput");
+                            RecordOutput(op, result, profiling);
                             if (result) {
                                 AssertInfo(
                                     result->size() > 0,
@@ -242,6 +299,11 @@ Driver::RunInternal(std::shared_ptr<Driver>& self,
                             }
                         }
                         if (result) {
+                            if (profiling) {
+                                ++next_op->stats().input_batches;
+                                next_op->stats().input_rows += result->size();
+                            }
+                            OperatorTimer timer(next_op, profiling);
                             CALL_OPERATOR(
                                 next_op->AddInput(result), next_op, "AddInput");
                             i += 2;
@@ -271,8 +333,10 @@ Driver::RunInternal(std::shared_ptr<Driver>& self,
                     }
                 } else {
                     {
+                        OperatorTimer timer(op, profiling);
                         CALL_OPERATOR(
                             result = op->GetOutput(), op, "GetOutput");
+                        RecordOutput(op, result, profiling);
                         if (result) {
                             AssertInfo(
                                 result->size() > 0,
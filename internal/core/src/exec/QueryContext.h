@@ -17,6 +17,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -27,6 +28,7 @@
 #include "common/Common.h"
 #include "common/Types.h"
 #include "common/Exception.h"
+#include "common/OpContext.h"
 #include "segcore/SegmentInterface.h"
 
 namespace milvus {
@@ -119,6 +121,10 @@ class QueryConfig : public MemConfig {
     static constexpr const char* kExprEvalBatchSize =
         "expression.eval_batch_size";
 
+    // Whether to record the execution stats of the operators and
+    // expressions and return them with the result. False by default.
+    static constexpr const char* kProfileEnabled = "query.profile_enabled";
+
     QueryConfig(const std::unordered_map<std::string, std::string>& values)
         : MemConfig(values) {
     }
@@ -135,6 +141,11 @@ class QueryConfig : public MemConfig {
         return BaseConfig::Get<int64_t>(kExprEvalBatchSize,
                                         EXEC_EVAL_EXPR_BATCH_SIZE);
     }
+
+    bool
+    get_profile_enabled() const {
+        return BaseConfig::Get<bool>(kProfileEnabled, false);
+    }
 };
 
 class Context {
@@ -187,7 +198,8 @@ class QueryContext : public Context {
           active_count_(active_count),
           query_timestamp_(timestamp),
           query_config_(query_config),
-          executor_(executor) {
+          executor_(executor),
+          profiling_(query_config_->get_profile_enabled()) {
     }
 
     folly::Executor*
@@ -265,6 +277,58 @@ class QueryContext : public Context {
         return std::move(retrieve_result_);
     }
 
+    // filter and mvcc operators output every batch as soon as it's
+    // evaluated instead of the bitset of the whole segment, so the caller
+    // may stop pulling results early
+    void
+    set_streaming(bool streaming) {
+        streaming_ = streaming;
+    }
+
+    bool
+    is_streaming() const {
+        return streaming_;
+    }
+
+    void
+    set_op_context(const milvus::OpContext* op_context) {
+        op_context_ = op_context;
+    }
+
+    const milvus::OpContext*
+    get_op_context() const {
+        return op_context_;
+    }
+
+    bool
+    is_profiling() const {
+        return profiling_;
+    }
+
+    // called by the drivers when they close, so with the drivers of a
+    // parallel task concurrently
+    void
+    AddOperatorProfile(nlohmann::json&& profile) {
+        std::lock_guard<std::mutex> lock(profile_mutex_);
+        operator_profiles_.push_back(std::move(profile));
+    }
+
+    // the profiles of the operators of the query as a json object, empty
+    // if the query is not profiled
+    std::string
+    GetProfile() const {
+        if (!profiling_) {
+            return "";
+        }
+        std::lock_guard<std::mutex> lock(profile_mutex_);
+        nlohmann::json profile{{"active_count", active_count_},
+                               {"operators", operator_profiles_}};
+        if (segment_ != nullptr) {
+            profile["segment_id"] = segment_->get_segment_id();
+        }
+        return profile.dump();
+    }
+
  private:
     folly::Executor* executor_;
     //folly::Executor::KeepAlive<> executor_keepalive_;
@@ -286,6 +350,15 @@ class QueryContext : public Context {
     // used for store segment search/retrieve result
     milvus::SearchResult search_result_;
     milvus::RetrieveResult retrieve_result_;
+
+    bool streaming_{false};
+
+    // cancellation of the query, nullptr if it can't be cancelled
+    const milvus::OpContext* op_context_{nullptr};
+
+    bool profiling_;
+    mutable std::mutex profile_mutex_;
+    std::vector<nlohmann::json> operator_profiles_;
 };
 
 // Represent the state of one thread of query execution.
@@ -132,7 +132,10 @@ Task::CreateDriversLocked(std::shared_ptr<Task>& self,
 void
 Task::Terminate(TaskState state) {
     for (auto& driver : drivers_) {
-        driver->CloseByTask();
+        // finished drivers have been removed already
+        if (driver != nullptr) {
+            driver->CloseByTask();
+        }
     }
 }
 
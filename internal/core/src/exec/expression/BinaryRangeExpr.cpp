@@ -127,9 +127,13 @@ VectorPtr
 PhyBinaryRangeFilterExpr::ExecRangeVisitorImpl() {
     if (is_index_mode_) {
         return ExecRangeVisitorImplForIndex<T>();
-    } else {
-        return ExecRangeVisitorImplForData<T>();
     }
+    if constexpr (std::is_same_v<T, std::string_view>) {
+        if (segment_->type() == SegmentType::Sealed) {
+            return ExecRangeVisitorImplForStringData();
+        }
+    }
+    return ExecRangeVisitorImplForData<T>();
 }
 
 template <typename T, typename IndexInnerType, typename HighPrecisionType>
@@ -304,12 +308,90 @@ PhyBinaryRangeFilterExpr::ExecRangeVisitorImplForData() {
     return res_vec;
 }
 
+VectorPtr
+PhyBinaryRangeFilterExpr::ExecRangeVisitorImplForStringData() {
+    auto real_batch_size = GetNextBatchSize();
+    if (real_batch_size == 0) {
+        return nullptr;
+    }
+
+    bool lower_inclusive = expr_->lower_inclusive_;
+    bool upper_inclusive = expr_->upper_inclusive_;
+    auto val1 = GetValueFromProto<std::string>(expr_->lower_val_);
+    auto val2 = GetValueFromProto<std::string>(expr_->upper_val_);
+    auto res_vec = std::make_shared<ColumnVector>(
+        TargetBitmap(real_batch_size), TargetBitmap(real_batch_size));
+    TargetBitmapView res(res_vec->GetRawData(), real_batch_size);
+    TargetBitmapView valid_res(res_vec->GetValidRawData(), real_batch_size);
+    valid_res.set();
+
+    auto execute_sub_batch = [lower_inclusive, upper_inclusive](
+                                 const StringBatchView& data,
+                                 const bool* valid_data,
+                                 const int size,
+                                 TargetBitmapView res,
+                                 TargetBitmapView valid_res,
+                                 const std::string& val1,
+                                 const std::string& val2) {
+        if (lower_inclusive && upper_inclusive) {
+            BinaryRangeStringElementFunc<true, true> func;
+            func(val1, val2, data, size, res);
+        } else if (lower_inclusive && !upper_inclusive) {
+            BinaryRangeStringElementFunc<true, false> func;
+            func(val1, val2, data, size, res);
+        } else if (!lower_inclusive && upper_inclusive) {
+            BinaryRangeStringElementFunc<false, true> func;
+            func(val1, val2, data, size, res);
+        } else {
+            BinaryRangeStringElementFunc<false, false> func;
+            func(val1, val2, data, size, res);
+        }
+        if (valid_data != nullptr) {
+            for (int i = 0; i < size; i++) {
+                if (!valid_data[i]) {
+                    res[i] = valid_res[i] = false;
+                }
+            }
+        }
+    };
+    auto skip_index_func =
+        [&val1, &val2, lower_inclusive, upper_inclusive](
+            const SkipIndex& skip_index, FieldId field_id, int64_t chunk_id) {
+            return skip_index.CanSkipBinaryRange<std::string_view>(
+                field_id,
+                chunk_id,
+                val1,
+                val2,
+                lower_inclusive,
+                upper_inclusive);
+        };
+    int64_t processed_size = ProcessStringDataChunks(
+        execute_sub_batch, skip_index_func, res, valid_res, val1, val2);
+    AssertInfo(processed_size == real_batch_size,
+               "internal error: expr processed rows {} not equal "
+               "expect batch size {}, related params[active_count:{}, "
+               "current_data_chunk:{}, num_data_chunk:{}, current_data_pos:{}]",
+               processed_size,
+               real_batch_size,
+               active_count_,
+               current_data_chunk_,
+               num_data_chunk_,
+               current_data_chunk_pos_);
+    return res_vec;
+}
+
 template <typename ValueType>
 VectorPtr
 PhyBinaryRangeFilterExpr::ExecRangeVisitorImplForJson() {
     using GetType = std::conditional_t<std::is_same_v<ValueType, std::string>,
                                        std::string_view,
                                        ValueType>;
+    auto [field, path] = GetShreddedJsonPath(
+        milvus::Json::pointer(expr_->column_.nested_path_));
+    if (path != nullptr) {
+        return ExecRangeVisitorImplForShreddedJson<ValueType>(*field, *path);
+    }
+
     auto real_batch_size = GetNextBatchSize();
     if (real_batch_size == 0) {
         return nullptr;
@@ -358,6 +440,150 @@ PhyBinaryRangeFilterExpr::ExecRangeVisitorImplForJson() {
     return res_vec;
 }
 
+template <typename ValueType>
+VectorPtr
+PhyBinaryRangeFilterExpr::ExecRangeVisitorImplForShreddedJson(
+    const segcore::ShreddedJsonField& field,
+    const segcore::ShreddedJsonPath& path) {
+    using GetType = std::conditional_t<std::is_same_v<ValueType, std::string>,
+                                       std::string_view,
+                                       ValueType>;
+    auto real_batch_size = GetNextBatchSize();
+    if (real_batch_size == 0) {
+        return nullptr;
+    }
+    auto res_vec = std::make_shared<ColumnVector>(
+        TargetBitmap(real_batch_size), TargetBitmap(real_batch_size));
+    TargetBitmapView res(res_vec->GetRawData(), real_batch_size);
+    TargetBitmapView valid_res(res_vec->GetValidRawData(), real_batch_size);
+    valid_res.set();
+
+    bool lower_inclusive = expr_->lower_inclusive_;
+    bool upper_inclusive = expr_->upper_inclusive_;
+    ValueType val1 = GetValueFromProto<ValueType>(expr_->lower_val_);
+    ValueType val2 = GetValueFromProto<ValueType>(expr_->upper_val_);
+    auto data_type = path.data_type();
+    // the lookup of a value of another type fails, same as a missing path
+    bool comparable = std::is_same_v<ValueType, std::string>
+                          ? data_type == DataType::VARCHAR
+                          : data_type != DataType::VARCHAR;
+
+    auto valid_data = field.valid_data();
+    auto execute_sub_batch = [lower_inclusive,
+                              upper_inclusive,
+                              &path,
+                              comparable,
+                              valid_data](int64_t offset,
+                                          const int size,
+                                          TargetBitmapView res,
+                                          TargetBitmapView valid_res,
+                                          ValueType val1,
+                                          ValueType val2) {
+        if (comparable) {
+            if constexpr (std::is_same_v<ValueType, std::string>) {
+                auto data = path.string_data();
+                data.offsets_ += offset;
+                if (lower_inclusive && upper_inclusive) {
+                    BinaryRangeStringElementFunc<true, true> func;
+                    func(val1, val2, data, size, res);
+                } else if (lower_inclusive && !upper_inclusive) {
+                    BinaryRangeStringElementFunc<true, false> func;
+                    func(val1, val2, data, size, res);
+                } else if (!lower_inclusive && upper_inclusive) {
+                    BinaryRangeStringElementFunc<false, true> func;
+                    func(val1, val2, data, size, res);
+                } else {
+                    BinaryRangeStringElementFunc<false, false> func;
+                    func(val1, val2, data, size, res);
+                }
+            } else {
+                auto compare = [&](const auto* src) {
+                    using T = std::decay_t<decltype(*src)>;
+                    if (lower_inclusive && upper_inclusive) {
+                        BinaryRangeElementFuncForShreddedJson<T,
+                                                              ValueType,
+                                                              true,
+                                                              true>
+                            func;
+                        func(val1, val2, src, size, res);
+                    } else if (lower_inclusive && !upper_inclusive) {
+                        BinaryRangeElementFuncForShreddedJson<T,
+                                                              ValueType,
+                                                              true,
+                                                              false>
+                            func;
+                        func(val1, val2, src, size, res);
+                    } else if (!lower_inclusive && upper_inclusive) {
+                        BinaryRangeElementFuncForShreddedJson<T,
+                                                              ValueType,
+                                                              false,
+                                                              true>
+                            func;
+                        func(val1, val2, src, size, res);
+                    } else {
+                        BinaryRangeElementFuncForShreddedJson<T,
+                                                              ValueType,
+                                                              false,
+                                                              false>
+                            func;
+                        func(val1, val2, src, size, res);
+                    }
+                };
+                if (path.data_type() == DataType::INT64) {
+                    compare(path.data<int64_t>() + offset);
+                } else {
+                    compare(path.data<double>() + offset);
+                }
+            }
+        }
+        auto presence = path.presence() + offset;
+        for (int i = 0; i < size; i++) {
+            if (!comparable || !presence[i]) {
+                res[i] = false;
+            }
+            if (valid_data != nullptr && !valid_data[offset + i]) {
+                res[i] = valid_res[i] = false;
+            }
+        }
+    };
+
+    std::function<bool(const SkipIndex&, FieldId, int)> skip_index_func;
+    if ((std::is_same_v<ValueType, int64_t> && data_type == DataType::INT64) ||
+        (std::is_same_v<ValueType, double> && data_type == DataType::DOUBLE) ||
+        (std::is_same_v<ValueType, std::string> &&
+         data_type == DataType::VARCHAR)) {
+        skip_index_func = [lower_inclusive,
+                           upper_inclusive,
+                           &val1,
+                           &val2,
+                           &path](const SkipIndex& skip_index,
+                                  FieldId field_id,
+                                  int block_id) {
+            return skip_index.CanSkipJsonPathBinaryRange<GetType>(
+                field_id,
+                path.pointer(),
+                block_id,
+                val1,
+                val2,
+                lower_inclusive,
+                upper_inclusive);
+        };
+    }
+    int64_t processed_size = ProcessShreddedJsonChunks(execute_sub_batch,
+                                                       skip_index_func,
+                                                       valid_data,
+                                                       res,
+                                                       valid_res,
+                                                       val1,
+                                                       val2);
+    AssertInfo(processed_size == real_batch_size,
+               "internal error: expr processed rows {} not equal "
+               "expect batch size {}",
+               processed_size,
+               real_batch_size);
+    return res_vec;
+}
+
 template <typename ValueType>
 VectorPtr
 PhyBinaryRangeFilterExpr::ExecRangeVisitorImplForArray() {
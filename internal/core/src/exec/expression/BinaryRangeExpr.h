@@ -52,6 +52,58 @@ struct BinaryRangeElementFunc {
     }
 };
 
+// BinaryRangeElementFunc for a batch of sealed string values, values are
+// read in place through the batch offsets.
+template <bool lower_inclusive, bool upper_inclusive>
+struct BinaryRangeStringElementFunc {
+    void
+    operator()(const std::string& val1,
+               const std::string& val2,
+               const StringBatchView& src,
+               size_t n,
+               TargetBitmapView res) {
+        std::string_view lower(val1);
+        std::string_view upper(val2);
+        for (size_t i = 0; i < n; ++i) {
+            auto value = src[i];
+            bool lower_ok = lower_inclusive ? lower <= value : lower < value;
+            bool upper_ok = upper_inclusive ? value <= upper : value < upper;
+            res[i] = lower_ok && upper_ok;
+        }
+    }
+};
+
+// BinaryRangeElementFunc over the typed column of a shredded JSON path,
+// int64 and double are compared as double like the JSON lookups do.
+template <typename T,
+          typename ValueType,
+          bool lower_inclusive,
+          bool upper_inclusive>
+struct BinaryRangeElementFuncForShreddedJson {
+    void
+    operator()(ValueType val1,
+               ValueType val2,
+               const T* src,
+               size_t n,
+               TargetBitmapView res) {
+        if constexpr (std::is_same_v<T, ValueType>) {
+            BinaryRangeElementFunc<T, lower_inclusive, upper_inclusive> func;
+            func(val1, val2, src, n, res);
+        } else {
+            auto lower = static_cast<double>(val1);
+            auto upper = static_cast<double>(val2);
+            for (size_t i = 0; i < n; ++i) {
+                auto value = static_cast<double>(src[i]);
+                bool lower_ok =
+                    lower_inclusive ? lower <= value : lower < value;
+                bool upper_ok =
+                    upper_inclusive ? value <= upper : value < upper;
+                res[i] = lower_ok && upper_ok;
+            }
+        }
+    }
+};
+
 #define BinaryRangeJSONCompare(cmp)                           \
     do {                                                      \
         if (valid_data != nullptr && !valid_data[i]) {        \
@@ -225,10 +277,21 @@ class PhyBinaryRangeFilterExpr : public SegmentExpr {
     VectorPtr
     ExecRangeVisitorImplForData();
 
+    // string field of sealed segment, compared in place over the chunk
+    VectorPtr
+    ExecRangeVisitorImplForStringData();
+
     template <typename ValueType>
     VectorPtr
     ExecRangeVisitorImplForJson();
 
+    // json path shredded into a typed column by the sealed segment
+    template <typename ValueType>
+    VectorPtr
+    ExecRangeVisitorImplForShreddedJson(
+        const segcore::ShreddedJsonField& field,
+        const segcore::ShreddedJsonPath& path);
+
     template <typename ValueType>
     VectorPtr
     ExecRangeVisitorImplForArray();
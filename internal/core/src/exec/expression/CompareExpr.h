@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include <fmt/core.h>
 #include <boost/variant.hpp>
 
@@ -240,20 +242,14 @@ class PhyCompareFilterExpr : public Expr {
             const T* left_data = left_chunk.data() + data_pos;
             const U* right_data = right_chunk.data() + data_pos;
             func(left_data, right_data, size, res + processed_size, values...);
-            const bool* left_valid_data = left_chunk.valid_data();
-            const bool* right_valid_data = right_chunk.valid_data();
-            // mask with valid_data
-            for (int i = 0; i < size; ++i) {
-                if (left_valid_data && !left_valid_data[i + data_pos]) {
-                    res[processed_size + i] = false;
-                    valid_res[processed_size + i] = false;
-                    continue;
-                }
-                if (right_valid_data && !right_valid_data[i + data_pos]) {
-                    res[processed_size + i] = false;
-                    valid_res[processed_size + i] = false;
-                }
-            }
+            ClearNulls(left_chunk.valid_data(),
+                       data_pos,
+                       size,
+                       valid_res + processed_size);
+            ClearNulls(right_chunk.valid_data(),
+                       data_pos,
+                       size,
+                       valid_res + processed_size);
             processed_size += size;
 
             if (processed_size >= batch_size_) {
@@ -263,9 +259,40 @@ class PhyCompareFilterExpr : public Expr {
             }
         }
 
+        res.inplace_and(valid_res, processed_size);
         return processed_size;
     }
 
+    // clears the valid bits of the rows whose value is null, the result is
+    // masked with the valid bits once for the whole batch
+    static void
+    ClearNulls(const bool* valid_data,
+               int64_t data_pos,
+               int64_t size,
+               TargetBitmapView valid_res) {
+        if (valid_data == nullptr) {
+            return;
+        }
+        for (int64_t i = 0; i < size; ++i) {
+            if (!valid_data[data_pos + i]) {
+                valid_res[i] = false;
+            }
+        }
+    }
+
+    int64_t
+    ChunkRows(FieldId field_id, int64_t chunk_id, int64_t num_chunk) const {
+        auto segment = segment_chunk_reader_.segment_;
+        if (segment->type() == SegmentType::Growing) {
+            auto size_per_chunk = segment_chunk_reader_.SizePerChunk();
+            return chunk_id == num_chunk - 1
+                       ? segment_chunk_reader_.active_count_ -
+                             chunk_id * size_per_chunk
+                       : size_per_chunk;
+        }
+        return segment->chunk_size(field_id, chunk_id);
+    }
+
     template <typename T, typename U, typename FUNC, typename... ValTypes>
     int64_t
     ProcessBothDataChunksForMultipleChunk(FUNC func,
@@ -274,63 +301,57 @@ class PhyCompareFilterExpr : public Expr {
                                           ValTypes... values) {
         int64_t processed_size = 0;
 
-        // only call this function when left and right are not indexed, so they have the same number of chunks
-        for (size_t i = left_current_chunk_id_; i < left_num_chunk_; i++) {
-            auto left_chunk =
-                segment_chunk_reader_.segment_->chunk_data<T>(left_field_, i);
-            auto right_chunk =
-                segment_chunk_reader_.segment_->chunk_data<U>(right_field_, i);
-            auto data_pos =
-                (i == left_current_chunk_id_) ? left_current_chunk_pos_ : 0;
-            auto size = 0;
-            if (segment_chunk_reader_.segment_->type() ==
-                SegmentType::Growing) {
-                size =
-                    (i == (left_num_chunk_ - 1))
-                        ? (segment_chunk_reader_.active_count_ %
-                                       segment_chunk_reader_.SizePerChunk() ==
-                                   0
-                               ? segment_chunk_reader_.SizePerChunk() - data_pos
-                               : segment_chunk_reader_.active_count_ %
-                                         segment_chunk_reader_.SizePerChunk() -
-                                     data_pos)
-                        : segment_chunk_reader_.SizePerChunk() - data_pos;
-            } else {
-                size =
-                    segment_chunk_reader_.segment_->chunk_size(left_field_, i) -
-                    data_pos;
+        // the fields of a sealed segment are loaded from their own binlogs,
+        // so the chunks of the two sides may end at different rows, every
+        // step compares the rows up to the nearer end of the two chunks
+        auto segment = segment_chunk_reader_.segment_;
+        while (processed_size < batch_size_) {
+            auto left_rows = ChunkRows(
+                left_field_, left_current_chunk_id_, left_num_chunk_);
+            if (left_current_chunk_pos_ >= left_rows &&
+                left_current_chunk_id_ + 1 < left_num_chunk_) {
+                ++left_current_chunk_id_;
+                left_current_chunk_pos_ = 0;
+                continue;
             }
-
-            if (processed_size + size >= batch_size_) {
-                size = batch_size_ - processed_size;
-            }
-
-            const T* left_data = left_chunk.data() + data_pos;
-            const U* right_data = right_chunk.data() + data_pos;
-            func(left_data, right_data, size, res + processed_size, values...);
-            const bool* left_valid_data = left_chunk.valid_data();
-            const bool* right_valid_data = right_chunk.valid_data();
-            // mask with valid_data
-            for (int i = 0; i < size; ++i) {
-                if (left_valid_data && !left_valid_data[i + data_pos]) {
-                    res[processed_size + i] = false;
-                    valid_res[processed_size + i] = false;
-                    continue;
-                }
-                if (right_valid_data && !right_valid_data[i + data_pos]) {
-                    res[processed_size + i] = false;
-                    valid_res[processed_size + i] = false;
-                }
+            auto right_rows = ChunkRows(
+                right_field_, right_current_chunk_id_, right_num_chunk_);
+            if (right_current_chunk_pos_ >= right_rows &&
+                right_current_chunk_id_ + 1 < right_num_chunk_) {
+                ++right_current_chunk_id_;
+                right_current_chunk_pos_ = 0;
+                continue;
             }
-            processed_size += size;
-
-            if (processed_size >= batch_size_) {
-                left_current_chunk_id_ = i;
-                left_current_chunk_pos_ = data_pos + size;
+            auto size = std::min({left_rows - left_current_chunk_pos_,
+                                  right_rows - right_current_chunk_pos_,
+                                  batch_size_ - processed_size});
+            if (size <= 0) {
                 break;
             }
+
+            auto left_chunk =
+                segment->chunk_data<T>(left_field_, left_current_chunk_id_);
+            auto right_chunk =
+                segment->chunk_data<U>(right_field_, right_current_chunk_id_);
+            func(left_chunk.data() + left_current_chunk_pos_,
+                 right_chunk.data() + right_current_chunk_pos_,
+                 size,
+                 res + processed_size,
+                 values...);
+            ClearNulls(left_chunk.valid_data(),
+                       left_current_chunk_pos_,
+                       size,
+                       valid_res + processed_size);
+            ClearNulls(right_chunk.valid_data(),
+                       right_current_chunk_pos_,
+                       size,
+                       valid_res + processed_size);
+            processed_size += size;
+            left_current_chunk_pos_ += size;
+            right_current_chunk_pos_ += size;
         }
 
+        res.inplace_and(valid_res, processed_size);
         return processed_size;
     }
 
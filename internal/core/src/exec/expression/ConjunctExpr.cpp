@@ -92,7 +92,7 @@ void
 PhyConjunctFilterExpr::Eval(EvalCtx& context, VectorPtr& result) {
     for (int i = 0; i < inputs_.size(); ++i) {
         VectorPtr input_result;
-        inputs_[i]->Eval(context, input_result);
+        inputs_[i]->EvalWithStats(context, input_result);
         if (i == 0) {
             result = input_result;
             auto all_flat_result = GetColumnVector(result);
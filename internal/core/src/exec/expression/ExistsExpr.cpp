@@ -51,6 +51,35 @@ PhyExistsFilterExpr::EvalJsonExistsForDataSegment() {
     valid_res.set();
 
     auto pointer = milvus::Json::pointer(expr_->column_.nested_path_);
+    auto [field, path] = GetShreddedJsonPath(pointer);
+    if (path != nullptr) {
+        // a path is shredded only if every value it holds is of the
+        // shredded type, so it exists exactly where it is present
+        auto valid_data = field->valid_data();
+        auto execute_sub_batch = [path = path, valid_data](
+                                     int64_t offset,
+                                     const int size,
+                                     TargetBitmapView res,
+                                     TargetBitmapView valid_res) {
+            auto presence = path->presence() + offset;
+            for (int i = 0; i < size; ++i) {
+                if (valid_data != nullptr && !valid_data[offset + i]) {
+                    res[i] = valid_res[i] = false;
+                    continue;
+                }
+                res[i] = presence[i];
+            }
+        };
+        int64_t processed_size = ProcessShreddedJsonChunks(
+            execute_sub_batch, nullptr, valid_data, res, valid_res);
+        AssertInfo(processed_size == real_batch_size,
+                   "internal error: expr processed rows {} not equal "
+                   "expect batch size {}",
+                   processed_size,
+                   real_batch_size);
+        return res_vec;
+    }
+
     auto execute_sub_batch = [](const milvus::Json* data,
                                 const bool* valid_data,
                                 const int size,
@@ -32,6 +32,7 @@
 #include "exec/expression/UnaryExpr.h"
 #include "exec/expression/ValueExpr.h"
 
+#include <chrono>
 #include <memory>
 
 namespace milvus {
@@ -46,10 +47,51 @@ ExprSet::Eval(int32_t begin,
     results.resize(exprs_.size());
 
     for (size_t i = begin; i < end; ++i) {
-        exprs_[i]->Eval(context, results[i]);
+        exprs_[i]->EvalWithStats(context, results[i]);
     }
 }
 
+void
+Expr::EvalWithStats(EvalCtx& context, VectorPtr& result) {
+    if (!context.get_exec_context()->get_query_context()->is_profiling()) {
+        Eval(context, result);
+        return;
+    }
+    auto start = std::chrono::steady_clock::now();
+    Eval(context, result);
+    stats_.wall_nanos += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::steady_clock::now() - start)
+                             .count();
+    ++stats_.batches;
+    auto col_vec = std::dynamic_pointer_cast<ColumnVector>(result);
+    if (col_vec != nullptr) {
+        stats_.rows += col_vec->size();
+        if (col_vec->IsBitmap()) {
+            TargetBitmapView view(col_vec->GetRawData(), col_vec->size());
+            stats_.true_rows += view.count();
+        }
+    }
+}
+
+nlohmann::json
+Expr::Profile() const {
+    nlohmann::json profile{
+        {"expr", name_},
+        {"batches", stats_.batches},
+        {"rows", stats_.rows},
+        {"true_rows", stats_.true_rows},
+        {"wall_ms", stats_.wall_nanos / 1e6},
+    };
+    AddProfileDetails(profile);
+    if (!inputs_.empty()) {
+        auto& inputs = profile["inputs"] = nlohmann::json::array();
+        for (auto& input : inputs_) {
+            inputs.push_back(input->Profile());
+        }
+    }
+    return profile;
+}
+
 std::vector<ExprPtr>
 CompileExpressions(const std::vector<expr::TypedExprPtr>& sources,
                    ExecContext* context,
@@ -31,6 +31,16 @@
 namespace milvus {
 namespace exec {
 
+// execution stats of an expression, recorded only if the query is profiled
+struct ExprStats {
+    int64_t batches{0};
+    int64_t rows{0};
+    // rows the expression is true for
+    int64_t true_rows{0};
+    // time spent in Eval, including the inputs of the expression
+    int64_t wall_nanos{0};
+};
+
 class Expr {
  public:
     Expr(DataType type,
@@ -67,13 +77,29 @@ class Expr {
     Eval(EvalCtx& context, VectorPtr& result) {
     }
 
+    // Eval, recording the stats of the expression if the query is profiled.
+    // The inputs of an expression are evaluated through it.
+    void
+    EvalWithStats(EvalCtx& context, VectorPtr& result);
+
     // Only move cursor to next batch
     // but not do real eval for optimization
     virtual void
     MoveCursor() {
     }
 
+    // the stats of the expression and of its inputs as a json tree
+    nlohmann::json
+    Profile() const;
+
  protected:
+    // adds the expression specific details to the profile of the expression
+    virtual void
+    AddProfileDetails(nlohmann::json& profile) const {
+    }
+
+    ExprStats stats_;
+
     DataType type_;
     const std::vector<std::shared_ptr<Expr>> inputs_;
     std::string name_;
@@ -252,7 +278,7 @@ class SegmentExpr : public Expr {
     }
 
     // used for processing raw data expr for sealed segments.
-    // now only used for std::string_view && json
+    // now only used for std::string_view, json and array views
     // TODO: support more types
     template <typename T, typename FUNC, typename... ValTypes>
     int64_t
@@ -280,6 +306,7 @@ class SegmentExpr : public Expr {
                  valid_res,
                  values...);
         } else {
+            ++skip_index_hits_;
             ApplyValidData(views_info.second.data(), res, valid_res, need_size);
         }
         current_data_chunk_pos_ += need_size;
@@ -297,7 +324,8 @@ class SegmentExpr : public Expr {
         int64_t processed_size = 0;
 
         if constexpr (std::is_same_v<T, std::string_view> ||
-                      std::is_same_v<T, Json>) {
+                      std::is_same_v<T, Json> ||
+                      std::is_same_v<T, ArrayView>) {
             if (segment_->type() == SegmentType::Sealed) {
                 return ProcessChunkForSealedSeg<T>(
                     func, skip_func, res, valid_res, values...);
@@ -333,6 +361,7 @@ class SegmentExpr : public Expr {
                      valid_res + processed_size,
                      values...);
             } else {
+                ++skip_index_hits_;
                 ApplyValidData(valid_data,
                                res + processed_size,
                                valid_res + processed_size,
@@ -380,7 +409,8 @@ class SegmentExpr : public Expr {
             if (!skip_func || !skip_func(skip_index, field_id_, i)) {
                 bool is_seal = false;
                 if constexpr (std::is_same_v<T, std::string_view> ||
-                              std::is_same_v<T, Json>) {
+                              std::is_same_v<T, Json> ||
+                              std::is_same_v<T, ArrayView>) {
                     if (segment_->type() == SegmentType::Sealed) {
                         // first is the raw data, second is valid_data
                         // use valid_data to see if raw data is null
@@ -412,14 +442,19 @@ class SegmentExpr : public Expr {
                          values...);
                 }
             } else {
+                ++skip_index_hits_;
                 const bool* valid_data;
+                FixedVector<bool> batch_valid_data;
                 if constexpr (std::is_same_v<T, std::string_view> ||
-                              std::is_same_v<T, Json>) {
+                              std::is_same_v<T, Json> ||
+                              std::is_same_v<T, ArrayView>) {
                     if (segment_->type() == SegmentType::Sealed) {
-                        valid_data = segment_
-                                         ->get_batch_views<T>(
-                                             field_id_, i, data_pos, size)
-                                         .second.data();
+                        batch_valid_data =
+                            segment_
+                                ->get_batch_views<T>(
+                                    field_id_, i, data_pos, size)
+                                .second;
+                        valid_data = batch_valid_data.data();
                     }
                 } else {
                     auto chunk = segment_->chunk_data<T>(field_id_, i);
@@ -461,6 +496,144 @@ class SegmentExpr : public Expr {
         }
     }
 
+    // variant of ProcessDataChunks for string fields of sealed segment,
+    // func is called with the StringBatchView of the batch, the kernel reads
+    // values through (data, offsets) in place and no per-row string_view
+    // vector is built.
+    template <typename FUNC, typename... ValTypes>
+    int64_t
+    ProcessStringDataChunks(
+        FUNC func,
+        std::function<bool(const milvus::SkipIndex&, FieldId, int)> skip_func,
+        TargetBitmapView res,
+        TargetBitmapView valid_res,
+        const ValTypes&... values) {
+        AssertInfo(segment_->type() == SegmentType::Sealed,
+                   "string batch only supported for sealed segment");
+        int64_t processed_size = 0;
+
+        for (size_t i = current_data_chunk_; i < num_data_chunk_; i++) {
+            auto data_pos =
+                (i == current_data_chunk_) ? current_data_chunk_pos_ : 0;
+            // sealed segment which is not chunked only has one chunk
+            int64_t size = (segment_->is_chunked()
+                                ? segment_->chunk_size(field_id_, i)
+                                : active_count_) -
+                           data_pos;
+
+            size = std::min(size, batch_size_ - processed_size);
+
+            auto& skip_index = segment_->GetSkipIndex();
+            auto [data, valid_data] = segment_->get_string_batch(
+                field_id_, i, data_pos, size, string_offsets_buf_);
+            if (!skip_func || !skip_func(skip_index, field_id_, i)) {
+                func(data,
+                     valid_data,
+                     size,
+                     res + processed_size,
+                     valid_res + processed_size,
+                     values...);
+            } else {
+                ++skip_index_hits_;
+                ApplyValidData(valid_data,
+                               res + processed_size,
+                               valid_res + processed_size,
+                               size);
+            }
+
+            processed_size += size;
+            if (processed_size >= batch_size_ || i == num_data_chunk_ - 1) {
+                current_data_chunk_ = i;
+                current_data_chunk_pos_ = data_pos + size;
+                break;
+            }
+        }
+
+        return processed_size;
+    }
+
+    // typed column of the JSON path if it is shredded by the sealed segment
+    // (see segcore/JsonShredding.h), nullptr otherwise
+    std::pair<const segcore::ShreddedJsonField*,
+              const segcore::ShreddedJsonPath*>
+    GetShreddedJsonPath(const std::string& pointer) const {
+        auto field = segment_->GetShreddedJsonField(field_id_);
+        if (field == nullptr) {
+            return {nullptr, nullptr};
+        }
+        return {field, field->GetPath(pointer)};
+    }
+
+    // variant of ProcessDataChunks for JSON paths shredded into typed
+    // columns, func is called with the segment offset of each piece of the
+    // batch instead of the data. Pieces don't cross the blocks of the zone
+    // maps of the path, skip_func is called with the block id.
+    template <typename FUNC, typename... ValTypes>
+    int64_t
+    ProcessShreddedJsonChunks(
+        FUNC func,
+        std::function<bool(const milvus::SkipIndex&, FieldId, int)> skip_func,
+        const bool* valid_data,
+        TargetBitmapView res,
+        TargetBitmapView valid_res,
+        ValTypes... values) {
+        AssertInfo(segment_->type() == SegmentType::Sealed,
+                   "shredded json only supported for sealed segment");
+        int64_t processed_size = 0;
+
+        for (size_t i = current_data_chunk_; i < num_data_chunk_; i++) {
+            auto data_pos =
+                (i == current_data_chunk_) ? current_data_chunk_pos_ : 0;
+            // sealed segment which is not chunked only has one chunk
+            int64_t size = (segment_->is_chunked()
+                                ? segment_->chunk_size(field_id_, i)
+                                : active_count_) -
+                           data_pos;
+
+            size = std::min(size, batch_size_ - processed_size);
+
+            int64_t offset =
+                (segment_->is_chunked()
+                     ? segment_->num_rows_until_chunk(field_id_, i)
+                     : 0) +
+                data_pos;
+            auto& skip_index = segment_->GetSkipIndex();
+            for (int64_t done = 0; done < size;) {
+                auto block_id =
+                    (offset + done) / segcore::JSON_SHREDDING_BLOCK_SIZE;
+                auto piece = std::min(
+                    size - done,
+                    (block_id + 1) * segcore::JSON_SHREDDING_BLOCK_SIZE -
+                        (offset + done));
+                if (!skip_func || !skip_func(skip_index, field_id_, block_id)) {
+                    func(offset + done,
+                         piece,
+                         res + processed_size + done,
+                         valid_res + processed_size + done,
+                         values...);
+                } else {
+                    ++skip_index_hits_;
+                    ApplyValidData(valid_data == nullptr
+                                       ? nullptr
+                                       : valid_data + offset + done,
+                                   res + processed_size + done,
+                                   valid_res + processed_size + done,
+                                   piece);
+                }
+                done += piece;
+            }
+
+            processed_size += size;
+            if (processed_size >= batch_size_ || i == num_data_chunk_ - 1) {
+                current_data_chunk_ = i;
+                current_data_chunk_pos_ = data_pos + size;
+                break;
+            }
+        }
+
+        return processed_size;
+    }
+
     int
     ProcessIndexOneChunk(TargetBitmap& result,
                          TargetBitmap& valid_result,
@@ -747,6 +920,13 @@ class SegmentExpr : public Expr {
     }
 
  protected:
+    void
+    AddProfileDetails(nlohmann::json& profile) const override {
+        profile["field_id"] = field_id_.get();
+        profile["path"] = is_index_mode_ && use_index_ ? "index" : "raw";
+        profile["skip_index_hits"] = skip_index_hits_;
+    }
+
     const segcore::SegmentInternalInterface* segment_;
     const FieldId field_id_;
     bool is_pk_field_{false};
@@ -766,6 +946,9 @@ class SegmentExpr : public Expr {
     // because expr maybe called for every batch.
     int64_t current_data_chunk_{0};
     int64_t current_data_chunk_pos_{0};
+    // scratch offsets for string batches of columns whose offsets can't
+    // be referenced in place, reused across batches
+    std::vector<uint64_t> string_offsets_buf_;
     int64_t current_index_chunk_{0};
     int64_t current_index_chunk_pos_{0};
     int64_t size_per_chunk_{0};
@@ -778,6 +961,9 @@ class SegmentExpr : public Expr {
 
     // Cache for text match.
     std::shared_ptr<TargetBitmap> cached_match_res_{nullptr};
+
+    // chunks of the raw data ruled out by the skip index
+    int64_t skip_index_hits_{0};
 };
 
 void
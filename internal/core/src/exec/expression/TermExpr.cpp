@@ -397,6 +397,27 @@ PhyTermFilterExpr::ExecTermJsonVariableInField() {
                                 const std::string pointer,
                                 const ValueType& target_val) {
         auto executor = [&](size_t i) {
+            if (data[i].binary() != nullptr) {
+                // walk the pre-parsed array, no need to parse the text
+                JsonBinaryValue array;
+                if (JsonBinaryValue(data[i].binary())
+                            .at_pointer(pointer, array) != simdjson::SUCCESS ||
+                    array.type() != JsonBinaryType::ARRAY) {
+                    return false;
+                }
+                for (uint32_t j = 0; j < array.size(); ++j) {
+                    JsonBinaryValue element;
+                    GetType val;
+                    if (array.at(j, element) != simdjson::SUCCESS ||
+                        element.get(val) != simdjson::SUCCESS) {
+                        return false;
+                    }
+                    if (val == target_val) {
+                        return true;
+                    }
+                }
+                return false;
+            }
             auto doc = data[i].doc();
             auto array = doc.at_pointer(pointer).get_array();
             if (array.error())
@@ -511,9 +532,13 @@ VectorPtr
 PhyTermFilterExpr::ExecVisitorImpl() {
     if (is_index_mode_) {
         return ExecVisitorImplForIndex<T>();
-    } else {
-        return ExecVisitorImplForData<T>();
     }
+    if constexpr (std::is_same_v<T, std::string_view>) {
+        if (segment_->type() == SegmentType::Sealed) {
+            return ExecVisitorImplForStringData();
+        }
+    }
+    return ExecVisitorImplForData<T>();
 }
 
 template <typename T>
@@ -622,5 +647,49 @@ PhyTermFilterExpr::ExecVisitorImplForData() {
     return res_vec;
 }
 
+VectorPtr
+PhyTermFilterExpr::ExecVisitorImplForStringData() {
+    auto real_batch_size = GetNextBatchSize();
+    if (real_batch_size == 0) {
+        return nullptr;
+    }
+
+    auto res_vec = std::make_shared<ColumnVector>(
+        TargetBitmap(real_batch_size), TargetBitmap(real_batch_size));
+    TargetBitmapView res(res_vec->GetRawData(), real_batch_size);
+    TargetBitmapView valid_res(res_vec->GetValidRawData(), real_batch_size);
+    valid_res.set();
+
+    std::unordered_set<std::string_view> vals_set;
+    for (auto& val : expr_->vals_) {
+        vals_set.emplace(GetValueFromProto<std::string_view>(val));
+    }
+    auto execute_sub_batch =
+        [](const StringBatchView& data,
+           const bool* valid_data,
+           const int size,
+           TargetBitmapView res,
+           TargetBitmapView valid_res,
+           const std::unordered_set<std::string_view>& vals) {
+            TermStringElementFuncSet func;
+            func(vals, data, size, res);
+            if (valid_data != nullptr) {
+                for (int i = 0; i < size; i++) {
+                    if (!valid_data[i]) {
+                        res[i] = valid_res[i] = false;
+                    }
+                }
+            }
+        };
+    int64_t processed_size = ProcessStringDataChunks(
+        execute_sub_batch, std::nullptr_t{}, res, valid_res, vals_set);
+    AssertInfo(processed_size == real_batch_size,
+               "internal error: expr processed rows {} not equal "
+               "expect batch size {}",
+               processed_size,
+               real_batch_size);
+    return res_vec;
+}
+
 }  //namespace exec
 }  // namespace milvus
@@ -18,6 +18,8 @@
 
 #include <fmt/core.h>
 
+#include <limits>
+
 #include "common/EasyAssert.h"
 #include "common/Types.h"
 #include "common/Vector.h"
@@ -35,6 +37,29 @@ struct TermElementFuncSet {
     }
 };
 
+// TermElementFuncSet for a batch of sealed string values, values are read
+// in place through the batch offsets, rows whose length is out of the
+// length range of the term values are rejected before hashing.
+struct TermStringElementFuncSet {
+    void
+    operator()(const std::unordered_set<std::string_view>& srcs,
+               const StringBatchView& vals,
+               size_t n,
+               TargetBitmapView res) {
+        size_t min_size = std::numeric_limits<size_t>::max();
+        size_t max_size = 0;
+        for (const auto& src : srcs) {
+            min_size = std::min(min_size, src.size());
+            max_size = std::max(max_size, src.size());
+        }
+        for (size_t i = 0; i < n; ++i) {
+            auto size = vals.value_size(i);
+            res[i] = size >= min_size && size <= max_size &&
+                     srcs.find(vals[i]) != srcs.end();
+        }
+    }
+};
+
 template <typename T>
 struct TermIndexFunc {
     typedef std::
@@ -93,6 +118,10 @@ class PhyTermFilterExpr : public SegmentExpr {
     VectorPtr
     ExecVisitorImplForData();
 
+    // string field of sealed segment, looked up in place over the chunk
+    VectorPtr
+    ExecVisitorImplForStringData();
+
     template <typename ValueType>
     VectorPtr
     ExecVisitorImplTemplateJson();
@@ -15,6 +15,8 @@
 // limitations under the License.
 
 #include "UnaryExpr.h"
+#include <algorithm>
+#include <map>
 #include <optional>
 #include "common/Json.h"
 
@@ -367,35 +369,6 @@ PhyUnaryRangeFilterExpr::ExecArrayEqualForIndex(bool reverse) {
                 }
             }
 
-            // filtering by index, get candidates.
-            std::function<const milvus::ArrayView*(int64_t)> retrieve;
-            if (segment_->is_chunked()) {
-                retrieve = [this](int64_t offset) -> const milvus::ArrayView* {
-                    auto [chunk_idx, chunk_offset] =
-                        segment_->get_chunk_by_offset(field_id_, offset);
-                    const auto& chunk =
-                        segment_->template chunk_data<milvus::ArrayView>(
-                            field_id_, chunk_idx);
-                    return chunk.data() + chunk_offset;
-                };
-            } else {
-                auto size_per_chunk = segment_->size_per_chunk();
-                retrieve = [ size_per_chunk, this ](int64_t offset) -> auto {
-                    auto chunk_idx = offset / size_per_chunk;
-                    auto chunk_offset = offset % size_per_chunk;
-                    const auto& chunk =
-                        segment_->template chunk_data<milvus::ArrayView>(
-                            field_id_, chunk_idx);
-                    return chunk.data() + chunk_offset;
-                };
-            }
-
-            // compare the array via the raw data.
-            auto filter = [&retrieve, &val, reverse](size_t offset) -> bool {
-                auto data_ptr = retrieve(offset);
-                return data_ptr->is_same_array(val) ^ reverse;
-            };
-
             // collect all candidates.
             std::unordered_set<size_t> candidates;
             std::unordered_set<size_t> tmp_candidates;
@@ -432,8 +405,62 @@ PhyUnaryRangeFilterExpr::ExecArrayEqualForIndex(bool reverse) {
             }
             TargetBitmap res(active_count_);
             // run post-filter. The filter will only be executed once in the framework.
-            for (const auto& candidate : candidates) {
-                res[candidate] = filter(candidate);
+            if (segment_->type() == SegmentType::Sealed) {
+                // array views of sealed segment are built on demand, once per
+                // dense run of the candidates of a chunk, so the sparse
+                // candidates don't build the views of the rows between them.
+                constexpr int64_t max_gap = 64;
+                std::map<int64_t, std::vector<std::pair<int64_t, size_t>>>
+                    chunk_candidates;
+                for (auto candidate : candidates) {
+                    auto [chunk_idx, chunk_offset] =
+                        segment_->is_chunked()
+                            ? segment_->get_chunk_by_offset(field_id_,
+                                                            candidate)
+                            : std::make_pair(int64_t(0), int64_t(candidate));
+                    chunk_candidates[chunk_idx].emplace_back(chunk_offset,
+                                                             candidate);
+                }
+                for (auto& [chunk_idx, offsets] : chunk_candidates) {
+                    std::sort(offsets.begin(), offsets.end());
+                    for (size_t run_begin = 0; run_begin < offsets.size();) {
+                        auto run_end = run_begin + 1;
+                        while (run_end < offsets.size() &&
+                               offsets[run_end].first -
+                                       offsets[run_end - 1].first <=
+                                   max_gap) {
+                            ++run_end;
+                        }
+                        auto begin = offsets[run_begin].first;
+                        auto views =
+                            segment_
+                                ->template get_batch_views<milvus::ArrayView>(
+                                    field_id_,
+                                    chunk_idx,
+                                    begin,
+                                    offsets[run_end - 1].first - begin + 1)
+                                .first;
+                        for (auto i = run_begin; i < run_end; ++i) {
+                            auto [chunk_offset, offset] = offsets[i];
+                            res[offset] =
+                                views[chunk_offset - begin].is_same_array(
+                                    val) ^
+                                reverse;
+                        }
+                        run_begin = run_end;
+                    }
+                }
+            } else {
+                auto size_per_chunk = segment_->size_per_chunk();
+                for (auto candidate : candidates) {
+                    const auto& chunk =
+                        segment_->template chunk_data<milvus::ArrayView>(
+                            field_id_, candidate / size_per_chunk);
+                    res[candidate] =
+                        chunk.data()[candidate % size_per_chunk].is_same_array(
+                            val) ^
+                        reverse;
+                }
             }
             return res;
         });
@@ -454,6 +481,20 @@ PhyUnaryRangeFilterExpr::ExecRangeVisitorImplJson() {
         std::conditional_t<std::is_same_v<ExprValueType, std::string>,
                            std::string_view,
                            ExprValueType>;
+    if constexpr (!std::is_same_v<ExprValueType, proto::plan::Array>) {
+        auto [field, path] = GetShreddedJsonPath(
+            milvus::Json::pointer(expr_->column_.nested_path_));
+        auto op_type = expr_->op_type_;
+        bool match_op = op_type == proto::plan::PrefixMatch ||
+                        op_type == proto::plan::Match;
+        if (path != nullptr &&
+            (!match_op || (std::is_same_v<ExprValueType, std::string> &&
+                           path->data_type() == DataType::VARCHAR))) {
+            return ExecRangeVisitorImplJsonForShredded<ExprValueType>(*field,
+                                                                      *path);
+        }
+    }
+
     auto real_batch_size = GetNextBatchSize();
     if (real_batch_size == 0) {
         return nullptr;
@@ -651,6 +692,151 @@ PhyUnaryRangeFilterExpr::ExecRangeVisitorImplJson() {
     return res_vec;
 }
 
+template <typename ExprValueType>
+VectorPtr
+PhyUnaryRangeFilterExpr::ExecRangeVisitorImplJsonForShredded(
+    const segcore::ShreddedJsonField& field,
+    const segcore::ShreddedJsonPath& path) {
+    using GetType =
+        std::conditional_t<std::is_same_v<ExprValueType, std::string>,
+                           std::string_view,
+                           ExprValueType>;
+    auto real_batch_size = GetNextBatchSize();
+    if (real_batch_size == 0) {
+        return nullptr;
+    }
+
+    ExprValueType val = GetValueFromProto<ExprValueType>(expr_->val_);
+    auto res_vec = std::make_shared<ColumnVector>(
+        TargetBitmap(real_batch_size), TargetBitmap(real_batch_size));
+    TargetBitmapView res(res_vec->GetRawData(), real_batch_size);
+    TargetBitmapView valid_res(res_vec->GetValidRawData(), real_batch_size);
+    valid_res.set();
+    auto op_type = expr_->op_type_;
+    auto data_type = path.data_type();
+    constexpr bool is_number = std::is_same_v<ExprValueType, int64_t> ||
+                               std::is_same_v<ExprValueType, double>;
+    constexpr bool is_string = std::is_same_v<ExprValueType, std::string>;
+    // the lookup of a value of another type fails, same as a missing path
+    bool comparable =
+        (is_number &&
+         (data_type == DataType::INT64 || data_type == DataType::DOUBLE)) ||
+        (is_string && data_type == DataType::VARCHAR);
+
+    auto valid_data = field.valid_data();
+    auto execute_sub_batch = [op_type, &path, comparable, valid_data](
+                                 int64_t offset,
+                                 const int size,
+                                 TargetBitmapView res,
+                                 TargetBitmapView valid_res,
+                                 ExprValueType val) {
+        if (comparable) {
+            if constexpr (std::is_same_v<ExprValueType, int64_t> ||
+                          std::is_same_v<ExprValueType, double>) {
+                if (path.data_type() == DataType::INT64) {
+                    UnaryShreddedJsonCompare(op_type,
+                                             path.data<int64_t>() + offset,
+                                             size,
+                                             val,
+                                             res);
+                } else {
+                    UnaryShreddedJsonCompare(op_type,
+                                             path.data<double>() + offset,
+                                             size,
+                                             val,
+                                             res);
+                }
+            } else if constexpr (std::is_same_v<ExprValueType,
+                                                std::string>) {
+                auto data = path.string_data();
+                data.offsets_ += offset;
+                switch (op_type) {
+                    case proto::plan::GreaterThan: {
+                        UnaryStringElementFunc<proto::plan::GreaterThan> func;
+                        func(data, size, val, res);
+                        break;
+                    }
+                    case proto::plan::GreaterEqual: {
+                        UnaryStringElementFunc<proto::plan::GreaterEqual> func;
+                        func(data, size, val, res);
+                        break;
+                    }
+                    case proto::plan::LessThan: {
+                        UnaryStringElementFunc<proto::plan::LessThan> func;
+                        func(data, size, val, res);
+                        break;
+                    }
+                    case proto::plan::LessEqual: {
+                        UnaryStringElementFunc<proto::plan::LessEqual> func;
+                        func(data, size, val, res);
+                        break;
+                    }
+                    case proto::plan::Equal: {
+                        UnaryStringElementFunc<proto::plan::Equal> func;
+                        func(data, size, val, res);
+                        break;
+                    }
+                    case proto::plan::NotEqual: {
+                        UnaryStringElementFunc<proto::plan::NotEqual> func;
+                        func(data, size, val, res);
+                        break;
+                    }
+                    case proto::plan::PrefixMatch: {
+                        UnaryStringElementFunc<proto::plan::PrefixMatch> func;
+                        func(data, size, val, res);
+                        break;
+                    }
+                    case proto::plan::Match: {
+                        UnaryStringElementFunc<proto::plan::Match> func;
+                        func(data, size, val, res);
+                        break;
+                    }
+                    default:
+                        PanicInfo(OpTypeInvalid,
+                                  "unsupported operator type for unary expr: "
+                                  "{}",
+                                  op_type);
+                }
+            }
+        }
+        auto presence = path.presence() + offset;
+        for (int i = 0; i < size; i++) {
+            if (!comparable || !presence[i]) {
+                res[i] = op_type == proto::plan::NotEqual;
+            }
+            if (valid_data != nullptr && !valid_data[offset + i]) {
+                res[i] = valid_res[i] = false;
+            }
+        }
+    };
+
+    std::function<bool(const SkipIndex&, FieldId, int)> skip_index_func;
+    if ((std::is_same_v<ExprValueType, int64_t> &&
+         data_type == DataType::INT64) ||
+        (std::is_same_v<ExprValueType, double> &&
+         data_type == DataType::DOUBLE) ||
+        (is_string && data_type == DataType::VARCHAR)) {
+        skip_index_func = [op_type, &val, &path](const SkipIndex& skip_index,
+                                                 FieldId field_id,
+                                                 int block_id) {
+            return skip_index.CanSkipJsonPathUnaryRange<GetType>(
+                field_id, path.pointer(), block_id, op_type, val);
+        };
+    }
+    int64_t processed_size = ProcessShreddedJsonChunks(execute_sub_batch,
+                                                       skip_index_func,
+                                                       valid_data,
+                                                       res,
+                                                       valid_res,
+                                                       val);
+    AssertInfo(processed_size == real_batch_size,
+               "internal error: expr processed rows {} not equal "
+               "expect batch size {}",
+               processed_size,
+               real_batch_size);
+    return res_vec;
+}
+
 template <typename T>
 VectorPtr
 PhyUnaryRangeFilterExpr::ExecRangeVisitorImpl() {
@@ -660,9 +846,13 @@ PhyUnaryRangeFilterExpr::ExecRangeVisitorImpl() {
 
     if (CanUseIndex<T>()) {
         return ExecRangeVisitorImplForIndex<T>();
-    } else {
-        return ExecRangeVisitorImplForData<T>();
     }
+    if constexpr (std::is_same_v<T, std::string_view>) {
+        if (segment_->type() == SegmentType::Sealed) {
+            return ExecRangeVisitorImplForStringData();
+        }
+    }
+    return ExecRangeVisitorImplForData<T>();
 }
 
 template <typename T>
@@ -904,6 +1094,101 @@ PhyUnaryRangeFilterExpr::ExecRangeVisitorImplForData() {
     return res_vec;
 }
 
+VectorPtr
+PhyUnaryRangeFilterExpr::ExecRangeVisitorImplForStringData() {
+    auto real_batch_size = GetNextBatchSize();
+    if (real_batch_size == 0) {
+        return nullptr;
+    }
+    auto val = GetValueFromProto<std::string>(expr_->val_);
+    auto res_vec = std::make_shared<ColumnVector>(
+        TargetBitmap(real_batch_size), TargetBitmap(real_batch_size));
+    TargetBitmapView res(res_vec->GetRawData(), real_batch_size);
+    TargetBitmapView valid_res(res_vec->GetValidRawData(), real_batch_size);
+    valid_res.set();
+    auto expr_type = expr_->op_type_;
+    auto execute_sub_batch = [expr_type](const StringBatchView& data,
+                                         const bool* valid_data,
+                                         const int size,
+                                         TargetBitmapView res,
+                                         TargetBitmapView valid_res,
+                                         const std::string& val) {
+        switch (expr_type) {
+            case proto::plan::GreaterThan: {
+                UnaryStringElementFunc<proto::plan::GreaterThan> func;
+                func(data, size, val, res);
+                break;
+            }
+            case proto::plan::GreaterEqual: {
+                UnaryStringElementFunc<proto::plan::GreaterEqual> func;
+                func(data, size, val, res);
+                break;
+            }
+            case proto::plan::LessThan: {
+                UnaryStringElementFunc<proto::plan::LessThan> func;
+                func(data, size, val, res);
+                break;
+            }
+            case proto::plan::LessEqual: {
+                UnaryStringElementFunc<proto::plan::LessEqual> func;
+                func(data, size, val, res);
+                break;
+            }
+            case proto::plan::Equal: {
+                UnaryStringElementFunc<proto::plan::Equal> func;
+                func(data, size, val, res);
+                break;
+            }
+            case proto::plan::NotEqual: {
+                UnaryStringElementFunc<proto::plan::NotEqual> func;
+                func(data, size, val, res);
+                break;
+            }
+            case proto::plan::PrefixMatch: {
+                UnaryStringElementFunc<proto::plan::PrefixMatch> func;
+                func(data, size, val, res);
+                break;
+            }
+            case proto::plan::Match: {
+                UnaryStringElementFunc<proto::plan::Match> func;
+                func(data, size, val, res);
+                break;
+            }
+            default:
+                PanicInfo(
+                    OpTypeInvalid,
+                    fmt::format("unsupported operator type for unary expr: {}",
+                                expr_type));
+        }
+        if (valid_data != nullptr) {
+            for (int i = 0; i < size; i++) {
+                if (!valid_data[i]) {
+                    res[i] = valid_res[i] = false;
+                }
+            }
+        }
+    };
+    auto skip_index_func = [expr_type, &val](const SkipIndex& skip_index,
+                                             FieldId field_id,
+                                             int64_t chunk_id) {
+        return skip_index.CanSkipUnaryRange<std::string_view>(
+            field_id, chunk_id, expr_type, val);
+    };
+    int64_t processed_size = ProcessStringDataChunks(
+        execute_sub_batch, skip_index_func, res, valid_res, val);
+    AssertInfo(processed_size == real_batch_size,
+               "internal error: expr processed rows {} not equal "
+               "expect batch size {}, related params[active_count:{}, "
+               "current_data_chunk:{}, num_data_chunk:{}, current_data_pos:{}]",
+               processed_size,
+               real_batch_size,
+               active_count_,
+               current_data_chunk_,
+               num_data_chunk_,
+               current_data_chunk_pos_);
+    return res_vec;
+}
+
 template <typename T>
 bool
 PhyUnaryRangeFilterExpr::CanUseIndex() {
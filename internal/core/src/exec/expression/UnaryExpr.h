@@ -18,6 +18,7 @@
 
 #include <fmt/core.h>
 
+#include <cstring>
 #include <utility>
 
 #include "common/EasyAssert.h"
@@ -127,6 +128,141 @@ struct UnaryElementFunc {
     }
 };
 
+// UnaryElementFunc for a batch of sealed string values, values are read
+// in place through the batch offsets instead of a vector of string_view.
+template <proto::plan::OpType op>
+struct UnaryStringElementFunc {
+    void
+    operator()(const StringBatchView& src,
+               size_t size,
+               const std::string& val,
+               TargetBitmapView res) {
+        if constexpr (op == proto::plan::OpType::Match) {
+            PatternMatchTranslator translator;
+            auto regex_pattern = translator(val);
+            RegexMatcher matcher(regex_pattern);
+            for (int i = 0; i < size; ++i) {
+                res[i] = matcher(src[i]);
+            }
+        } else if constexpr (op == proto::plan::OpType::Equal ||
+                             op == proto::plan::OpType::NotEqual) {
+            // length is compared first, most of the rows are filtered out
+            // without touching the value bytes
+            for (int i = 0; i < size; ++i) {
+                auto value_size = src.value_size(i);
+                bool equal =
+                    value_size == val.size() &&
+                    memcmp(src.value_data(i), val.data(), value_size) == 0;
+                res[i] = (op == proto::plan::OpType::Equal) ? equal : !equal;
+            }
+        } else if constexpr (op == proto::plan::OpType::PrefixMatch) {
+            for (int i = 0; i < size; ++i) {
+                res[i] = src.value_size(i) >= val.size() &&
+                         memcmp(src.value_data(i), val.data(), val.size()) ==
+                             0;
+            }
+        } else {
+            std::string_view target(val);
+            for (int i = 0; i < size; ++i) {
+                auto cmp = src[i].compare(target);
+                if constexpr (op == proto::plan::OpType::GreaterThan) {
+                    res[i] = cmp > 0;
+                } else if constexpr (op == proto::plan::OpType::GreaterEqual) {
+                    res[i] = cmp >= 0;
+                } else if constexpr (op == proto::plan::OpType::LessThan) {
+                    res[i] = cmp < 0;
+                } else if constexpr (op == proto::plan::OpType::LessEqual) {
+                    res[i] = cmp <= 0;
+                } else {
+                    PanicInfo(OpTypeInvalid,
+                              fmt::format("unsupported op_type:{} for "
+                                          "UnaryStringElementFunc",
+                                          op));
+                }
+            }
+        }
+    }
+};
+
+// compares the typed column of a shredded JSON path with the value of the
+// expr. Column and value of the same type go through UnaryElementFunc,
+// int64 and double are compared as double like the JSON lookups do.
+template <typename T, typename ValueType>
+void
+UnaryShreddedJsonCompare(proto::plan::OpType op_type,
+                         const T* src,
+                         size_t size,
+                         ValueType val,
+                         TargetBitmapView res) {
+    if constexpr (std::is_same_v<T, ValueType>) {
+        switch (op_type) {
+            case proto::plan::GreaterThan: {
+                UnaryElementFunc<T, proto::plan::GreaterThan> func;
+                func(src, size, val, res);
+                break;
+            }
+            case proto::plan::GreaterEqual: {
+                UnaryElementFunc<T, proto::plan::GreaterEqual> func;
+                func(src, size, val, res);
+                break;
+            }
+            case proto::plan::LessThan: {
+                UnaryElementFunc<T, proto::plan::LessThan> func;
+                func(src, size, val, res);
+                break;
+            }
+            case proto::plan::LessEqual: {
+                UnaryElementFunc<T, proto::plan::LessEqual> func;
+                func(src, size, val, res);
+                break;
+            }
+            case proto::plan::Equal: {
+                UnaryElementFunc<T, proto::plan::Equal> func;
+                func(src, size, val, res);
+                break;
+            }
+            case proto::plan::NotEqual: {
+                UnaryElementFunc<T, proto::plan::NotEqual> func;
+                func(src, size, val, res);
+                break;
+            }
+            default:
+                PanicInfo(OpTypeInvalid,
+                          "unsupported operator type for shredded json: {}",
+                          op_type);
+        }
+    } else {
+        auto target = static_cast<double>(val);
+        for (size_t i = 0; i < size; ++i) {
+            auto value = static_cast<double>(src[i]);
+            switch (op_type) {
+                case proto::plan::GreaterThan:
+                    res[i] = value > target;
+                    break;
+                case proto::plan::GreaterEqual:
+                    res[i] = value >= target;
+                    break;
+                case proto::plan::LessThan:
+                    res[i] = value < target;
+                    break;
+                case proto::plan::LessEqual:
+                    res[i] = value <= target;
+                    break;
+                case proto::plan::Equal:
+                    res[i] = value == target;
+                    break;
+                case proto::plan::NotEqual:
+                    res[i] = value != target;
+                    break;
+                default:
+                    PanicInfo(OpTypeInvalid,
+                              "unsupported operator type for shredded json: {}",
+                              op_type);
+            }
+        }
+    }
+}
+
 #define UnaryArrayCompare(cmp)                                          \
     do {                                                                \
         if constexpr (std::is_same_v<GetType, proto::plan::Array>) {    \
@@ -312,10 +448,21 @@ class PhyUnaryRangeFilterExpr : public SegmentExpr {
     VectorPtr
     ExecRangeVisitorImplForData();
 
+    // string field of sealed segment, compared in place over the chunk
+    VectorPtr
+    ExecRangeVisitorImplForStringData();
+
     template <typename ExprValueType>
     VectorPtr
     ExecRangeVisitorImplJson();
 
+    // json path shredded into a typed column by the sealed segment
+    template <typename ExprValueType>
+    VectorPtr
+    ExecRangeVisitorImplJsonForShredded(
+        const segcore::ShreddedJsonField& field,
+        const segcore::ShreddedJsonPath& path);
+
     template <typename ExprValueType>
     VectorPtr
     ExecRangeVisitorImplArray();
@@ -0,0 +1,237 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "AggregationNode.h"
+
+#include "common/Common.h"
+#include "common/OpContext.h"
+#include "exec/operator/aggregate/AggregateTable.h"
+#include "storage/MmapManager.h"
+
+namespace milvus {
+namespace exec {
+
+PhyAggregationNode::PhyAggregationNode(
+    int32_t operator_id,
+    DriverContext* driverctx,
+    const std::shared_ptr<const plan::AggregationNode>& node)
+    : Operator(driverctx, node->output_type(), operator_id, node->id()),
+      node_(node) {
+    ExecContext* exec_context = operator_context_->get_exec_context();
+    query_context_ = exec_context->get_query_context();
+    segment_ = query_context_->get_segment();
+    active_count_ = query_context_->get_active_count();
+}
+
+void
+PhyAggregationNode::AddInput(RowVectorPtr& input) {
+    input_ = std::move(input);
+}
+
+template <typename T, typename Func>
+void
+PhyAggregationNode::VisitIndex(FieldId field_id, Func& func) const {
+    // the index keeps std::string for both string representations
+    using IndexType = std::conditional_t<std::is_same_v<T, std::string_view>,
+                                         std::string,
+                                         T>;
+    AssertInfo(segment_->HasIndex(field_id) &&
+                   segment_->HasRawData(field_id.get()),
+               "neither field data nor raw data index of field {} is loaded",
+               field_id.get());
+    auto& index = segment_->chunk_scalar_index<IndexType>(field_id, 0);
+    auto batch_size = std::min(EXEC_EVAL_EXPR_BATCH_SIZE, active_count_);
+    std::vector<IndexType> values(batch_size);
+    std::vector<T> views;
+    auto valid_data = std::make_unique<bool[]>(batch_size);
+    for (int64_t offset = 0; offset < active_count_; offset += batch_size) {
+        CheckCancellation(query_context_->get_op_context(),
+                          static_cast<double>(offset) / active_count_);
+        auto size = std::min(batch_size, active_count_ - offset);
+        for (int64_t i = 0; i < size; ++i) {
+            auto value = index.Reverse_Lookup(offset + i);
+            valid_data[i] = value.has_value();
+            values[i] = value.has_value() ? std::move(value.value())
+                                          : IndexType();
+        }
+        if constexpr (std::is_same_v<T, std::string_view>) {
+            views.assign(values.begin(), values.begin() + size);
+            func(views.data(), valid_data.get(), offset, size);
+        } else if constexpr (std::is_same_v<T, bool>) {
+            // std::vector<bool> has no data()
+            auto bools = std::make_unique<bool[]>(size);
+            std::copy(values.begin(), values.begin() + size, bools.get());
+            func(bools.get(), valid_data.get(), offset, size);
+        } else {
+            func(values.data(), valid_data.get(), offset, size);
+        }
+    }
+}
+
+template <typename T, typename Func>
+void
+PhyAggregationNode::VisitChunks(FieldId field_id, Func& func) const {
+    if (!segment_->HasFieldData(field_id)) {
+        // sealed scalar fields whose index keeps the raw data load no
+        // field data
+        VisitIndex<T>(field_id, func);
+        return;
+    }
+    auto is_chunked = segment_->is_chunked();
+    auto size_per_chunk = segment_->size_per_chunk();
+    auto num_chunks = is_chunked ? segment_->num_chunk_data(field_id)
+                                 : upper_div(active_count_, size_per_chunk);
+    int64_t offset = 0;
+    for (int64_t chunk_id = 0; chunk_id < num_chunks && offset < active_count_;
+         ++chunk_id) {
+        CheckCancellation(query_context_->get_op_context(),
+                          static_cast<double>(offset) / active_count_);
+        auto chunk_size = is_chunked ? segment_->chunk_size(field_id, chunk_id)
+                                     : size_per_chunk;
+        auto size = std::min(chunk_size, active_count_ - offset);
+        if constexpr (std::is_same_v<T, std::string_view>) {
+            if (segment_->type() == SegmentType::Sealed) {
+                auto [views, valid_data] =
+                    segment_->get_batch_views<std::string_view>(
+                        field_id, chunk_id, 0, size);
+                func(views.data(),
+                     valid_data.empty() ? nullptr : valid_data.data(),
+                     offset,
+                     size);
+                offset += size;
+                continue;
+            }
+        }
+        auto chunk = segment_->chunk_data<T>(field_id, chunk_id);
+        func(chunk.data(), chunk.valid_data(), offset, size);
+        offset += size;
+    }
+}
+
+template <typename Func>
+void
+PhyAggregationNode::VisitColumn(FieldId field_id,
+                                DataType data_type,
+                                Func&& func) const {
+    switch (data_type) {
+        case DataType::BOOL:
+            VisitChunks<bool>(field_id, func);
+            break;
+        case DataType::INT8:
+            VisitChunks<int8_t>(field_id, func);
+            break;
+        case DataType::INT16:
+            VisitChunks<int16_t>(field_id, func);
+            break;
+        case DataType::INT32:
+            VisitChunks<int32_t>(field_id, func);
+            break;
+        case DataType::INT64:
+            VisitChunks<int64_t>(field_id, func);
+            break;
+        case DataType::FLOAT:
+            VisitChunks<float>(field_id, func);
+            break;
+        case DataType::DOUBLE:
+            VisitChunks<double>(field_id, func);
+            break;
+        case DataType::VARCHAR:
+            if (segment_->type() == SegmentType::Growing &&
+                !storage::MmapManager::GetInstance()
+                     .GetMmapConfig()
+                     .growing_enable_mmap) {
+                VisitChunks<std::string>(field_id, func);
+            } else {
+                VisitChunks<std::string_view>(field_id, func);
+            }
+            break;
+        default:
+            PanicInfo(DataTypeInvalid,
+                      "unsupported aggregation data type {}",
+                      data_type);
+    }
+}
+
+RowVectorPtr
+PhyAggregationNode::GetOutput() {
+    if (is_finished_ || !no_more_input_) {
+        return nullptr;
+    }
+
+    auto col_input = GetColumnVector(input_);
+    TargetBitmapView view(col_input->GetRawData(), col_input->size());
+    AssertInfo(view.size() == active_count_,
+               "filter bitmap of {} rows, expect {}",
+               view.size(),
+               active_count_);
+    // the group of every row, -1 for the rows filtered out
+    std::vector<int32_t> group_ids(active_count_);
+    for (int64_t i = 0; i < active_count_; ++i) {
+        group_ids[i] = view[i] ? -1 : 0;
+    }
+
+    AggregateTable table(node_);
+    auto& group_by_field_ids = node_->group_by_field_ids();
+    for (size_t k = 0; k < group_by_field_ids.size(); ++k) {
+        VisitColumn(group_by_field_ids[k],
+                    node_->group_by_data_types()[k],
+                    [&](const auto* values,
+                        const bool* valid_data,
+                        int64_t offset,
+                        int64_t size) {
+                        table.AddGroupColumn(k,
+                                             values,
+                                             valid_data,
+                                             group_ids.data() + offset,
+                                             size);
+                    });
+    }
+    auto& aggregates = node_->aggregates();
+    for (size_t i = 0; i < aggregates.size(); ++i) {
+        if (!aggregates[i].field_id_.has_value()) {
+            table.CountRows(i, group_ids.data(), active_count_);
+            continue;
+        }
+        VisitColumn(aggregates[i].field_id_.value(),
+                    aggregates[i].data_type_,
+                    [&](const auto* values,
+                        const bool* valid_data,
+                        int64_t offset,
+                        int64_t size) {
+                        table.Accumulate(i,
+                                         values,
+                                         valid_data,
+                                         group_ids.data() + offset,
+                                         size);
+                    });
+    }
+
+    RetrieveResult retrieve_result;
+    retrieve_result.field_data_ = table.SerializePartial();
+    retrieve_result.total_data_cnt_ = active_count_;
+    query_context_->set_retrieve_result(std::move(retrieve_result));
+    is_finished_ = true;
+
+    return input_;
+}
+
+bool
+PhyAggregationNode::IsFinished() {
+    return is_finished_;
+}
+
+}  // namespace exec
+}  // namespace milvus
@@ -16,8 +16,30 @@
 
 #include "FilterBitsNode.h"
 
+#include "segcore/FilterResultCache.h"
+#include "segcore/SegcoreConfig.h"
+
 namespace milvus {
 namespace exec {
+
+namespace {
+
+bool
+HasTermFilterOn(const expr::TypedExprPtr& expr, FieldId field_id) {
+    if (auto term = std::dynamic_pointer_cast<const expr::TermFilterExpr>(expr);
+        term != nullptr && term->column_.field_id_ == field_id) {
+        return true;
+    }
+    for (auto& input : expr->inputs()) {
+        if (HasTermFilterOn(input, field_id)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace
+
 PhyFilterBitsNode::PhyFilterBitsNode(
     int32_t operator_id,
     DriverContext* driverctx,
@@ -34,6 +56,17 @@ PhyFilterBitsNode::PhyFilterBitsNode(
     exprs_ = std::make_unique<ExprSet>(filters, exec_context);
     need_process_rows_ = query_context_->get_active_count();
     num_processed_rows_ = 0;
+
+    // the ids of a term filter on the primary key are looked up at the query
+    // timestamp, other filters on a sealed segment depend only on its data
+    auto segment = query_context_->get_segment();
+    auto pk_field_id = segment->get_schema().get_primary_field_id();
+    if (segment->type() == SegmentType::Sealed &&
+        !(pk_field_id.has_value() &&
+          HasTermFilterOn(filter->filter(), pk_field_id.value()))) {
+        cache_expr_ = filter->filter();
+        segment_cache_key_ = segment->filter_cache_key();
+    }
 }
 
 void
@@ -64,40 +97,70 @@ PhyFilterBitsNode::GetOutput() {
     std::chrono::high_resolution_clock::time_point scalar_start =
         std::chrono::high_resolution_clock::now();
 
-    EvalCtx eval_ctx(
-        operator_context_->get_exec_context(), exprs_.get(), input_.get());
-
     TargetBitmap bitset;
     TargetBitmap valid_bitset;
-    while (num_processed_rows_ < need_process_rows_) {
-        exprs_->Eval(0, 1, true, eval_ctx, results_);
-
-        AssertInfo(results_.size() == 1 && results_[0] != nullptr,
-                   "PhyFilterBitsNode result size should be size one and not "
-                   "be nullptr");
-
-        if (auto col_vec =
-                std::dynamic_pointer_cast<ColumnVector>(results_[0])) {
-            if (col_vec->IsBitmap()) {
-                auto col_vec_size = col_vec->size();
-                TargetBitmapView view(col_vec->GetRawData(), col_vec_size);
-                bitset.append(view);
-                TargetBitmapView valid_view(col_vec->GetValidRawData(),
-                                            col_vec_size);
-                valid_bitset.append(valid_view);
-                num_processed_rows_ += col_vec_size;
+    // in streaming mode only one batch is evaluated per call
+    auto streaming = query_context_->is_streaming();
+    auto op_context = query_context_->get_op_context();
+    auto& config = segcore::SegcoreConfig::default_config();
+    auto& cache = segcore::FilterResultCache::GetInstance();
+    auto use_cache = cache_expr_ != nullptr && !streaming &&
+                     config.get_filter_cache_capacity() > 0;
+    if (use_cache && cache_filter_.empty()) {
+        cache_filter_ = expr::StructuralKey(*cache_expr_);
+    }
+    if (use_cache && cache.Get(segment_cache_key_,
+                               cache_filter_,
+                               need_process_rows_,
+                               bitset,
+                               valid_bitset)) {
+        cache_hit_ = true;
+        num_processed_rows_ = need_process_rows_;
+    } else {
+        EvalCtx eval_ctx(
+            operator_context_->get_exec_context(), exprs_.get(), input_.get());
+        do {
+            CheckCancellation(op_context,
+                              double(num_processed_rows_) / need_process_rows_);
+            exprs_->Eval(0, 1, true, eval_ctx, results_);
+
+            AssertInfo(results_.size() == 1 && results_[0] != nullptr,
+                       "PhyFilterBitsNode result size should be size one and "
+                       "not be nullptr");
+
+            if (auto col_vec =
+                    std::dynamic_pointer_cast<ColumnVector>(results_[0])) {
+                if (col_vec->IsBitmap()) {
+                    auto col_vec_size = col_vec->size();
+                    TargetBitmapView view(col_vec->GetRawData(),
+                                          col_vec_size);
+                    bitset.append(view);
+                    TargetBitmapView valid_view(col_vec->GetValidRawData(),
+                                                col_vec_size);
+                    valid_bitset.append(valid_view);
+                    num_processed_rows_ += col_vec_size;
+                } else {
+                    PanicInfo(ExprInvalid,
+                              "PhyFilterBitsNode result should be bitmap");
+                }
             } else {
                 PanicInfo(ExprInvalid,
-                          "PhyFilterBitsNode result should be bitmap");
+                          "PhyFilterBitsNode result should be ColumnVector");
             }
-        } else {
-            PanicInfo(ExprInvalid,
-                      "PhyFilterBitsNode result should be ColumnVector");
+        } while (!streaming && num_processed_rows_ < need_process_rows_);
+        if (use_cache) {
+            auto segment = query_context_->get_segment();
+            cache.Put(
+                segment_cache_key_,
+                [segment]() { return segment->filter_cache_key(); },
+                cache_filter_,
+                bitset,
+                valid_bitset);
         }
     }
     bitset.flip();
-    Assert(bitset.size() == need_process_rows_);
-    Assert(valid_bitset.size() == need_process_rows_);
+    Assert(streaming || bitset.size() == need_process_rows_);
+    Assert(valid_bitset.size() == bitset.size());
     // num_processed_rows_ = need_process_rows_;
     std::vector<VectorPtr> col_res;
     col_res.push_back(std::make_shared<ColumnVector>(std::move(bitset),
@@ -112,5 +175,14 @@ PhyFilterBitsNode::GetOutput() {
     return std::make_shared<RowVector>(col_res);
 }
 
+void
+PhyFilterBitsNode::AddProfileDetails(nlohmann::json& profile) const {
+    profile["filter_cache_hit"] = cache_hit_;
+    auto& exprs = profile["exprs"] = nlohmann::json::array();
+    for (auto& expr : exprs_->exprs()) {
+        exprs.push_back(expr->Profile());
+    }
+}
+
 }  // namespace exec
 }  // namespace milvus
@@ -71,11 +71,22 @@ class PhyFilterBitsNode : public Operator {
         return "PhyFilterBitsNode";
     }
 
+ protected:
+    void
+    AddProfileDetails(nlohmann::json& profile) const override;
+
  private:
     std::unique_ptr<ExprSet> exprs_;
     QueryContext* query_context_;
     int64_t num_processed_rows_;
     int64_t need_process_rows_;
+    // the filter whose result is cached in FilterResultCache, null if it's
+    // not cached, its key, built on the first use of the cache, and the key
+    // of the segment at the start of the query
+    expr::TypedExprPtr cache_expr_;
+    std::string cache_filter_;
+    int64_t segment_cache_key_ = 0;
+    bool cache_hit_ = false;
 };
 }  // namespace exec
 }  // namespace milvus
\ No newline at end of file
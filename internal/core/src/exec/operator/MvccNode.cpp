@@ -16,6 +16,8 @@
 
 #include "MvccNode.h"
 
+#include <algorithm>
+
 namespace milvus {
 namespace exec {
 
@@ -30,6 +32,8 @@ PhyMvccNode::PhyMvccNode(int32_t operator_id,
     query_timestamp_ = query_context->get_query_timestamp();
     active_count_ = query_context->get_active_count();
     is_source_node_ = mvcc_node->sources().size() == 0;
+    streaming_ = query_context->is_streaming();
+    batch_size_ = query_context->query_config()->get_expr_batch_size();
 }
 
 void
@@ -51,6 +55,9 @@ PhyMvccNode::GetOutput() {
         is_finished_ = true;
         return nullptr;
     }
+    if (streaming_) {
+        return GetStreamingOutput();
+    }
     // the first vector is filtering result and second bitset is a valid bitset
     // if valid_bitset[i]==false, means result[i] is null
     auto col_input = is_source_node_ ? std::make_shared<ColumnVector>(
@@ -68,6 +75,40 @@ PhyMvccNode::GetOutput() {
     return std::make_shared<RowVector>(std::vector<VectorPtr>{col_input});
 }
 
+RowVectorPtr
+PhyMvccNode::GetStreamingOutput() {
+    // the visibility of the whole segment is computed once, then applied
+    // to the batches of the input
+    if (mvcc_bitset_.empty()) {
+        mvcc_bitset_ = TargetBitmap(active_count_);
+        TargetBitmapView view(mvcc_bitset_.data(), active_count_);
+        segment_->mask_with_timestamps(view, query_timestamp_);
+        segment_->mask_with_delete(view, active_count_, query_timestamp_);
+    }
+
+    ColumnVectorPtr col_input;
+    if (is_source_node_) {
+        auto size = std::min(batch_size_, active_count_ - num_processed_rows_);
+        col_input = std::make_shared<ColumnVector>(TargetBitmap(size),
+                                                   TargetBitmap(size));
+    } else {
+        col_input = GetColumnVector(input_);
+        input_ = nullptr;
+    }
+    auto size = col_input->size();
+    AssertInfo(num_processed_rows_ + size <= active_count_,
+               "mvcc input rows {} exceed active count {}",
+               num_processed_rows_ + size,
+               active_count_);
+
+    TargetBitmapView data(col_input->GetRawData(), size);
+    data |= mvcc_bitset_.view(num_processed_rows_, size);
+    num_processed_rows_ += size;
+    is_finished_ = num_processed_rows_ == active_count_;
+
+    return std::make_shared<RowVector>(std::vector<VectorPtr>{col_input});
+}
+
 bool
 PhyMvccNode::IsFinished() {
     return is_finished_;
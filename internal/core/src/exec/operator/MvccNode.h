@@ -66,12 +66,22 @@ class PhyMvccNode : public Operator {
         return "PhyMvccNode";
     }
 
+ private:
+    RowVectorPtr
+    GetStreamingOutput();
+
  private:
     const segcore::SegmentInternalInterface* segment_;
     milvus::Timestamp query_timestamp_;
     int64_t active_count_;
     bool is_finished_{false};
     bool is_source_node_{false};
+
+    // see QueryContext::is_streaming
+    bool streaming_{false};
+    int64_t batch_size_;
+    int64_t num_processed_rows_{0};
+    TargetBitmap mvcc_bitset_;
 };
 
 }  // namespace exec
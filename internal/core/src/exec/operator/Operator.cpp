@@ -17,5 +17,23 @@
 #include "Operator.h"
 
 namespace milvus {
-namespace exec {}
+namespace exec {
+
+nlohmann::json
+Operator::Profile() const {
+    nlohmann::json profile{
+        {"operator", ToString()},
+        {"plan_node_id", get_plannode_id()},
+        {"operator_id", get_operator_id()},
+        {"input_batches", stats_.input_batches},
+        {"input_rows", stats_.input_rows},
+        {"output_batches", stats_.output_batches},
+        {"output_rows", stats_.output_rows},
+        {"wall_ms", stats_.wall_nanos / 1e6},
+    };
+    AddProfileDetails(profile);
+    return profile;
+}
+
+}  // namespace exec
 }  // namespace milvus
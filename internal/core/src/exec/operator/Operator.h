@@ -91,6 +91,17 @@ class OperatorContext {
     mutable std::unique_ptr<ExecContext> exec_context_;
 };
 
+// execution stats of an operator, recorded by the driver only if the query
+// is profiled
+struct OperatorStats {
+    int64_t input_batches{0};
+    int64_t input_rows{0};
+    int64_t output_batches{0};
+    int64_t output_rows{0};
+    // time spent in AddInput and GetOutput
+    int64_t wall_nanos{0};
+};
+
 class Operator {
  public:
     Operator(DriverContext* ctx,
@@ -158,9 +169,26 @@ class Operator {
         return "Base Operator";
     }
 
+    OperatorStats&
+    stats() {
+        return stats_;
+    }
+
+    // the stats of the operator and the details added by AddProfileDetails
+    // as a json object
+    nlohmann::json
+    Profile() const;
+
  protected:
+    // adds the operator specific details to the profile of the operator
+    virtual void
+    AddProfileDetails(nlohmann::json& profile) const {
+    }
+
     std::unique_ptr<OperatorContext> operator_context_;
 
+    OperatorStats stats_;
+
     DataType output_type_;
 
     RowVectorPtr input_;
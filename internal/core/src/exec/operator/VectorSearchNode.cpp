@@ -43,6 +43,7 @@ PhyVectorSearchNode::PhyVectorSearchNode(
     active_count_ = query_context_->get_active_count();
     placeholder_group_ = query_context_->get_placeholder_group();
     search_info_ = query_context_->get_search_info();
+    search_info_.op_context_ = query_context_->get_op_context();
 }
 
 void
@@ -0,0 +1,526 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "AggregateTable.h"
+
+#include <functional>
+#include <string_view>
+
+namespace milvus {
+namespace exec {
+
+namespace {
+
+DataArray
+MakeArray(DataType data_type, int64_t field_id) {
+    DataArray array;
+    array.set_type(static_cast<proto::schema::DataType>(data_type));
+    array.set_field_id(field_id);
+    return array;
+}
+
+// type of the sum, min and max states of the values of data_type
+DataType
+StateType(DataType data_type) {
+    return IsFloatDataType(data_type) ? DataType::DOUBLE : DataType::INT64;
+}
+
+// type of the distinct values of data_type, as converted by
+// ToAggregateValue
+DataType
+DistinctType(DataType data_type) {
+    if (data_type == DataType::BOOL || IsStringDataType(data_type)) {
+        return data_type;
+    }
+    return StateType(data_type);
+}
+
+template <typename T>
+T
+GetOr(const AggregateValue& value) {
+    auto ptr = std::get_if<T>(&value);
+    return ptr == nullptr ? T() : *ptr;
+}
+
+// fills scalars with the values, a null as the default of the type
+template <typename Values>
+void
+FillScalars(DataType data_type,
+            const Values& values,
+            proto::schema::ScalarField* scalars) {
+    switch (data_type) {
+        case DataType::BOOL: {
+            auto data = scalars->mutable_bool_data()->mutable_data();
+            for (const AggregateValue& value : values) {
+                data->Add(GetOr<bool>(value));
+            }
+            break;
+        }
+        case DataType::INT8:
+        case DataType::INT16:
+        case DataType::INT32: {
+            auto data = scalars->mutable_int_data()->mutable_data();
+            for (const AggregateValue& value : values) {
+                data->Add(static_cast<int32_t>(GetOr<int64_t>(value)));
+            }
+            break;
+        }
+        case DataType::INT64: {
+            auto data = scalars->mutable_long_data()->mutable_data();
+            for (const AggregateValue& value : values) {
+                data->Add(GetOr<int64_t>(value));
+            }
+            break;
+        }
+        case DataType::FLOAT: {
+            auto data = scalars->mutable_float_data()->mutable_data();
+            for (const AggregateValue& value : values) {
+                data->Add(static_cast<float>(GetOr<double>(value)));
+            }
+            break;
+        }
+        case DataType::DOUBLE: {
+            auto data = scalars->mutable_double_data()->mutable_data();
+            for (const AggregateValue& value : values) {
+                data->Add(GetOr<double>(value));
+            }
+            break;
+        }
+        case DataType::VARCHAR:
+        case DataType::STRING: {
+            auto data = scalars->mutable_string_data()->mutable_data();
+            for (const AggregateValue& value : values) {
+                *data->Add() = GetOr<std::string>(value);
+            }
+            break;
+        }
+        default: {
+            PanicInfo(DataTypeInvalid,
+                      "unsupported aggregate data type {}",
+                      data_type);
+        }
+    }
+}
+
+DataArray
+CountColumn(const std::vector<int64_t>& counts, int64_t field_id) {
+    auto array = MakeArray(DataType::INT64, field_id);
+    array.mutable_scalars()->mutable_long_data()->mutable_data()->Add(
+        counts.begin(), counts.end());
+    return array;
+}
+
+// the sum, min or max of every group, null for the groups of no value
+DataArray
+StateColumn(DataType data_type,
+            const std::vector<int64_t>& counts,
+            const std::vector<int64_t>& ints,
+            const std::vector<double>& floats,
+            int64_t field_id) {
+    auto array = MakeArray(StateType(data_type), field_id);
+    auto scalars = array.mutable_scalars();
+    if (IsFloatDataType(data_type)) {
+        scalars->mutable_double_data()->mutable_data()->Add(floats.begin(),
+                                                            floats.end());
+    } else {
+        scalars->mutable_long_data()->mutable_data()->Add(ints.begin(),
+                                                          ints.end());
+    }
+    for (auto count : counts) {
+        array.add_valid_data(count > 0);
+    }
+    return array;
+}
+
+// calls func with the values of the scalars and their number
+template <typename Func>
+void
+VisitScalars(const proto::schema::ScalarField& scalars, Func&& func) {
+    switch (scalars.data_case()) {
+        case proto::schema::ScalarField::kBoolData: {
+            auto& data = scalars.bool_data().data();
+            func(data.data(), data.size());
+            break;
+        }
+        case proto::schema::ScalarField::kIntData: {
+            auto& data = scalars.int_data().data();
+            func(data.data(), data.size());
+            break;
+        }
+        case proto::schema::ScalarField::kLongData: {
+            auto& data = scalars.long_data().data();
+            func(data.data(), data.size());
+            break;
+        }
+        case proto::schema::ScalarField::kFloatData: {
+            auto& data = scalars.float_data().data();
+            func(data.data(), data.size());
+            break;
+        }
+        case proto::schema::ScalarField::kDoubleData: {
+            auto& data = scalars.double_data().data();
+            func(data.data(), data.size());
+            break;
+        }
+        case proto::schema::ScalarField::kStringData: {
+            auto& data = scalars.string_data().data();
+            std::vector<std::string_view> views(data.begin(), data.end());
+            func(views.data(), views.size());
+            break;
+        }
+        case proto::schema::ScalarField::DATA_NOT_SET: {
+            func(static_cast<const int64_t*>(nullptr), 0);
+            break;
+        }
+        default: {
+            PanicInfo(DataTypeInvalid,
+                      "unsupported partial aggregate data {}",
+                      static_cast<int>(scalars.data_case()));
+        }
+    }
+}
+
+const bool*
+ValidData(const DataArray& array) {
+    return array.valid_data_size() == 0 ? nullptr : array.valid_data().data();
+}
+
+}  // namespace
+
+AggregateTable::AggregateTable(
+    std::shared_ptr<const plan::AggregationNode> node)
+    : node_(std::move(node)) {
+    auto num_columns = node_->group_by_field_ids().size();
+    column_values_.resize(num_columns);
+    value_ids_.resize(num_columns);
+    group_parents_.resize(num_columns);
+    group_values_.resize(num_columns);
+    group_ids_.resize(num_columns);
+    accumulators_.resize(node_->aggregates().size());
+    ResizeAccumulators();
+}
+
+int64_t
+AggregateTable::num_groups() const {
+    auto num_columns = column_values_.size();
+    if (num_columns == 0) {
+        // all the rows are in one group without group by
+        return 1;
+    }
+    if (num_columns == 1) {
+        return column_values_[0].size();
+    }
+    return group_parents_[num_columns - 1].size();
+}
+
+int32_t
+AggregateTable::LookupValue(size_t column, AggregateValue&& value) {
+    auto& ids = value_ids_[column];
+    auto it = ids.find(value);
+    if (it != ids.end()) {
+        return it->second;
+    }
+    auto& values = column_values_[column];
+    auto value_id = static_cast<int32_t>(values.size());
+    values.push_back(value);
+    ids.emplace(std::move(value), value_id);
+    return value_id;
+}
+
+int32_t
+AggregateTable::LookupGroup(size_t column, int32_t parent, int32_t value_id) {
+    auto key = (static_cast<uint64_t>(parent) << 32) |
+               static_cast<uint32_t>(value_id);
+    auto& parents = group_parents_[column];
+    auto [it, inserted] = group_ids_[column].try_emplace(
+        key, static_cast<int32_t>(parents.size()));
+    if (inserted) {
+        parents.push_back(parent);
+        group_values_[column].push_back(value_id);
+    }
+    return it->second;
+}
+
+void
+AggregateTable::ResizeAccumulators() {
+    auto groups = num_groups();
+    for (size_t i = 0; i < accumulators_.size(); ++i) {
+        auto& aggregate = node_->aggregates()[i];
+        auto& accumulator = accumulators_[i];
+        accumulator.counts.resize(groups);
+        switch (aggregate.op_) {
+            case plan::AggregateOp::kCount:
+                break;
+            case plan::AggregateOp::kCountDistinct:
+                accumulator.distincts.resize(groups);
+                break;
+            default:
+                if (IsFloatDataType(aggregate.data_type_)) {
+                    accumulator.floats.resize(groups);
+                } else {
+                    accumulator.ints.resize(groups);
+                }
+        }
+    }
+}
+
+void
+AggregateTable::CountRows(size_t index,
+                          const int32_t* group_ids,
+                          int64_t size) {
+    auto& counts = accumulators_[index].counts;
+    for (int64_t i = 0; i < size; ++i) {
+        if (group_ids[i] >= 0) {
+            ++counts[group_ids[i]];
+        }
+    }
+}
+
+const AggregateValue&
+AggregateTable::GroupKey(size_t column, int32_t group) const {
+    for (auto k = column_values_.size() - 1; k > column; --k) {
+        group = group_parents_[k][group];
+    }
+    auto value_id = column == 0 ? group : group_values_[column][group];
+    return column_values_[column][value_id];
+}
+
+void
+AggregateTable::AppendGroupColumns(std::vector<DataArray>& output) const {
+    auto groups = num_groups();
+    for (size_t k = 0; k < column_values_.size(); ++k) {
+        auto data_type = node_->group_by_data_types()[k];
+        auto array =
+            MakeArray(data_type, node_->group_by_field_ids()[k].get());
+        std::vector<std::reference_wrapper<const AggregateValue>> keys;
+        keys.reserve(groups);
+        for (int32_t group = 0; group < groups; ++group) {
+            keys.emplace_back(GroupKey(k, group));
+        }
+        FillScalars(data_type, keys, array.mutable_scalars());
+        if (value_ids_[k].count(AggregateValue()) > 0) {
+            for (const AggregateValue& key : keys) {
+                array.add_valid_data(
+                    !std::holds_alternative<std::monostate>(key));
+            }
+        }
+        output.push_back(std::move(array));
+    }
+}
+
+void
+AggregateTable::MergeColumns(const std::vector<const DataArray*>& partial) {
+    size_t pos = 0;
+    auto next = [&]() -> const DataArray& {
+        AssertInfo(pos < partial.size(),
+                   "partial aggregate of {} columns is too short",
+                   partial.size());
+        return *partial[pos++];
+    };
+
+    int64_t rows = 1;
+    std::vector<int32_t> group_ids(rows, 0);
+    for (size_t k = 0; k < column_values_.size(); ++k) {
+        auto& column = next();
+        VisitScalars(column.scalars(), [&](const auto* values, int64_t size) {
+            if (k == 0) {
+                rows = size;
+                group_ids.assign(rows, 0);
+            }
+            AssertInfo(size == rows,
+                       "unaligned group by columns of {} and {} rows",
+                       size,
+                       rows);
+            AddGroupColumn(
+                k, values, ValidData(column), group_ids.data(), rows);
+        });
+    }
+
+    for (size_t i = 0; i < accumulators_.size(); ++i) {
+        auto& aggregate = node_->aggregates()[i];
+        auto& accumulator = accumulators_[i];
+        auto merge_counts = [&](const DataArray& column) {
+            auto& counts = column.scalars().long_data().data();
+            AssertInfo(counts.size() == rows,
+                       "partial counts of {} rows, expect {}",
+                       counts.size(),
+                       rows);
+            for (int64_t row = 0; row < rows; ++row) {
+                accumulator.counts[group_ids[row]] += counts[row];
+            }
+        };
+        auto merge_states = [&](auto& states, const auto& values,
+                                const bool* valid_data) {
+            using State = std::decay_t<decltype(states[0])>;
+            AssertInfo(values.size() == rows,
+                       "partial states of {} rows, expect {}",
+                       values.size(),
+                       rows);
+            for (int64_t row = 0; row < rows; ++row) {
+                if (valid_data != nullptr && !valid_data[row]) {
+                    continue;
+                }
+                auto group = group_ids[row];
+                Update(aggregate.op_,
+                       states[group],
+                       static_cast<State>(values[row]),
+                       accumulator.counts[group] == 0);
+                if (aggregate.op_ != plan::AggregateOp::kAvg) {
+                    ++accumulator.counts[group];
+                }
+            }
+        };
+
+        switch (aggregate.op_) {
+            case plan::AggregateOp::kCount: {
+                merge_counts(next());
+                break;
+            }
+            case plan::AggregateOp::kCountDistinct: {
+                auto& arrays = next().scalars().array_data().data();
+                AssertInfo(arrays.size() == rows,
+                           "partial distinct values of {} rows, expect {}",
+                           arrays.size(),
+                           rows);
+                for (int64_t row = 0; row < rows; ++row) {
+                    auto& distincts = accumulator.distincts[group_ids[row]];
+                    VisitScalars(arrays[row],
+                                 [&](const auto* values, int64_t size) {
+                                     for (int64_t j = 0; j < size; ++j) {
+                                         distincts.insert(
+                                             ToAggregateValue(values[j]));
+                                     }
+                                 });
+                }
+                break;
+            }
+            default: {
+                auto& column = next();
+                if (IsFloatDataType(aggregate.data_type_)) {
+                    merge_states(accumulator.floats,
+                                 column.scalars().double_data().data(),
+                                 ValidData(column));
+                } else {
+                    merge_states(accumulator.ints,
+                                 column.scalars().long_data().data(),
+                                 ValidData(column));
+                }
+                if (aggregate.op_ == plan::AggregateOp::kAvg) {
+                    merge_counts(next());
+                }
+            }
+        }
+    }
+}
+
+std::vector<DataArray>
+AggregateTable::SerializePartial() const {
+    std::vector<DataArray> output;
+    AppendGroupColumns(output);
+    for (size_t i = 0; i < accumulators_.size(); ++i) {
+        auto& aggregate = node_->aggregates()[i];
+        auto& accumulator = accumulators_[i];
+        auto field_id =
+            aggregate.field_id_.has_value() ? aggregate.field_id_->get() : 0;
+        switch (aggregate.op_) {
+            case plan::AggregateOp::kCount: {
+                output.push_back(CountColumn(accumulator.counts, field_id));
+                break;
+            }
+            case plan::AggregateOp::kCountDistinct: {
+                auto array = MakeArray(DataType::ARRAY, field_id);
+                auto arrays = array.mutable_scalars()->mutable_array_data();
+                auto element_type = DistinctType(aggregate.data_type_);
+                arrays->set_element_type(
+                    static_cast<proto::schema::DataType>(element_type));
+                for (auto& distincts : accumulator.distincts) {
+                    FillScalars(element_type, distincts, arrays->add_data());
+                }
+                output.push_back(std::move(array));
+                break;
+            }
+            default: {
+                output.push_back(StateColumn(aggregate.data_type_,
+                                             accumulator.counts,
+                                             accumulator.ints,
+                                             accumulator.floats,
+                                             field_id));
+                if (aggregate.op_ == plan::AggregateOp::kAvg) {
+                    output.push_back(
+                        CountColumn(accumulator.counts, field_id));
+                }
+            }
+        }
+    }
+    return output;
+}
+
+std::vector<DataArray>
+AggregateTable::Finalize() const {
+    std::vector<DataArray> output;
+    AppendGroupColumns(output);
+    auto groups = num_groups();
+    for (size_t i = 0; i < accumulators_.size(); ++i) {
+        auto& aggregate = node_->aggregates()[i];
+        auto& accumulator = accumulators_[i];
+        auto field_id =
+            aggregate.field_id_.has_value() ? aggregate.field_id_->get() : 0;
+        switch (aggregate.op_) {
+            case plan::AggregateOp::kCount: {
+                output.push_back(CountColumn(accumulator.counts, field_id));
+                break;
+            }
+            case plan::AggregateOp::kCountDistinct: {
+                auto array = MakeArray(DataType::INT64, field_id);
+                auto data = array.mutable_scalars()
+                                ->mutable_long_data()
+                                ->mutable_data();
+                for (auto& distincts : accumulator.distincts) {
+                    data->Add(distincts.size());
+                }
+                output.push_back(std::move(array));
+                break;
+            }
+            case plan::AggregateOp::kAvg: {
+                auto array = MakeArray(DataType::DOUBLE, field_id);
+                auto data = array.mutable_scalars()
+                                ->mutable_double_data()
+                                ->mutable_data();
+                for (int64_t group = 0; group < groups; ++group) {
+                    auto count = accumulator.counts[group];
+                    auto sum = IsFloatDataType(aggregate.data_type_)
+                                   ? accumulator.floats[group]
+                                   : accumulator.ints[group];
+                    data->Add(count > 0 ? sum / count : 0);
+                    array.add_valid_data(count > 0);
+                }
+                output.push_back(std::move(array));
+                break;
+            }
+            default: {
+                output.push_back(StateColumn(aggregate.data_type_,
+                                             accumulator.counts,
+                                             accumulator.ints,
+                                             accumulator.floats,
+                                             field_id));
+            }
+        }
+    }
+    return output;
+}
+
+}  // namespace exec
+}  // namespace milvus
@@ -0,0 +1,245 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <variant>
+#include <vector>
+
+#include "common/EasyAssert.h"
+#include "common/Types.h"
+#include "plan/PlanNode.h"
+
+namespace milvus {
+namespace exec {
+
+// value of a group key or a distinct value, std::monostate for null
+using AggregateValue =
+    std::variant<std::monostate, bool, int64_t, double, std::string>;
+
+template <typename T>
+inline AggregateValue
+ToAggregateValue(const T& value) {
+    if constexpr (std::is_same_v<T, bool>) {
+        return value;
+    } else if constexpr (std::is_integral_v<T>) {
+        return static_cast<int64_t>(value);
+    } else if constexpr (std::is_floating_point_v<T>) {
+        return static_cast<double>(value);
+    } else {
+        return std::string(value);
+    }
+}
+
+/**
+ * @brief Groups and aggregate states of an aggregation node.
+ *
+ * The rows are mapped to groups one group by column at a time, a group by
+ * the first k columns is a group by the first k - 1 columns together with a
+ * value of the k-th column. The states are kept column wise, one vector per
+ * aggregate indexed by group, so a chunk of a column is accumulated in a
+ * tight loop over the group ids of its rows.
+ */
+class AggregateTable {
+ public:
+    explicit AggregateTable(std::shared_ptr<const plan::AggregationNode> node);
+
+    int64_t
+    num_groups() const;
+
+    // maps the rows to their groups by the column-th group by column,
+    // group_ids holds the groups of the rows by the previous columns on
+    // input, -1 for the rows skipped
+    template <typename T>
+    void
+    AddGroupColumn(size_t column,
+                   const T* values,
+                   const bool* valid_data,
+                   int32_t* group_ids,
+                   int64_t size) {
+        AssertInfo(column < column_values_.size(),
+                   "group by column {} out of range",
+                   column);
+        for (int64_t i = 0; i < size; ++i) {
+            auto group = group_ids[i];
+            if (group < 0) {
+                continue;
+            }
+            auto value_id =
+                valid_data == nullptr || valid_data[i]
+                    ? LookupValue(column, ToAggregateValue(values[i]))
+                    : LookupValue(column, AggregateValue());
+            group_ids[i] =
+                column == 0 ? value_id : LookupGroup(column, group, value_id);
+        }
+        ResizeAccumulators();
+    }
+
+    // adds the non null values of the field of the index-th aggregate to
+    // the groups of their rows
+    template <typename T>
+    void
+    Accumulate(size_t index,
+               const T* values,
+               const bool* valid_data,
+               const int32_t* group_ids,
+               int64_t size) {
+        auto& accumulator = accumulators_[index];
+        auto op = node_->aggregates()[index].op_;
+        auto for_each_value = [&](auto&& func) {
+            for (int64_t i = 0; i < size; ++i) {
+                auto group = group_ids[i];
+                if (group >= 0 && (valid_data == nullptr || valid_data[i])) {
+                    ++accumulator.counts[group];
+                    func(group, values[i]);
+                }
+            }
+        };
+        switch (op) {
+            case plan::AggregateOp::kCount: {
+                for_each_value([](int32_t, const T&) {});
+                break;
+            }
+            case plan::AggregateOp::kCountDistinct: {
+                for_each_value([&](int32_t group, const T& value) {
+                    accumulator.distincts[group].insert(
+                        ToAggregateValue(value));
+                });
+                break;
+            }
+            default: {
+                if constexpr (std::is_arithmetic_v<T>) {
+                    if constexpr (std::is_floating_point_v<T>) {
+                        for_each_value([&](int32_t group, const T& value) {
+                            Update(op,
+                                   accumulator.floats[group],
+                                   static_cast<double>(value),
+                                   accumulator.counts[group] == 1);
+                        });
+                    } else {
+                        for_each_value([&](int32_t group, const T& value) {
+                            Update(op,
+                                   accumulator.ints[group],
+                                   static_cast<int64_t>(value),
+                                   accumulator.counts[group] == 1);
+                        });
+                    }
+                } else {
+                    PanicInfo(DataTypeInvalid,
+                              "aggregate {} of non numeric values",
+                              static_cast<int>(op));
+                }
+            }
+        }
+    }
+
+    // counts the rows of the groups for count(*)
+    void
+    CountRows(size_t index, const int32_t* group_ids, int64_t size);
+
+    // adds a partial aggregate of the same node made by SerializePartial,
+    // partial is a container of its columns
+    template <typename Columns>
+    void
+    MergePartial(const Columns& partial) {
+        std::vector<const DataArray*> columns;
+        columns.reserve(partial.size());
+        for (const DataArray& column : partial) {
+            columns.push_back(&column);
+        }
+        MergeColumns(columns);
+    }
+
+    // the group by columns followed by the states of the aggregates, avg
+    // is kept as a sum and a count column, count distinct as an array of
+    // the distinct values of every group
+    std::vector<DataArray>
+    SerializePartial() const;
+
+    // the group by columns followed by the values of the aggregates, the
+    // integral sum, min and max are int64, the floating ones and avg double
+    std::vector<DataArray>
+    Finalize() const;
+
+ private:
+    struct Accumulator {
+        // number of the non null values added per group
+        std::vector<int64_t> counts;
+        // sum, min or max of the integral values per group
+        std::vector<int64_t> ints;
+        // sum, min or max of the floating values per group
+        std::vector<double> floats;
+        std::vector<std::unordered_set<AggregateValue>> distincts;
+    };
+
+    template <typename V>
+    static void
+    Update(plan::AggregateOp op, V& state, V value, bool first) {
+        switch (op) {
+            case plan::AggregateOp::kSum:
+            case plan::AggregateOp::kAvg:
+                state += value;
+                break;
+            case plan::AggregateOp::kMin:
+                state = first || value < state ? value : state;
+                break;
+            case plan::AggregateOp::kMax:
+                state = first || value > state ? value : state;
+                break;
+            default:
+                PanicInfo(OpTypeInvalid,
+                          "unexpected aggregate {}",
+                          static_cast<int>(op));
+        }
+    }
+
+    void
+    MergeColumns(const std::vector<const DataArray*>& partial);
+
+    int32_t
+    LookupValue(size_t column, AggregateValue&& value);
+
+    int32_t
+    LookupGroup(size_t column, int32_t parent, int32_t value_id);
+
+    void
+    ResizeAccumulators();
+
+    const AggregateValue&
+    GroupKey(size_t column, int32_t group) const;
+
+    void
+    AppendGroupColumns(std::vector<DataArray>& output) const;
+
+    std::shared_ptr<const plan::AggregationNode> node_;
+    // distinct values of every group by column, indexed by value id
+    std::vector<std::vector<AggregateValue>> column_values_;
+    std::vector<std::unordered_map<AggregateValue, int32_t>> value_ids_;
+    // the groups by the first k + 1 columns for k > 0, a group by the first
+    // column is the value id of the column
+    std::vector<std::vector<int32_t>> group_parents_;
+    std::vector<std::vector<int32_t>> group_values_;
+    std::vector<std::unordered_map<uint64_t, int32_t>> group_ids_;
+    std::vector<Accumulator> accumulators_;
+};
+
+}  // namespace exec
+}  // namespace milvus
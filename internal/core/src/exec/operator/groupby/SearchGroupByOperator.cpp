@@ -14,9 +14,13 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 #include "SearchGroupByOperator.h"
+
+#include <iterator>
+
 #include "common/Consts.h"
 #include "segcore/SegmentSealedImpl.h"
 #include "query/Utils.h"
+#include "storage/ThreadPools.h"
 
 namespace milvus {
 namespace exec {
@@ -149,17 +153,36 @@ GroupIteratorsByType(
     std::vector<float>& distances,
     const knowhere::MetricType& metrics_type,
     std::vector<size_t>& topk_per_nq_prefix_sum) {
-    topk_per_nq_prefix_sum.push_back(0);
-    for (auto& iterator : iterators) {
-        GroupIteratorResult<T>(iterator,
+    struct NqResult {
+        std::vector<GroupByValueType> group_by_values;
+        std::vector<int64_t> offsets;
+        std::vector<float> distances;
+    };
+    std::vector<NqResult> results(iterators.size());
+    auto group_nq = [&](size_t i) {
+        GroupIteratorResult<T>(iterators[i],
                                topK,
                                group_size,
                                strict_group_size,
                                data_getter,
-                               group_by_values,
-                               seg_offsets,
-                               distances,
+                               results[i].group_by_values,
+                               results[i].offsets,
+                               results[i].distances,
                                metrics_type);
+    };
+
+    auto& pool = ThreadPools::GetThreadPool(ThreadPoolPriority::HIGH);
+    pool.ParallelFor(iterators.size(), TaskPriority::HIGH, group_nq);
+
+    topk_per_nq_prefix_sum.push_back(0);
+    for (auto& result : results) {
+        seg_offsets.insert(
+            seg_offsets.end(), result.offsets.begin(), result.offsets.end());
+        distances.insert(
+            distances.end(), result.distances.begin(), result.distances.end());
+        std::move(result.group_by_values.begin(),
+                  result.group_by_values.end(),
+                  std::back_inserter(group_by_values));
         topk_per_nq_prefix_sum.push_back(seg_offsets.size());
     }
 }
@@ -176,24 +199,41 @@ GroupIteratorResult(const std::shared_ptr<VectorIterator>& iterator,
                     std::vector<float>& distances,
                     const knowhere::MetricType& metrics_type) {
     //1.
-    GroupByMap<T> groupMap(topK, group_size, strict_group_size);
+    GroupByMap<GroupByKey<T>> groupMap(topK, group_size, strict_group_size);
 
     //2. do iteration until fill the whole map or run out of all data
     //note it may enumerate all data inside a segment and can block following
     //query and search possibly
-    std::vector<std::tuple<int64_t, float, T>> res;
-    while (iterator->HasNext() && !groupMap.IsGroupResEnough()) {
-        auto offset_dis_pair = iterator->Next();
-        AssertInfo(
-            offset_dis_pair.has_value(),
-            "Wrong state! iterator cannot return valid result whereas it still"
-            "tells hasNext, terminate groupBy operation");
-        auto offset = offset_dis_pair.value().first;
-        auto dis = offset_dis_pair.value().second;
-        T row_data = data_getter.Get(offset);
-        if (groupMap.Push(row_data)) {
-            res.emplace_back(offset, dis, row_data);
+    //the rows are pulled and their keys looked up in batches, starting from
+    //the least rows which may fill the map and doubling after every batch
+    std::vector<std::tuple<int64_t, float, GroupByKey<T>>> res;
+    std::vector<std::pair<int64_t, float>> batch;
+    std::vector<int64_t> batch_offsets;
+    // not a std::vector, whose bools are packed
+    FixedVector<GroupByKey<T>> keys;
+    // holds the strings the keys view if the field is only indexed
+    std::deque<std::string> key_buffer;
+    int64_t batch_size = strict_group_size ? topK * group_size : topK;
+    batch_size = std::clamp<int64_t>(batch_size, 1, MAX_GROUP_BY_BATCH_SIZE);
+    while (!groupMap.IsGroupResEnough()) {
+        iterator->NextBatch(batch_size, batch);
+        if (batch.empty()) {
+            break;
+        }
+        batch_offsets.resize(batch.size());
+        for (size_t i = 0; i < batch.size(); i++) {
+            batch_offsets[i] = batch[i].first;
+        }
+        keys.resize(batch.size());
+        data_getter.BulkGet(
+            batch_offsets.data(), batch.size(), keys.data(), key_buffer);
+        for (size_t i = 0; i < batch.size() && !groupMap.IsGroupResEnough();
+             i++) {
+            if (groupMap.Push(keys[i])) {
+                res.emplace_back(batch[i].first, batch[i].second, keys[i]);
+            }
         }
+        batch_size = std::min(batch_size * 2, MAX_GROUP_BY_BATCH_SIZE);
     }
 
     //3. sorted based on distances and metrics
@@ -207,7 +247,7 @@ GroupIteratorResult(const std::shared_ptr<VectorIterator>& iterator,
     for (auto iter = res.cbegin(); iter != res.cend(); iter++) {
         offsets.emplace_back(std::get<0>(*iter));
         distances.emplace_back(std::get<1>(*iter));
-        group_by_values.emplace_back(std::move(std::get<2>(*iter)));
+        group_by_values.emplace_back(T(std::get<2>(*iter)));
     }
 }
 
@@ -16,6 +16,11 @@
 
 #pragma once
 
+#include <algorithm>
+#include <deque>
+#include <string_view>
+#include <type_traits>
+
 #include "common/QueryInfo.h"
 #include "knowhere/index/index_node.h"
 #include "segcore/SegmentInterface.h"
@@ -28,11 +33,30 @@
 namespace milvus {
 namespace exec {
 
+// the most rows pulled from a vector iterator at once by group by
+constexpr int64_t MAX_GROUP_BY_BATCH_SIZE = 4096;
+
+// the key rows are grouped by, strings are viewed in place
+template <typename T>
+using GroupByKey =
+    std::conditional_t<std::is_same_v<T, std::string>, std::string_view, T>;
+
 template <typename T>
 class DataGetter {
  public:
+    virtual ~DataGetter() = default;
+
     virtual T
     Get(int64_t idx) const = 0;
+
+    // fills the group keys of the rows at the offsets, a string key views the
+    // data of the segment, or a copy kept in the buffer if it is only held
+    // by an index
+    virtual void
+    BulkGet(const int64_t* offsets,
+            int64_t count,
+            GroupByKey<T>* keys,
+            std::deque<std::string>& buffer) const = 0;
 };
 
 template <typename T>
@@ -52,27 +76,70 @@ class GrowingDataGetter : public DataGetter<T> {
     Get(int64_t idx) const {
         return growing_raw_data_->operator[](idx);
     }
+
+    void
+    BulkGet(const int64_t* offsets,
+            int64_t count,
+            GroupByKey<T>* keys,
+            std::deque<std::string>& buffer) const {
+        for (int64_t i = 0; i < count; i++) {
+            keys[i] = growing_raw_data_->operator[](offsets[i]);
+        }
+    }
 };
 
 template <typename T>
 class SealedDataGetter : public DataGetter<T> {
  private:
-    std::shared_ptr<Span<T>> field_data_;
-    std::shared_ptr<std::vector<std::string_view>> str_field_data_;
-    const index::ScalarIndex<T>* field_index_;
+    // the data of every chunk of the field and the offset of its first row
+    std::vector<Span<T>> spans_;
+    std::vector<std::vector<std::string_view>> str_views_;
+    std::vector<int64_t> chunk_starts_{0};
+    const index::ScalarIndex<T>* field_index_{nullptr};
+
+    std::pair<int64_t, int64_t>
+    Locate(int64_t offset) const {
+        if (chunk_starts_.size() == 2) {
+            return {0, offset};
+        }
+        auto it = std::upper_bound(
+            chunk_starts_.begin(), chunk_starts_.end(), offset);
+        auto chunk_id = std::distance(chunk_starts_.begin(), it) - 1;
+        return {chunk_id, offset - chunk_starts_[chunk_id]};
+    }
+
+    GroupByKey<T>
+    KeyAt(int64_t offset) const {
+        auto [chunk_id, chunk_offset] = Locate(offset);
+        if constexpr (std::is_same_v<T, std::string>) {
+            return str_views_[chunk_id][chunk_offset];
+        } else {
+            return spans_[chunk_id][chunk_offset];
+        }
+    }
+
+    T
+    IndexValueAt(int64_t offset) const {
+        auto raw = field_index_->Reverse_Lookup(offset);
+        AssertInfo(raw.has_value(), "field data not found");
+        return std::move(raw.value());
+    }
 
  public:
     SealedDataGetter(const segcore::SegmentSealed& segment, FieldId& field_id) {
         if (segment.HasFieldData(field_id)) {
-            if constexpr (std::is_same_v<T, std::string>) {
-                str_field_data_ =
-                    std::make_shared<std::vector<std::string_view>>(
-                        segment.chunk_view<std::string_view>(field_id, 0)
+            for (int64_t i = 0; i < segment.num_chunk_data(field_id); i++) {
+                int64_t chunk_rows;
+                if constexpr (std::is_same_v<T, std::string>) {
+                    str_views_.push_back(
+                        segment.chunk_view<std::string_view>(field_id, i)
                             .first);
-            } else {
-                auto span = segment.chunk_data<T>(field_id, 0);
-                field_data_ = std::make_shared<Span<T>>(
-                    span.data(), span.valid_data(), span.row_count());
+                    chunk_rows = str_views_.back().size();
+                } else {
+                    spans_.push_back(segment.chunk_data<T>(field_id, i));
+                    chunk_rows = spans_.back().row_count();
+                }
+                chunk_starts_.push_back(chunk_starts_.back() + chunk_rows);
             }
         } else if (segment.HasIndex(field_id)) {
             this->field_index_ = &(segment.chunk_scalar_index<T>(field_id, 0));
@@ -84,25 +151,31 @@ class SealedDataGetter : public DataGetter<T> {
         }
     }
 
-    SealedDataGetter(const SealedDataGetter<T>& other)
-        : field_data_(other.field_data_),
-          str_field_data_(other.str_field_data_),
-          field_index_(other.field_index_) {
-    }
-
     T
     Get(int64_t idx) const {
-        if (field_data_ || str_field_data_) {
+        if (field_index_ != nullptr) {
+            return IndexValueAt(idx);
+        }
+        return T(KeyAt(idx));
+    }
+
+    void
+    BulkGet(const int64_t* offsets,
+            int64_t count,
+            GroupByKey<T>* keys,
+            std::deque<std::string>& buffer) const {
+        if (field_index_ == nullptr) {
+            for (int64_t i = 0; i < count; i++) {
+                keys[i] = KeyAt(offsets[i]);
+            }
+            return;
+        }
+        for (int64_t i = 0; i < count; i++) {
             if constexpr (std::is_same_v<T, std::string>) {
-                std::string_view str_val_view =
-                    str_field_data_->operator[](idx);
-                return std::string(str_val_view.data(), str_val_view.length());
+                keys[i] = buffer.emplace_back(IndexValueAt(offsets[i]));
+            } else {
+                keys[i] = IndexValueAt(offsets[i]);
             }
-            return field_data_->operator[](idx);
-        } else {
-            auto raw = (*field_index_).Reverse_Lookup(idx);
-            AssertInfo(raw.has_value(), "field data not found");
-            return raw.value();
         }
     }
 };
@@ -19,6 +19,7 @@
 #include <fmt/core.h>
 #include <memory>
 #include <string>
+#include <typeinfo>
 #include <vector>
 
 #include "exec/expression/function/FunctionFactory.h"
@@ -738,6 +739,92 @@ class JsonContainsExpr : public ITypeFilterExpr {
     bool same_type_;
     const std::vector<proto::plan::GenericValue> vals_;
 };
+
+// key of an expr equal for the exprs of the same kind, columns, operators,
+// values and inputs. Unlike ToString every part of it is length prefixed, so
+// the segments of a nested path or the values of a list can't run together.
+inline std::string
+StructuralKey(const ITypeExpr& expr) {
+    std::string key;
+    auto append = [&key](const std::string& part) {
+        key += std::to_string(part.size());
+        key += ':';
+        key += part;
+    };
+    auto append_int = [&](int64_t part) { append(std::to_string(part)); };
+    auto append_column = [&](const ColumnInfo& column) {
+        append_int(column.field_id_.get());
+        append_int(static_cast<int64_t>(column.data_type_));
+        append_int(static_cast<int64_t>(column.element_type_));
+        append_int(column.nested_path_.size());
+        for (auto& segment : column.nested_path_) {
+            append(segment);
+        }
+    };
+    auto append_values =
+        [&](const std::vector<proto::plan::GenericValue>& values) {
+            append_int(values.size());
+            for (auto& value : values) {
+                append(value.SerializeAsString());
+            }
+        };
+
+    append(typeid(expr).name());
+    append_int(static_cast<int64_t>(expr.type()));
+    if (auto e = dynamic_cast<const UnaryRangeFilterExpr*>(&expr)) {
+        append_column(e->column_);
+        append_int(e->op_type_);
+        append(e->val_.SerializeAsString());
+    } else if (auto e = dynamic_cast<const BinaryRangeFilterExpr*>(&expr)) {
+        append_column(e->column_);
+        append(e->lower_val_.SerializeAsString());
+        append(e->upper_val_.SerializeAsString());
+        append_int(e->lower_inclusive_);
+        append_int(e->upper_inclusive_);
+    } else if (auto e = dynamic_cast<const TermFilterExpr*>(&expr)) {
+        append_column(e->column_);
+        append_values(e->vals_);
+        append_int(e->is_in_field_);
+    } else if (auto e =
+                   dynamic_cast<const BinaryArithOpEvalRangeExpr*>(&expr)) {
+        append_column(e->column_);
+        append_int(e->op_type_);
+        append_int(e->arith_op_type_);
+        append(e->right_operand_.SerializeAsString());
+        append(e->value_.SerializeAsString());
+    } else if (auto e = dynamic_cast<const JsonContainsExpr*>(&expr)) {
+        append_column(e->column_);
+        append_int(e->op_);
+        append_int(e->same_type_);
+        append_values(e->vals_);
+    } else if (auto e = dynamic_cast<const ExistsExpr*>(&expr)) {
+        append_column(e->column_);
+    } else if (auto e = dynamic_cast<const ColumnExpr*>(&expr)) {
+        append_column(e->GetColumn());
+    } else if (auto e = dynamic_cast<const ValueExpr*>(&expr)) {
+        append(e->GetGenericValue().SerializeAsString());
+    } else if (auto e = dynamic_cast<const CompareExpr*>(&expr)) {
+        append_int(e->left_field_id_.get());
+        append_int(e->right_field_id_.get());
+        append_int(static_cast<int64_t>(e->left_data_type_));
+        append_int(static_cast<int64_t>(e->right_data_type_));
+        append_int(e->op_type_);
+    } else if (auto e = dynamic_cast<const LogicalUnaryExpr*>(&expr)) {
+        append_int(static_cast<int64_t>(e->op_type_));
+    } else if (auto e = dynamic_cast<const LogicalBinaryExpr*>(&expr)) {
+        append_int(static_cast<int64_t>(e->op_type_));
+    } else if (auto e = dynamic_cast<const CallExpr*>(&expr)) {
+        append(e->fun_name());
+    } else if (dynamic_cast<const AlwaysTrueExpr*>(&expr) == nullptr) {
+        // the row and field accesses, which have no columns of their own
+        append(expr.ToString());
+    }
+    append_int(expr.inputs().size());
+    for (auto& input : expr.inputs()) {
+        append(StructuralKey(*input));
+    }
+    return key;
+}
 }  // namespace expr
 }  // namespace milvus
 
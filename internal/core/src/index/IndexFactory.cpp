@@ -214,10 +214,17 @@ IndexFactory::ScalarIndexLoadResource(
     request.has_raw_data = false;
 
     if (index_type == milvus::index::ASCENDING_SORT) {
-        request.final_memory_cost = index_size_gb;
-        request.final_disk_cost = 0;
-        request.max_memory_cost = 2 * index_size_gb;
-        request.max_disk_cost = 0;
+        if (mmap_enable) {
+            request.final_memory_cost = 0;
+            request.final_disk_cost = index_size_gb;
+            request.max_memory_cost = index_size_gb;
+            request.max_disk_cost = index_size_gb;
+        } else {
+            request.final_memory_cost = index_size_gb;
+            request.final_disk_cost = 0;
+            request.max_memory_cost = 2 * index_size_gb;
+            request.max_disk_cost = 0;
+        }
         request.has_raw_data = true;
     } else if (index_type == milvus::index::MARISA_TRIE ||
                index_type == milvus::index::MARISA_TRIE_UPPER) {
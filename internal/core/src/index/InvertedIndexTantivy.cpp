@@ -221,10 +221,13 @@ template <typename T>
 const TargetBitmap
 InvertedIndexTantivy<T>::In(size_t n, const T* values) {
     TargetBitmap bitset(Count());
-    for (size_t i = 0; i < n; ++i) {
-        auto array = wrapper_->term_query(values[i]);
-        apply_hits(bitset, array, true);
+    // tantivy takes the terms as a slice, which must not be built from the
+    // null pointer of an empty list
+    if (n == 0) {
+        return bitset;
     }
+    auto array = wrapper_->terms_query(values, n);
+    apply_hits(bitset, array, true);
     return bitset;
 }
 
@@ -254,10 +257,11 @@ const TargetBitmap
 InvertedIndexTantivy<T>::InApplyFilter(
     size_t n, const T* values, const std::function<bool(size_t)>& filter) {
     TargetBitmap bitset(Count());
-    for (size_t i = 0; i < n; ++i) {
-        auto array = wrapper_->term_query(values[i]);
-        apply_hits_with_filter(bitset, array, filter);
+    if (n == 0) {
+        return bitset;
     }
+    auto array = wrapper_->terms_query(values, n);
+    apply_hits_with_filter(bitset, array, filter);
     return bitset;
 }
 
@@ -265,18 +269,19 @@ template <typename T>
 void
 InvertedIndexTantivy<T>::InApplyCallback(
     size_t n, const T* values, const std::function<void(size_t)>& callback) {
-    for (size_t i = 0; i < n; ++i) {
-        auto array = wrapper_->term_query(values[i]);
-        apply_hits_with_callback(array, callback);
+    if (n == 0) {
+        return;
     }
+    auto array = wrapper_->terms_query(values, n);
+    apply_hits_with_callback(array, callback);
 }
 
 template <typename T>
 const TargetBitmap
 InvertedIndexTantivy<T>::NotIn(size_t n, const T* values) {
     TargetBitmap bitset(Count(), true);
-    for (size_t i = 0; i < n; ++i) {
-        auto array = wrapper_->term_query(values[i]);
+    if (n > 0) {
+        auto array = wrapper_->terms_query(values, n);
         apply_hits(bitset, array, false);
     }
     for (size_t i = 0; i < null_offset.size(); ++i) {
@@ -36,6 +36,16 @@ constexpr const char* BITMAP_INDEX_META = "bitmap_index_meta";
 constexpr const char* BITMAP_INDEX_LENGTH = "bitmap_index_length";
 constexpr const char* BITMAP_INDEX_NUM_ROWS = "bitmap_index_num_rows";
 
+// below meta key of store sort indexes, SORT_INDEX_DATA is the layout of
+// values interleaved with their row ids written until the scalar index
+// version is bumped, the arrays of values and rows are only loaded
+constexpr const char* SORT_INDEX_DATA = "index_data";
+constexpr const char* SORT_INDEX_VALUES = "sort_index_values";
+constexpr const char* SORT_INDEX_ROW_IDS = "sort_index_row_ids";
+constexpr const char* SORT_INDEX_ROW_OFFSETS = "sort_index_row_offsets";
+constexpr const char* SORT_INDEX_LENGTH = "index_length";
+constexpr const char* SORT_INDEX_NUM_ROWS = "index_num_rows";
+
 constexpr const char* INDEX_TYPE = "index_type";
 constexpr const char* METRIC_TYPE = "metric_type";
 
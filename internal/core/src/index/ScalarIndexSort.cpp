@@ -15,13 +15,17 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <filesystem>
 #include <memory>
 #include <optional>
 #include <utility>
 #include <pb/schema.pb.h>
+#include <sys/mman.h>
+#include <unistd.h>
 #include <vector>
 #include <string>
 #include "common/CDataType.h"
+#include "common/File.h"
 #include "index/ScalarIndex.h"
 #include "knowhere/log.h"
 #include "Meta.h"
@@ -30,14 +34,45 @@
 #include "common/Types.h"
 #include "index/Utils.h"
 #include "index/ScalarIndexSort.h"
+#include "log/Log.h"
 #include "storage/Util.h"
 
 namespace milvus::index {
 
+namespace {
+// the arrays of a mapped index start at multiples of it
+constexpr size_t kMmapArrayAlignment = 8;
+
+size_t
+AlignArray(size_t size) {
+    return (size + kMmapArrayAlignment - 1) / kMmapArrayAlignment *
+           kMmapArrayAlignment;
+}
+
+// a single write may write only a part of large buffers
+void
+WriteFully(File& file, const void* data, size_t size) {
+    auto ptr = static_cast<const char*>(data);
+    while (size > 0) {
+        auto written = file.Write(ptr, size);
+        if (written <= 0) {
+            auto filepath = file.Path();
+            file.Close();
+            remove(filepath.c_str());
+            PanicInfo(
+                ErrorCode::UnistdError,
+                fmt::format("write index to fd error: {}", strerror(errno)));
+        }
+        ptr += written;
+        size -= written;
+    }
+}
+}  // namespace
+
 template <typename T>
 ScalarIndexSort<T>::ScalarIndexSort(
     const storage::FileManagerContext& file_manager_context)
-    : ScalarIndex<T>(ASCENDING_SORT), is_built_(false), data_() {
+    : ScalarIndex<T>(ASCENDING_SORT), is_built_(false) {
     if (file_manager_context.Valid()) {
         file_manager_ =
             std::make_shared<storage::MemFileManagerImpl>(file_manager_context);
@@ -45,6 +80,18 @@ ScalarIndexSort<T>::ScalarIndexSort(
     }
 }
 
+template <typename T>
+void
+ScalarIndexSort<T>::UnmapIndexData() {
+    if (mmap_data_ != nullptr && mmap_data_ != MAP_FAILED) {
+        if (munmap(mmap_data_, mmap_size_) != 0) {
+            LOG_ERROR("failed to unmap sort index, err={}", strerror(errno));
+        }
+        mmap_data_ = nullptr;
+        mmap_size_ = 0;
+    }
+}
+
 template <typename T>
 void
 ScalarIndexSort<T>::Build(const Config& config) {
@@ -68,23 +115,22 @@ ScalarIndexSort<T>::Build(size_t n, const T* values, const bool* valid_data) {
     if (n == 0) {
         PanicInfo(DataIsEmpty, "ScalarIndexSort cannot build null values!");
     }
-    data_.reserve(n);
+    std::vector<IndexStructure<T>> data;
+    data.reserve(n);
     total_num_rows_ = n;
     valid_bitset_ = TargetBitmap(total_num_rows_, false);
-    idx_to_offsets_.resize(n);
 
     T* p = const_cast<T*>(values);
     for (size_t i = 0; i < n; ++i, ++p) {
         if (!valid_data || valid_data[i]) {
-            data_.emplace_back(IndexStructure(*p, i));
+            data.emplace_back(IndexStructure(*p, i));
             valid_bitset_.set(i);
         }
     }
 
-    std::sort(data_.begin(), data_.end());
-    for (size_t i = 0; i < data_.size(); ++i) {
-        idx_to_offsets_[data_[i].idx_] = i;
-    }
+    std::sort(data.begin(), data.end());
+    SplitStructures(data);
+    BuildBlockKeys();
     is_built_ = true;
 }
 
@@ -101,7 +147,8 @@ ScalarIndexSort<T>::BuildWithFieldData(
         PanicInfo(DataIsEmpty, "ScalarIndexSort cannot build null values!");
     }
 
-    data_.reserve(length);
+    std::vector<IndexStructure<T>> structures;
+    structures.reserve(length);
     valid_bitset_ = TargetBitmap(total_num_rows_, false);
     int64_t offset = 0;
     for (const auto& data : field_datas) {
@@ -109,45 +156,82 @@ ScalarIndexSort<T>::BuildWithFieldData(
         for (size_t i = 0; i < slice_num; ++i) {
             if (data->is_valid(i)) {
                 auto value = reinterpret_cast<const T*>(data->RawValue(i));
-                data_.emplace_back(IndexStructure(*value, offset));
+                structures.emplace_back(IndexStructure(*value, offset));
                 valid_bitset_.set(offset);
             }
             offset++;
         }
     }
 
-    std::sort(data_.begin(), data_.end());
-    idx_to_offsets_.resize(total_num_rows_);
-    for (size_t i = 0; i < length; ++i) {
-        idx_to_offsets_[data_[i].idx_] = i;
-    }
+    std::sort(structures.begin(), structures.end());
+    SplitStructures(structures);
+    BuildBlockKeys();
     is_built_ = true;
 }
 
+template <typename T>
+void
+ScalarIndexSort<T>::SplitStructures(
+    const std::vector<IndexStructure<T>>& data) {
+    num_values_ = data.size();
+    owned_values_ = std::make_unique<T[]>(num_values_);
+    owned_row_ids_.resize(num_values_);
+    owned_row_offsets_.assign(total_num_rows_, -1);
+    for (size_t i = 0; i < num_values_; ++i) {
+        owned_values_[i] = data[i].a_;
+        owned_row_ids_[i] = data[i].idx_;
+        owned_row_offsets_[data[i].idx_] = i;
+    }
+    values_ = owned_values_.get();
+    row_ids_ = owned_row_ids_.data();
+    row_offsets_ = owned_row_offsets_.data();
+}
+
+template <typename T>
+void
+ScalarIndexSort<T>::BuildBlockKeys() {
+    block_keys_.clear();
+    block_keys_.reserve((num_values_ + kBlockSize - 1) / kBlockSize);
+    for (size_t i = 0; i < num_values_; i += kBlockSize) {
+        block_keys_.push_back(values_[i]);
+    }
+}
+
 template <typename T>
 BinarySet
 ScalarIndexSort<T>::Serialize(const Config& config) {
     AssertInfo(is_built_, "index has not been built");
+    if constexpr (!std::is_arithmetic_v<T>) {
+        PanicInfo(Unsupported,
+                  "serialize is only supported by sort index of numbers");
+    } else {
+        // the values interleaved with their row ids, the layout the nodes
+        // of the current scalar index version load. The arrays are only
+        // written once the version is bumped.
+        std::vector<IndexStructure<T>> data;
+        data.reserve(num_values_);
+        for (size_t i = 0; i < num_values_; ++i) {
+            data.emplace_back(values_[i], row_ids_[i]);
+        }
+        auto index_data_size = data.size() * sizeof(IndexStructure<T>);
+        std::shared_ptr<uint8_t[]> index_data(new uint8_t[index_data_size]);
+        memcpy(index_data.get(), data.data(), index_data_size);
 
-    auto index_data_size = data_.size() * sizeof(IndexStructure<T>);
-    std::shared_ptr<uint8_t[]> index_data(new uint8_t[index_data_size]);
-    memcpy(index_data.get(), data_.data(), index_data_size);
-
-    std::shared_ptr<uint8_t[]> index_length(new uint8_t[sizeof(size_t)]);
-    auto index_size = data_.size();
-    memcpy(index_length.get(), &index_size, sizeof(size_t));
+        std::shared_ptr<uint8_t[]> index_length(new uint8_t[sizeof(size_t)]);
+        memcpy(index_length.get(), &num_values_, sizeof(size_t));
 
-    std::shared_ptr<uint8_t[]> index_num_rows(new uint8_t[sizeof(size_t)]);
-    memcpy(index_num_rows.get(), &total_num_rows_, sizeof(size_t));
+        std::shared_ptr<uint8_t[]> index_num_rows(new uint8_t[sizeof(size_t)]);
+        memcpy(index_num_rows.get(), &total_num_rows_, sizeof(size_t));
 
-    BinarySet res_set;
-    res_set.Append("index_data", index_data, index_data_size);
-    res_set.Append("index_length", index_length, sizeof(size_t));
-    res_set.Append("index_num_rows", index_num_rows, sizeof(size_t));
+        BinarySet res_set;
+        res_set.Append(SORT_INDEX_DATA, index_data, index_data_size);
+        res_set.Append(SORT_INDEX_LENGTH, index_length, sizeof(size_t));
+        res_set.Append(SORT_INDEX_NUM_ROWS, index_num_rows, sizeof(size_t));
 
-    milvus::Disassemble(res_set);
+        milvus::Disassemble(res_set);
 
-    return res_set;
+        return res_set;
+    }
 }
 
 template <typename T>
@@ -165,29 +249,118 @@ ScalarIndexSort<T>::Upload(const Config& config) {
     return ret;
 }
 
+template <typename T>
+void
+ScalarIndexSort<T>::LoadArrays(const T* values,
+                               const int32_t* row_ids,
+                               const int32_t* row_offsets) {
+    owned_values_ = std::make_unique<T[]>(num_values_);
+    std::copy(values, values + num_values_, owned_values_.get());
+    owned_row_ids_.assign(row_ids, row_ids + num_values_);
+    owned_row_offsets_.assign(row_offsets, row_offsets + total_num_rows_);
+    values_ = owned_values_.get();
+    row_ids_ = owned_row_ids_.data();
+    row_offsets_ = owned_row_offsets_.data();
+}
+
+template <typename T>
+void
+ScalarIndexSort<T>::MMapIndexData(const std::string& filepath,
+                                  const T* values,
+                                  const int32_t* row_ids,
+                                  const int32_t* row_offsets) {
+    static const char padding[kMmapArrayAlignment] = {};
+    auto values_size = num_values_ * sizeof(T);
+    auto row_ids_begin = AlignArray(values_size);
+    auto row_ids_size = num_values_ * sizeof(int32_t);
+    auto row_offsets_begin = AlignArray(row_ids_begin + row_ids_size);
+    auto data_size = row_offsets_begin + total_num_rows_ * sizeof(int32_t);
+
+    std::filesystem::create_directories(
+        std::filesystem::path(filepath).parent_path());
+    auto file = File::Open(filepath, O_RDWR | O_CREAT | O_TRUNC);
+    WriteFully(file, values, values_size);
+    WriteFully(file, padding, row_ids_begin - values_size);
+    WriteFully(file, row_ids, row_ids_size);
+    WriteFully(file, padding, row_offsets_begin - row_ids_begin - row_ids_size);
+    WriteFully(file, row_offsets, total_num_rows_ * sizeof(int32_t));
+
+    mmap_data_ = static_cast<char*>(
+        mmap(NULL, data_size, PROT_READ, MAP_PRIVATE, file.Descriptor(), 0));
+    if (mmap_data_ == MAP_FAILED) {
+        file.Close();
+        remove(filepath.c_str());
+        PanicInfo(
+            ErrorCode::UnexpectedError, "failed to mmap: {}", strerror(errno));
+    }
+    mmap_size_ = data_size;
+    unlink(filepath.c_str());
+
+    values_ = reinterpret_cast<const T*>(mmap_data_);
+    row_ids_ = reinterpret_cast<const int32_t*>(mmap_data_ + row_ids_begin);
+    row_offsets_ =
+        reinterpret_cast<const int32_t*>(mmap_data_ + row_offsets_begin);
+    is_mmap_ = true;
+
+    // the arrays may be the owned ones, released once written
+    owned_values_.reset();
+    std::vector<int32_t>().swap(owned_row_ids_);
+    std::vector<int32_t>().swap(owned_row_offsets_);
+}
+
 template <typename T>
 void
 ScalarIndexSort<T>::LoadWithoutAssemble(const BinarySet& index_binary,
                                         const Config& config) {
-    size_t index_size;
-    auto index_length = index_binary.GetByName("index_length");
-    memcpy(&index_size, index_length->data.get(), (size_t)index_length->size);
-
-    auto index_data = index_binary.GetByName("index_data");
-    data_.resize(index_size);
-    auto index_num_rows = index_binary.GetByName("index_num_rows");
-    memcpy(&total_num_rows_,
-           index_num_rows->data.get(),
-           (size_t)index_num_rows->size);
-    idx_to_offsets_.resize(total_num_rows_);
-    valid_bitset_ = TargetBitmap(total_num_rows_, false);
-    memcpy(data_.data(), index_data->data.get(), (size_t)index_data->size);
-    for (size_t i = 0; i < data_.size(); ++i) {
-        idx_to_offsets_[data_[i].idx_] = i;
-        valid_bitset_.set(data_[i].idx_);
-    }
+    if constexpr (!std::is_arithmetic_v<T>) {
+        PanicInfo(Unsupported,
+                  "load is only supported by sort index of numbers");
+    } else {
+        auto index_length = index_binary.GetByName(SORT_INDEX_LENGTH);
+        memcpy(
+            &num_values_, index_length->data.get(), (size_t)index_length->size);
+        auto index_num_rows = index_binary.GetByName(SORT_INDEX_NUM_ROWS);
+        memcpy(&total_num_rows_,
+               index_num_rows->data.get(),
+               (size_t)index_num_rows->size);
+        auto mmap_filepath =
+            GetValueFromConfig<std::string>(config, MMAP_FILE_PATH);
+
+        if (index_binary.binary_map_.count(SORT_INDEX_DATA) > 0) {
+            // indexes built before the values and rows were kept apart
+            auto index_data = index_binary.GetByName(SORT_INDEX_DATA);
+            std::vector<IndexStructure<T>> data(num_values_);
+            memcpy(data.data(),
+                   index_data->data.get(),
+                   (size_t)index_data->size);
+            SplitStructures(data);
+            if (mmap_filepath.has_value()) {
+                MMapIndexData(
+                    mmap_filepath.value(), values_, row_ids_, row_offsets_);
+            }
+        } else {
+            auto values = reinterpret_cast<const T*>(
+                index_binary.GetByName(SORT_INDEX_VALUES)->data.get());
+            auto row_ids = reinterpret_cast<const int32_t*>(
+                index_binary.GetByName(SORT_INDEX_ROW_IDS)->data.get());
+            auto row_offsets = reinterpret_cast<const int32_t*>(
+                index_binary.GetByName(SORT_INDEX_ROW_OFFSETS)->data.get());
+            if (mmap_filepath.has_value()) {
+                MMapIndexData(
+                    mmap_filepath.value(), values, row_ids, row_offsets);
+            } else {
+                LoadArrays(values, row_ids, row_offsets);
+            }
+        }
+        BuildBlockKeys();
 
-    is_built_ = true;
+        valid_bitset_ = TargetBitmap(total_num_rows_, false);
+        for (size_t i = 0; i < num_values_; ++i) {
+            valid_bitset_.set(row_ids_[i]);
+        }
+
+        is_built_ = true;
+    }
 }
 
 template <typename T>
@@ -219,23 +392,71 @@ ScalarIndexSort<T>::Load(milvus::tracer::TraceContext ctx,
     LoadWithoutAssemble(binary_set, config);
 }
 
+template <typename T>
+size_t
+ScalarIndexSort<T>::LowerBound(const T& value) const {
+    // the first block whose first value is not less than value follows the
+    // block holding the bound, unless it's the first one
+    auto block =
+        std::lower_bound(block_keys_.begin(), block_keys_.end(), value) -
+        block_keys_.begin();
+    if (block == 0) {
+        return 0;
+    }
+    auto begin = (block - 1) * kBlockSize + 1;
+    auto end = std::min(block * kBlockSize, num_values_);
+    return std::lower_bound(values_ + begin, values_ + end, value) - values_;
+}
+
+template <typename T>
+size_t
+ScalarIndexSort<T>::UpperBound(const T& value) const {
+    auto block =
+        std::upper_bound(block_keys_.begin(), block_keys_.end(), value) -
+        block_keys_.begin();
+    if (block == 0) {
+        return 0;
+    }
+    auto begin = (block - 1) * kBlockSize + 1;
+    auto end = std::min(block * kBlockSize, num_values_);
+    return std::upper_bound(values_ + begin, values_ + end, value) - values_;
+}
+
+template <typename T>
+TargetBitmap
+ScalarIndexSort<T>::PositionsToBitmap(size_t begin, size_t end) const {
+    if (begin >= end) {
+        return TargetBitmap(total_num_rows_);
+    }
+    if (end - begin <= num_values_ / 2) {
+        TargetBitmap bitset(total_num_rows_);
+        for (auto i = begin; i < end; ++i) {
+            bitset[row_ids_[i]] = true;
+        }
+        return bitset;
+    }
+    // most of the values are in range, clear the rows of the others
+    TargetBitmap bitset(total_num_rows_, true);
+    bitset &= valid_bitset_;
+    for (size_t i = 0; i < begin; ++i) {
+        bitset[row_ids_[i]] = false;
+    }
+    for (auto i = end; i < num_values_; ++i) {
+        bitset[row_ids_[i]] = false;
+    }
+    return bitset;
+}
+
 template <typename T>
 const TargetBitmap
 ScalarIndexSort<T>::In(const size_t n, const T* values) {
     AssertInfo(is_built_, "index has not been built");
     TargetBitmap bitset(Count());
     for (size_t i = 0; i < n; ++i) {
-        auto lb = std::lower_bound(
-            data_.begin(), data_.end(), IndexStructure<T>(*(values + i)));
-        auto ub = std::upper_bound(
-            data_.begin(), data_.end(), IndexStructure<T>(*(values + i)));
-        for (; lb < ub; ++lb) {
-            if (lb->a_ != *(values + i)) {
-                std::cout << "error happens in ScalarIndexSort<T>::In, "
-                             "experted value is: "
-                          << *(values + i) << ", but real value is: " << lb->a_;
-            }
-            bitset[lb->idx_] = true;
+        for (auto pos = LowerBound(values[i]);
+             pos < num_values_ && values_[pos] == values[i];
+             ++pos) {
+            bitset[row_ids_[pos]] = true;
         }
     }
     return bitset;
@@ -247,17 +468,10 @@ ScalarIndexSort<T>::NotIn(const size_t n, const T* values) {
     AssertInfo(is_built_, "index has not been built");
     TargetBitmap bitset(Count(), true);
     for (size_t i = 0; i < n; ++i) {
-        auto lb = std::lower_bound(
-            data_.begin(), data_.end(), IndexStructure<T>(*(values + i)));
-        auto ub = std::upper_bound(
-            data_.begin(), data_.end(), IndexStructure<T>(*(values + i)));
-        for (; lb < ub; ++lb) {
-            if (lb->a_ != *(values + i)) {
-                std::cout << "error happens in ScalarIndexSort<T>::NotIn, "
-                             "experted value is: "
-                          << *(values + i) << ", but real value is: " << lb->a_;
-            }
-            bitset[lb->idx_] = false;
+        for (auto pos = LowerBound(values[i]);
+             pos < num_values_ && values_[pos] == values[i];
+             ++pos) {
+            bitset[row_ids_[pos]] = false;
         }
     }
     // NotIn(null) and In(null) is both false, need to mask with IsNotNull operate
@@ -288,37 +502,29 @@ template <typename T>
 const TargetBitmap
 ScalarIndexSort<T>::Range(const T value, const OpType op) {
     AssertInfo(is_built_, "index has not been built");
-    TargetBitmap bitset(Count());
-    auto lb = data_.begin();
-    auto ub = data_.end();
     if (ShouldSkip(value, value, op)) {
-        return bitset;
+        return TargetBitmap(Count());
     }
+    size_t lb = 0;
+    size_t ub = num_values_;
     switch (op) {
         case OpType::LessThan:
-            ub = std::lower_bound(
-                data_.begin(), data_.end(), IndexStructure<T>(value));
+            ub = LowerBound(value);
             break;
         case OpType::LessEqual:
-            ub = std::upper_bound(
-                data_.begin(), data_.end(), IndexStructure<T>(value));
+            ub = UpperBound(value);
             break;
         case OpType::GreaterThan:
-            lb = std::upper_bound(
-                data_.begin(), data_.end(), IndexStructure<T>(value));
+            lb = UpperBound(value);
             break;
         case OpType::GreaterEqual:
-            lb = std::lower_bound(
-                data_.begin(), data_.end(), IndexStructure<T>(value));
+            lb = LowerBound(value);
             break;
         default:
             PanicInfo(OpTypeInvalid,
                       fmt::format("Invalid OperatorType: {}", op));
     }
-    for (; lb < ub; ++lb) {
-        bitset[lb->idx_] = true;
-    }
-    return bitset;
+    return PositionsToBitmap(lb, ub);
 }
 
 template <typename T>
@@ -328,48 +534,31 @@ ScalarIndexSort<T>::Range(T lower_bound_value,
                           T upper_bound_value,
                           bool ub_inclusive) {
     AssertInfo(is_built_, "index has not been built");
-    TargetBitmap bitset(Count());
     if (lower_bound_value > upper_bound_value ||
         (lower_bound_value == upper_bound_value &&
          !(lb_inclusive && ub_inclusive))) {
-        return bitset;
+        return TargetBitmap(Count());
     }
     if (ShouldSkip(lower_bound_value, upper_bound_value, OpType::Range)) {
-        return bitset;
-    }
-    auto lb = data_.begin();
-    auto ub = data_.end();
-    if (lb_inclusive) {
-        lb = std::lower_bound(
-            data_.begin(), data_.end(), IndexStructure<T>(lower_bound_value));
-    } else {
-        lb = std::upper_bound(
-            data_.begin(), data_.end(), IndexStructure<T>(lower_bound_value));
-    }
-    if (ub_inclusive) {
-        ub = std::upper_bound(
-            data_.begin(), data_.end(), IndexStructure<T>(upper_bound_value));
-    } else {
-        ub = std::lower_bound(
-            data_.begin(), data_.end(), IndexStructure<T>(upper_bound_value));
+        return TargetBitmap(Count());
     }
-    for (; lb < ub; ++lb) {
-        bitset[lb->idx_] = true;
-    }
-    return bitset;
+    auto lb = lb_inclusive ? LowerBound(lower_bound_value)
+                           : UpperBound(lower_bound_value);
+    auto ub = ub_inclusive ? UpperBound(upper_bound_value)
+                           : LowerBound(upper_bound_value);
+    return PositionsToBitmap(lb, ub);
 }
 
 template <typename T>
 std::optional<T>
 ScalarIndexSort<T>::Reverse_Lookup(size_t idx) const {
-    AssertInfo(idx < idx_to_offsets_.size(), "out of range of total count");
+    AssertInfo(idx < total_num_rows_, "out of range of total count");
     AssertInfo(is_built_, "index has not been built");
 
     if (!valid_bitset_[idx]) {
         return std::nullopt;
     }
-    auto offset = idx_to_offsets_[idx];
-    return data_[offset].a_;
+    return values_[row_offsets_[idx]];
 }
 
 template <typename T>
@@ -377,30 +566,30 @@ bool
 ScalarIndexSort<T>::ShouldSkip(const T lower_value,
                                const T upper_value,
                                const milvus::OpType op) {
-    if (!data_.empty()) {
-        auto lower_bound = data_.begin();
-        auto upper_bound = data_.rbegin();
+    if (num_values_ > 0) {
+        const auto& min_value = values_[0];
+        const auto& max_value = values_[num_values_ - 1];
         bool shouldSkip = false;
         switch (op) {
             case OpType::LessThan: {
-                shouldSkip = upper_value <= lower_bound->a_;
+                shouldSkip = upper_value <= min_value;
                 break;
             }
             case OpType::LessEqual: {
-                shouldSkip = upper_value < lower_bound->a_;
+                shouldSkip = upper_value < min_value;
                 break;
             }
             case OpType::GreaterThan: {
-                shouldSkip = lower_value >= upper_bound->a_;
+                shouldSkip = lower_value >= max_value;
                 break;
             }
             case OpType::GreaterEqual: {
-                shouldSkip = lower_value > upper_bound->a_;
+                shouldSkip = lower_value > max_value;
                 break;
             }
             case OpType::Range: {
-                shouldSkip = (lower_value > upper_bound->a_) ||
-                             (upper_value < lower_bound->a_);
+                shouldSkip =
+                    (lower_value > max_value) || (upper_value < min_value);
                 break;
             }
             default:
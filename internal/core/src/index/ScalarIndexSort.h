@@ -18,6 +18,8 @@
 
 #include <algorithm>
 #include <memory>
+#include <optional>
+#include <type_traits>
 #include <utility>
 #include <vector>
 #include <string>
@@ -36,6 +38,12 @@ class ScalarIndexSort : public ScalarIndex<T> {
         const storage::FileManagerContext& file_manager_context =
             storage::FileManagerContext());
 
+    ~ScalarIndexSort() {
+        if (is_mmap_) {
+            UnmapIndexData();
+        }
+    }
+
     BinarySet
     Serialize(const Config& config) override;
 
@@ -87,7 +95,12 @@ class ScalarIndexSort : public ScalarIndex<T> {
 
     int64_t
     Size() override {
-        return (int64_t)data_.size();
+        return (int64_t)num_values_;
+    }
+
+    bool
+    IsMmapSupported() const override {
+        return std::is_arithmetic_v<T>;
     }
 
     BinarySet
@@ -105,10 +118,51 @@ class ScalarIndexSort : public ScalarIndex<T> {
     bool
     ShouldSkip(const T lower_value, const T upper_value, const OpType op);
 
+    // sets the rows of the values at positions [begin, end)
+    TargetBitmap
+    PositionsToBitmap(size_t begin, size_t end) const;
+
+    // keeps the values and rows of the structures, ordered by value, as the
+    // arrays of the index
+    void
+    SplitStructures(const std::vector<IndexStructure<T>>& data);
+
+    // copies the arrays of a loaded index into memory
+    void
+    LoadArrays(const T* values,
+               const int32_t* row_ids,
+               const int32_t* row_offsets);
+
+    // writes the arrays into the file and maps it in place of them
+    void
+    MMapIndexData(const std::string& filepath,
+                  const T* values,
+                  const int32_t* row_ids,
+                  const int32_t* row_offsets);
+
+    void
+    BuildBlockKeys();
+
+    void
+    UnmapIndexData();
+
  public:
-    const std::vector<IndexStructure<T>>&
-    GetData() {
-        return data_;
+    // the position of the first value not less than value
+    size_t
+    LowerBound(const T& value) const;
+
+    // the position of the first value greater than value
+    size_t
+    UpperBound(const T& value) const;
+
+    const T&
+    ValueAt(size_t position) const {
+        return values_[position];
+    }
+
+    int32_t
+    RowIdAt(size_t position) const {
+        return row_ids_[position];
     }
 
     bool
@@ -121,10 +175,28 @@ class ScalarIndexSort : public ScalarIndex<T> {
                         const Config& config) override;
 
  private:
+    // the values of a block span a page, a search finds the block by the
+    // first values of the blocks before searching inside it
+    static constexpr size_t kBlockSize =
+        std::max<size_t>(4096 / sizeof(T), 1);
+
     bool is_built_;
     Config config_;
-    std::vector<int32_t> idx_to_offsets_;  // used to retrieve.
-    std::vector<IndexStructure<T>> data_;
+    // the valid values in ascending order, the row of each, and the position
+    // of the value of each row, -1 for null rows. They point into either the
+    // owned vectors or the mapped index file.
+    size_t num_values_{0};
+    const T* values_{nullptr};
+    const int32_t* row_ids_{nullptr};
+    const int32_t* row_offsets_{nullptr};
+    std::unique_ptr<T[]> owned_values_;
+    std::vector<int32_t> owned_row_ids_;
+    std::vector<int32_t> owned_row_offsets_;
+    // the first value of every block of kBlockSize values, always in memory
+    std::vector<T> block_keys_;
+    bool is_mmap_{false};
+    char* mmap_data_{nullptr};
+    size_t mmap_size_{0};
     std::shared_ptr<storage::MemFileManagerImpl> file_manager_;
     size_t total_num_rows_{0};
     // generate valid_bitset_ to speed up NotIn and IsNull and IsNotNull operate
@@ -28,6 +28,114 @@ SkipIndex::GetFieldChunkMetrics(milvus::FieldId field_id, int chunk_id) const {
     return defaultFieldChunkMetrics;
 }
 
+const FieldChunkMetrics&
+SkipIndex::GetJsonPathBlockMetrics(FieldId field_id,
+                                   const std::string& pointer,
+                                   int64_t block_id) const {
+    std::shared_lock lck(mutex_);
+    auto field_metrics = jsonPathBlockMetrics_.find(field_id);
+    if (field_metrics == jsonPathBlockMetrics_.end()) {
+        return defaultFieldChunkMetrics;
+    }
+    auto path_metrics = field_metrics->second.find(pointer);
+    if (path_metrics == field_metrics->second.end()) {
+        return defaultFieldChunkMetrics;
+    }
+    auto block_metrics = path_metrics->second.find(block_id);
+    if (block_metrics == path_metrics->second.end()) {
+        return defaultFieldChunkMetrics;
+    }
+    return *(block_metrics->second.get());
+}
+
+void
+SkipIndex::EmplaceJsonPathBlockMetrics(
+    FieldId field_id,
+    const std::string& pointer,
+    int64_t block_id,
+    std::unique_ptr<FieldChunkMetrics> metrics) {
+    std::unique_lock lck(mutex_);
+    jsonPathBlockMetrics_[field_id][pointer].emplace(block_id,
+                                                     std::move(metrics));
+}
+
+void
+SkipIndex::DropJsonPathMetrics(FieldId field_id) {
+    std::unique_lock lck(mutex_);
+    jsonPathBlockMetrics_.erase(field_id);
+}
+
+void
+SkipIndex::LoadJsonPathPrimitive(FieldId field_id,
+                                 const std::string& pointer,
+                                 int64_t block_id,
+                                 DataType data_type,
+                                 const void* block_data,
+                                 const bool* valid_data,
+                                 int64_t count) {
+    auto blockMetrics = std::make_unique<FieldChunkMetrics>();
+    blockMetrics->null_count_ = count;
+    if (count > 0) {
+        switch (data_type) {
+            case DataType::INT64: {
+                auto info = ProcessFieldMetrics<int64_t>(
+                    static_cast<const int64_t*>(block_data), valid_data, count);
+                blockMetrics->min_ = Metrics(info.min_);
+                blockMetrics->max_ = Metrics(info.max_);
+                blockMetrics->null_count_ = info.null_count_;
+                break;
+            }
+            case DataType::DOUBLE: {
+                auto info = ProcessFieldMetrics<double>(
+                    static_cast<const double*>(block_data), valid_data, count);
+                blockMetrics->min_ = Metrics(info.min_);
+                blockMetrics->max_ = Metrics(info.max_);
+                blockMetrics->null_count_ = info.null_count_;
+                break;
+            }
+            default:
+                PanicInfo(DataTypeInvalid,
+                          "unsupported data type {} for json path metrics",
+                          data_type);
+        }
+    }
+    blockMetrics->hasValue_ = blockMetrics->null_count_ != count;
+    EmplaceJsonPathBlockMetrics(
+        field_id, pointer, block_id, std::move(blockMetrics));
+}
+
+void
+SkipIndex::LoadJsonPathString(FieldId field_id,
+                              const std::string& pointer,
+                              int64_t block_id,
+                              const StringBatchView& block_data,
+                              const bool* valid_data,
+                              int64_t count) {
+    auto blockMetrics = std::make_unique<FieldChunkMetrics>();
+    std::string_view min_string;
+    std::string_view max_string;
+    int64_t null_count = 0;
+    for (int64_t i = 0; i < count; i++) {
+        if (!valid_data[i]) {
+            null_count++;
+            continue;
+        }
+        auto val = block_data[i];
+        if (null_count == i || val < min_string) {
+            min_string = val;
+        }
+        if (null_count == i || val > max_string) {
+            max_string = val;
+        }
+    }
+    blockMetrics->min_ = Metrics(std::string(min_string));
+    blockMetrics->max_ = Metrics(std::string(max_string));
+    blockMetrics->null_count_ = null_count;
+    blockMetrics->hasValue_ = null_count != count;
+    EmplaceJsonPathBlockMetrics(
+        field_id, pointer, block_id, std::move(blockMetrics));
+}
+
 void
 SkipIndex::LoadPrimitive(milvus::FieldId field_id,
                          int64_t chunk_id,
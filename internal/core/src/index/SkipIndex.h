@@ -13,6 +13,7 @@
 #include <cstddef>
 #include <unordered_map>
 
+#include "common/Common.h"
 #include "common/Types.h"
 #include "log/Log.h"
 #include "mmap/Column.h"
@@ -93,6 +94,61 @@ class SkipIndex {
         return false;
     }
 
+    // min/max of the blocks of JSON paths shredded into typed columns,
+    // block_id is the row offset in segment divided by the block size
+    template <typename T>
+    bool
+    CanSkipJsonPathUnaryRange(FieldId field_id,
+                              const std::string& pointer,
+                              int64_t block_id,
+                              OpType op_type,
+                              const T& val) const {
+        auto& block_metrics =
+            GetJsonPathBlockMetrics(field_id, pointer, block_id);
+        return MinMaxUnaryFilter<T>(block_metrics, op_type, val);
+    }
+
+    template <typename T>
+    bool
+    CanSkipJsonPathBinaryRange(FieldId field_id,
+                               const std::string& pointer,
+                               int64_t block_id,
+                               const T& lower_val,
+                               const T& upper_val,
+                               bool lower_inclusive,
+                               bool upper_inclusive) const {
+        auto& block_metrics =
+            GetJsonPathBlockMetrics(field_id, pointer, block_id);
+        return MinMaxBinaryFilter<T>(block_metrics,
+                                     lower_val,
+                                     upper_val,
+                                     lower_inclusive,
+                                     upper_inclusive);
+    }
+
+    // data_type is INT64 or DOUBLE, rows with valid_data false are the
+    // ones where the path is missing
+    void
+    LoadJsonPathPrimitive(FieldId field_id,
+                          const std::string& pointer,
+                          int64_t block_id,
+                          DataType data_type,
+                          const void* block_data,
+                          const bool* valid_data,
+                          int64_t count);
+
+    void
+    LoadJsonPathString(FieldId field_id,
+                       const std::string& pointer,
+                       int64_t block_id,
+                       const StringBatchView& block_data,
+                       const bool* valid_data,
+                       int64_t count);
+
+    // drops the block metrics of all shredded paths of the json field
+    void
+    DropJsonPathMetrics(FieldId field_id);
+
     void
     LoadPrimitive(milvus::FieldId field_id,
                   int64_t chunk_id,
@@ -132,6 +188,17 @@ class SkipIndex {
     const FieldChunkMetrics&
     GetFieldChunkMetrics(FieldId field_id, int chunk_id) const;
 
+    const FieldChunkMetrics&
+    GetJsonPathBlockMetrics(FieldId field_id,
+                            const std::string& pointer,
+                            int64_t block_id) const;
+
+    void
+    EmplaceJsonPathBlockMetrics(FieldId field_id,
+                                const std::string& pointer,
+                                int64_t block_id,
+                                std::unique_ptr<FieldChunkMetrics> metrics);
+
     template <typename T>
     struct IsAllowedType {
         static constexpr bool isAllowedType =
@@ -333,6 +400,13 @@ class SkipIndex {
         FieldId,
         std::unordered_map<int64_t, std::unique_ptr<FieldChunkMetrics>>>
         fieldChunkMetrics_;
+    // field id -> json pointer -> block id -> metrics
+    std::unordered_map<
+        FieldId,
+        std::unordered_map<
+            std::string,
+            std::unordered_map<int64_t, std::unique_ptr<FieldChunkMetrics>>>>
+        jsonPathBlockMetrics_;
     mutable std::shared_mutex mutex_;
 };
 }  // namespace milvus
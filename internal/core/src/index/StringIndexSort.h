@@ -39,19 +39,14 @@ class StringIndexSort : public ScalarIndexSort<std::string> {
 
     const TargetBitmap
     PrefixMatch(std::string_view prefix) {
-        auto data = GetData();
-        TargetBitmap bitset(data.size());
-        auto it = std::lower_bound(
-            data.begin(),
-            data.end(),
-            prefix,
-            [](const IndexStructure<std::string>& value,
-               std::string_view prefix) { return value.a_ < prefix; });
-        for (; it != data.end(); ++it) {
-            if (!milvus::PrefixMatch(it->a_, prefix)) {
+        TargetBitmap bitset(Count());
+        auto num_values = static_cast<size_t>(Size());
+        for (auto pos = LowerBound(std::string(prefix)); pos < num_values;
+             ++pos) {
+            if (!milvus::PrefixMatch(ValueAt(pos), prefix)) {
                 break;
             }
-            bitset[it->idx_] = true;
+            bitset[RowIdAt(pos)] = true;
         }
         return bitset;
     }
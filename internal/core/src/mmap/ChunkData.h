@@ -194,22 +194,33 @@ VariableLengthChunk<Array>::set(const Array* src,
         length,
         begin,
         size_);
+    // layout of each row: |element offsets|data|, element offsets are only
+    // written for variable length element types and read in place by views.
     size_t total_size = 0;
-    size_t padding_size = 0;
     for (auto i = 0; i < length; i++) {
-        total_size += src[i].byte_size() + padding_size;
+        total_size += src[i].get_offsets().size() * sizeof(uint64_t) +
+                      src[i].byte_size();
     }
     auto buf = (char*)mcm->Allocate(mmap_descriptor_, total_size);
     AssertInfo(buf != nullptr, "failed to allocate memory from mmap_manager.");
-    for (auto i = 0, offset = 0; i < length; i++) {
-        auto data_size = src[i].byte_size() + padding_size;
-        char* data_ptr = buf + offset;
+    for (size_t i = 0, offset = 0; i < length; i++) {
+        const auto& element_offsets = src[i].get_offsets();
+        auto offsets_bytes_len = element_offsets.size() * sizeof(uint64_t);
+        char* offsets_ptr = buf + offset;
+        std::copy_n(reinterpret_cast<const char*>(element_offsets.data()),
+                    offsets_bytes_len,
+                    offsets_ptr);
+        char* data_ptr = offsets_ptr + offsets_bytes_len;
         std::copy(src[i].data(), src[i].data() + src[i].byte_size(), data_ptr);
-        data_[i + begin] = ArrayView(data_ptr,
-                                     data_size,
-                                     src[i].get_element_type(),
-                                     src[i].get_offsets_in_copy());
-        offset += data_size;
+        data_[i + begin] =
+            ArrayView(data_ptr,
+                      src[i].length(),
+                      src[i].byte_size(),
+                      src[i].get_element_type(),
+                      element_offsets.empty()
+                          ? nullptr
+                          : reinterpret_cast<const uint64_t*>(offsets_ptr));
+        offset += offsets_bytes_len + src[i].byte_size();
     }
 }
 
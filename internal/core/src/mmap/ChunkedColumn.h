@@ -77,6 +77,38 @@ class ChunkedColumnBase : public ColumnBase {
         return chunks_[chunk_id]->ValueAt(offset_in_chunk);
     };
 
+    const char*
+    ChunkValueAt(int64_t chunk_id, int64_t offset_in_chunk) const {
+        return chunks_[chunk_id]->ValueAt(offset_in_chunk);
+    }
+
+    // calls fn(chunk_id, offset_in_chunk, i, length) for the runs of
+    // offsets[i, i + length) which are consecutive rows of a chunk. The
+    // chunk is only searched for when an offset leaves the previous one, so
+    // sorted offsets take a single pass.
+    template <typename Fn>
+    void
+    ForEachRun(const int64_t* offsets, int64_t count, Fn&& fn) const {
+        int64_t chunk_id = 0;
+        int64_t chunk_begin = 0;
+        int64_t chunk_end = 0;
+        for (int64_t i = 0; i < count;) {
+            auto offset = offsets[i];
+            if (offset < chunk_begin || offset >= chunk_end) {
+                chunk_id = GetChunkIDByOffset(offset).first;
+                chunk_begin = num_rows_until_chunk_[chunk_id];
+                chunk_end = chunk_begin + chunks_[chunk_id]->RowNums();
+            }
+            int64_t length = 1;
+            while (i + length < count && offset + length < chunk_end &&
+                   offsets[i + length] == offset + length) {
+                ++length;
+            }
+            fn(chunk_id, offset - chunk_begin, i, length);
+            i += length;
+        }
+    }
+
     // MmappedData() returns the mmaped address
     const char*
     MmappedData() const override {
@@ -155,6 +187,29 @@ class ChunkedColumnBase : public ColumnBase {
                   "StringViews only supported for VariableColumn");
     }
 
+    // values of rows in [start_offset, start_offset + length) of a chunk,
+    // second is the valid data of the rows, nullptr if not nullable
+    virtual std::pair<StringBatchView, const bool*>
+    StringBatch(int64_t chunk_id,
+                int64_t start_offset,
+                int64_t length,
+                std::vector<uint64_t>& offsets_buf) const {
+        PanicInfo(ErrorCode::Unsupported,
+                  "StringBatch only supported for VariableColumn");
+    }
+
+    virtual std::pair<std::vector<Json>, FixedVector<bool>>
+    JsonViews(int64_t chunk_id, int64_t start_offset, int64_t length) const {
+        PanicInfo(ErrorCode::Unsupported,
+                  "JsonViews only supported for VariableColumn<Json>");
+    }
+
+    virtual std::pair<std::vector<ArrayView>, FixedVector<bool>>
+    ArrayViews(int64_t chunk_id, int64_t start_offset, int64_t length) const {
+        PanicInfo(ErrorCode::Unsupported,
+                  "ArrayViews only supported for ArrayColumn");
+    }
+
     std::pair<size_t, size_t>
     GetChunkIDByOffset(int64_t offset) const {
         AssertInfo(offset < num_rows_,
@@ -328,6 +383,31 @@ class ChunkedVariableColumn : public ChunkedColumnBase {
             ->StringViews();
     }
 
+    std::pair<StringBatchView, const bool*>
+    StringBatch(int64_t chunk_id,
+                int64_t start_offset,
+                int64_t length,
+                std::vector<uint64_t>& offsets_buf) const override {
+        // offsets of string chunk are read in place, no need to use buffer
+        auto chunk = static_cast<StringChunk*>(chunks_[chunk_id].get());
+        auto valid_data = chunk->ValidData();
+        return {chunk->StringBatch(start_offset, length),
+                valid_data == nullptr ? nullptr : valid_data + start_offset};
+    }
+
+    std::pair<std::vector<Json>, FixedVector<bool>>
+    JsonViews(int64_t chunk_id,
+              int64_t start_offset,
+              int64_t length) const override {
+        if constexpr (std::is_same_v<T, Json>) {
+            return static_cast<JSONChunk*>(chunks_[chunk_id].get())
+                ->Views(start_offset, length);
+        } else {
+            PanicInfo(ErrorCode::Unsupported,
+                      "JsonViews only supported for VariableColumn<Json>");
+        }
+    }
+
     std::shared_ptr<Chunk>
     GetChunk(int64_t chunk_id) const {
         return chunks_[chunk_id];
@@ -369,6 +449,24 @@ class ChunkedVariableColumn : public ChunkedColumnBase {
     RawAt(const int i) const {
         return std::string_view((*this)[i]);
     }
+
+    // calls fn(i, value) for the raw values at offsets
+    template <typename Fn>
+    void
+    BulkRawAt(const int64_t* offsets, int64_t count, Fn&& fn) const {
+        ForEachRun(offsets,
+                   count,
+                   [&](int64_t chunk_id,
+                       int64_t offset_in_chunk,
+                       int64_t i,
+                       int64_t length) {
+                       auto chunk =
+                           static_cast<StringChunk*>(chunks_[chunk_id].get());
+                       for (int64_t j = 0; j < length; ++j) {
+                           fn(i + j, (*chunk)[offset_in_chunk + j]);
+                       }
+                   });
+    }
 };
 
 class ChunkedArrayColumn : public ChunkedColumnBase {
@@ -388,22 +486,48 @@ class ChunkedArrayColumn : public ChunkedColumnBase {
 
     SpanBase
     Span(int64_t chunk_id) const override {
-        return std::dynamic_pointer_cast<ArrayChunk>(chunks_[chunk_id])->Span();
+        PanicInfo(ErrorCode::NotImplemented,
+                  "span() interface is not implemented for array column, "
+                  "use ArrayViews() instead");
+    }
+
+    std::pair<std::vector<ArrayView>, FixedVector<bool>>
+    ArrayViews(int64_t chunk_id,
+               int64_t start_offset,
+               int64_t length) const override {
+        return static_cast<ArrayChunk*>(chunks_[chunk_id].get())
+            ->Views(start_offset, length);
     }
 
     ArrayView
     operator[](const int i) const {
         auto [chunk_id, offset_in_chunk] = GetChunkIDByOffset(i);
-        return std::dynamic_pointer_cast<ArrayChunk>(chunks_[chunk_id])
+        return static_cast<ArrayChunk*>(chunks_[chunk_id].get())
             ->View(offset_in_chunk);
     }
 
     ScalarArray
     RawAt(const int i) const {
-        auto [chunk_id, offset_in_chunk] = GetChunkIDByOffset(i);
-        return std::dynamic_pointer_cast<ArrayChunk>(chunks_[chunk_id])
-            ->View(offset_in_chunk)
-            .output_data();
+        return (*this)[i].output_data();
+    }
+
+    // calls fn(i, view) for the array views at offsets, the views read the
+    // elements and their offsets in place from the chunks
+    template <typename Fn>
+    void
+    BulkRawAt(const int64_t* offsets, int64_t count, Fn&& fn) const {
+        ForEachRun(offsets,
+                   count,
+                   [&](int64_t chunk_id,
+                       int64_t offset_in_chunk,
+                       int64_t i,
+                       int64_t length) {
+                       auto chunk =
+                           static_cast<ArrayChunk*>(chunks_[chunk_id].get());
+                       for (int64_t j = 0; j < length; ++j) {
+                           fn(i + j, chunk->View(offset_in_chunk + j));
+                       }
+                   });
     }
 };
 }  // namespace milvus
\ No newline at end of file
@@ -302,7 +302,7 @@ class SingleChunkColumnBase : public ColumnBase {
     }
 
     // returns the ballpark number of bytes used by this object
-    size_t
+    virtual size_t
     MemoryUsageBytes() const {
         return data_cap_size_ + padding_ + (valid_data_.size() + 7) / 8;
     }
@@ -323,6 +323,28 @@ class SingleChunkColumnBase : public ColumnBase {
                   "StringViews only supported for VariableColumn");
     }
 
+    // values of rows in [start_offset, start_offset + length), second is
+    // the valid data of the rows, nullptr if not nullable
+    virtual std::pair<StringBatchView, const bool*>
+    StringBatch(int64_t start_offset,
+                int64_t length,
+                std::vector<uint64_t>& offsets_buf) const {
+        PanicInfo(ErrorCode::Unsupported,
+                  "StringBatch only supported for VariableColumn");
+    }
+
+    virtual std::pair<std::vector<ArrayView>, FixedVector<bool>>
+    ArrayViews(int64_t start_offset, int64_t length) const {
+        PanicInfo(ErrorCode::Unsupported,
+                  "ArrayViews only supported for ArrayColumn");
+    }
+
+    virtual std::pair<std::vector<Json>, FixedVector<bool>>
+    JsonViews(int64_t start_offset, int64_t length) const {
+        PanicInfo(ErrorCode::Unsupported,
+                  "JsonViews only supported for VariableColumn<Json>");
+    }
+
     virtual void
     AppendBatch(const FieldDataPtr data) {
         size_t required_size = data_size_ + data->DataSize();
@@ -728,6 +750,86 @@ class SingleChunkVariableColumn : public SingleChunkColumnBase {
         return res;
     }
 
+    std::pair<StringBatchView, const bool*>
+    StringBatch(int64_t start_offset,
+                int64_t length,
+                std::vector<uint64_t>& offsets_buf) const override {
+        if (start_offset < 0 || start_offset > num_rows_ ||
+            start_offset + length > num_rows_) {
+            PanicInfo(ErrorCode::OutOfRange, "index out of range");
+        }
+
+        // rows are written as |size|data|size|data..., so the offset of
+        // the next row is exactly where the current value ends.
+        char* pos = data_ + indices_[start_offset / block_size_];
+        for (size_t j = 0; j < start_offset % block_size_; j++) {
+            uint32_t size;
+            size = *reinterpret_cast<uint32_t*>(pos);
+            pos += sizeof(uint32_t) + size;
+        }
+        offsets_buf.resize(length + 1);
+        for (int64_t j = 0; j < length; j++) {
+            offsets_buf[j] = pos - data_;
+            uint32_t size;
+            size = *reinterpret_cast<uint32_t*>(pos);
+            pos += sizeof(uint32_t) + size;
+        }
+        offsets_buf[length] = pos - data_;
+
+        const bool* valid_data =
+            nullable_ ? valid_data_.data() + start_offset : nullptr;
+        return {StringBatchView{data_, offsets_buf.data(), sizeof(uint32_t)},
+                valid_data};
+    }
+
+    std::pair<std::vector<Json>, FixedVector<bool>>
+    JsonViews(int64_t start_offset, int64_t length) const override {
+        if constexpr (std::is_same_v<T, Json>) {
+            if (start_offset < 0 || start_offset > num_rows_ ||
+                start_offset + length > num_rows_) {
+                PanicInfo(ErrorCode::OutOfRange, "index out of range");
+            }
+
+            char* pos = data_ + indices_[start_offset / block_size_];
+            for (size_t j = 0; j < start_offset % block_size_; j++) {
+                uint32_t size;
+                size = *reinterpret_cast<uint32_t*>(pos);
+                pos += sizeof(uint32_t) + size;
+            }
+
+            std::vector<Json> res;
+            res.reserve(length);
+            for (int64_t i = start_offset; i < start_offset + length; i++) {
+                uint32_t size;
+                size = *reinterpret_cast<uint32_t*>(pos);
+                pos += sizeof(uint32_t);
+                auto binary =
+                    json_binary_offsets_.empty() ||
+                            json_binary_offsets_[i + 1] ==
+                                json_binary_offsets_[i]
+                        ? nullptr
+                        : json_binary_.data() + json_binary_offsets_[i];
+                res.emplace_back(pos, size, binary);
+                pos += size;
+            }
+            FixedVector<bool> valid_data;
+            if (nullable_) {
+                valid_data.assign(valid_data_.begin() + start_offset,
+                                  valid_data_.begin() + start_offset + length);
+            }
+            return {std::move(res), std::move(valid_data)};
+        } else {
+            PanicInfo(ErrorCode::Unsupported,
+                      "JsonViews only supported for VariableColumn<Json>");
+        }
+    }
+
+    size_t
+    MemoryUsageBytes() const override {
+        return SingleChunkColumnBase::MemoryUsageBytes() + json_binary_.size() +
+               json_binary_offsets_.size() * sizeof(uint64_t);
+    }
+
     ViewType
     operator[](const int i) const {
         if (i < 0 || i > num_rows_) {
@@ -828,10 +930,36 @@ class SingleChunkVariableColumn : public SingleChunkColumnBase {
             }
         }
 
+        // the json binary is kept in memory, it's not built for columns
+        // mapped from file so that they don't pay it out of the mmap budget,
+        // their rows are parsed from the text instead.
+        if constexpr (std::is_same_v<T, Json>) {
+            if (mapping_type_ != MappingType::MAP_WITH_FILE) {
+                BuildJsonBinary();
+            }
+        }
         shrink_indice();
     }
 
  protected:
+    // pre-parse all rows into json binary (see JsonBinary.h), so that path
+    // lookups in expressions don't need to parse the text of every row
+    void
+    BuildJsonBinary() {
+        json_binary_offsets_.reserve(num_rows_ + 1);
+        char* pos = data_;
+        for (size_t i = 0; i < num_rows_; ++i) {
+            uint32_t size;
+            size = *reinterpret_cast<uint32_t*>(pos);
+            pos += sizeof(uint32_t);
+            json_binary_offsets_.push_back(json_binary_.size());
+            EncodeJsonBinary(std::string_view(pos, size), json_binary_);
+            pos += size;
+        }
+        json_binary_offsets_.push_back(json_binary_.size());
+        json_binary_.shrink_to_fit();
+    }
+
     void
     shrink_indice() {
         std::vector<uint64_t> tmp_indices;
@@ -851,6 +979,10 @@ class SingleChunkVariableColumn : public SingleChunkColumnBase {
     // raw data index, record indices located 0, block_size_, 2 * block_size_, 3 * block_size_
     size_t block_size_;
     std::vector<uint64_t> indices_{};
+    // json binary of all rows, empty for null or invalid rows, only for Json
+    // and not built for MAP_WITH_FILE columns
+    std::string json_binary_{};
+    std::vector<uint64_t> json_binary_offsets_{};
 };
 
 class SingleChunkArrayColumn : public SingleChunkColumnBase {
@@ -873,31 +1005,73 @@ class SingleChunkArrayColumn : public SingleChunkColumnBase {
 
     SpanBase
     Span() const override {
-        return SpanBase(views_.data(),
-                        valid_data_.data(),
-                        views_.size(),
-                        sizeof(ArrayView));
+        PanicInfo(ErrorCode::NotImplemented,
+                  "span() interface is not implemented for array column, "
+                  "use ArrayViews() instead");
     }
 
-    [[nodiscard]] const std::vector<ArrayView>&
-    Views() const {
-        return views_;
+    std::pair<std::vector<ArrayView>, FixedVector<bool>>
+    ArrayViews(int64_t start_offset, int64_t length) const override {
+        AssertInfo(start_offset >= 0 && start_offset + length <= num_rows_,
+                   "views out of range, start_offset={}, length={}, "
+                   "num_rows={}",
+                   start_offset,
+                   length,
+                   num_rows_);
+        std::vector<ArrayView> views;
+        views.reserve(length);
+        for (int64_t i = start_offset; i < start_offset + length; i++) {
+            views.emplace_back((*this)[i]);
+        }
+        FixedVector<bool> valid_data;
+        if (nullable_) {
+            valid_data.assign(valid_data_.begin() + start_offset,
+                              valid_data_.begin() + start_offset + length);
+        }
+        return {std::move(views), std::move(valid_data)};
     }
 
     ArrayView
     operator[](const int i) const {
-        return views_[i];
+        auto offset = indices_[i];
+        auto next_offset =
+            i + 1 == indices_.size() ? data_size_ : indices_[i + 1];
+        auto size = next_offset - offset;
+        auto element_begin = element_indices_[i];
+        auto len = element_indices_[i + 1] - element_begin;
+        if (!IsVariableDataType(element_type_)) {
+            // int8, int16, int32 are all promoted to int32
+            len = (element_type_ == DataType::INT8 ||
+                   element_type_ == DataType::INT16)
+                      ? size / sizeof(int32_t)
+                      : size / GetDataTypeSize(element_type_);
+        }
+        return ArrayView(data_ + offset,
+                         len,
+                         size,
+                         element_type_,
+                         element_offsets_.data() + element_begin);
     }
 
     ScalarArray
     RawAt(const int i) const {
-        return views_[i].output_data();
+        return (*this)[i].output_data();
+    }
+
+    // calls fn(i, view) for the array views at offsets, the views read the
+    // elements and their offsets in place from the column
+    template <typename Fn>
+    void
+    BulkRawAt(const int64_t* offsets, int64_t count, Fn&& fn) const {
+        for (int64_t i = 0; i < count; ++i) {
+            fn(i, (*this)[offsets[i]]);
+        }
     }
 
     void
     Append(const Array& array, bool valid_data = false) {
         indices_.emplace_back(data_size_);
-        element_indices_.emplace_back(array.get_offsets());
+        AppendElementOffsets(array);
         if (nullable_) {
             return SingleChunkColumnBase::Append(
                 static_cast<const char*>(array.data()),
@@ -908,39 +1082,41 @@ class SingleChunkArrayColumn : public SingleChunkColumnBase {
                                       array.byte_size());
     }
 
+    // element_offsets holds the element offsets of all rows back to back,
+    // element_indices[i] is where the offsets of row i begin in it.
     void
     Seal(std::vector<uint64_t>&& indices = {},
-         std::vector<std::vector<uint64_t>>&& element_indices = {}) {
+         std::vector<uint64_t>&& element_offsets = {},
+         std::vector<uint64_t>&& element_indices = {}) {
         if (!indices.empty()) {
             indices_ = std::move(indices);
+            element_offsets_ = std::move(element_offsets);
             element_indices_ = std::move(element_indices);
         }
         num_rows_ = indices_.size();
-        ConstructViews();
+        if (element_indices_.size() == num_rows_) {
+            element_indices_.push_back(element_offsets_.size());
+        }
+        indices_.shrink_to_fit();
+        element_offsets_.shrink_to_fit();
+        element_indices_.shrink_to_fit();
     }
 
- protected:
+ private:
     void
-    ConstructViews() {
-        views_.reserve(indices_.size());
-        for (size_t i = 0; i < indices_.size() - 1; i++) {
-            views_.emplace_back(data_ + indices_[i],
-                                indices_[i + 1] - indices_[i],
-                                element_type_,
-                                std::move(element_indices_[i]));
-        }
-        views_.emplace_back(data_ + indices_.back(),
-                            data_size_ - indices_.back(),
-                            element_type_,
-                            std::move(element_indices_[indices_.size() - 1]));
-        element_indices_.clear();
+    AppendElementOffsets(const Array& array) {
+        element_indices_.emplace_back(element_offsets_.size());
+        const auto& offsets = array.get_offsets();
+        element_offsets_.insert(
+            element_offsets_.end(), offsets.begin(), offsets.end());
     }
 
  private:
     std::vector<uint64_t> indices_{};
-    std::vector<std::vector<uint64_t>> element_indices_{};
-    // Compatible with current Span type
-    std::vector<ArrayView> views_{};
+    // element offsets of variable length elements, stored in a flat way to
+    // avoid an allocation per row.
+    std::vector<uint64_t> element_offsets_{};
+    std::vector<uint64_t> element_indices_{};
     DataType element_type_;
 };
 }  // namespace milvus
\ No newline at end of file
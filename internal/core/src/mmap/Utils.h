@@ -90,7 +90,8 @@ WriteFieldData(File& file,
                const FieldDataPtr& data,
                uint64_t& total_written,
                std::vector<uint64_t>& indices,
-               std::vector<std::vector<uint64_t>>& element_indices,
+               std::vector<uint64_t>& element_offsets,
+               std::vector<uint64_t>& element_indices,
                FixedVector<bool>& valid_data) {
     if (IsVariableDataType(data_type)) {
         switch (data_type) {
@@ -146,7 +147,10 @@ WriteFieldData(File& file,
                     if (written < array->byte_size()) {
                         THROW_FILE_WRITE_ERROR
                     }
-                    element_indices.emplace_back(array->get_offsets());
+                    element_indices.emplace_back(element_offsets.size());
+                    element_offsets.insert(element_offsets.end(),
+                                           array->get_offsets().begin(),
+                                           array->get_offsets().end());
                     total_written += written;
                 }
                 break;
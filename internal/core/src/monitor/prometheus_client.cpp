@@ -158,6 +158,8 @@ std::map<std::string, std::string> writeDiskDurationLabels{
     {"type", "write_disk"}};
 std::map<std::string, std::string> deserializeDurationLabels{
     {"type", "deserialize"}};
+std::map<std::string, std::string> waitMemoryDurationLabels{
+    {"type", "wait_memory"}};
 DEFINE_PROMETHEUS_HISTOGRAM_FAMILY(internal_storage_load_duration,
                                    "[cpp]durations of load segment")
 DEFINE_PROMETHEUS_HISTOGRAM(internal_storage_download_duration,
@@ -169,6 +171,22 @@ DEFINE_PROMETHEUS_HISTOGRAM(internal_storage_write_disk_duration,
 DEFINE_PROMETHEUS_HISTOGRAM(internal_storage_deserialize_duration,
                             internal_storage_load_duration,
                             deserializeDurationLabels)
+DEFINE_PROMETHEUS_HISTOGRAM(internal_storage_wait_memory_duration,
+                            internal_storage_load_duration,
+                            waitMemoryDurationLabels)
+std::map<std::string, std::string> loadMemoryReservedLabels{
+    {"type", "reserved_bytes"}};
+std::map<std::string, std::string> loadMemoryWaitingLabels{
+    {"type", "waiting_requests"}};
+DEFINE_PROMETHEUS_GAUGE_FAMILY(
+    internal_storage_load_memory,
+    "[cpp]memory reserved by and requests waiting for the load governor")
+DEFINE_PROMETHEUS_GAUGE(internal_storage_load_memory_reserved,
+                        internal_storage_load_memory,
+                        loadMemoryReservedLabels)
+DEFINE_PROMETHEUS_GAUGE(internal_storage_load_memory_waiting,
+                        internal_storage_load_memory,
+                        loadMemoryWaitingLabels)
 
 // search latency metrics
 std::map<std::string, std::string> scalarLatencyLabels{
@@ -195,6 +213,51 @@ DEFINE_PROMETHEUS_HISTOGRAM_WITH_BUCKETS(
     internal_core_search_latency,
     scalarProportionLabels,
     ratioBuckets)
+std::map<std::string, std::string> indexStrategyLabels{{"strategy", "index"}};
+std::map<std::string, std::string> bruteForceStrategyLabels{
+    {"strategy", "brute_force"}};
+DEFINE_PROMETHEUS_COUNTER_FAMILY(
+    internal_core_search_strategy,
+    "[cpp]number of searches on indexed segments by strategy")
+DEFINE_PROMETHEUS_COUNTER(internal_core_search_strategy_index,
+                          internal_core_search_strategy,
+                          indexStrategyLabels)
+DEFINE_PROMETHEUS_COUNTER(internal_core_search_strategy_brute_force,
+                          internal_core_search_strategy,
+                          bruteForceStrategyLabels)
+std::map<std::string, std::string> filterCacheHitLabels{{"result", "hit"}};
+std::map<std::string, std::string> filterCacheMissLabels{{"result", "miss"}};
+DEFINE_PROMETHEUS_COUNTER_FAMILY(
+    internal_core_filter_cache_requests,
+    "[cpp]number of lookups of the filter result cache by result")
+DEFINE_PROMETHEUS_COUNTER(internal_core_filter_cache_requests_hit,
+                          internal_core_filter_cache_requests,
+                          filterCacheHitLabels)
+DEFINE_PROMETHEUS_COUNTER(internal_core_filter_cache_requests_miss,
+                          internal_core_filter_cache_requests,
+                          filterCacheMissLabels)
+DEFINE_PROMETHEUS_GAUGE_FAMILY(internal_core_filter_cache_bytes,
+                               "[cpp]memory held by the filter result cache")
+DEFINE_PROMETHEUS_GAUGE(internal_core_filter_cache_bytes_used,
+                        internal_core_filter_cache_bytes,
+                        {})
+
+// retrieve cursor metrics
+DEFINE_PROMETHEUS_COUNTER_FAMILY(
+    internal_core_retrieve_cursor_requests,
+    "[cpp]number of lookups of the cursors of paged retrieves by result")
+DEFINE_PROMETHEUS_COUNTER(internal_core_retrieve_cursor_requests_hit,
+                          internal_core_retrieve_cursor_requests,
+                          filterCacheHitLabels)
+DEFINE_PROMETHEUS_COUNTER(internal_core_retrieve_cursor_requests_miss,
+                          internal_core_retrieve_cursor_requests,
+                          filterCacheMissLabels)
+DEFINE_PROMETHEUS_GAUGE_FAMILY(
+    internal_core_retrieve_cursor_bytes,
+    "[cpp]memory held by the cursors of paged retrieves")
+DEFINE_PROMETHEUS_GAUGE(internal_core_retrieve_cursor_bytes_used,
+                        internal_core_retrieve_cursor_bytes,
+                        {})
 
 // mmap metrics
 std::map<std::string, std::string> mmapAllocatedSpaceAnonLabel = {
@@ -223,4 +286,31 @@ DEFINE_PROMETHEUS_GAUGE(internal_mmap_in_used_space_bytes_anon,
 DEFINE_PROMETHEUS_GAUGE(internal_mmap_in_used_space_bytes_file,
                         internal_mmap_in_used_space_bytes,
                         mmapAllocatedSpaceFileLabel)
+
+// cancelled operation metrics
+std::map<std::string, std::string> cancelLabels{{"reason", "cancel"}};
+std::map<std::string, std::string> deadlineLabels{{"reason", "deadline"}};
+std::map<std::string, std::string> estimatedLabels{{"type", "estimated"}};
+DEFINE_PROMETHEUS_COUNTER_FAMILY(
+    internal_core_cancelled_op_count,
+    "[cpp]number of operations stopped by cancellation")
+DEFINE_PROMETHEUS_COUNTER(internal_core_cancelled_op_count_cancel,
+                          internal_core_cancelled_op_count,
+                          cancelLabels)
+DEFINE_PROMETHEUS_COUNTER(internal_core_cancelled_op_count_deadline,
+                          internal_core_cancelled_op_count,
+                          deadlineLabels)
+DEFINE_PROMETHEUS_COUNTER_FAMILY(
+    internal_core_cancelled_op_saved_cpu,
+    "[cpp]cpu time(ms) saved by stopping cancelled operations")
+DEFINE_PROMETHEUS_COUNTER(internal_core_cancelled_op_saved_cpu_ms,
+                          internal_core_cancelled_op_saved_cpu,
+                          estimatedLabels)
+
+// thread pool metrics
+DEFINE_PROMETHEUS_GAUGE_FAMILY(internal_thread_pool_queue_depth,
+                               "[cpp]number of tasks waiting in thread pool")
+DEFINE_PROMETHEUS_HISTOGRAM_FAMILY(
+    internal_thread_pool_wait_latency,
+    "[cpp]latency(ms) of tasks waiting in thread pool")
 }  // namespace milvus::monitor
@@ -119,6 +119,10 @@ DECLARE_PROMETHEUS_HISTOGRAM_FAMILY(internal_storage_load_duration);
 DECLARE_PROMETHEUS_HISTOGRAM(internal_storage_download_duration);
 DECLARE_PROMETHEUS_HISTOGRAM(internal_storage_write_disk_duration);
 DECLARE_PROMETHEUS_HISTOGRAM(internal_storage_deserialize_duration);
+DECLARE_PROMETHEUS_HISTOGRAM(internal_storage_wait_memory_duration);
+DECLARE_PROMETHEUS_GAUGE_FAMILY(internal_storage_load_memory);
+DECLARE_PROMETHEUS_GAUGE(internal_storage_load_memory_reserved);
+DECLARE_PROMETHEUS_GAUGE(internal_storage_load_memory_waiting);
 
 // mmap metrics
 DECLARE_PROMETHEUS_HISTOGRAM_FAMILY(internal_mmap_allocated_space_bytes);
@@ -134,5 +138,29 @@ DECLARE_PROMETHEUS_HISTOGRAM(internal_core_search_latency_scalar);
 DECLARE_PROMETHEUS_HISTOGRAM(internal_core_search_latency_vector);
 DECLARE_PROMETHEUS_HISTOGRAM(internal_core_search_latency_groupby);
 DECLARE_PROMETHEUS_HISTOGRAM(internal_core_search_latency_scalar_proportion);
+DECLARE_PROMETHEUS_COUNTER_FAMILY(internal_core_search_strategy);
+DECLARE_PROMETHEUS_COUNTER(internal_core_search_strategy_index);
+DECLARE_PROMETHEUS_COUNTER(internal_core_search_strategy_brute_force);
+DECLARE_PROMETHEUS_COUNTER_FAMILY(internal_core_filter_cache_requests);
+DECLARE_PROMETHEUS_COUNTER(internal_core_filter_cache_requests_hit);
+DECLARE_PROMETHEUS_COUNTER(internal_core_filter_cache_requests_miss);
+DECLARE_PROMETHEUS_GAUGE_FAMILY(internal_core_filter_cache_bytes);
+DECLARE_PROMETHEUS_GAUGE(internal_core_filter_cache_bytes_used);
+DECLARE_PROMETHEUS_COUNTER_FAMILY(internal_core_retrieve_cursor_requests);
+DECLARE_PROMETHEUS_COUNTER(internal_core_retrieve_cursor_requests_hit);
+DECLARE_PROMETHEUS_COUNTER(internal_core_retrieve_cursor_requests_miss);
+DECLARE_PROMETHEUS_GAUGE_FAMILY(internal_core_retrieve_cursor_bytes);
+DECLARE_PROMETHEUS_GAUGE(internal_core_retrieve_cursor_bytes_used);
+
+// cancelled operation metrics
+DECLARE_PROMETHEUS_COUNTER_FAMILY(internal_core_cancelled_op_count);
+DECLARE_PROMETHEUS_COUNTER(internal_core_cancelled_op_count_cancel);
+DECLARE_PROMETHEUS_COUNTER(internal_core_cancelled_op_count_deadline);
+DECLARE_PROMETHEUS_COUNTER_FAMILY(internal_core_cancelled_op_saved_cpu);
+DECLARE_PROMETHEUS_COUNTER(internal_core_cancelled_op_saved_cpu_ms);
+
+// thread pool metrics, labeled by the name of the pool
+DECLARE_PROMETHEUS_GAUGE_FAMILY(internal_thread_pool_queue_depth_family);
+DECLARE_PROMETHEUS_HISTOGRAM_FAMILY(internal_thread_pool_wait_latency_family);
 
 }  // namespace milvus::monitor
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -399,6 +400,92 @@ class CountNode : public PlanNode {
     const std::vector<PlanNodePtr> sources_;
 };
 
+enum class AggregateOp {
+    kCount,
+    kSum,
+    kMin,
+    kMax,
+    kAvg,
+    kCountDistinct,
+};
+
+struct Aggregate {
+    AggregateOp op_;
+    // std::nullopt for count(*)
+    std::optional<FieldId> field_id_;
+    // data type of the aggregated field, NONE for count(*)
+    DataType data_type_{DataType::NONE};
+};
+
+/**
+ * @brief Computes the aggregates of the rows passing the filter on the
+ * segment, by groups of the group by fields if any. The output is a partial
+ * aggregate, merged with the ones of the other segments in reduce.
+ */
+class AggregationNode : public PlanNode {
+ public:
+    AggregationNode(
+        const PlanNodeId& id,
+        std::vector<Aggregate> aggregates,
+        std::vector<FieldId> group_by_field_ids,
+        std::vector<DataType> group_by_data_types,
+        std::vector<PlanNodePtr> sources = std::vector<PlanNodePtr>{})
+        : PlanNode(id),
+          aggregates_(std::move(aggregates)),
+          group_by_field_ids_(std::move(group_by_field_ids)),
+          group_by_data_types_(std::move(group_by_data_types)),
+          sources_{std::move(sources)} {
+        AssertInfo(group_by_field_ids_.size() == group_by_data_types_.size(),
+                   "unaligned group by fields and data types");
+    }
+
+    DataType
+    output_type() const override {
+        return DataType::NONE;
+    }
+
+    std::vector<PlanNodePtr>
+    sources() const override {
+        return sources_;
+    }
+
+    const std::vector<Aggregate>&
+    aggregates() const {
+        return aggregates_;
+    }
+
+    const std::vector<FieldId>&
+    group_by_field_ids() const {
+        return group_by_field_ids_;
+    }
+
+    const std::vector<DataType>&
+    group_by_data_types() const {
+        return group_by_data_types_;
+    }
+
+    std::string_view
+    name() const override {
+        return "AggregationNode";
+    }
+
+    std::string
+    ToString() const override {
+        return fmt::format(
+            "AggregationNode:[aggregates:{}, group by fields:{}]\n\t[source "
+            "node:{}]",
+            aggregates_.size(),
+            group_by_field_ids_.size(),
+            SourceToString());
+    }
+
+ private:
+    const std::vector<Aggregate> aggregates_;
+    const std::vector<FieldId> group_by_field_ids_;
+    const std::vector<DataType> group_by_data_types_;
+    const std::vector<PlanNodePtr> sources_;
+};
+
 enum class ExecutionStrategy {
     // Process splits as they come in any available driver.
     kUngrouped,
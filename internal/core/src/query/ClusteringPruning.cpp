@@ -0,0 +1,348 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "query/ClusteringPruning.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+#include "common/Consts.h"
+#include "common/EasyAssert.h"
+#include "common/Utils.h"
+#include "query/SearchBruteForce.h"
+#include "query/SubSearchResult.h"
+
+namespace milvus::query {
+
+namespace {
+
+float
+InnerProduct(const float* x, const float* y, int64_t dim) {
+    float sum = 0;
+    for (int64_t i = 0; i < dim; ++i) {
+        sum += x[i] * y[i];
+    }
+    return sum;
+}
+
+float
+L2Distance(const float* x, const float* y, int64_t dim) {
+    float sum = 0;
+    for (int64_t i = 0; i < dim; ++i) {
+        auto diff = x[i] - y[i];
+        sum += diff * diff;
+    }
+    return std::sqrt(sum);
+}
+
+// the search can be pruned by the clusters
+bool
+CanPrune(const Schema& schema, const SearchInfo& search_info) {
+    auto& metric_type = search_info.metric_type_;
+    return schema[search_info.field_id_].get_data_type() ==
+               DataType::VECTOR_FLOAT &&
+           (metric_type == knowhere::metric::L2 ||
+            metric_type == knowhere::metric::IP) &&
+           !search_info.group_by_field_id_.has_value() &&
+           !search_info.search_params_.contains(RADIUS);
+}
+
+// the number of the clusters a search visits at most
+int64_t
+MaxProbes(const SearchInfo& search_info, int64_t num_clusters) {
+    auto probe_ratio = 1.0;
+    if (search_info.search_params_.contains(CLUSTER_PROBE_RATIO)) {
+        auto& param = search_info.search_params_[CLUSTER_PROBE_RATIO];
+        if (param.is_number()) {
+            probe_ratio = param.get<double>();
+        } else if (param.is_string()) {
+            try {
+                probe_ratio = std::stod(param.get<std::string>());
+            } catch (std::exception&) {
+                PanicInfo(ConfigInvalid,
+                          "{} should be a number, but got {}",
+                          CLUSTER_PROBE_RATIO,
+                          param.dump());
+            }
+        } else {
+            PanicInfo(ConfigInvalid,
+                      "{} should be a number, but got {}",
+                      CLUSTER_PROBE_RATIO,
+                      param.dump());
+        }
+        AssertInfo(probe_ratio > 0 && probe_ratio <= 1,
+                   "{} should be in (0, 1], but got {}",
+                   CLUSTER_PROBE_RATIO,
+                   probe_ratio);
+    }
+    return std::max<int64_t>(
+        1, static_cast<int64_t>(std::ceil(probe_ratio * num_clusters)));
+}
+
+}  // namespace
+
+ClusteringCentroidsPtr
+BuildClusteringCentroids(
+    const proto::clustering::ClusteringCentroidsStats& centroids,
+    const proto::clustering::ClusteringCentroidIdMappingStats& id_mapping,
+    int64_t dim,
+    int64_t num_rows,
+    const VectorAt& vector_at) {
+    int64_t num_clusters = centroids.centroids_size();
+    AssertInfo(num_clusters > 0, "no clustering centroid");
+    AssertInfo(id_mapping.centroid_id_mapping_size() == num_rows,
+               "clustering id mapping of {} rows for a segment of {} rows",
+               id_mapping.centroid_id_mapping_size(),
+               num_rows);
+
+    auto clusters = std::make_shared<ClusteringCentroids>();
+    clusters->dim_ = dim;
+    clusters->centroids_.reserve(num_clusters * dim);
+    for (auto& centroid : centroids.centroids()) {
+        auto& data = centroid.float_vector().data();
+        AssertInfo(centroid.dim() == dim && data.size() == dim,
+                   "clustering centroid of dim {} for a field of dim {}",
+                   centroid.dim(),
+                   dim);
+        clusters->centroids_.insert(
+            clusters->centroids_.end(), data.begin(), data.end());
+    }
+
+    if (vector_at) {
+        clusters->radii_.resize(num_clusters, 0);
+    }
+    clusters->rows_.resize(num_clusters);
+    for (int64_t i = 0; i < num_rows; ++i) {
+        int64_t cluster = id_mapping.centroid_id_mapping(i);
+        AssertInfo(cluster < num_clusters,
+                   "row {} mapped to centroid {} of {}",
+                   i,
+                   cluster,
+                   num_clusters);
+        clusters->rows_[cluster].push_back(i);
+        if (!vector_at) {
+            continue;
+        }
+        auto distance = L2Distance(vector_at(i),
+                                   clusters->centroids_.data() + cluster * dim,
+                                   dim);
+        auto& radius = clusters->radii_[cluster];
+        radius = std::max(radius, distance);
+    }
+    // padded for the rounding of the distances of the search kernels, so a
+    // cluster is never skipped for a row it holds
+    for (auto& radius : clusters->radii_) {
+        radius = radius * (1 + 1e-4f) + 1e-6f;
+    }
+    return clusters;
+}
+
+bool
+SearchOnSealedClusters(const Schema& schema,
+                       const ClusteringCentroids& clusters,
+                       const VectorAt& vector_at,
+                       const SearchInfo& search_info,
+                       const void* query_data,
+                       int64_t num_queries,
+                       const BitsetView& bitset,
+                       SearchResult& result) {
+    if (!CanPrune(schema, search_info) || clusters.radii_.empty()) {
+        return false;
+    }
+    auto& metric_type = search_info.metric_type_;
+    auto is_l2 = metric_type == knowhere::metric::L2;
+    auto dim = clusters.dim_;
+    auto topk = search_info.topk_;
+    auto num_clusters = clusters.num_clusters();
+    auto queries = static_cast<const float*>(query_data);
+
+    // the best distance a row of a cluster may have to a query, the
+    // squared distance for L2 as the search kernels return, and the best of
+    // them over the queries per cluster
+    std::vector<float> bounds(num_queries * num_clusters);
+    std::vector<float> best_bounds(num_clusters,
+                                   SubSearchResult::init_value(metric_type));
+    for (int64_t q = 0; q < num_queries; ++q) {
+        auto query = queries + q * dim;
+        auto query_norm = std::sqrt(InnerProduct(query, query, dim));
+        for (int64_t c = 0; c < num_clusters; ++c) {
+            auto centroid = clusters.centroids_.data() + c * dim;
+            auto radius = clusters.radii_[c];
+            float bound;
+            if (is_l2) {
+                auto distance = std::max(
+                    0.0f, L2Distance(query, centroid, dim) - radius);
+                bound = distance * distance;
+                best_bounds[c] = std::min(best_bounds[c], bound);
+            } else {
+                bound =
+                    InnerProduct(query, centroid, dim) + query_norm * radius;
+                best_bounds[c] = std::max(best_bounds[c], bound);
+            }
+            bounds[q * num_clusters + c] = bound;
+        }
+    }
+    std::vector<int64_t> order(num_clusters);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](int64_t x, int64_t y) {
+        return is_l2 ? best_bounds[x] < best_bounds[y]
+                     : best_bounds[x] > best_bounds[y];
+    });
+
+    auto max_probes = MaxProbes(search_info, num_clusters);
+
+    // the rounding of the distances is left to the final result, so the
+    // bounds are compared with the exact distances
+    dataset::SearchDataset dataset{
+        metric_type, num_queries, topk, -1, dim, query_data};
+    SubSearchResult final_qr(
+        num_queries, topk, metric_type, search_info.round_decimal_);
+    // every query has its top k and the k-th of them is at least as good as
+    // any row of the cluster
+    auto can_skip = [&](int64_t cluster) {
+        for (int64_t q = 0; q < num_queries; ++q) {
+            auto kth = q * topk + topk - 1;
+            if (final_qr.get_ids()[kth] == INVALID_SEG_OFFSET) {
+                return false;
+            }
+            auto distance = final_qr.get_distances()[kth];
+            auto bound = bounds[q * num_clusters + cluster];
+            if (is_l2 ? distance > bound : distance < bound) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    std::vector<int64_t> offsets;
+    std::vector<float> vectors;
+    int64_t num_probes = 0;
+    for (auto cluster : order) {
+        if (num_probes == max_probes) {
+            break;
+        }
+        CheckCancellation(search_info.op_context_,
+                          double(num_probes) / max_probes);
+        if (can_skip(cluster)) {
+            continue;
+        }
+        ++num_probes;
+        offsets.clear();
+        for (auto row : clusters.rows_[cluster]) {
+            if (bitset.empty() || !bitset.test(row)) {
+                offsets.push_back(row);
+            }
+        }
+        if (offsets.empty()) {
+            continue;
+        }
+        vectors.resize(offsets.size() * dim);
+        for (size_t i = 0; i < offsets.size(); ++i) {
+            std::memcpy(vectors.data() + i * dim,
+                        vector_at(offsets[i]),
+                        dim * sizeof(float));
+        }
+        auto sub_qr = BruteForceSearch(dataset,
+                                       vectors.data(),
+                                       offsets.size(),
+                                       search_info,
+                                       BitsetView(),
+                                       DataType::VECTOR_FLOAT);
+        for (auto& o : sub_qr.mutable_seg_offsets()) {
+            if (o != INVALID_SEG_OFFSET) {
+                o = offsets[o];
+            }
+        }
+        final_qr.merge(sub_qr);
+    }
+    final_qr.round_values();
+
+    result.distances_ = std::move(final_qr.mutable_distances());
+    result.seg_offsets_ = std::move(final_qr.mutable_seg_offsets());
+    result.unity_topK_ = topk;
+    result.total_nq_ = num_queries;
+    return true;
+}
+
+bool
+FilterUnprobedClusters(const Schema& schema,
+                       const ClusteringCentroids& clusters,
+                       const SearchInfo& search_info,
+                       const void* query_data,
+                       int64_t num_queries,
+                       int64_t num_rows,
+                       const BitsetView& bitset,
+                       BitsetType& filtered) {
+    if (!CanPrune(schema, search_info)) {
+        return false;
+    }
+    auto num_clusters = clusters.num_clusters();
+    auto max_probes = MaxProbes(search_info, num_clusters);
+    if (max_probes >= num_clusters) {
+        return false;
+    }
+    auto dim = clusters.dim_;
+    auto is_l2 = search_info.metric_type_ == knowhere::metric::L2;
+    auto queries = static_cast<const float*>(query_data);
+
+    std::vector<bool> probed(num_clusters, false);
+    std::vector<float> distances(num_clusters);
+    std::vector<int64_t> order(num_clusters);
+    for (int64_t q = 0; q < num_queries; ++q) {
+        auto query = queries + q * dim;
+        for (int64_t c = 0; c < num_clusters; ++c) {
+            auto centroid = clusters.centroids_.data() + c * dim;
+            distances[c] = is_l2 ? L2Distance(query, centroid, dim)
+                                 : -InnerProduct(query, centroid, dim);
+        }
+        std::iota(order.begin(), order.end(), 0);
+        std::partial_sort(order.begin(),
+                          order.begin() + max_probes,
+                          order.end(),
+                          [&](int64_t x, int64_t y) {
+                              return distances[x] < distances[y];
+                          });
+        for (int64_t i = 0; i < max_probes; ++i) {
+            probed[order[i]] = true;
+        }
+    }
+    if (std::find(probed.begin(), probed.end(), false) == probed.end()) {
+        return false;
+    }
+
+    filtered.resize(num_rows);
+    filtered.reset();
+    if (!bitset.empty()) {
+        AssertInfo(bitset.size() == num_rows,
+                   "bitset of {} rows for a search of {} rows",
+                   bitset.size(),
+                   num_rows);
+        for (int64_t i = 0; i < num_rows; ++i) {
+            if (bitset.test(i)) {
+                filtered.set(i);
+            }
+        }
+    }
+    for (int64_t c = 0; c < num_clusters; ++c) {
+        if (!probed[c]) {
+            for (auto row : clusters.rows_[c]) {
+                if (row < num_rows) {
+                    filtered.set(row);
+                }
+            }
+        }
+    }
+    return true;
+}
+
+}  // namespace milvus::query
@@ -0,0 +1,110 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "common/BitsetView.h"
+#include "common/QueryInfo.h"
+#include "common/QueryResult.h"
+#include "common/Schema.h"
+#include "pb/clustering.pb.h"
+
+namespace milvus::query {
+
+// search param of the ratio of the clusters of a segment a search visits at
+// most, 1 by default, which returns the exact results
+constexpr const char* CLUSTER_PROBE_RATIO = "cluster_probe_ratio";
+
+// The clusters of the rows of a float vector field of a sealed segment as
+// trained by clustering compaction, every row belongs to the cluster of its
+// nearest centroid.
+struct ClusteringCentroids {
+    int64_t dim_;
+    // num_clusters * dim
+    std::vector<float> centroids_;
+    // largest L2 distance of the rows of a cluster to its centroid, empty if
+    // the clusters were built without the raw vectors
+    std::vector<float> radii_;
+    // offsets of the rows of every cluster
+    std::vector<std::vector<int64_t>> rows_;
+
+    int64_t
+    num_clusters() const {
+        return rows_.size();
+    }
+
+    // memory taken by the clusters, the row offsets take 8 bytes per row
+    int64_t
+    ByteSize() const {
+        int64_t size = (centroids_.capacity() + radii_.capacity()) *
+                           sizeof(float) +
+                       rows_.capacity() * sizeof(std::vector<int64_t>);
+        for (auto& rows : rows_) {
+            size += rows.capacity() * sizeof(int64_t);
+        }
+        return size;
+    }
+};
+
+using ClusteringCentroidsPtr = std::shared_ptr<const ClusteringCentroids>;
+
+// returns the vector of the row at an offset
+using VectorAt = std::function<const float*(int64_t)>;
+
+// Builds the clusters of the num_rows rows of a segment from the centroids
+// and the id mapping of the segment uploaded by clustering compaction. The
+// radii are left empty if vector_at is empty, i.e. the field is only loaded
+// as an index.
+ClusteringCentroidsPtr
+BuildClusteringCentroids(
+    const proto::clustering::ClusteringCentroidsStats& centroids,
+    const proto::clustering::ClusteringCentroidIdMappingStats& id_mapping,
+    int64_t dim,
+    int64_t num_rows,
+    const VectorAt& vector_at);
+
+// Searches the raw vectors of a sealed segment cluster by cluster, in the
+// order of the bound of the distances of their rows to the queries given by
+// the centroids and radii, skipping the clusters which can't hold a row
+// closer than the top k found so far. Returns false without searching if the
+// search can't be pruned so, i.e. for other than L2 and IP searches on float
+// vectors, range and group by searches, or clusters without radii.
+bool
+SearchOnSealedClusters(const Schema& schema,
+                       const ClusteringCentroids& clusters,
+                       const VectorAt& vector_at,
+                       const SearchInfo& search_info,
+                       const void* query_data,
+                       int64_t num_queries,
+                       const BitsetView& bitset,
+                       SearchResult& result);
+
+// An index can't skip the clusters by their bounds, so a search on an index
+// or an interim index only visits the clusters of the nearest centroids of
+// every query, as many as the cluster_probe_ratio of the search allows.
+// Filters the rows of the other clusters into filtered, a copy of bitset of
+// num_rows rows. Returns false if no cluster is filtered out, i.e. for the
+// searches the clusters don't prune and a probe ratio of 1.
+bool
+FilterUnprobedClusters(const Schema& schema,
+                       const ClusteringCentroids& clusters,
+                       const SearchInfo& search_info,
+                       const void* query_data,
+                       int64_t num_queries,
+                       int64_t num_rows,
+                       const BitsetView& bitset,
+                       BitsetType& filtered);
+
+}  // namespace milvus::query
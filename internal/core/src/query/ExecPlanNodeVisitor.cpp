@@ -23,6 +23,7 @@
 #include "log/Log.h"
 #include "plan/PlanNode.h"
 #include "exec/Task.h"
+#include "exec/operator/aggregate/AggregateTable.h"
 #include "segcore/SegmentInterface.h"
 #include "common/Tracer.h"
 namespace milvus::query {
@@ -72,6 +73,17 @@ empty_search_result(int64_t num_queries) {
     return final_result;
 }
 
+// the config of the query of a plan node, profiled if the plan asks for it
+static std::shared_ptr<milvus::exec::QueryConfig>
+MakeQueryConfig(const PlanNode& node) {
+    if (!node.profile_) {
+        return std::make_shared<milvus::exec::QueryConfig>();
+    }
+    return std::make_shared<milvus::exec::QueryConfig>(
+        std::unordered_map<std::string, std::string>{
+            {milvus::exec::QueryConfig::kProfileEnabled, "true"}});
+}
+
 BitsetType
 ExecPlanNodeVisitor::ExecuteTask(
     plan::PlanFragment& plan,
@@ -106,6 +118,54 @@ ExecPlanNodeVisitor::ExecuteTask(
     return bitset_holder;
 }
 
+BitsetType
+ExecPlanNodeVisitor::ExecuteTaskWithLimit(
+    plan::PlanFragment& plan,
+    std::shared_ptr<milvus::exec::QueryContext> query_context,
+    int64_t limit) {
+    LOG_DEBUG("plannode: {}, active_count: {}, timestamp: {}, limit: {}",
+              plan.plan_node_->ToString(),
+              query_context->get_active_count(),
+              query_context->get_query_timestamp(),
+              limit);
+
+    AssertInfo(query_context->is_streaming(),
+               "limited execution requires streaming operators");
+    auto task =
+        milvus::exec::Task::Create(DEFAULT_TASK_ID, plan, 0, query_context);
+    int64_t hit_num = 0;
+    bool finished = false;
+    BitsetType bitset_holder;
+    // one more hit than the limit tells there are more results
+    while (hit_num <= limit) {
+        auto result = task->Next();
+        if (!result) {
+            Assert(bitset_holder.size() == query_context->get_active_count());
+            finished = true;
+            break;
+        }
+        auto childrens = result->childrens();
+        AssertInfo(childrens.size() == 1,
+                   "plannode result vector's children size not equal one");
+        if (auto vec = std::dynamic_pointer_cast<ColumnVector>(childrens[0])) {
+            BitsetTypeView view(vec->GetRawData(), vec->size());
+            hit_num += view.size() - view.count();
+            bitset_holder.append(view);
+        } else {
+            PanicInfo(UnexpectedError, "expr return type not matched");
+        }
+    }
+    if (!finished) {
+        // drivers hold the task until they are closed
+        task->RequestCancel();
+    }
+    LOG_DEBUG("evaluated {} of {} rows for limit {}",
+              bitset_holder.size(),
+              query_context->get_active_count(),
+              limit);
+    return bitset_holder;
+}
+
 template <typename VectorType>
 void
 ExecPlanNodeVisitor::VectorVisitorImpl(VectorPlanNode& node) {
@@ -127,16 +187,22 @@ ExecPlanNodeVisitor::VectorVisitorImpl(VectorPlanNode& node) {
     auto plan = plan::PlanFragment(node.plannodes_);
 
     // Set query context
-    auto query_context = std::make_shared<milvus::exec::QueryContext>(
-        DEAFULT_QUERY_ID, segment, active_count, timestamp_);
+    auto query_context =
+        std::make_shared<milvus::exec::QueryContext>(DEAFULT_QUERY_ID,
+                                                     segment,
+                                                     active_count,
+                                                     timestamp_,
+                                                     MakeQueryConfig(node));
     query_context->set_search_info(node.search_info_);
     query_context->set_placeholder_group(placeholder_group_);
+    query_context->set_op_context(op_context_);
 
     // Do plan fragment task work
     auto result = ExecuteTask(plan, query_context);
 
     // Store result
     search_result_opt_ = std::move(query_context->get_search_result());
+    search_result_opt_->profile_ = query_context->GetProfile();
 }
 
 std::unique_ptr<RetrieveResult>
@@ -162,6 +228,13 @@ ExecPlanNodeVisitor::visit(RetrievePlanNode& node) {
 
     auto active_count = segment->get_active_count(timestamp_);
 
+    if (active_count == 0 && node.aggregation_ != nullptr) {
+        exec::AggregateTable table(node.aggregation_);
+        retrieve_result.field_data_ = table.SerializePartial();
+        retrieve_result_opt_ = std::move(retrieve_result);
+        return;
+    }
+
     // PreExecute: skip all calculation
     if (active_count == 0 && !node.is_count_) {
         retrieve_result_opt_ = std::move(retrieve_result);
@@ -178,25 +251,66 @@ ExecPlanNodeVisitor::visit(RetrievePlanNode& node) {
     auto plan = plan::PlanFragment(node.plannodes_);
 
     // Set query context
-    auto query_context = std::make_shared<milvus::exec::QueryContext>(
-        DEAFULT_QUERY_ID, segment, active_count, timestamp_);
+    auto query_context =
+        std::make_shared<milvus::exec::QueryContext>(DEAFULT_QUERY_ID,
+                                                     segment,
+                                                     active_count,
+                                                     timestamp_,
+                                                     MakeQueryConfig(node));
+    query_context->set_op_context(op_context_);
 
     // Do task execution
-    auto bitset_holder = ExecuteTask(plan, query_context);
+    BitsetType bitset_holder;
+    auto has_limit = node.limit_ != segcore::Unlimited &&
+                     node.limit_ != segcore::NoLimit;
+    if (!node.is_count_ && node.aggregation_ == nullptr && has_limit &&
+        segment->is_sorted_by_pk()) {
+        // offsets are in pk order, so the first limit rows passing the
+        // filter are the result and the rest of the segment is not needed
+        query_context->set_streaming(true);
+        bitset_holder = ExecuteTaskWithLimit(plan, query_context, node.limit_);
+    } else {
+        bitset_holder = ExecuteTask(plan, query_context);
+    }
 
     // Store result
-    if (node.is_count_) {
+    if (node.is_count_ || node.aggregation_ != nullptr) {
         retrieve_result_opt_ = std::move(query_context->get_retrieve_result());
+        retrieve_result_opt_->profile_ = query_context->GetProfile();
     } else {
-        retrieve_result.total_data_cnt_ = bitset_holder.size();
+        retrieve_result.total_data_cnt_ = active_count;
         tracer::AutoSpan _("Find Limit Pk", tracer::GetRootSpan());
         auto results_pair = segment->find_first(node.limit_, bitset_holder);
         retrieve_result.result_offsets_ = std::move(results_pair.first);
         retrieve_result.has_more_result = results_pair.second;
+        retrieve_result.profile_ = query_context->GetProfile();
         retrieve_result_opt_ = std::move(retrieve_result);
     }
 }
 
+BitsetType
+ExecPlanNodeVisitor::ExecuteRetrieveFilter(RetrievePlanNode& node) {
+    auto segment =
+        dynamic_cast<const segcore::SegmentInternalInterface*>(&segment_);
+    AssertInfo(segment, "Support SegmentSmallIndex Only");
+    AssertInfo(!node.is_count_ && node.aggregation_ == nullptr,
+               "count or aggregation has no rows to page");
+    auto active_count = segment->get_active_count(timestamp_);
+    if (active_count == 0) {
+        return BitsetType();
+    }
+
+    auto plan = plan::PlanFragment(node.plannodes_);
+    auto query_context =
+        std::make_shared<milvus::exec::QueryContext>(DEAFULT_QUERY_ID,
+                                                     segment,
+                                                     active_count,
+                                                     timestamp_,
+                                                     MakeQueryConfig(node));
+    query_context->set_op_context(op_context_);
+    return ExecuteTask(plan, query_context);
+}
+
 void
 ExecPlanNodeVisitor::visit(FloatVectorANNS& node) {
     VectorVisitorImpl<FloatVector>(node);
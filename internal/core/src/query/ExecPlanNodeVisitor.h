@@ -43,15 +43,18 @@ class ExecPlanNodeVisitor : public PlanNodeVisitor {
  public:
     ExecPlanNodeVisitor(const segcore::SegmentInterface& segment,
                         Timestamp timestamp,
-                        const PlaceholderGroup* placeholder_group)
+                        const PlaceholderGroup* placeholder_group,
+                        const OpContext* op_context = nullptr)
         : segment_(segment),
           timestamp_(timestamp),
-          placeholder_group_(placeholder_group) {
+          placeholder_group_(placeholder_group),
+          op_context_(op_context) {
     }
 
     ExecPlanNodeVisitor(const segcore::SegmentInterface& segment,
-                        Timestamp timestamp)
-        : segment_(segment), timestamp_(timestamp) {
+                        Timestamp timestamp,
+                        const OpContext* op_context = nullptr)
+        : segment_(segment), timestamp_(timestamp), op_context_(op_context) {
         placeholder_group_ = nullptr;
     }
 
@@ -78,6 +81,11 @@ class ExecPlanNodeVisitor : public PlanNodeVisitor {
         return ret;
     }
 
+    // the bits of the rows visible at the timestamp which don't pass the
+    // filter of the retrieve, evaluated on all of them whatever its limit
+    BitsetType
+    ExecuteRetrieveFilter(RetrievePlanNode& node);
+
     void
     SetExprUsePkIndex(bool use_pk_index) {
         expr_use_pk_index_ = use_pk_index;
@@ -92,6 +100,14 @@ class ExecPlanNodeVisitor : public PlanNodeVisitor {
     ExecuteTask(plan::PlanFragment& plan,
                 std::shared_ptr<milvus::exec::QueryContext> query_context);
 
+    // pulls batches of the task until more than limit rows pass the plan,
+    // the returned bitset may cover only a prefix of the segment
+    static BitsetType
+    ExecuteTaskWithLimit(
+        plan::PlanFragment& plan,
+        std::shared_ptr<milvus::exec::QueryContext> query_context,
+        int64_t limit);
+
  private:
     template <typename VectorType>
     void
@@ -101,6 +117,7 @@ class ExecPlanNodeVisitor : public PlanNodeVisitor {
     const segcore::SegmentInterface& segment_;
     Timestamp timestamp_;
     const PlaceholderGroup* placeholder_group_;
+    const OpContext* op_context_;
 
     SearchResultOpt search_result_opt_;
     RetrieveResultOpt retrieve_result_opt_;
@@ -0,0 +1,601 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "query/ExprOptimizer.h"
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <optional>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace milvus::query {
+
+namespace {
+
+using expr::TypedExprPtr;
+using GenericValue = proto::plan::GenericValue;
+using ChainOp = expr::LogicalBinaryExpr::OpType;
+using proto::plan::OpType;
+
+// rewrites a node whose inputs are rewritten already, under_not is true
+// below a NOT
+using NodeRule = std::function<TypedExprPtr(const TypedExprPtr&, bool)>;
+// rewrites the operands of a chain of ands or ors
+using ChainRule = std::function<std::vector<TypedExprPtr>(
+    ChainOp, const std::vector<TypedExprPtr>&, bool)>;
+
+std::shared_ptr<const expr::LogicalBinaryExpr>
+AsChain(const TypedExprPtr& expr) {
+    auto binary =
+        std::dynamic_pointer_cast<const expr::LogicalBinaryExpr>(expr);
+    if (binary != nullptr && (binary->op_type_ == ChainOp::And ||
+                              binary->op_type_ == ChainOp::Or)) {
+        return binary;
+    }
+    return nullptr;
+}
+
+void
+FlattenChain(const TypedExprPtr& expr,
+             ChainOp op,
+             std::vector<TypedExprPtr>& operands) {
+    auto chain = AsChain(expr);
+    if (chain == nullptr || chain->op_type_ != op) {
+        operands.push_back(expr);
+        return;
+    }
+    for (auto& input : chain->inputs()) {
+        FlattenChain(input, op, operands);
+    }
+}
+
+TypedExprPtr
+BuildChain(ChainOp op, const std::vector<TypedExprPtr>& operands) {
+    AssertInfo(!operands.empty(), "chain of no operand");
+    auto result = operands[0];
+    for (size_t i = 1; i < operands.size(); ++i) {
+        result =
+            std::make_shared<expr::LogicalBinaryExpr>(op, result, operands[i]);
+    }
+    return result;
+}
+
+TypedExprPtr
+Rewrite(const TypedExprPtr& expr,
+        const NodeRule& node_rule,
+        const ChainRule& chain_rule,
+        bool under_not = false) {
+    if (auto chain = AsChain(expr)) {
+        auto op = chain->op_type_;
+        std::vector<TypedExprPtr> operands;
+        FlattenChain(expr, op, operands);
+        auto rewritten = operands;
+        for (auto& operand : rewritten) {
+            operand = Rewrite(operand, node_rule, chain_rule, under_not);
+        }
+        if (chain_rule) {
+            rewritten = chain_rule(op, rewritten, under_not);
+        }
+        if (rewritten == operands) {
+            return expr;
+        }
+        return BuildChain(op, rewritten);
+    }
+    auto result = expr;
+    auto unary = std::dynamic_pointer_cast<const expr::LogicalUnaryExpr>(expr);
+    if (unary != nullptr &&
+        unary->op_type_ == expr::LogicalUnaryExpr::OpType::LogicalNot) {
+        auto& child = unary->inputs()[0];
+        auto rewritten = Rewrite(child, node_rule, chain_rule, true);
+        if (rewritten != child) {
+            result =
+                std::make_shared<expr::LogicalUnaryExpr>(unary->op_type_,
+                                                         rewritten);
+        }
+    }
+    return node_rule ? node_rule(result, under_not) : result;
+}
+
+// a column of a scalar field rather than a path of a json or an element of
+// an array
+bool
+IsPlainColumn(const expr::ColumnInfo& column) {
+    return column.nested_path_.empty() &&
+           column.data_type_ != DataType::JSON &&
+           column.data_type_ != DataType::ARRAY;
+}
+
+using ColumnKey = std::pair<int64_t, DataType>;
+
+ColumnKey
+KeyOf(const expr::ColumnInfo& column) {
+    return {column.field_id_.get(), column.data_type_};
+}
+
+// -1, 0 or 1 as lhs is less than, equal to or greater than rhs of the same
+// kind
+int
+CompareValues(const GenericValue& lhs, const GenericValue& rhs) {
+    auto compare = [](const auto& x, const auto& y) {
+        return x < y ? -1 : (y < x ? 1 : 0);
+    };
+    switch (lhs.val_case()) {
+        case GenericValue::kInt64Val:
+            return compare(lhs.int64_val(), rhs.int64_val());
+        case GenericValue::kFloatVal:
+            return compare(lhs.float_val(), rhs.float_val());
+        case GenericValue::kStringVal:
+            return compare(lhs.string_val(), rhs.string_val());
+        default:
+            PanicInfo(DataTypeInvalid,
+                      "unexpected value {} of a range",
+                      static_cast<int>(lhs.val_case()));
+    }
+}
+
+bool
+IsOrderedValue(const GenericValue& value) {
+    return value.val_case() == GenericValue::kInt64Val ||
+           value.val_case() == GenericValue::kFloatVal ||
+           value.val_case() == GenericValue::kStringVal;
+}
+
+std::optional<OpType>
+ComplementOf(OpType op) {
+    switch (op) {
+        case OpType::GreaterThan:
+            return OpType::LessEqual;
+        case OpType::GreaterEqual:
+            return OpType::LessThan;
+        case OpType::LessThan:
+            return OpType::GreaterEqual;
+        case OpType::LessEqual:
+            return OpType::GreaterThan;
+        case OpType::Equal:
+            return OpType::NotEqual;
+        case OpType::NotEqual:
+            return OpType::Equal;
+        default:
+            return std::nullopt;
+    }
+}
+
+// one side of a range, the tighter of two bounds on the same side
+struct Bound {
+    GenericValue value;
+    bool inclusive;
+
+    bool
+    TighterThan(const Bound& other, bool lower) const {
+        auto order = CompareValues(value, other.value);
+        if (order == 0) {
+            return !inclusive && other.inclusive;
+        }
+        return lower ? order > 0 : order < 0;
+    }
+};
+
+}  // namespace
+
+TypedExprPtr
+PushDownNot(const TypedExprPtr& expr) {
+    return Rewrite(
+        expr,
+        [](const TypedExprPtr& node, bool) -> TypedExprPtr {
+            auto unary =
+                std::dynamic_pointer_cast<const expr::LogicalUnaryExpr>(node);
+            if (unary == nullptr ||
+                unary->op_type_ != expr::LogicalUnaryExpr::OpType::LogicalNot) {
+                return node;
+            }
+            auto& child = unary->inputs()[0];
+            auto inner =
+                std::dynamic_pointer_cast<const expr::LogicalUnaryExpr>(child);
+            if (inner != nullptr &&
+                inner->op_type_ ==
+                    expr::LogicalUnaryExpr::OpType::LogicalNot) {
+                return inner->inputs()[0];
+            }
+            // a NaN is neither less than nor not less than a value, so the
+            // floating columns are left as is
+            auto range =
+                std::dynamic_pointer_cast<const expr::UnaryRangeFilterExpr>(
+                    child);
+            if (range == nullptr || !IsPlainColumn(range->column_) ||
+                !(IsIntegerDataType(range->column_.data_type_) ||
+                  IsStringDataType(range->column_.data_type_) ||
+                  range->column_.data_type_ == DataType::BOOL)) {
+                return node;
+            }
+            auto complement = ComplementOf(range->op_type_);
+            if (!complement.has_value()) {
+                return node;
+            }
+            return std::make_shared<expr::UnaryRangeFilterExpr>(
+                range->column_, complement.value(), range->val_);
+        },
+        nullptr);
+}
+
+TypedExprPtr
+FoldConstants(const TypedExprPtr& expr) {
+    return Rewrite(
+        expr,
+        nullptr,
+        [](ChainOp op,
+           const std::vector<TypedExprPtr>& operands,
+           bool under_not) {
+            if (under_not) {
+                return operands;
+            }
+            auto is_true = [](const TypedExprPtr& operand) {
+                return std::dynamic_pointer_cast<const expr::AlwaysTrueExpr>(
+                           operand) != nullptr;
+            };
+            auto first_true =
+                std::find_if(operands.begin(), operands.end(), is_true);
+            if (first_true == operands.end()) {
+                return operands;
+            }
+            if (op == ChainOp::Or) {
+                return std::vector<TypedExprPtr>{*first_true};
+            }
+            std::vector<TypedExprPtr> result;
+            std::copy_if(operands.begin(),
+                         operands.end(),
+                         std::back_inserter(result),
+                         [&](const TypedExprPtr& operand) {
+                             return !is_true(operand);
+                         });
+            if (result.empty()) {
+                result.push_back(*first_true);
+            }
+            return result;
+        });
+}
+
+TypedExprPtr
+DeduplicateExprs(const TypedExprPtr& expr) {
+    return Rewrite(expr,
+                   nullptr,
+                   [](ChainOp,
+                      const std::vector<TypedExprPtr>& operands,
+                      bool) {
+                       std::unordered_set<std::string> seen;
+                       std::vector<TypedExprPtr> result;
+                       for (auto& operand : operands) {
+                           if (seen.insert(expr::StructuralKey(*operand))
+                                   .second) {
+                               result.push_back(operand);
+                           }
+                       }
+                       return result;
+                   });
+}
+
+TypedExprPtr
+MergeEqualsIntoTerm(const TypedExprPtr& expr) {
+    return Rewrite(
+        expr,
+        nullptr,
+        [](ChainOp op, const std::vector<TypedExprPtr>& operands, bool) {
+            if (op != ChainOp::Or) {
+                return operands;
+            }
+            struct Group {
+                std::optional<expr::ColumnInfo> column;
+                std::vector<size_t> members;
+                std::vector<GenericValue> values;
+                bool mergeable = true;
+            };
+            std::map<ColumnKey, Group> groups;
+            auto add = [&](const expr::ColumnInfo& column,
+                           size_t index,
+                           const GenericValue* begin,
+                           const GenericValue* end) {
+                if (!IsPlainColumn(column)) {
+                    return;
+                }
+                auto& group = groups[KeyOf(column)];
+                if (!group.column.has_value()) {
+                    group.column.emplace(column);
+                }
+                group.members.push_back(index);
+                for (auto value = begin; value != end; ++value) {
+                    if (!group.values.empty() &&
+                        value->val_case() !=
+                            group.values.front().val_case()) {
+                        group.mergeable = false;
+                    }
+                    group.values.push_back(*value);
+                }
+            };
+            for (size_t i = 0; i < operands.size(); ++i) {
+                if (auto range = std::dynamic_pointer_cast<
+                        const expr::UnaryRangeFilterExpr>(operands[i])) {
+                    if (range->op_type_ == OpType::Equal) {
+                        add(range->column_, i, &range->val_, &range->val_ + 1);
+                    }
+                } else if (auto term = std::dynamic_pointer_cast<
+                               const expr::TermFilterExpr>(operands[i])) {
+                    if (!term->is_in_field_ && !term->vals_.empty()) {
+                        add(term->column_,
+                            i,
+                            term->vals_.data(),
+                            term->vals_.data() + term->vals_.size());
+                    }
+                }
+            }
+
+            std::vector<TypedExprPtr> result;
+            std::unordered_set<size_t> merged;
+            for (size_t i = 0; i < operands.size(); ++i) {
+                if (merged.count(i) > 0) {
+                    continue;
+                }
+                auto entry = std::find_if(
+                    groups.begin(), groups.end(), [&](const auto& entry) {
+                        auto& members = entry.second.members;
+                        return entry.second.mergeable && members.size() > 1 &&
+                               members.front() == i;
+                    });
+                if (entry == groups.end()) {
+                    result.push_back(operands[i]);
+                    continue;
+                }
+                auto& group = entry->second;
+                merged.insert(group.members.begin(), group.members.end());
+                std::unordered_set<GenericValue,
+                                   expr::ExprInfo::GenericValueHasher,
+                                   expr::ExprInfo::GenericValueEqual>
+                    distinct;
+                std::vector<GenericValue> values;
+                for (auto& value : group.values) {
+                    if (distinct.insert(value).second) {
+                        values.push_back(value);
+                    }
+                }
+                result.push_back(std::make_shared<expr::TermFilterExpr>(
+                    group.column.value(), values));
+            }
+            return result;
+        });
+}
+
+TypedExprPtr
+MergeRanges(const TypedExprPtr& expr) {
+    return Rewrite(
+        expr,
+        nullptr,
+        [](ChainOp op, const std::vector<TypedExprPtr>& operands, bool) {
+            if (op != ChainOp::And) {
+                return operands;
+            }
+            struct Group {
+                std::optional<expr::ColumnInfo> column;
+                std::vector<size_t> members;
+                std::optional<Bound> lower;
+                std::optional<Bound> upper;
+                std::optional<GenericValue::ValCase> val_case;
+                bool mergeable = true;
+            };
+            std::map<ColumnKey, Group> groups;
+            auto add_bound = [](Group& group, Bound&& bound, bool lower) {
+                if (!group.val_case.has_value()) {
+                    group.val_case = bound.value.val_case();
+                }
+                if (!IsOrderedValue(bound.value) ||
+                    bound.value.val_case() != group.val_case.value()) {
+                    group.mergeable = false;
+                    return;
+                }
+                auto& current = lower ? group.lower : group.upper;
+                if (!current.has_value() ||
+                    bound.TighterThan(current.value(), lower)) {
+                    current = std::move(bound);
+                }
+            };
+            for (size_t i = 0; i < operands.size(); ++i) {
+                std::optional<expr::ColumnInfo> column;
+                std::vector<std::pair<Bound, bool>> bounds;
+                if (auto range = std::dynamic_pointer_cast<
+                        const expr::UnaryRangeFilterExpr>(operands[i])) {
+                    switch (range->op_type_) {
+                        case OpType::GreaterThan:
+                        case OpType::GreaterEqual:
+                            bounds.push_back(
+                                {{range->val_,
+                                  range->op_type_ == OpType::GreaterEqual},
+                                 true});
+                            break;
+                        case OpType::LessThan:
+                        case OpType::LessEqual:
+                            bounds.push_back(
+                                {{range->val_,
+                                  range->op_type_ == OpType::LessEqual},
+                                 false});
+                            break;
+                        default:
+                            continue;
+                    }
+                    column.emplace(range->column_);
+                } else if (auto range = std::dynamic_pointer_cast<
+                               const expr::BinaryRangeFilterExpr>(
+                               operands[i])) {
+                    bounds.push_back(
+                        {{range->lower_val_, range->lower_inclusive_}, true});
+                    bounds.push_back(
+                        {{range->upper_val_, range->upper_inclusive_}, false});
+                    column.emplace(range->column_);
+                }
+                if (!column.has_value() || !IsPlainColumn(column.value()) ||
+                    column->data_type_ == DataType::BOOL) {
+                    continue;
+                }
+                auto& group = groups[KeyOf(column.value())];
+                if (!group.column.has_value()) {
+                    group.column = column;
+                }
+                group.members.push_back(i);
+                for (auto& [bound, lower] : bounds) {
+                    add_bound(group, std::move(bound), lower);
+                }
+            }
+
+            std::vector<TypedExprPtr> result;
+            std::unordered_set<size_t> merged;
+            for (size_t i = 0; i < operands.size(); ++i) {
+                if (merged.count(i) > 0) {
+                    continue;
+                }
+                auto entry = std::find_if(
+                    groups.begin(), groups.end(), [&](const auto& entry) {
+                        auto& members = entry.second.members;
+                        return entry.second.mergeable && members.size() > 1 &&
+                               members.front() == i;
+                    });
+                if (entry == groups.end()) {
+                    result.push_back(operands[i]);
+                    continue;
+                }
+                auto& group = entry->second;
+                merged.insert(group.members.begin(), group.members.end());
+                auto& column = group.column.value();
+                if (group.lower.has_value() && group.upper.has_value()) {
+                    result.push_back(
+                        std::make_shared<expr::BinaryRangeFilterExpr>(
+                            column,
+                            group.lower->value,
+                            group.upper->value,
+                            group.lower->inclusive,
+                            group.upper->inclusive));
+                } else if (group.lower.has_value()) {
+                    result.push_back(
+                        std::make_shared<expr::UnaryRangeFilterExpr>(
+                            column,
+                            group.lower->inclusive ? OpType::GreaterEqual
+                                                   : OpType::GreaterThan,
+                            group.lower->value));
+                } else {
+                    result.push_back(
+                        std::make_shared<expr::UnaryRangeFilterExpr>(
+                            column,
+                            group.upper->inclusive ? OpType::LessEqual
+                                                   : OpType::LessThan,
+                            group.upper->value));
+                }
+            }
+            return result;
+        });
+}
+
+int
+EstimateCost(const TypedExprPtr& expr) {
+    auto column_cost = [](const expr::ColumnInfo& column) {
+        if (!IsPlainColumn(column)) {
+            return 3;
+        }
+        return IsStringDataType(column.data_type_) ? 2 : 1;
+    };
+    if (std::dynamic_pointer_cast<const expr::AlwaysTrueExpr>(expr)) {
+        return 0;
+    }
+    if (auto range =
+            std::dynamic_pointer_cast<const expr::UnaryRangeFilterExpr>(
+                expr)) {
+        switch (range->op_type_) {
+            case OpType::PrefixMatch:
+            case OpType::PostfixMatch:
+            case OpType::Match:
+                return column_cost(range->column_) + 1;
+            default:
+                return column_cost(range->column_);
+        }
+    }
+    if (auto range =
+            std::dynamic_pointer_cast<const expr::BinaryRangeFilterExpr>(
+                expr)) {
+        return column_cost(range->column_);
+    }
+    if (auto term =
+            std::dynamic_pointer_cast<const expr::TermFilterExpr>(expr)) {
+        return column_cost(term->column_);
+    }
+    if (auto exists =
+            std::dynamic_pointer_cast<const expr::ExistsExpr>(expr)) {
+        return column_cost(exists->column_);
+    }
+    if (auto arith = std::dynamic_pointer_cast<
+            const expr::BinaryArithOpEvalRangeExpr>(expr)) {
+        return column_cost(arith->column_) + 1;
+    }
+    if (auto compare =
+            std::dynamic_pointer_cast<const expr::CompareExpr>(expr)) {
+        return IsStringDataType(compare->left_data_type_) ||
+                       IsStringDataType(compare->right_data_type_)
+                   ? 3
+                   : 2;
+    }
+    if (std::dynamic_pointer_cast<const expr::JsonContainsExpr>(expr)) {
+        return 4;
+    }
+    if (std::dynamic_pointer_cast<const expr::CallExpr>(expr)) {
+        return 5;
+    }
+    // a logical expr costs as its most expensive input
+    int cost = 0;
+    for (auto& input : expr->inputs()) {
+        cost = std::max(cost, EstimateCost(input));
+    }
+    return cost;
+}
+
+TypedExprPtr
+OrderByCost(const TypedExprPtr& expr) {
+    return Rewrite(expr,
+                   nullptr,
+                   [](ChainOp,
+                      const std::vector<TypedExprPtr>& operands,
+                      bool under_not) {
+                       if (under_not) {
+                           return operands;
+                       }
+                       std::vector<std::pair<int, TypedExprPtr>> costs;
+                       for (auto& operand : operands) {
+                           costs.emplace_back(EstimateCost(operand), operand);
+                       }
+                       std::stable_sort(costs.begin(),
+                                        costs.end(),
+                                        [](const auto& x, const auto& y) {
+                                            return x.first < y.first;
+                                        });
+                       std::vector<TypedExprPtr> result;
+                       for (auto& [cost, operand] : costs) {
+                           result.push_back(operand);
+                       }
+                       return result;
+                   });
+}
+
+TypedExprPtr
+OptimizeExpr(const TypedExprPtr& expr) {
+    auto result = PushDownNot(expr);
+    result = FoldConstants(result);
+    result = DeduplicateExprs(result);
+    result = MergeEqualsIntoTerm(result);
+    result = MergeRanges(result);
+    return OrderByCost(result);
+}
+
+}  // namespace milvus::query
@@ -0,0 +1,62 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include "expr/ITypeExpr.h"
+
+namespace milvus::query {
+
+// Rewrites of the filter parsed from the plan proto before it is compiled,
+// every rule returns the expr itself if it has nothing to rewrite and the
+// rewritten expr filters the same rows. The operands of a chain of ands or
+// ors are rewritten as a whole, as the executor flattens them.
+//
+// The executor takes the valid bits of a chain from its first operand and a
+// NOT keeps only the valid rows, so the rules which change the first operand
+// of a chain are not applied below a NOT.
+
+// NOT NOT x to x, and NOT of a comparison of an integral, bool or string
+// column to the complementary comparison.
+expr::TypedExprPtr
+PushDownNot(const expr::TypedExprPtr& expr);
+
+// x AND true to x, x OR true to true.
+expr::TypedExprPtr
+FoldConstants(const expr::TypedExprPtr& expr);
+
+// drops the operands of a chain equal to an earlier one, x AND x to x.
+expr::TypedExprPtr
+DeduplicateExprs(const expr::TypedExprPtr& expr);
+
+// a == 1 OR a == 2 OR a IN [3] to a IN [1, 2, 3].
+expr::TypedExprPtr
+MergeEqualsIntoTerm(const expr::TypedExprPtr& expr);
+
+// a > 1 AND a <= 10 AND a > 3 to 3 < a <= 10.
+expr::TypedExprPtr
+MergeRanges(const expr::TypedExprPtr& expr);
+
+// orders the operands of a chain by EstimateCost, the executor skips the
+// following operands once a batch is decided by the cheap ones.
+expr::TypedExprPtr
+OrderByCost(const expr::TypedExprPtr& expr);
+
+// relative cost of evaluating an expr per row, 0 for constants, 1 for a
+// comparison of a numeric column up to 5 for a function call.
+int
+EstimateCost(const expr::TypedExprPtr& expr);
+
+// all the rules above.
+expr::TypedExprPtr
+OptimizeExpr(const expr::TypedExprPtr& expr);
+
+}  // namespace milvus::query
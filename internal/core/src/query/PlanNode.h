@@ -21,6 +21,7 @@
 
 namespace milvus::plan {
 class PlanNode;
+class AggregationNode;
 };
 namespace milvus::query {
 
@@ -31,6 +32,9 @@ struct PlanNode {
     virtual ~PlanNode() = default;
     virtual void
     accept(PlanNodeVisitor&) = 0;
+
+    // whether to record the execution stats of the query
+    bool profile_ = false;
 };
 
 using PlanNodePtr = std::unique_ptr<PlanNode>;
@@ -80,6 +84,8 @@ struct RetrievePlanNode : PlanNode {
 
     bool is_count_;
     int64_t limit_;
+    // set if the plan aggregates the rows instead of returning them
+    std::shared_ptr<const milvus::plan::AggregationNode> aggregation_;
 };
 
 }  // namespace milvus::query
@@ -21,6 +21,7 @@
 #include "common/EasyAssert.h"
 #include "exec/expression/function/FunctionFactory.h"
 #include "pb/plan.pb.h"
+#include "query/ExprOptimizer.h"
 #include "query/Utils.h"
 #include "knowhere/comp/materialized_view.h"
 #include "plan/PlanNode.h"
@@ -35,7 +36,7 @@ ProtoParser::PlanNodeFromProto(const planpb::PlanNode& plan_node_proto) {
     auto& anns_proto = plan_node_proto.vector_anns();
 
     auto expr_parser = [&]() -> plan::PlanNodePtr {
-        auto expr = ParseExprs(anns_proto.predicates());
+        auto expr = OptimizeExpr(ParseExprs(anns_proto.predicates()));
         return std::make_shared<plan::FilterBitsNode>(
             milvus::plan::GetNextPlanNodeId(), expr);
     };
@@ -148,7 +149,7 @@ ProtoParser::RetrievePlanNodeFromProto(
             node->is_count_ = false;
             auto& predicate_proto = plan_node_proto.predicates();
             auto expr_parser = [&]() -> plan::PlanNodePtr {
-                auto expr = ParseExprs(predicate_proto);
+                auto expr = OptimizeExpr(ParseExprs(predicate_proto));
                 return std::make_shared<plan::FilterBitsNode>(
                     milvus::plan::GetNextPlanNodeId(), expr);
             }();
@@ -162,7 +163,7 @@ ProtoParser::RetrievePlanNodeFromProto(
             if (query.has_predicates()) {
                 auto& predicate_proto = query.predicates();
                 auto expr_parser = [&]() -> plan::PlanNodePtr {
-                    auto expr = ParseExprs(predicate_proto);
+                    auto expr = OptimizeExpr(ParseExprs(predicate_proto));
                     return std::make_shared<plan::FilterBitsNode>(
                         milvus::plan::GetNextPlanNodeId(), expr);
                 }();
@@ -180,6 +181,12 @@ ProtoParser::RetrievePlanNodeFromProto(
                 plannode = std::make_shared<milvus::plan::CountNode>(
                     milvus::plan::GetNextPlanNodeId(), sources);
                 sources = std::vector<milvus::plan::PlanNodePtr>{plannode};
+            } else if (query.aggregates_size() > 0 ||
+                       query.group_by_field_ids_size() > 0) {
+                // group by alone returns the distinct groups
+                node->aggregation_ = ParseAggregationNode(query, sources);
+                plannode = node->aggregation_;
+                sources = std::vector<milvus::plan::PlanNodePtr>{plannode};
             }
             node->plannodes_ = plannode;
         }
@@ -189,6 +196,96 @@ ProtoParser::RetrievePlanNodeFromProto(
     return plan_node;
 }
 
+std::shared_ptr<plan::AggregationNode>
+ProtoParser::ParseAggregationNode(const planpb::QueryPlanNode& query_pb,
+                                  std::vector<plan::PlanNodePtr> sources) {
+    auto is_numeric = [](DataType data_type) {
+        return IsIntegerDataType(data_type) || IsFloatDataType(data_type);
+    };
+    auto is_groupable = [](DataType data_type) {
+        return data_type == DataType::BOOL || IsIntegerDataType(data_type) ||
+               data_type == DataType::VARCHAR;
+    };
+
+    std::vector<plan::Aggregate> aggregates;
+    for (auto& aggregate_pb : query_pb.aggregates()) {
+        plan::Aggregate aggregate;
+        if (aggregate_pb.field_id() == 0) {
+            AssertInfo(aggregate_pb.op() == planpb::Aggregate::Count,
+                       "aggregate {} without a field",
+                       planpb::Aggregate::AggregateOp_Name(aggregate_pb.op()));
+            aggregate.op_ = plan::AggregateOp::kCount;
+            aggregates.push_back(aggregate);
+            continue;
+        }
+        auto field_id = FieldId(aggregate_pb.field_id());
+        auto data_type = schema[field_id].get_data_type();
+        aggregate.field_id_ = field_id;
+        aggregate.data_type_ = data_type;
+        bool supported = false;
+        switch (aggregate_pb.op()) {
+            case planpb::Aggregate::Count:
+                aggregate.op_ = plan::AggregateOp::kCount;
+                supported = is_numeric(data_type) || is_groupable(data_type);
+                break;
+            case planpb::Aggregate::Sum:
+                aggregate.op_ = plan::AggregateOp::kSum;
+                supported = is_numeric(data_type);
+                break;
+            case planpb::Aggregate::Min:
+                aggregate.op_ = plan::AggregateOp::kMin;
+                supported = is_numeric(data_type);
+                break;
+            case planpb::Aggregate::Max:
+                aggregate.op_ = plan::AggregateOp::kMax;
+                supported = is_numeric(data_type);
+                break;
+            case planpb::Aggregate::Avg:
+                aggregate.op_ = plan::AggregateOp::kAvg;
+                supported = is_numeric(data_type);
+                break;
+            case planpb::Aggregate::CountDistinct:
+                aggregate.op_ = plan::AggregateOp::kCountDistinct;
+                supported = is_numeric(data_type) || is_groupable(data_type);
+                break;
+            default:
+                PanicInfo(OpTypeInvalid,
+                          "unsupported aggregate {}",
+                          static_cast<int>(aggregate_pb.op()));
+        }
+        if (!supported) {
+            PanicInfo(DataTypeInvalid,
+                      "unsupported aggregate {} of field {} of type {}",
+                      planpb::Aggregate::AggregateOp_Name(aggregate_pb.op()),
+                      field_id.get(),
+                      data_type);
+        }
+        aggregates.push_back(aggregate);
+    }
+
+    std::vector<FieldId> group_by_field_ids;
+    std::vector<DataType> group_by_data_types;
+    for (auto field_id_raw : query_pb.group_by_field_ids()) {
+        auto field_id = FieldId(field_id_raw);
+        auto data_type = schema[field_id].get_data_type();
+        if (!is_groupable(data_type)) {
+            PanicInfo(DataTypeInvalid,
+                      "unsupported group by field {} of type {}",
+                      field_id.get(),
+                      data_type);
+        }
+        group_by_field_ids.push_back(field_id);
+        group_by_data_types.push_back(data_type);
+    }
+
+    return std::make_shared<plan::AggregationNode>(
+        plan::GetNextPlanNodeId(),
+        std::move(aggregates),
+        std::move(group_by_field_ids),
+        std::move(group_by_data_types),
+        std::move(sources));
+}
+
 std::unique_ptr<Plan>
 ProtoParser::CreatePlan(const proto::plan::PlanNode& plan_node_proto) {
     LOG_DEBUG("create search plan from proto: {}",
@@ -196,6 +293,7 @@ ProtoParser::CreatePlan(const proto::plan::PlanNode& plan_node_proto) {
     auto plan = std::make_unique<Plan>(schema);
 
     auto plan_node = PlanNodeFromProto(plan_node_proto);
+    plan_node->profile_ = plan_node_proto.profile();
     plan->tag2field_["$0"] = plan_node->search_info_.field_id_;
     plan->plan_node_ = std::move(plan_node);
     ExtractedPlanInfo extra_info(schema.size());
@@ -220,6 +318,7 @@ ProtoParser::CreateRetrievePlan(const proto::plan::PlanNode& plan_node_proto) {
     auto retrieve_plan = std::make_unique<RetrievePlan>(schema);
 
     auto plan_node = RetrievePlanNodeFromProto(plan_node_proto);
+    plan_node->profile_ = plan_node_proto.profile();
 
     retrieve_plan->plan_node_ = std::move(plan_node);
     for (auto field_id_raw : plan_node_proto.output_field_ids()) {
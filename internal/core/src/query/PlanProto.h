@@ -55,6 +55,10 @@ class ProtoParser {
                TypeCheckFunction type_check = TypeIsBool);
 
  private:
+    std::shared_ptr<plan::AggregationNode>
+    ParseAggregationNode(const proto::plan::QueryPlanNode& query_pb,
+                         std::vector<plan::PlanNodePtr> sources);
+
     expr::TypedExprPtr
     CreateAlwaysTrueExprs();
 
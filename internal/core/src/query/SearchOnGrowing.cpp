@@ -116,6 +116,7 @@ SearchOnGrowing(const segcore::SegmentGrowingImpl& segment,
 
         for (int chunk_id = current_chunk_id; chunk_id < max_chunk;
              ++chunk_id) {
+            CheckCancellation(info.op_context_, double(chunk_id) / max_chunk);
             auto chunk_data = vec_ptr->get_chunk_data(chunk_id);
 
             auto element_begin = chunk_id * vec_size_per_chunk;
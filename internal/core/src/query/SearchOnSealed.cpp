@@ -11,20 +11,83 @@
 
 #include <algorithm>
 #include <cmath>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include "bitset/detail/element_wise.h"
 #include "common/BitsetView.h"
 #include "common/QueryInfo.h"
 #include "common/Types.h"
+#include "common/Utils.h"
 #include "mmap/Column.h"
+#include "monitor/prometheus_client.h"
 #include "query/SearchBruteForce.h"
 #include "query/SearchOnSealed.h"
 #include "query/helper.h"
+#include "segcore/SegcoreConfig.h"
 #include "exec/operator/groupby/SearchGroupByOperator.h"
 
 namespace milvus::query {
 
+namespace {
+
+// the offsets of the rows bitset keeps if they are few enough, by the brute
+// force filter ratio of the segcore config, to be searched exactly instead
+// of through an index walking the filtered out rows as well
+std::optional<std::vector<int64_t>>
+SelectBruteForceRows(const FieldMeta& field,
+                     const SearchInfo& search_info,
+                     const BitsetView& bitset) {
+    // the vector iterators of group by are built on the whole index
+    if (field.get_data_type() == DataType::VECTOR_SPARSE_FLOAT ||
+        search_info.group_by_field_id_.has_value() || bitset.empty()) {
+        return std::nullopt;
+    }
+    auto ratio =
+        segcore::SegcoreConfig::default_config().get_brute_force_filter_ratio();
+    auto num_rows = static_cast<int64_t>(bitset.size());
+    auto num_kept = num_rows - static_cast<int64_t>(bitset.count());
+    if (num_kept == 0 || num_kept > ratio * num_rows) {
+        return std::nullopt;
+    }
+    std::vector<int64_t> offsets;
+    offsets.reserve(num_kept);
+    for (int64_t i = 0; i < num_rows; ++i) {
+        if (!bitset.test(i)) {
+            offsets.push_back(i);
+        }
+    }
+    return offsets;
+}
+
+// searches the vectors of the rows at offsets, gathered into vec_data in
+// the same order, exactly, the results refer to the rows by their offsets
+void
+SearchOnSealedRows(const Schema& schema,
+                   const void* vec_data,
+                   const std::vector<int64_t>& offsets,
+                   const SearchInfo& search_info,
+                   const void* query_data,
+                   int64_t num_queries,
+                   SearchResult& result) {
+    SearchOnSealed(schema,
+                   vec_data,
+                   search_info,
+                   query_data,
+                   num_queries,
+                   offsets.size(),
+                   BitsetView(),
+                   result);
+    for (auto& offset : result.seg_offsets_) {
+        if (offset != -1) {
+            offset = offsets[offset];
+        }
+    }
+}
+
+}  // namespace
+
 void
 SearchOnSealedIndex(const Schema& schema,
                     const segcore::SealedIndexingRecord& record,
@@ -55,6 +118,23 @@ SearchOnSealedIndex(const Schema& schema,
     dataset->SetIsSparse(is_sparse);
     auto vec_index =
         dynamic_cast<index::VectorIndex*>(field_indexing->indexing_.get());
+
+    auto rows = SelectBruteForceRows(field, search_info, bitset);
+    if (rows.has_value() && vec_index->HasRawData()) {
+        auto vectors =
+            vec_index->GetVector(GenIdsDataset(rows->size(), rows->data()));
+        SearchOnSealedRows(schema,
+                           vectors.data(),
+                           rows.value(),
+                           search_info,
+                           query_data,
+                           num_queries,
+                           search_result);
+        monitor::internal_core_search_strategy_brute_force.Increment();
+        return;
+    }
+    monitor::internal_core_search_strategy_index.Increment();
+
     if (!milvus::exec::PrepareVectorIteratorsFromIndex(search_info,
                                                        num_queries,
                                                        dataset,
@@ -112,6 +192,7 @@ SearchOnSealed(const Schema& schema,
 
     auto offset = 0;
     for (int i = 0; i < num_chunk; ++i) {
+        CheckCancellation(search_info.op_context_, double(i) / num_chunk);
         auto vec_data = column->Data(i);
         auto chunk_size = column->chunk_row_nums(i);
         const uint8_t* bitset_ptr = nullptr;
@@ -83,6 +83,7 @@ ChunkedSegmentSealedImpl::LoadIndex(const LoadIndexInfo& info) {
     } else {
         LoadScalarIndex(info);
     }
+    InvalidateFilterCache();
 }
 
 void
@@ -394,6 +395,7 @@ ChunkedSegmentSealedImpl::LoadFieldData(FieldId field_id, FieldDataInfo& data) {
                     // var_column->Seal();
                     stats_.mem_size += var_column->DataByteSize();
                     field_data_size = var_column->DataByteSize();
+                    stats_.mem_size += LoadJsonShredding(field_id, *var_column);
                     column = std::move(var_column);
                     break;
                 }
@@ -518,6 +520,7 @@ ChunkedSegmentSealedImpl::LoadFieldData(FieldId field_id, FieldDataInfo& data) {
         std::unique_lock lck(mutex_);
         update_row_count(num_rows);
     }
+    InvalidateFilterCache();
 }
 
 void
@@ -537,7 +540,6 @@ ChunkedSegmentSealedImpl::MapFieldData(const FieldId field_id,
     // write the field data to disk
     uint64_t total_written = 0;
     std::vector<uint64_t> indices{};
-    std::vector<std::vector<uint64_t>> element_indices{};
     // FixedVector<bool> valid_data{};
     std::shared_ptr<milvus::ArrowDataWrapper> r;
 
@@ -549,7 +551,6 @@ ChunkedSegmentSealedImpl::MapFieldData(const FieldId field_id,
         //                field_data,
         //                total_written,
         //                indices,
-        //                element_indices,
         //                valid_data);
         auto chunk = create_chunk(
             field_meta,
@@ -592,8 +593,7 @@ ChunkedSegmentSealedImpl::MapFieldData(const FieldId field_id,
             }
             case milvus::DataType::ARRAY: {
                 auto arr_column = std::make_shared<ChunkedArrayColumn>(chunks);
-                // arr_column->Seal(std::move(indices),
-                //                  std::move(element_indices));
+                // arr_column->Seal(std::move(indices));
                 column = std::move(arr_column);
                 break;
             }
@@ -653,6 +653,7 @@ ChunkedSegmentSealedImpl::MapFieldData(const FieldId field_id,
         std::unique_lock lck(mutex_);
         set_bit(field_data_ready_bitset_, field_id, true);
     }
+    InvalidateFilterCache();
 }
 
 void
@@ -788,6 +789,57 @@ ChunkedSegmentSealedImpl::get_chunk_buffer(FieldId field_id,
               "get_chunk_buffer only used for  variable column field");
 }
 
+std::pair<std::vector<ArrayView>, FixedVector<bool>>
+ChunkedSegmentSealedImpl::chunk_array_views_impl(FieldId field_id,
+                                                 int64_t chunk_id,
+                                                 int64_t start_offset,
+                                                 int64_t length) const {
+    std::shared_lock lck(mutex_);
+    AssertInfo(get_bit(field_data_ready_bitset_, field_id),
+               "Can't get bitset element at " + std::to_string(field_id.get()));
+    if (auto it = fields_.find(field_id); it != fields_.end()) {
+        auto& field_data = it->second;
+        return field_data->ArrayViews(chunk_id, start_offset, length);
+    }
+    PanicInfo(ErrorCode::UnexpectedError,
+              "chunk_array_views_impl only used for array column field");
+}
+
+std::pair<std::vector<Json>, FixedVector<bool>>
+ChunkedSegmentSealedImpl::chunk_json_views_impl(FieldId field_id,
+                                                int64_t chunk_id,
+                                                int64_t start_offset,
+                                                int64_t length) const {
+    std::shared_lock lck(mutex_);
+    AssertInfo(get_bit(field_data_ready_bitset_, field_id),
+               "Can't get bitset element at " + std::to_string(field_id.get()));
+    if (auto it = fields_.find(field_id); it != fields_.end()) {
+        auto& field_data = it->second;
+        return field_data->JsonViews(chunk_id, start_offset, length);
+    }
+    PanicInfo(ErrorCode::UnexpectedError,
+              "chunk_json_views_impl only used for json column field");
+}
+
+std::pair<StringBatchView, const bool*>
+ChunkedSegmentSealedImpl::chunk_string_batch_impl(
+    FieldId field_id,
+    int64_t chunk_id,
+    int64_t start_offset,
+    int64_t length,
+    std::vector<uint64_t>& offsets_buf) const {
+    std::shared_lock lck(mutex_);
+    AssertInfo(get_bit(field_data_ready_bitset_, field_id),
+               "Can't get bitset element at " + std::to_string(field_id.get()));
+    if (auto it = fields_.find(field_id); it != fields_.end()) {
+        auto& field_data = it->second;
+        return field_data->StringBatch(
+            chunk_id, start_offset, length, offsets_buf);
+    }
+    PanicInfo(ErrorCode::UnexpectedError,
+              "chunk_string_batch_impl only used for variable column field");
+}
+
 bool
 ChunkedSegmentSealedImpl::is_mmap_field(FieldId field_id) const {
     std::shared_lock lck(mutex_);
@@ -902,6 +954,25 @@ ChunkedSegmentSealedImpl::vector_search(SearchInfo& search_info,
 
     AssertInfo(field_meta.is_vector(),
                "The meta type of vector field is not vector type");
+    auto clusters = GetClusteringCentroids(field_id);
+    // an index can't skip the clusters by their bounds, it is kept off the
+    // rows of the clusters the search doesn't probe instead
+    auto index_bitset = bitset;
+    BitsetType unprobed_bitset;
+    if (clusters != nullptr && num_rows_.has_value() &&
+        (get_bit(binlog_index_bitset_, field_id) ||
+         get_bit(index_ready_bitset_, field_id)) &&
+        query::FilterUnprobedClusters(
+            *schema_,
+            *clusters,
+            search_info,
+            query_data,
+            query_count,
+            bitset.empty() ? num_rows_.value() : bitset.size(),
+            bitset,
+            unprobed_bitset)) {
+        index_bitset = BitsetView(unprobed_bitset);
+    }
     if (get_bit(binlog_index_bitset_, field_id)) {
         AssertInfo(
             vec_binlog_config_.find(field_id) != vec_binlog_config_.end(),
@@ -917,7 +988,7 @@ ChunkedSegmentSealedImpl::vector_search(SearchInfo& search_info,
                                    binlog_search_info,
                                    query_data,
                                    query_count,
-                                   bitset,
+                                   index_bitset,
                                    output);
         milvus::tracer::AddEvent(
             "finish_searching_vector_temperate_binlog_index");
@@ -930,7 +1001,7 @@ ChunkedSegmentSealedImpl::vector_search(SearchInfo& search_info,
                                    search_info,
                                    query_data,
                                    query_count,
-                                   bitset,
+                                   index_bitset,
                                    output);
         milvus::tracer::AddEvent("finish_searching_vector_index");
     } else {
@@ -940,6 +1011,22 @@ ChunkedSegmentSealedImpl::vector_search(SearchInfo& search_info,
         AssertInfo(num_rows_.has_value(), "Can't get row count value");
         auto row_count = num_rows_.value();
         auto vec_data = fields_.at(field_id);
+        if (clusters != nullptr &&
+            query::SearchOnSealedClusters(
+                *schema_,
+                *clusters,
+                [&](int64_t offset) {
+                    return reinterpret_cast<const float*>(
+                        vec_data->ValueAt(offset));
+                },
+                search_info,
+                query_data,
+                query_count,
+                bitset,
+                output)) {
+            milvus::tracer::AddEvent("finish_searching_vector_clusters");
+            return;
+        }
         query::SearchOnSealed(*schema_,
                               vec_data,
                               search_info,
@@ -1044,7 +1131,7 @@ ChunkedSegmentSealedImpl::get_vector(FieldId field_id,
         path_to_column.emplace(std::get<0>(tuple), nullptr);
     }
 
-    // read and prefetch
+    // read and prefetch, ahead of the downloads of loading segments
     auto& pool = ThreadPools::GetThreadPool(milvus::ThreadPoolPriority::HIGH);
     std::vector<std::future<
         std::tuple<std::string, std::shared_ptr<ChunkedColumnBase>>>>
@@ -1052,8 +1139,12 @@ ChunkedSegmentSealedImpl::get_vector(FieldId field_id,
     futures.reserve(path_to_column.size());
     for (const auto& iter : path_to_column) {
         const auto& data_path = iter.first;
-        futures.emplace_back(pool.Submit(
-            ReadFromChunkCache, cc, data_path, mmap_descriptor_, field_meta));
+        futures.emplace_back(pool.SubmitWithPriority(TaskPriority::HIGH,
+                                                     ReadFromChunkCache,
+                                                     cc,
+                                                     data_path,
+                                                     mmap_descriptor_,
+                                                     field_meta));
     }
 
     for (int i = 0; i < futures.size(); ++i) {
@@ -1124,6 +1215,19 @@ ChunkedSegmentSealedImpl::DropFieldData(const FieldId field_id) {
         std::unique_lock lck(mutex_);
         if (get_bit(field_data_ready_bitset_, field_id)) {
             fields_.erase(field_id);
+            if (auto clusters = clustering_centroids_->find(field_id);
+                clusters != clustering_centroids_->end()) {
+                stats_.mem_size -= clusters->second->ByteSize();
+                auto updated =
+                    std::make_shared<ClusteringCentroidsMap>(
+                        *clustering_centroids_);
+                updated->erase(field_id);
+                std::atomic_store(
+                    &clustering_centroids_,
+                    std::shared_ptr<const ClusteringCentroidsMap>(
+                        std::move(updated)));
+            }
+            DropJsonShredding(field_id);
             set_bit(field_data_ready_bitset_, field_id, false);
         }
         if (get_bit(binlog_index_bitset_, field_id)) {
@@ -1132,6 +1236,7 @@ ChunkedSegmentSealedImpl::DropFieldData(const FieldId field_id) {
         }
         lck.unlock();
     }
+    InvalidateFilterCache();
 }
 
 void
@@ -1147,6 +1252,7 @@ ChunkedSegmentSealedImpl::DropIndex(const FieldId field_id) {
     std::unique_lock lck(mutex_);
     vector_indexings_.drop_field_indexing(field_id);
     set_bit(index_ready_bitset_, field_id, false);
+    InvalidateFilterCache();
 }
 
 void
@@ -1282,6 +1388,40 @@ std::pair<std::vector<OffsetMap::OffsetType>, bool>
 ChunkedSegmentSealedImpl::find_first(int64_t limit,
                                      const BitsetType& bitset) const {
     if (!is_sorted_by_pk_) {
+        // few hits are cheaper to order by their pks than to be looked up
+        // while walking the pk index
+        auto pk_field_id =
+            schema_->get_primary_field_id().value_or(FieldId(-1));
+        auto it = fields_.find(pk_field_id);
+        int64_t hit_num = bitset.size() - bitset.count();
+        if (it != fields_.end() &&
+            prefer_find_first_by_heap(limit, hit_num, bitset.size())) {
+            auto& pk_column = it->second;
+            switch (schema_->get_fields().at(pk_field_id).get_data_type()) {
+                case DataType::INT64: {
+                    return find_first_by_heap(
+                        limit, bitset, [&pk_column](int64_t offset) {
+                            auto [chunk_id, offset_in_chunk] =
+                                pk_column->GetChunkIDByOffset(offset);
+                            return reinterpret_cast<const int64_t*>(
+                                pk_column->Data(chunk_id))[offset_in_chunk];
+                        });
+                }
+                case DataType::VARCHAR: {
+                    auto var_column = std::dynamic_pointer_cast<
+                        ChunkedVariableColumn<std::string>>(pk_column);
+                    if (var_column == nullptr) {
+                        break;
+                    }
+                    return find_first_by_heap(
+                        limit, bitset, [&var_column](int64_t offset) {
+                            return var_column->RawAt(offset);
+                        });
+                }
+                default:
+                    break;
+            }
+        }
         return insert_record_.pk2offset_->find_first(limit, bitset);
     }
     if (limit == Unlimited || limit == NoLimit) {
@@ -1401,11 +1541,20 @@ ChunkedSegmentSealedImpl::bulk_subscript_impl(const ChunkedColumnBase* field,
                                               int64_t count,
                                               T* dst) {
     static_assert(IsScalar<T>);
-    for (int64_t i = 0; i < count; ++i) {
-        auto offset = seg_offsets[i];
-        dst[i] = *static_cast<const S*>(
-            static_cast<const void*>(field->ValueAt(offset)));
-    }
+    field->ForEachRun(
+        seg_offsets,
+        count,
+        [&](int64_t chunk_id, int64_t offset_in_chunk, int64_t i, int64_t n) {
+            auto src = reinterpret_cast<const S*>(
+                field->ChunkValueAt(chunk_id, offset_in_chunk));
+            if constexpr (std::is_same_v<S, T>) {
+                std::copy_n(src, n, dst + i);
+            } else {
+                for (int64_t j = 0; j < n; ++j) {
+                    dst[i + j] = src[j];
+                }
+            }
+        });
 }
 
 template <typename S, typename T>
@@ -1430,10 +1579,10 @@ ChunkedSegmentSealedImpl::bulk_subscript_ptr_impl(
     int64_t count,
     google::protobuf::RepeatedPtrField<T>* dst) {
     auto field = reinterpret_cast<const ChunkedVariableColumn<S>*>(column);
-    for (int64_t i = 0; i < count; ++i) {
-        auto offset = seg_offsets[i];
-        dst->at(i) = std::move(T(field->RawAt(offset)));
-    }
+    // copied into the strings fill_with_empty already allocated
+    field->BulkRawAt(seg_offsets, count, [&](int64_t i, std::string_view raw) {
+        dst->at(i).assign(raw.data(), raw.size());
+    });
 }
 
 template <typename T>
@@ -1444,10 +1593,9 @@ ChunkedSegmentSealedImpl::bulk_subscript_array_impl(
     int64_t count,
     google::protobuf::RepeatedPtrField<T>* dst) {
     auto field = reinterpret_cast<const ChunkedArrayColumn*>(column);
-    for (int64_t i = 0; i < count; ++i) {
-        auto offset = seg_offsets[i];
-        dst->at(i) = std::move(field->RawAt(offset));
-    }
+    field->BulkRawAt(seg_offsets, count, [&](int64_t i, const ArrayView& view) {
+        dst->at(i) = view.output_data();
+    });
 }
 
 // for dense vector
@@ -1458,12 +1606,14 @@ ChunkedSegmentSealedImpl::bulk_subscript_impl(int64_t element_sizeof,
                                               int64_t count,
                                               void* dst_raw) {
     auto dst_vec = reinterpret_cast<char*>(dst_raw);
-    for (int64_t i = 0; i < count; ++i) {
-        auto offset = seg_offsets[i];
-        auto src = field->ValueAt(offset);
-        auto dst = dst_vec + i * element_sizeof;
-        memcpy(dst, src, element_sizeof);
-    }
+    field->ForEachRun(
+        seg_offsets,
+        count,
+        [&](int64_t chunk_id, int64_t offset_in_chunk, int64_t i, int64_t n) {
+            memcpy(dst_vec + i * element_sizeof,
+                   field->ChunkValueAt(chunk_id, offset_in_chunk),
+                   n * element_sizeof);
+        });
 }
 
 void
@@ -1479,9 +1629,15 @@ ChunkedSegmentSealedImpl::ClearData() {
         vector_indexings_.clear();
         insert_record_.clear();
         fields_.clear();
+        std::atomic_store(&clustering_centroids_,
+                          std::make_shared<const ClusteringCentroidsMap>());
+        while (!shredded_json_fields_.empty()) {
+            DropJsonShredding(shredded_json_fields_.begin()->first);
+        }
         variable_fields_avg_size_.clear();
         stats_.mem_size = 0;
     }
+    InvalidateFilterCache();
     auto cc = storage::MmapManager::GetInstance().GetChunkCache();
     if (cc == nullptr) {
         return;
@@ -1579,6 +1735,7 @@ ChunkedSegmentSealedImpl::CreateTextIndex(FieldId field_id) {
                              field_meta.get_analyzer_params().c_str());
 
     text_indexes_[field_id] = std::move(index);
+    InvalidateFilterCache();
 }
 
 void
@@ -1589,6 +1746,7 @@ ChunkedSegmentSealedImpl::LoadTextIndex(
     index->RegisterTokenizer("milvus_tokenizer",
                              field_meta.get_analyzer_params().c_str());
     text_indexes_[field_id] = std::move(index);
+    InvalidateFilterCache();
 }
 
 std::unique_ptr<DataArray>
@@ -2157,4 +2315,48 @@ ChunkedSegmentSealedImpl::RemoveFieldFile(const FieldId field_id) {
     }
 }
 
+void
+ChunkedSegmentSealedImpl::LoadClusteringCentroids(
+    FieldId field_id,
+    const proto::clustering::ClusteringCentroidsStats& centroids,
+    const proto::clustering::ClusteringCentroidIdMappingStats& id_mapping) {
+    std::unique_lock lck(mutex_);
+    auto& field_meta = schema_->operator[](field_id);
+    AssertInfo(field_meta.get_data_type() == DataType::VECTOR_FLOAT,
+               "clustering of field {} of type {}",
+               field_id.get(),
+               field_meta.get_data_type());
+    AssertInfo(num_rows_.has_value(), "Can't get row count value");
+    auto dim = field_meta.get_dim();
+    // a field only loaded as an index has no radii, its searches are only
+    // pruned by the probe ratio
+    query::VectorAt vector_at;
+    if (get_bit(field_data_ready_bitset_, field_id)) {
+        auto column = fields_.at(field_id);
+        vector_at = [column](int64_t offset) {
+            return reinterpret_cast<const float*>(column->ValueAt(offset));
+        };
+    }
+    auto clusters = query::BuildClusteringCentroids(
+        centroids, id_mapping, dim, num_rows_.value(), vector_at);
+    auto updated =
+        std::make_shared<ClusteringCentroidsMap>(*clustering_centroids_);
+    auto& slot = (*updated)[field_id];
+    if (slot != nullptr) {
+        stats_.mem_size -= slot->ByteSize();
+    }
+    stats_.mem_size += clusters->ByteSize();
+    slot = std::move(clusters);
+    std::atomic_store(
+        &clustering_centroids_,
+        std::shared_ptr<const ClusteringCentroidsMap>(std::move(updated)));
+}
+
+query::ClusteringCentroidsPtr
+ChunkedSegmentSealedImpl::GetClusteringCentroids(FieldId field_id) const {
+    auto clusters = std::atomic_load(&clustering_centroids_);
+    auto iter = clusters->find(field_id);
+    return iter == clusters->end() ? nullptr : iter->second;
+}
+
 }  // namespace milvus::segcore
@@ -34,6 +34,7 @@
 #include "sys/mman.h"
 #include "common/Types.h"
 #include "common/IndexMeta.h"
+#include "query/ClusteringPruning.h"
 
 namespace milvus::segcore {
 
@@ -98,6 +99,17 @@ class ChunkedSegmentSealedImpl : public SegmentSealed {
     LoadTextIndex(FieldId field_id,
                   std::unique_ptr<index::TextMatchIndex> index) override;
 
+    void
+    LoadClusteringCentroids(
+        FieldId field_id,
+        const proto::clustering::ClusteringCentroidsStats& centroids,
+        const proto::clustering::ClusteringCentroidIdMappingStats& id_mapping)
+        override;
+
+    // the clusters of the vector field, nullptr if none is loaded
+    query::ClusteringCentroidsPtr
+    GetClusteringCentroids(FieldId field_id) const;
+
  public:
     size_t
     GetMemoryUsageInBytes() const override {
@@ -142,6 +154,11 @@ class ChunkedSegmentSealedImpl : public SegmentSealed {
         return true;
     }
 
+    bool
+    is_sorted_by_pk() const override {
+        return is_sorted_by_pk_;
+    }
+
  public:
     int64_t
     num_chunk_index(FieldId field_id) const override;
@@ -212,6 +229,25 @@ class ChunkedSegmentSealedImpl : public SegmentSealed {
                      int64_t start_offset,
                      int64_t length) const override;
 
+    std::pair<std::vector<ArrayView>, FixedVector<bool>>
+    chunk_array_views_impl(FieldId field_id,
+                           int64_t chunk_id,
+                           int64_t start_offset,
+                           int64_t length) const override;
+
+    std::pair<std::vector<Json>, FixedVector<bool>>
+    chunk_json_views_impl(FieldId field_id,
+                          int64_t chunk_id,
+                          int64_t start_offset,
+                          int64_t length) const override;
+
+    std::pair<StringBatchView, const bool*>
+    chunk_string_batch_impl(FieldId field_id,
+                            int64_t chunk_id,
+                            int64_t start_offset,
+                            int64_t length,
+                            std::vector<uint64_t>& offsets_buf) const override;
+
     const index::IndexBase*
     chunk_index_impl(FieldId field_id, int64_t chunk_id) const override;
 
@@ -385,6 +421,14 @@ class ChunkedSegmentSealedImpl : public SegmentSealed {
 
     // whether the segment is sorted by the pk
     bool is_sorted_by_pk_ = false;
+
+    // clusters of the rows of the vector fields, dropped with their data.
+    // The map is immutable, it's replaced under mutex_ and read with
+    // std::atomic_load, as searches already hold mutex_ shared.
+    using ClusteringCentroidsMap =
+        std::unordered_map<FieldId, query::ClusteringCentroidsPtr>;
+    std::shared_ptr<const ClusteringCentroidsMap> clustering_centroids_ =
+        std::make_shared<const ClusteringCentroidsMap>();
 };
 
 }  // namespace milvus::segcore
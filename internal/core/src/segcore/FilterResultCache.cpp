@@ -0,0 +1,186 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "segcore/FilterResultCache.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include "common/EasyAssert.h"
+#include "monitor/prometheus_client.h"
+#include "segcore/SegcoreConfig.h"
+
+namespace milvus::segcore {
+
+FilterResultCache::CompressedBits::CompressedBits(const TargetBitmap& bits)
+    : size_(bits.size()) {
+    inverted_ = static_cast<int64_t>(bits.count()) * 2 > size_;
+    auto add_bits = [&](const TargetBitmap& set_bits) {
+        for (auto i = set_bits.find_first(); i.has_value();
+             i = set_bits.find_next(i.value())) {
+            sparse_.add(static_cast<uint32_t>(i.value()));
+        }
+    };
+    if (inverted_) {
+        auto unset_bits = bits.clone();
+        unset_bits.flip();
+        add_bits(unset_bits);
+    } else {
+        add_bits(bits);
+    }
+    sparse_.runOptimize();
+    if (sparse_.getSizeInBytes() >= bits.size_in_bytes()) {
+        sparse_ = roaring::Roaring();
+        inverted_ = false;
+        dense_ = bits.clone();
+    }
+}
+
+TargetBitmap
+FilterResultCache::CompressedBits::Decompress() const {
+    if (dense_.has_value()) {
+        return dense_->clone();
+    }
+    TargetBitmap bits(size_, inverted_);
+    for (auto i : sparse_) {
+        bits.set(i, !inverted_);
+    }
+    return bits;
+}
+
+size_t
+FilterResultCache::CompressedBits::bytes() const {
+    return dense_.has_value() ? dense_->size_in_bytes()
+                              : sparse_.getSizeInBytes();
+}
+
+FilterResultCache&
+FilterResultCache::GetInstance() {
+    static FilterResultCache instance;
+    return instance;
+}
+
+int64_t
+FilterResultCache::NextSegmentKey() {
+    static std::atomic<int64_t> next_key{0};
+    return next_key++;
+}
+
+bool
+FilterResultCache::Get(int64_t segment_key,
+                       const std::string& filter,
+                       int64_t num_rows,
+                       TargetBitmap& result,
+                       TargetBitmap& valid_result) {
+    auto& shard = ShardOf(segment_key);
+    std::unique_lock<std::mutex> lck(shard.mutex_);
+    auto segment = shard.index_.find(segment_key);
+    if (segment != shard.index_.end()) {
+        auto it = segment->second.find(filter);
+        if (it != segment->second.end()) {
+            auto& entry = *it->second;
+            // the segment held fewer rows when the entry was cached
+            if (entry.result_.size() == num_rows) {
+                shard.entries_.splice(
+                    shard.entries_.begin(), shard.entries_, it->second);
+                result = entry.result_.Decompress();
+                valid_result = entry.valid_result_.Decompress();
+                monitor::internal_core_filter_cache_requests_hit.Increment();
+                return true;
+            }
+        }
+    }
+    monitor::internal_core_filter_cache_requests_miss.Increment();
+    return false;
+}
+
+void
+FilterResultCache::Put(int64_t segment_key,
+                       const std::function<int64_t()>& current_segment_key,
+                       const std::string& filter,
+                       const TargetBitmap& result,
+                       const TargetBitmap& valid_result) {
+    AssertInfo(result.size() == valid_result.size(),
+               "filter result of {} rows with valid bits of {} rows",
+               result.size(),
+               valid_result.size());
+    auto capacity = std::max<int64_t>(
+        SegcoreConfig::default_config().get_filter_cache_capacity(), 0);
+    auto shard_capacity = static_cast<size_t>(capacity) / kNumShards;
+    Entry entry{segment_key,
+                filter,
+                CompressedBits(result),
+                CompressedBits(valid_result),
+                0};
+    entry.bytes_ = entry.result_.bytes() + entry.valid_result_.bytes() +
+                   filter.size() + sizeof(Entry);
+
+    auto& shard = ShardOf(segment_key);
+    std::unique_lock<std::mutex> lck(shard.mutex_);
+    // the segment takes a new key before it erases the entries of the old
+    // one under this lock, so an entry put after that is never erased
+    if (current_segment_key() != segment_key) {
+        return;
+    }
+    auto segment = shard.index_.find(segment_key);
+    if (segment != shard.index_.end()) {
+        auto it = segment->second.find(filter);
+        if (it != segment->second.end()) {
+            Erase(shard, it->second);
+        }
+    }
+    if (entry.bytes_ <= shard_capacity) {
+        while (shard.bytes_ + entry.bytes_ > shard_capacity) {
+            Erase(shard, std::prev(shard.entries_.end()));
+        }
+        shard.bytes_ += entry.bytes_;
+        bytes_ += entry.bytes_;
+        shard.entries_.push_front(std::move(entry));
+        shard.index_[segment_key][filter] = shard.entries_.begin();
+    }
+    monitor::internal_core_filter_cache_bytes_used.Set(bytes_.load());
+}
+
+void
+FilterResultCache::EraseSegment(int64_t segment_key) {
+    auto& shard = ShardOf(segment_key);
+    std::unique_lock<std::mutex> lck(shard.mutex_);
+    auto segment = shard.index_.find(segment_key);
+    if (segment == shard.index_.end()) {
+        return;
+    }
+    for (auto& [filter, entry] : segment->second) {
+        shard.bytes_ -= entry->bytes_;
+        bytes_ -= entry->bytes_;
+        shard.entries_.erase(entry);
+    }
+    shard.index_.erase(segment);
+    monitor::internal_core_filter_cache_bytes_used.Set(bytes_.load());
+}
+
+size_t
+FilterResultCache::bytes() const {
+    return bytes_.load();
+}
+
+void
+FilterResultCache::Erase(Shard& shard, EntryIter entry) {
+    auto segment = shard.index_.find(entry->segment_key_);
+    segment->second.erase(entry->filter_);
+    if (segment->second.empty()) {
+        shard.index_.erase(segment);
+    }
+    shard.bytes_ -= entry->bytes_;
+    bytes_ -= entry->bytes_;
+    shard.entries_.erase(entry);
+}
+
+}  // namespace milvus::segcore
@@ -0,0 +1,136 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include <roaring/roaring.hh>
+
+#include "common/Types.h"
+
+namespace milvus::segcore {
+
+// LRU cache of the bits of the filters evaluated on sealed segments, shared
+// by the queries with the same filter. An entry is keyed by the filter key of
+// its segment, which changes whenever the data or the indexes the filter may
+// read change, and by the expr::StructuralKey of the filter expr. The bits
+// are taken before deletes and timestamps are applied, so they don't go stale
+// when rows are deleted.
+//
+// The bits are kept as a roaring bitmap of the less common of the set and
+// the unset bits if that takes less memory than the bits themselves. The
+// entries are spread over shards by their segment key, each with its own
+// lock and an even share of the filter cache capacity of SegcoreConfig, read
+// on every Put.
+class FilterResultCache {
+ public:
+    static FilterResultCache&
+    GetInstance();
+
+    // a filter key no segment took before
+    static int64_t
+    NextSegmentKey();
+
+    // fills the bits and the valid bits of the filter on num_rows rows of
+    // the segment, returns false if they are not cached
+    bool
+    Get(int64_t segment_key,
+        const std::string& filter,
+        int64_t num_rows,
+        TargetBitmap& result,
+        TargetBitmap& valid_result);
+
+    // current_segment_key returns the filter key the segment has now, the
+    // bits are dropped if it's no longer segment_key as the segment was
+    // changed while they were evaluated
+    void
+    Put(int64_t segment_key,
+        const std::function<int64_t()>& current_segment_key,
+        const std::string& filter,
+        const TargetBitmap& result,
+        const TargetBitmap& valid_result);
+
+    void
+    EraseSegment(int64_t segment_key);
+
+    size_t
+    bytes() const;
+
+ private:
+    FilterResultCache() = default;
+
+    class CompressedBits {
+     public:
+        explicit CompressedBits(const TargetBitmap& bits);
+
+        TargetBitmap
+        Decompress() const;
+
+        size_t
+        bytes() const;
+
+        int64_t
+        size() const {
+            return size_;
+        }
+
+     private:
+        int64_t size_;
+        // the roaring bitmap holds the unset bits instead of the set ones
+        bool inverted_ = false;
+        roaring::Roaring sparse_;
+        std::optional<TargetBitmap> dense_;
+    };
+
+    struct Entry {
+        int64_t segment_key_;
+        std::string filter_;
+        CompressedBits result_;
+        CompressedBits valid_result_;
+        size_t bytes_;
+    };
+    using EntryIter = std::list<Entry>::iterator;
+
+    struct Shard {
+        std::mutex mutex_;
+        // most recently used first
+        std::list<Entry> entries_;
+        std::unordered_map<int64_t,
+                           std::unordered_map<std::string, EntryIter>>
+            index_;
+        size_t bytes_ = 0;
+    };
+
+    static constexpr size_t kNumShards = 16;
+
+    Shard&
+    ShardOf(int64_t segment_key) {
+        return shards_[static_cast<uint64_t>(segment_key) % kNumShards];
+    }
+
+    // the lock of the shard must be held by the caller
+    void
+    Erase(Shard& shard, EntryIter entry);
+
+    std::array<Shard, kNumShards> shards_;
+    // bytes of the entries of all the shards
+    std::atomic<size_t> bytes_{0};
+};
+
+}  // namespace milvus::segcore
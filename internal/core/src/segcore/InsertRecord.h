@@ -510,10 +510,14 @@ struct InsertRecord {
                     ChunkedVariableColumn<std::string>>(data);
 
                 auto num_chunk = column->num_chunks();
+                std::vector<uint64_t> offsets_buf;
                 for (int i = 0; i < num_chunk; ++i) {
-                    auto pks = column->StringViews(i).first;
-                    for (auto& pk : pks) {
-                        pk2offset_->insert(std::string(pk), offset++);
+                    auto chunk_num_rows = column->chunk_row_nums(i);
+                    auto pks =
+                        column->StringBatch(i, 0, chunk_num_rows, offsets_buf)
+                            .first;
+                    for (int j = 0; j < chunk_num_rows; ++j) {
+                        pk2offset_->insert(std::string(pks[j]), offset++);
                     }
                 }
                 break;
@@ -544,7 +548,10 @@ struct InsertRecord {
             case DataType::VARCHAR: {
                 auto column = std::dynamic_pointer_cast<
                     SingleChunkVariableColumn<std::string>>(data);
-                auto pks = column->Views();
+                std::vector<uint64_t> offsets_buf;
+                auto pks =
+                    column->StringBatch(0, column->NumRows(), offsets_buf)
+                        .first;
 
                 for (int i = 0; i < column->NumRows(); ++i) {
                     pk2offset_->insert(std::string(pks[i]), offset++);
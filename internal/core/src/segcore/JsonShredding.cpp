@@ -0,0 +1,334 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "segcore/JsonShredding.h"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include <utility>
+
+#include "common/EasyAssert.h"
+#include "common/JsonBinary.h"
+
+namespace milvus::segcore {
+
+namespace {
+
+struct Candidate {
+    DataType data_type{DataType::NONE};
+    int64_t count{0};
+    bool conflict{false};
+};
+
+using Candidates = std::unordered_map<std::string, Candidate>;
+
+DataType
+ShreddedDataType(JsonBinaryType type) {
+    switch (type) {
+        case JsonBinaryType::INT64:
+            return DataType::INT64;
+        case JsonBinaryType::DOUBLE:
+            return DataType::DOUBLE;
+        case JsonBinaryType::STRING:
+            return DataType::VARCHAR;
+        default:
+            return DataType::NONE;
+    }
+}
+
+// same escaping as Json::pointer
+void
+AppendPointerToken(std::string& pointer, std::string_view key) {
+    pointer.push_back('/');
+    for (auto c : key) {
+        if (c == '~') {
+            pointer.append("~0");
+        } else if (c == '/') {
+            pointer.append("~1");
+        } else {
+            pointer.push_back(c);
+        }
+    }
+}
+
+void
+CollectPaths(const JsonBinaryValue& object,
+             std::string& pointer,
+             int depth,
+             Candidates& candidates) {
+    for (uint32_t i = 0; i < object.size(); i++) {
+        auto key = object.key_at(i);
+        // keys are sorted, lookups of a duplicated key find the first one
+        if (i > 0 && key == object.key_at(i - 1)) {
+            continue;
+        }
+        auto prefix_size = pointer.size();
+        AppendPointerToken(pointer, key);
+        auto value = object.value_at(i);
+
+        auto iter = candidates.find(pointer);
+        if (iter == candidates.end() &&
+            candidates.size() < JSON_SHREDDING_MAX_CANDIDATES) {
+            iter = candidates.emplace(pointer, Candidate{}).first;
+        }
+        if (iter != candidates.end()) {
+            auto& candidate = iter->second;
+            auto data_type = ShreddedDataType(value.type());
+            if (data_type == DataType::NONE ||
+                (candidate.data_type != DataType::NONE &&
+                 candidate.data_type != data_type)) {
+                candidate.conflict = true;
+            } else {
+                candidate.data_type = data_type;
+                candidate.count++;
+            }
+        }
+
+        if (value.type() == JsonBinaryType::OBJECT &&
+            depth + 1 < JSON_SHREDDING_MAX_DEPTH) {
+            CollectPaths(value, pointer, depth + 1, candidates);
+        }
+        pointer.resize(prefix_size);
+    }
+}
+
+}  // namespace
+
+ShreddedJsonPath::ShreddedJsonPath(std::string pointer,
+                                   DataType data_type,
+                                   int64_t num_rows)
+    : pointer_(std::move(pointer)),
+      data_type_(data_type),
+      num_rows_(num_rows),
+      presence_(num_rows, false) {
+    switch (data_type_) {
+        case DataType::INT64:
+            int64_data_.resize(num_rows);
+            break;
+        case DataType::DOUBLE:
+            double_data_.resize(num_rows);
+            break;
+        case DataType::VARCHAR:
+            string_offsets_.resize(num_rows + 1, 0);
+            break;
+        default:
+            PanicInfo(DataTypeInvalid,
+                      "unsupported data type {} of shredded json path",
+                      data_type_);
+    }
+}
+
+int64_t
+ShreddedJsonPath::ByteSize() const {
+    return presence_.size() * sizeof(bool) +
+           int64_data_.size() * sizeof(int64_t) +
+           double_data_.size() * sizeof(double) + string_data_.size() +
+           string_offsets_.size() * sizeof(uint64_t);
+}
+
+bool
+ShreddedJsonPath::Extract(int64_t offset, const Json& row) {
+    bool present = false;
+    if (row.binary() != nullptr) {
+        JsonBinaryValue value;
+        if (JsonBinaryValue(row.binary()).at_pointer(pointer_, value) ==
+            simdjson::SUCCESS) {
+            if (ShreddedDataType(value.type()) != data_type_) {
+                return false;
+            }
+            switch (data_type_) {
+                case DataType::INT64:
+                    value.get(int64_data_[offset]);
+                    break;
+                case DataType::DOUBLE:
+                    value.get(double_data_[offset]);
+                    break;
+                default: {
+                    std::string_view str;
+                    value.get(str);
+                    string_data_.append(str);
+                    break;
+                }
+            }
+            present = true;
+        }
+    } else {
+        // rows the binary encoding rejected are looked up on the text,
+        // which may still find values before the broken part of it
+        switch (data_type_) {
+            case DataType::INT64: {
+                auto x = row.at<int64_t>(pointer_);
+                if (!x.error()) {
+                    int64_data_[offset] = x.value();
+                    present = true;
+                }
+                break;
+            }
+            case DataType::DOUBLE: {
+                // integers are read as double too, but compare as int64
+                if (!row.at<int64_t>(pointer_).error()) {
+                    return false;
+                }
+                auto x = row.at<double>(pointer_);
+                if (!x.error()) {
+                    double_data_[offset] = x.value();
+                    present = true;
+                }
+                break;
+            }
+            default: {
+                auto x = row.at<std::string_view>(pointer_);
+                if (!x.error()) {
+                    string_data_.append(x.value());
+                    present = true;
+                }
+                break;
+            }
+        }
+        if (!present && row.exist(pointer_)) {
+            return false;
+        }
+    }
+    presence_[offset] = present;
+    if (data_type_ == DataType::VARCHAR) {
+        string_offsets_[offset + 1] = string_data_.size();
+    }
+    return true;
+}
+
+std::unique_ptr<ShreddedJsonField>
+ShreddedJsonField::Build(const BatchVisitor& visitor,
+                         int64_t num_rows,
+                         int64_t max_paths,
+                         double min_presence_ratio) {
+    if (num_rows == 0 || max_paths <= 0) {
+        return nullptr;
+    }
+
+    Candidates candidates;
+    std::string pointer;
+    visitor([&](const Json* rows, const bool* valid_data, int64_t count) {
+        for (int64_t i = 0; i < count; i++) {
+            if ((valid_data != nullptr && !valid_data[i]) ||
+                rows[i].binary() == nullptr) {
+                continue;
+            }
+            JsonBinaryValue root(rows[i].binary());
+            if (root.type() == JsonBinaryType::OBJECT) {
+                CollectPaths(root, pointer, 0, candidates);
+            }
+        }
+    });
+
+    auto min_count = std::max<int64_t>(
+        1, static_cast<int64_t>(std::ceil(min_presence_ratio * num_rows)));
+    std::vector<std::pair<std::string, Candidate>> selected;
+    for (auto& [path, candidate] : candidates) {
+        if (!candidate.conflict && candidate.count >= min_count) {
+            selected.emplace_back(path, candidate);
+        }
+    }
+    std::sort(selected.begin(),
+              selected.end(),
+              [](const auto& lhs, const auto& rhs) {
+                  if (lhs.second.count != rhs.second.count) {
+                      return lhs.second.count > rhs.second.count;
+                  }
+                  return lhs.first < rhs.first;
+              });
+    if (selected.size() > static_cast<size_t>(max_paths)) {
+        selected.resize(max_paths);
+    }
+    if (selected.empty()) {
+        return nullptr;
+    }
+
+    auto field = std::make_unique<ShreddedJsonField>();
+    field->paths_.reserve(selected.size());
+    for (auto& [path, candidate] : selected) {
+        field->paths_.emplace_back(path, candidate.data_type, num_rows);
+    }
+
+    // the scan above only follows objects, a path is dropped if a lookup
+    // resolves it to a value of another type, e.g. through array indexes
+    std::vector<bool> dropped(field->paths_.size(), false);
+    int64_t offset = 0;
+    visitor([&](const Json* rows, const bool* valid_data, int64_t count) {
+        AssertInfo(offset + count <= num_rows,
+                   "json rows {} exceed num rows {}",
+                   offset + count,
+                   num_rows);
+        if (valid_data != nullptr) {
+            field->valid_data_.resize(num_rows, true);
+            std::copy(
+                valid_data, valid_data + count, &field->valid_data_[offset]);
+        }
+        for (int64_t i = 0; i < count; i++, offset++) {
+            bool valid = valid_data == nullptr || valid_data[i];
+            for (size_t j = 0; j < field->paths_.size(); j++) {
+                auto& path = field->paths_[j];
+                if (!valid) {
+                    if (path.data_type_ == DataType::VARCHAR) {
+                        path.string_offsets_[offset + 1] =
+                            path.string_data_.size();
+                    }
+                    continue;
+                }
+                if (!dropped[j] && !path.Extract(offset, rows[i])) {
+                    dropped[j] = true;
+                }
+            }
+        }
+    });
+    AssertInfo(offset == num_rows,
+               "json rows {} not equal to num rows {}",
+               offset,
+               num_rows);
+
+    std::vector<ShreddedJsonPath> paths;
+    for (size_t j = 0; j < field->paths_.size(); j++) {
+        if (!dropped[j]) {
+            paths.emplace_back(std::move(field->paths_[j]));
+        }
+    }
+    if (paths.empty()) {
+        return nullptr;
+    }
+    field->paths_ = std::move(paths);
+    return field;
+}
+
+const ShreddedJsonPath*
+ShreddedJsonField::GetPath(const std::string& pointer) const {
+    for (auto& path : paths_) {
+        if (path.pointer() == pointer) {
+            return &path;
+        }
+    }
+    return nullptr;
+}
+
+int64_t
+ShreddedJsonField::ByteSize() const {
+    int64_t size = valid_data_.size() * sizeof(bool);
+    for (auto& path : paths_) {
+        size += path.ByteSize();
+    }
+    return size;
+}
+
+}  // namespace milvus::segcore
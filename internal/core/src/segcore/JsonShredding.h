@@ -0,0 +1,149 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/Common.h"
+#include "common/Json.h"
+#include "common/Types.h"
+
+namespace milvus::segcore {
+
+// rows of a shredded path are grouped into blocks of this size, SkipIndex
+// keeps the min/max of every block
+constexpr int64_t JSON_SHREDDING_BLOCK_SIZE = 8192;
+// bounds of the scan looking for paths to shred: objects nested deeper are
+// not visited, and no new path is tracked once this many have been seen so
+// fields with high cardinality keys don't blow up the scan
+constexpr int JSON_SHREDDING_MAX_DEPTH = 4;
+constexpr size_t JSON_SHREDDING_MAX_CANDIDATES = 1024;
+
+// A path of a JSON field extracted into a typed column when the sealed
+// segment is loaded. The row of a path is present iff the JSON lookup of
+// the path succeeds, and every present row holds a value of data_type(),
+// so filters on the path are evaluated on the column with the same result
+// as on the JSON rows.
+class ShreddedJsonPath {
+ public:
+    ShreddedJsonPath(std::string pointer, DataType data_type, int64_t num_rows);
+
+    const std::string&
+    pointer() const {
+        return pointer_;
+    }
+
+    // INT64, DOUBLE or VARCHAR
+    DataType
+    data_type() const {
+        return data_type_;
+    }
+
+    int64_t
+    num_rows() const {
+        return num_rows_;
+    }
+
+    // false for null rows and rows where the path is missing
+    const bool*
+    presence() const {
+        return presence_.data();
+    }
+
+    // values of INT64 and DOUBLE paths, 0 for rows not present
+    template <typename T>
+    const T*
+    data() const {
+        if constexpr (std::is_same_v<T, int64_t>) {
+            return int64_data_.data();
+        } else {
+            static_assert(std::is_same_v<T, double>,
+                          "unsupported type of shredded json path");
+            return double_data_.data();
+        }
+    }
+
+    // values of VARCHAR paths, empty for rows not present
+    StringBatchView
+    string_data() const {
+        return StringBatchView{string_data_.data(), string_offsets_.data(), 0};
+    }
+
+    int64_t
+    ByteSize() const;
+
+ private:
+    friend class ShreddedJsonField;
+
+    // returns false if the row holds a value of another type at the path
+    bool
+    Extract(int64_t offset, const Json& row);
+
+    std::string pointer_;
+    DataType data_type_;
+    int64_t num_rows_;
+    FixedVector<bool> presence_;
+    std::vector<int64_t> int64_data_;
+    std::vector<double> double_data_;
+    std::string string_data_;
+    std::vector<uint64_t> string_offsets_;
+};
+
+// shredded paths of a JSON field of a sealed segment
+class ShreddedJsonField {
+ public:
+    using BatchCallback = std::function<void(
+        const Json* rows, const bool* valid_data, int64_t count)>;
+    // calls the callback with all the rows of the field in row order
+    using BatchVisitor = std::function<void(const BatchCallback&)>;
+
+    // scans the rows and extracts at most max_paths paths, each of them
+    // holding values of a single supported type and present in at least
+    // min_presence_ratio of the rows, returns nullptr if no path qualifies
+    static std::unique_ptr<ShreddedJsonField>
+    Build(const BatchVisitor& visitor,
+          int64_t num_rows,
+          int64_t max_paths,
+          double min_presence_ratio);
+
+    // nullptr if the path is not shredded
+    const ShreddedJsonPath*
+    GetPath(const std::string& pointer) const;
+
+    const std::vector<ShreddedJsonPath>&
+    paths() const {
+        return paths_;
+    }
+
+    // validity of the rows, nullptr if the field is not nullable
+    const bool*
+    valid_data() const {
+        return valid_data_.empty() ? nullptr : valid_data_.data();
+    }
+
+    int64_t
+    ByteSize() const;
+
+ private:
+    std::vector<ShreddedJsonPath> paths_;
+    FixedVector<bool> valid_data_;
+};
+
+}  // namespace milvus::segcore
@@ -0,0 +1,188 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "segcore/RetrieveCursor.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "monitor/prometheus_client.h"
+#include "segcore/SegcoreConfig.h"
+
+namespace milvus::segcore {
+
+RetrieveCursor::RetrieveCursor(Timestamp timestamp,
+                               size_t plan_hash,
+                               const std::vector<int64_t>& offsets)
+    : timestamp_(timestamp),
+      plan_hash_(plan_hash),
+      remaining_(offsets.size()) {
+    auto sorted = std::is_sorted(offsets.begin(), offsets.end()) &&
+                  (offsets.empty() ||
+                   offsets.back() <= std::numeric_limits<uint32_t>::max());
+    if (sorted) {
+        sorted_offsets_.emplace();
+        for (auto offset : offsets) {
+            sorted_offsets_->add(static_cast<uint32_t>(offset));
+        }
+        sorted_offsets_->runOptimize();
+    } else {
+        offsets_ = offsets;
+    }
+}
+
+std::vector<int64_t>
+RetrieveCursor::Peek(int64_t limit) const {
+    if (limit <= 0 || limit > remaining_) {
+        limit = remaining_;
+    }
+    std::vector<int64_t> page;
+    page.reserve(limit);
+    if (sorted_offsets_.has_value()) {
+        auto it = sorted_offsets_->begin();
+        it.equalorlarger(next_offset_);
+        for (; static_cast<int64_t>(page.size()) < limit; ++it) {
+            page.push_back(*it);
+        }
+    } else {
+        page.assign(offsets_.begin() + position_,
+                    offsets_.begin() + position_ + limit);
+    }
+    return page;
+}
+
+void
+RetrieveCursor::Advance(const std::vector<int64_t>& page) {
+    if (page.empty()) {
+        return;
+    }
+    if (sorted_offsets_.has_value()) {
+        next_offset_ = static_cast<uint32_t>(page.back()) + 1;
+    } else {
+        position_ += page.size();
+    }
+    remaining_ -= page.size();
+}
+
+size_t
+RetrieveCursor::bytes() const {
+    auto offsets_bytes = sorted_offsets_.has_value()
+                             ? sorted_offsets_->getSizeInBytes()
+                             : offsets_.capacity() * sizeof(int64_t);
+    return offsets_bytes + sizeof(RetrieveCursor);
+}
+
+RetrieveCursorManager&
+RetrieveCursorManager::GetInstance() {
+    static RetrieveCursorManager instance;
+    return instance;
+}
+
+std::unique_ptr<RetrieveCursor>
+RetrieveCursorManager::Take(int64_t segment_key, int64_t cursor_id) {
+    std::unique_lock<std::mutex> lck(mutex_);
+    EraseExpired(Clock::now());
+    auto it = index_.find({segment_key, cursor_id});
+    if (it == index_.end()) {
+        monitor::internal_core_retrieve_cursor_requests_miss.Increment();
+        UpdateMetrics();
+        return nullptr;
+    }
+    auto cursor = std::move(it->second->cursor_);
+    Erase(it->second);
+    monitor::internal_core_retrieve_cursor_requests_hit.Increment();
+    UpdateMetrics();
+    return cursor;
+}
+
+void
+RetrieveCursorManager::Put(int64_t segment_key,
+                           int64_t cursor_id,
+                           std::unique_ptr<RetrieveCursor> cursor) {
+    auto capacity = static_cast<size_t>(std::max<int64_t>(
+        SegcoreConfig::default_config().get_retrieve_cursor_capacity(), 0));
+    auto now = Clock::now();
+    Key key{segment_key, cursor_id};
+    Entry entry{key, std::move(cursor), 0, now};
+    entry.bytes_ = entry.cursor_->bytes() + sizeof(Entry);
+
+    std::unique_lock<std::mutex> lck(mutex_);
+    EraseExpired(now);
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+        Erase(it->second);
+    }
+    if (entry.bytes_ > capacity) {
+        UpdateMetrics();
+        return;
+    }
+    while (bytes_ + entry.bytes_ > capacity) {
+        Erase(std::prev(entries_.end()));
+    }
+    bytes_ += entry.bytes_;
+    entries_.push_front(std::move(entry));
+    index_[key] = entries_.begin();
+    UpdateMetrics();
+}
+
+void
+RetrieveCursorManager::EraseSegment(int64_t segment_key) {
+    std::unique_lock<std::mutex> lck(mutex_);
+    auto it = index_.lower_bound(
+        {segment_key, std::numeric_limits<int64_t>::min()});
+    while (it != index_.end() && it->first.first == segment_key) {
+        auto entry = (it++)->second;
+        Erase(entry);
+    }
+    UpdateMetrics();
+}
+
+void
+RetrieveCursorManager::Close(int64_t cursor_id) {
+    std::unique_lock<std::mutex> lck(mutex_);
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        auto entry = it++;
+        if (entry->key_.second == cursor_id) {
+            Erase(entry);
+        }
+    }
+    UpdateMetrics();
+}
+
+size_t
+RetrieveCursorManager::bytes() const {
+    std::unique_lock<std::mutex> lck(mutex_);
+    return bytes_;
+}
+
+void
+RetrieveCursorManager::Erase(EntryIter entry) {
+    index_.erase(entry->key_);
+    bytes_ -= entry->bytes_;
+    entries_.erase(entry);
+}
+
+void
+RetrieveCursorManager::EraseExpired(Clock::time_point now) {
+    auto ttl = std::chrono::seconds(
+        SegcoreConfig::default_config().get_retrieve_cursor_ttl());
+    // the least recently used cursors expire first
+    while (!entries_.empty() && entries_.back().last_used_ + ttl <= now) {
+        Erase(std::prev(entries_.end()));
+    }
+}
+
+void
+RetrieveCursorManager::UpdateMetrics() {
+    monitor::internal_core_retrieve_cursor_bytes_used.Set(bytes_);
+}
+
+}  // namespace milvus::segcore
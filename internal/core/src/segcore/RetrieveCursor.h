@@ -0,0 +1,149 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <chrono>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <roaring/roaring.hh>
+
+#include "common/Types.h"
+
+namespace milvus::segcore {
+
+// The offsets of the rows of a segment passing the filter of a paged
+// retrieve, in the order of their primary keys, and the position of the
+// next page. The filter is evaluated once, when the cursor is opened, and
+// the pages are taken from the offsets at the timestamp of the first one.
+// The cursor is only read by the pages of a plan with the same hash of its
+// filters and output fields.
+//
+// Ascending offsets, the pk order of a sorted sealed segment, are kept as a
+// roaring bitmap, the others as they are.
+class RetrieveCursor {
+ public:
+    RetrieveCursor(Timestamp timestamp,
+                   size_t plan_hash,
+                   const std::vector<int64_t>& offsets);
+
+    // the offsets of the next page of at most limit rows, all the remaining
+    // ones if limit is not positive, the cursor stays on the page until it
+    // is advanced past it
+    std::vector<int64_t>
+    Peek(int64_t limit) const;
+
+    // moves the cursor past the page returned by Peek
+    void
+    Advance(const std::vector<int64_t>& page);
+
+    bool
+    has_more() const {
+        return remaining_ > 0;
+    }
+
+    Timestamp
+    timestamp() const {
+        return timestamp_;
+    }
+
+    size_t
+    plan_hash() const {
+        return plan_hash_;
+    }
+
+    size_t
+    bytes() const;
+
+ private:
+    Timestamp timestamp_;
+    size_t plan_hash_;
+    int64_t remaining_;
+
+    std::optional<roaring::Roaring> sorted_offsets_;
+    // the smallest offset of the next page
+    uint32_t next_offset_ = 0;
+
+    std::vector<int64_t> offsets_;
+    size_t position_ = 0;
+};
+
+// LRU cache of the open retrieve cursors. A cursor is keyed by the filter
+// key of its segment, so it is dropped along with the cached filter results
+// when the data or the indexes of the segment change, and by the cursor id
+// chosen by the caller for the whole paged retrieve.
+//
+// A cursor is taken out of the cache while a page is read and put back if
+// rows remain or the page fails. Cursors unused for the cursor ttl of
+// SegcoreConfig expire, and their memory is bounded by the cursor capacity,
+// a cursor larger than it is not kept. A retrieve which misses its cursor
+// opens it again.
+class RetrieveCursorManager {
+ public:
+    static RetrieveCursorManager&
+    GetInstance();
+
+    // the cursor, removed from the cache, or nullptr
+    std::unique_ptr<RetrieveCursor>
+    Take(int64_t segment_key, int64_t cursor_id);
+
+    void
+    Put(int64_t segment_key,
+        int64_t cursor_id,
+        std::unique_ptr<RetrieveCursor> cursor);
+
+    void
+    EraseSegment(int64_t segment_key);
+
+    // drops the cursors of the id on all the segments
+    void
+    Close(int64_t cursor_id);
+
+    size_t
+    bytes() const;
+
+ private:
+    using Clock = std::chrono::steady_clock;
+    using Key = std::pair<int64_t, int64_t>;
+
+    RetrieveCursorManager() = default;
+
+    struct Entry {
+        Key key_;
+        std::unique_ptr<RetrieveCursor> cursor_;
+        size_t bytes_;
+        Clock::time_point last_used_;
+    };
+    using EntryIter = std::list<Entry>::iterator;
+
+    void
+    Erase(EntryIter entry);
+
+    void
+    EraseExpired(Clock::time_point now);
+
+    void
+    UpdateMetrics();
+
+    mutable std::mutex mutex_;
+    // most recently used first
+    std::list<Entry> entries_;
+    std::map<Key, EntryIter> index_;
+    size_t bytes_ = 0;
+};
+
+}  // namespace milvus::segcore
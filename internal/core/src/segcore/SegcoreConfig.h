@@ -73,8 +73,85 @@ class SegcoreConfig {
         return enable_interim_segment_index_;
     }
 
+    // max number of paths of a JSON field extracted into typed columns when
+    // a sealed segment is loaded, 0 disables json shredding
+    void
+    set_json_shredding_max_paths(int64_t max_paths) {
+        json_shredding_max_paths_ = max_paths;
+    }
+
+    int64_t
+    get_json_shredding_max_paths() const {
+        return json_shredding_max_paths_;
+    }
+
+    // a path is only extracted if it holds a value in at least this ratio
+    // of the rows of the segment
+    void
+    set_json_shredding_min_presence_ratio(double ratio) {
+        json_shredding_min_presence_ratio_ = ratio;
+    }
+
+    double
+    get_json_shredding_min_presence_ratio() const {
+        return json_shredding_min_presence_ratio_;
+    }
+
+    // a search on an indexed sealed segment scans the vectors of the rows
+    // passing its filter exactly instead of searching the index if they
+    // are at most this ratio of the rows, 0 always searches the index
+    void
+    set_brute_force_filter_ratio(double ratio) {
+        brute_force_filter_ratio_ = ratio;
+    }
+
+    double
+    get_brute_force_filter_ratio() const {
+        return brute_force_filter_ratio_;
+    }
+
+    // memory the filter results of sealed segments reused by the queries
+    // with the same filter may take, 0 disables the cache
+    void
+    set_filter_cache_capacity(int64_t bytes) {
+        filter_cache_capacity_ = bytes;
+    }
+
+    int64_t
+    get_filter_cache_capacity() const {
+        return filter_cache_capacity_;
+    }
+
+    // memory the cursors of paged retrieves may take, 0 disables them
+    void
+    set_retrieve_cursor_capacity(int64_t bytes) {
+        retrieve_cursor_capacity_ = bytes;
+    }
+
+    int64_t
+    get_retrieve_cursor_capacity() const {
+        return retrieve_cursor_capacity_;
+    }
+
+    // seconds a retrieve cursor is kept while no page is read from it
+    void
+    set_retrieve_cursor_ttl(int64_t seconds) {
+        retrieve_cursor_ttl_ = seconds;
+    }
+
+    int64_t
+    get_retrieve_cursor_ttl() const {
+        return retrieve_cursor_ttl_;
+    }
+
  private:
     inline static bool enable_interim_segment_index_ = false;
+    inline static int64_t json_shredding_max_paths_ = 0;
+    inline static double json_shredding_min_presence_ratio_ = 0.5;
+    inline static double brute_force_filter_ratio_ = 0.01;
+    inline static int64_t filter_cache_capacity_ = 0;
+    inline static int64_t retrieve_cursor_capacity_ = 256 * 1024 * 1024;
+    inline static int64_t retrieve_cursor_ttl_ = 600;
     inline static int64_t chunk_rows_ = 32 * 1024;
     inline static int64_t nlist_ = 100;
     inline static int64_t nprobe_ = 4;
@@ -121,6 +121,36 @@ SegmentChunkReader::GetChunkDataAccessor<std::string>(
             }
             return chunk_data[current_chunk_pos++];
         };
+    } else if (segment_->type() == SegmentType::Sealed) {
+        // read values in place from the sealed chunk, only the accessed row
+        // is copied out
+        auto offsets_buf = std::make_shared<std::vector<uint64_t>>();
+        auto current_chunk_size =
+            segment_->chunk_size(field_id, current_chunk_id);
+        auto chunk_info = segment_->get_string_batch(
+            field_id, current_chunk_id, 0, current_chunk_size, *offsets_buf);
+        return [=,
+                &current_chunk_id,
+                &current_chunk_pos]() mutable -> const data_access_type {
+            if (current_chunk_pos >= current_chunk_size) {
+                current_chunk_id++;
+                current_chunk_pos = 0;
+                current_chunk_size =
+                    segment_->chunk_size(field_id, current_chunk_id);
+                chunk_info = segment_->get_string_batch(field_id,
+                                                        current_chunk_id,
+                                                        0,
+                                                        current_chunk_size,
+                                                        *offsets_buf);
+            }
+            auto chunk_valid_data = chunk_info.second;
+            if (chunk_valid_data && !chunk_valid_data[current_chunk_pos]) {
+                current_chunk_pos++;
+                return std::nullopt;
+            }
+
+            return std::string(chunk_info.first[current_chunk_pos++]);
+        };
     } else {
         auto chunk_info =
             segment_->chunk_view<std::string_view>(field_id, current_chunk_id);
@@ -248,6 +278,22 @@ SegmentChunkReader::GetChunkDataAccessor<std::string>(FieldId field_id,
             }
             return chunk_data[i];
         };
+    } else if (segment_->type() == SegmentType::Sealed) {
+        auto offsets_buf = std::make_shared<std::vector<uint64_t>>();
+        auto chunk_info =
+            segment_->get_string_batch(field_id,
+                                       chunk_id,
+                                       0,
+                                       segment_->chunk_size(field_id, chunk_id),
+                                       *offsets_buf);
+        return [chunk_data = chunk_info.first,
+                chunk_valid_data = chunk_info.second,
+                offsets_buf](int i) -> const data_access_type {
+            if (chunk_valid_data && !chunk_valid_data[i]) {
+                return std::nullopt;
+            }
+            return std::string(chunk_data[i]);
+        };
     } else {
         auto chunk_info =
             segment_->chunk_view<std::string_view>(field_id, chunk_id);
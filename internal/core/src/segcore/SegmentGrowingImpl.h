@@ -354,6 +354,37 @@ class SegmentGrowingImpl : public SegmentGrowing {
             "get_chunk_buffer interface not supported for growing segment");
     }
 
+    std::pair<std::vector<ArrayView>, FixedVector<bool>>
+    chunk_array_views_impl(FieldId field_id,
+                           int64_t chunk_id,
+                           int64_t start_offset,
+                           int64_t length) const override {
+        PanicInfo(ErrorCode::Unsupported,
+                  "chunk_array_views_impl interface not supported for growing "
+                  "segment");
+    }
+
+    std::pair<std::vector<Json>, FixedVector<bool>>
+    chunk_json_views_impl(FieldId field_id,
+                          int64_t chunk_id,
+                          int64_t start_offset,
+                          int64_t length) const override {
+        PanicInfo(ErrorCode::Unsupported,
+                  "chunk_json_views_impl interface not supported for growing "
+                  "segment");
+    }
+
+    std::pair<StringBatchView, const bool*>
+    chunk_string_batch_impl(FieldId field_id,
+                            int64_t chunk_id,
+                            int64_t start_offset,
+                            int64_t length,
+                            std::vector<uint64_t>& offsets_buf) const override {
+        PanicInfo(ErrorCode::Unsupported,
+                  "chunk_string_batch_impl interface not supported for "
+                  "growing segment");
+    }
+
     void
     check_search(const query::Plan* plan) const override {
         Assert(plan);
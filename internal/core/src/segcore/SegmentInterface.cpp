@@ -12,6 +12,8 @@
 #include "SegmentInterface.h"
 
 #include <cstdint>
+#include <functional>
+#include <string>
 
 #include "Utils.h"
 #include "common/EasyAssert.h"
@@ -19,9 +21,77 @@
 #include "common/Tracer.h"
 #include "common/Types.h"
 #include "query/ExecPlanNodeVisitor.h"
+#include "storage/ThreadPools.h"
 
 namespace milvus::segcore {
 
+namespace {
+
+// below this many rows an output field is materialized faster than it is
+// handed to a worker
+constexpr int64_t PARALLEL_FILL_MIN_ROWS = 1024;
+
+// calls fill(i) for the columns of the output fields, in parallel on the
+// pool of the search if there are enough rows
+template <typename F>
+void
+FillColumns(size_t num_columns, int64_t num_rows, const F& fill) {
+    if (num_columns > 1 && num_rows >= PARALLEL_FILL_MIN_ROWS) {
+        auto& pool = ThreadPools::GetThreadPool(ThreadPoolPriority::HIGH);
+        pool.ParallelFor(num_columns, TaskPriority::HIGH, fill);
+        return;
+    }
+    for (size_t i = 0; i < num_columns; ++i) {
+        fill(i);
+    }
+}
+
+void
+AppendFilterKeys(const plan::PlanNodePtr& node, std::string& key) {
+    if (auto filter =
+            std::dynamic_pointer_cast<const plan::FilterBitsNode>(node)) {
+        key += expr::StructuralKey(*filter->filter());
+    } else if (auto filter =
+                   std::dynamic_pointer_cast<const plan::FilterNode>(node)) {
+        key += expr::StructuralKey(*filter->filter());
+    }
+    for (auto& source : node->sources()) {
+        AppendFilterKeys(source, key);
+    }
+}
+
+// hash of the filters and the output fields of a retrieve plan, the limit
+// is left out as it may change from page to page
+size_t
+HashRetrievePlan(const query::RetrievePlan& plan) {
+    std::string key;
+    AppendFilterKeys(plan.plan_node_->plannodes_, key);
+    key += fmt::format("|{}|", plan.field_ids_.size());
+    for (auto field_id : plan.field_ids_) {
+        key += fmt::format("{},", field_id.get());
+    }
+    for (auto& field : plan.target_dynamic_fields_) {
+        key += fmt::format("{}:{}", field.size(), field);
+    }
+    return std::hash<std::string>{}(key);
+}
+
+}  // namespace
+
+SegmentInternalInterface::~SegmentInternalInterface() {
+    auto key = filter_cache_key_.load();
+    FilterResultCache::GetInstance().EraseSegment(key);
+    RetrieveCursorManager::GetInstance().EraseSegment(key);
+}
+
+void
+SegmentInternalInterface::InvalidateFilterCache() {
+    auto old_key =
+        filter_cache_key_.exchange(FilterResultCache::NextSegmentKey());
+    FilterResultCache::GetInstance().EraseSegment(old_key);
+    RetrieveCursorManager::GetInstance().EraseSegment(old_key);
+}
+
 void
 SegmentInternalInterface::FillPrimaryKeys(const query::Plan* plan,
                                           SearchResult& results) const {
@@ -56,22 +126,26 @@ SegmentInternalInterface::FillTargetEntry(const query::Plan* plan,
     AssertInfo(results.seg_offsets_.size() == size,
                "Size of result distances is not equal to size of ids");
 
-    std::unique_ptr<DataArray> field_data;
     // fill other entries except primary key by result_offset
-    for (auto field_id : plan->target_entries_) {
+    auto& target_entries = plan->target_entries_;
+    std::vector<std::unique_ptr<DataArray>> columns(target_entries.size());
+    FillColumns(columns.size(), size, [&](size_t i) {
+        auto field_id = target_entries[i];
         if (plan->schema_.get_dynamic_field_id().has_value() &&
             plan->schema_.get_dynamic_field_id().value() == field_id &&
             !plan->target_dynamic_fields_.empty()) {
             auto& target_dynamic_fields = plan->target_dynamic_fields_;
-            field_data = std::move(bulk_subscript(field_id,
-                                                  results.seg_offsets_.data(),
-                                                  size,
-                                                  target_dynamic_fields));
+            columns[i] = bulk_subscript(field_id,
+                                        results.seg_offsets_.data(),
+                                        size,
+                                        target_dynamic_fields);
         } else {
-            field_data = std::move(
-                bulk_subscript(field_id, results.seg_offsets_.data(), size));
+            columns[i] =
+                bulk_subscript(field_id, results.seg_offsets_.data(), size);
         }
-        results.output_fields_data_[field_id] = std::move(field_data);
+    });
+    for (size_t i = 0; i < columns.size(); ++i) {
+        results.output_fields_data_[target_entries[i]] = std::move(columns[i]);
     }
 }
 
@@ -79,11 +153,13 @@ std::unique_ptr<SearchResult>
 SegmentInternalInterface::Search(
     const query::Plan* plan,
     const query::PlaceholderGroup* placeholder_group,
-    Timestamp timestamp) const {
+    Timestamp timestamp,
+    const OpContext* op_context) const {
     std::shared_lock lck(mutex_);
     milvus::tracer::AddEvent("obtained_segment_lock_mutex");
     check_search(plan);
-    query::ExecPlanNodeVisitor visitor(*this, timestamp, placeholder_group);
+    query::ExecPlanNodeVisitor visitor(
+        *this, timestamp, placeholder_group, op_context);
     auto results = std::make_unique<SearchResult>();
     *results = visitor.get_moved_result(*plan->plan_node_);
     results->segment_ = (void*)this;
@@ -95,14 +171,16 @@ SegmentInternalInterface::Retrieve(tracer::TraceContext* trace_ctx,
                                    const query::RetrievePlan* plan,
                                    Timestamp timestamp,
                                    int64_t limit_size,
-                                   bool ignore_non_pk) const {
+                                   bool ignore_non_pk,
+                                   const OpContext* op_context) const {
     std::shared_lock lck(mutex_);
     tracer::AutoSpan span("Retrieve", tracer::GetRootSpan());
     auto results = std::make_unique<proto::segcore::RetrieveResults>();
-    query::ExecPlanNodeVisitor visitor(*this, timestamp);
+    query::ExecPlanNodeVisitor visitor(*this, timestamp, op_context);
     auto retrieve_results = visitor.get_retrieve_result(*plan->plan_node_);
     retrieve_results.segment_ = (void*)this;
     results->set_has_more_result(retrieve_results.has_more_result);
+    results->set_profile(std::move(retrieve_results.profile_));
 
     auto result_rows = retrieve_results.result_offsets_.size();
     int64_t output_data_size = 0;
@@ -122,6 +200,13 @@ SegmentInternalInterface::Retrieve(tracer::TraceContext* trace_ctx,
         *results->add_fields_data() = retrieve_results.field_data_[0];
         return results;
     }
+    if (plan->plan_node_->aggregation_ != nullptr) {
+        // the partial aggregate, merged with the other segments in reduce
+        for (auto& field_data : retrieve_results.field_data_) {
+            *results->add_fields_data() = std::move(field_data);
+        }
+        return results;
+    }
 
     results->mutable_offset()->Add(retrieve_results.result_offsets_.begin(),
                                    retrieve_results.result_offsets_.end());
@@ -154,8 +239,22 @@ SegmentInternalInterface::FillTargetEntry(
         return pk_field_id.has_value() && pk_field_id.value() == field_id;
     };
 
+    auto is_system_field = [](const FieldId& field_id) -> bool {
+        return SystemProperty::Instance().IsSystem(field_id);
+    };
+
+    std::vector<FieldId> field_ids;
     for (auto field_id : plan->field_ids_) {
-        if (SystemProperty::Instance().IsSystem(field_id)) {
+        if (is_system_field(field_id) || !ignore_non_pk ||
+            is_pk_field(field_id)) {
+            field_ids.push_back(field_id);
+        }
+    }
+
+    std::vector<std::unique_ptr<DataArray>> columns(field_ids.size());
+    FillColumns(columns.size(), size, [&](size_t i) {
+        auto field_id = field_ids[i];
+        if (is_system_field(field_id)) {
             auto system_type =
                 SystemProperty::Instance().GetSystemFieldType(field_id);
 
@@ -170,31 +269,39 @@ SegmentInternalInterface::FillTargetEntry(
             auto data = reinterpret_cast<const int64_t*>(output.data());
             auto obj = scalar_array->mutable_long_data();
             obj->mutable_data()->Add(data, data + size);
-            fields_data->AddAllocated(data_array.release());
-            continue;
-        }
-
-        if (ignore_non_pk && !is_pk_field(field_id)) {
-            continue;
+            columns[i] = std::move(data_array);
+            return;
         }
 
         if (plan->schema_.get_dynamic_field_id().has_value() &&
             plan->schema_.get_dynamic_field_id().value() == field_id &&
             !plan->target_dynamic_fields_.empty()) {
             auto& target_dynamic_fields = plan->target_dynamic_fields_;
-            auto col =
+            columns[i] =
                 bulk_subscript(field_id, offsets, size, target_dynamic_fields);
-            fields_data->AddAllocated(col.release());
-            continue;
+            return;
         }
 
         auto& field_meta = plan->schema_[field_id];
-
-        auto col = bulk_subscript(field_id, offsets, size);
+        columns[i] = bulk_subscript(field_id, offsets, size);
         if (field_meta.get_data_type() == DataType::ARRAY) {
-            col->mutable_scalars()->mutable_array_data()->set_element_type(
-                proto::schema::DataType(field_meta.get_element_type()));
+            columns[i]
+                ->mutable_scalars()
+                ->mutable_array_data()
+                ->set_element_type(
+                    proto::schema::DataType(field_meta.get_element_type()));
         }
+    });
+
+    // the columns are added in the order of the plan
+    for (size_t i = 0; i < field_ids.size(); ++i) {
+        auto field_id = field_ids[i];
+        auto& col = columns[i];
+        if (is_system_field(field_id)) {
+            fields_data->AddAllocated(col.release());
+            continue;
+        }
+        auto& field_meta = plan->schema_[field_id];
         if (fill_ids && is_pk_field(field_id)) {
             // fill_ids should be true when the first Retrieve was called. The reduce phase depends on the ids to do
             // merge-sort.
@@ -246,6 +353,68 @@ SegmentInternalInterface::Retrieve(tracer::TraceContext* trace_ctx,
     return results;
 }
 
+std::unique_ptr<proto::segcore::RetrieveResults>
+SegmentInternalInterface::RetrieveByCursor(tracer::TraceContext* trace_ctx,
+                                           const query::RetrievePlan* plan,
+                                           Timestamp timestamp,
+                                           int64_t cursor_id,
+                                           int64_t limit_size,
+                                           const OpContext* op_context) const {
+    std::shared_lock lck(mutex_);
+    tracer::AutoSpan span("RetrieveByCursor", tracer::GetRootSpan());
+    auto& node = *plan->plan_node_;
+    AssertInfo(!node.is_count_ && node.aggregation_ == nullptr,
+               "count or aggregation can't be retrieved by cursor");
+    auto results = std::make_unique<proto::segcore::RetrieveResults>();
+
+    auto& cursors = RetrieveCursorManager::GetInstance();
+    auto segment_key = filter_cache_key_.load();
+    auto plan_hash = HashRetrievePlan(*plan);
+    auto cursor = cursors.Take(segment_key, cursor_id);
+    if (cursor == nullptr || cursor->timestamp() != timestamp ||
+        cursor->plan_hash() != plan_hash) {
+        query::ExecPlanNodeVisitor visitor(*this, timestamp, op_context);
+        auto bitset = visitor.ExecuteRetrieveFilter(node);
+        auto offsets = find_first(Unlimited, bitset).first;
+        cursor =
+            std::make_unique<RetrieveCursor>(timestamp, plan_hash, offsets);
+    }
+    // the cursor moves past the page only once the page is filled, a page
+    // which fails is read again by the next retrieve
+    auto offsets = cursor->Peek(node.limit_);
+    try {
+        int64_t output_data_size = 0;
+        for (auto field_id : plan->field_ids_) {
+            output_data_size += get_field_avg_size(field_id) * offsets.size();
+        }
+        if (output_data_size > limit_size) {
+            PanicInfo(RetrieveError,
+                      fmt::format("query results exceed the limit size {}",
+                                  limit_size));
+        }
+
+        results->set_all_retrieve_count(get_active_count(timestamp));
+        results->mutable_offset()->Add(offsets.begin(), offsets.end());
+        FillTargetEntry(trace_ctx,
+                        plan,
+                        results,
+                        offsets.data(),
+                        offsets.size(),
+                        false,
+                        true);
+    } catch (...) {
+        cursors.Put(segment_key, cursor_id, std::move(cursor));
+        throw;
+    }
+
+    cursor->Advance(offsets);
+    results->set_has_more_result(cursor->has_more());
+    if (cursor->has_more()) {
+        cursors.Put(segment_key, cursor_id, std::move(cursor));
+    }
+    return results;
+}
+
 int64_t
 SegmentInternalInterface::get_real_count() const {
 #if 0
@@ -392,6 +561,122 @@ SegmentInternalInterface::LoadPrimitiveSkipIndex(milvus::FieldId field_id,
         field_id, chunk_id, data_type, chunk_data, valid_data, count);
 }
 
+const ShreddedJsonField*
+SegmentInternalInterface::GetShreddedJsonField(FieldId field_id) const {
+    std::shared_lock lock(mutex_);
+    auto iter = shredded_json_fields_.find(field_id);
+    if (iter == shredded_json_fields_.end()) {
+        return nullptr;
+    }
+    return iter->second.get();
+}
+
+int64_t
+SegmentInternalInterface::LoadJsonShredding(FieldId field_id,
+                                            const ChunkedColumnBase& column) {
+    auto visitor = [&column](const ShreddedJsonField::BatchCallback& func) {
+        for (int64_t i = 0; i < column.num_chunks(); i++) {
+            auto [views, valid_data] =
+                column.JsonViews(i, 0, column.chunk_row_nums(i));
+            func(views.data(), valid_data.data(), views.size());
+        }
+    };
+    return LoadJsonShredding(field_id, visitor, column.NumRows());
+}
+
+int64_t
+SegmentInternalInterface::LoadJsonShredding(
+    FieldId field_id, const SingleChunkColumnBase& column) {
+    int64_t num_rows = column.NumRows();
+    auto visitor = [&column,
+                    num_rows](const ShreddedJsonField::BatchCallback& func) {
+        for (int64_t start = 0; start < num_rows;
+             start += JSON_SHREDDING_BLOCK_SIZE) {
+            auto length =
+                std::min<int64_t>(JSON_SHREDDING_BLOCK_SIZE, num_rows - start);
+            auto [views, valid_data] = column.JsonViews(start, length);
+            func(views.data(), valid_data.data(), length);
+        }
+    };
+    return LoadJsonShredding(field_id, visitor, num_rows);
+}
+
+int64_t
+SegmentInternalInterface::LoadJsonShredding(
+    FieldId field_id,
+    const ShreddedJsonField::BatchVisitor& visitor,
+    int64_t num_rows) {
+    auto& config = SegcoreConfig::default_config();
+    auto field = ShreddedJsonField::Build(
+        visitor,
+        num_rows,
+        config.get_json_shredding_max_paths(),
+        config.get_json_shredding_min_presence_ratio());
+    if (field == nullptr) {
+        return 0;
+    }
+
+    for (auto& path : field->paths()) {
+        for (int64_t start = 0; start < num_rows;
+             start += JSON_SHREDDING_BLOCK_SIZE) {
+            auto block_id = start / JSON_SHREDDING_BLOCK_SIZE;
+            auto count =
+                std::min<int64_t>(JSON_SHREDDING_BLOCK_SIZE, num_rows - start);
+            auto presence = path.presence() + start;
+            switch (path.data_type()) {
+                case DataType::INT64:
+                    skip_index_.LoadJsonPathPrimitive(
+                        field_id,
+                        path.pointer(),
+                        block_id,
+                        DataType::INT64,
+                        path.data<int64_t>() + start,
+                        presence,
+                        count);
+                    break;
+                case DataType::DOUBLE:
+                    skip_index_.LoadJsonPathPrimitive(
+                        field_id,
+                        path.pointer(),
+                        block_id,
+                        DataType::DOUBLE,
+                        path.data<double>() + start,
+                        presence,
+                        count);
+                    break;
+                default: {
+                    auto data = path.string_data();
+                    data.offsets_ += start;
+                    skip_index_.LoadJsonPathString(field_id,
+                                                   path.pointer(),
+                                                   block_id,
+                                                   data,
+                                                   presence,
+                                                   count);
+                    break;
+                }
+            }
+        }
+        LOG_INFO("shredded json path {} of field {} as {}, {} rows present",
+                 path.pointer(),
+                 field_id.get(),
+                 path.data_type(),
+                 std::count(path.presence(), path.presence() + num_rows, true));
+    }
+
+    auto size = field->ByteSize();
+    std::unique_lock lock(mutex_);
+    shredded_json_fields_[field_id] = std::move(field);
+    return size;
+}
+
+void
+SegmentInternalInterface::DropJsonShredding(FieldId field_id) {
+    if (shredded_json_fields_.erase(field_id) > 0) {
+        skip_index_.DropJsonPathMetrics(field_id);
+    }
+}
+
 index::TextMatchIndex*
 SegmentInternalInterface::GetTextIndex(FieldId field_id) const {
     std::shared_lock lock(mutex_);
@@ -37,7 +37,11 @@
 #include "index/IndexInfo.h"
 #include "index/SkipIndex.h"
 #include "mmap/Column.h"
+#include "mmap/ChunkedColumn.h"
 #include "index/TextMatchIndex.h"
+#include "segcore/FilterResultCache.h"
+#include "segcore/RetrieveCursor.h"
+#include "segcore/JsonShredding.h"
 
 namespace milvus::segcore {
 
@@ -64,14 +68,16 @@ class SegmentInterface {
     virtual std::unique_ptr<SearchResult>
     Search(const query::Plan* Plan,
            const query::PlaceholderGroup* placeholder_group,
-           Timestamp timestamp) const = 0;
+           Timestamp timestamp,
+           const OpContext* op_context = nullptr) const = 0;
 
     virtual std::unique_ptr<proto::segcore::RetrieveResults>
     Retrieve(tracer::TraceContext* trace_ctx,
              const query::RetrievePlan* Plan,
              Timestamp timestamp,
              int64_t limit_size,
-             bool ignore_non_pk) const = 0;
+             bool ignore_non_pk,
+             const OpContext* op_context = nullptr) const = 0;
 
     virtual std::unique_ptr<proto::segcore::RetrieveResults>
     Retrieve(tracer::TraceContext* trace_ctx,
@@ -79,6 +85,17 @@ class SegmentInterface {
              const int64_t* offsets,
              int64_t size) const = 0;
 
+    // the next page of a paged retrieve, at most limit_ rows of the plan in
+    // pk order. The filter is evaluated for the first page only, the next
+    // pages of the same cursor id are read from its RetrieveCursor.
+    virtual std::unique_ptr<proto::segcore::RetrieveResults>
+    RetrieveByCursor(tracer::TraceContext* trace_ctx,
+                     const query::RetrievePlan* Plan,
+                     Timestamp timestamp,
+                     int64_t cursor_id,
+                     int64_t limit_size,
+                     const OpContext* op_context = nullptr) const = 0;
+
     virtual size_t
     GetMemoryUsageInBytes() const = 0;
 
@@ -140,6 +157,15 @@ class SegmentInterface {
 // only for implementation
 class SegmentInternalInterface : public SegmentInterface {
  public:
+    ~SegmentInternalInterface() override;
+
+    // key of the filter results of the segment in FilterResultCache, taken
+    // anew whenever the data or the indexes filters read change
+    int64_t
+    filter_cache_key() const {
+        return filter_cache_key_.load();
+    }
+
     template <typename T>
     Span<T>
     chunk_data(FieldId field_id, int64_t chunk_id) const {
@@ -163,6 +189,25 @@ class SegmentInternalInterface : public SegmentInterface {
         }
     }
 
+    // return values of rows located in [start_offset, start_offset + length)
+    // of the string field chunk without materializing per-row views, the
+    // valid data pointer is nullptr if the field is not nullable.
+    // offsets_buf is scratch space, only used when the column can't expose
+    // its offsets in place, it must outlive the returned view.
+    std::pair<StringBatchView, const bool*>
+    get_string_batch(FieldId field_id,
+                     int64_t chunk_id,
+                     int64_t start_offset,
+                     int64_t length,
+                     std::vector<uint64_t>& offsets_buf) const {
+        if (this->type() == SegmentType::Growing) {
+            PanicInfo(ErrorCode::Unsupported,
+                      "get string batch not supported for growing segment");
+        }
+        return chunk_string_batch_impl(
+            field_id, chunk_id, start_offset, length, offsets_buf);
+    }
+
     template <typename ViewType>
     std::pair<std::vector<ViewType>, FixedVector<bool>>
     get_batch_views(FieldId field_id,
@@ -173,31 +218,39 @@ class SegmentInternalInterface : public SegmentInterface {
             PanicInfo(ErrorCode::Unsupported,
                       "get chunk views not supported for growing segment");
         }
-        auto chunk_info =
-            get_chunk_buffer(field_id, chunk_id, start_offset, length);
-        BufferView buffer = chunk_info.first;
-        std::vector<ViewType> res;
-        res.reserve(length);
-        if (buffer.data_.index() == 1) {
-            char* pos = std::get<1>(buffer.data_).first;
-            for (size_t j = 0; j < length; j++) {
-                uint32_t size;
-                size = *reinterpret_cast<uint32_t*>(pos);
-                pos += sizeof(uint32_t);
-                res.emplace_back(ViewType(pos, size));
-                pos += size;
-            }
+        if constexpr (std::is_same_v<ViewType, ArrayView>) {
+            return chunk_array_views_impl(
+                field_id, chunk_id, start_offset, length);
+        } else if constexpr (std::is_same_v<ViewType, Json>) {
+            return chunk_json_views_impl(
+                field_id, chunk_id, start_offset, length);
         } else {
-            auto elements = std::get<0>(buffer.data_);
-            for (auto& element : elements) {
-                for (int i = element.start_; i < element.end_; i++) {
-                    res.emplace_back(ViewType(
-                        element.data_ + element.offsets_[i],
-                        element.offsets_[i + 1] - element.offsets_[i]));
+            auto chunk_info =
+                get_chunk_buffer(field_id, chunk_id, start_offset, length);
+            BufferView buffer = chunk_info.first;
+            std::vector<ViewType> res;
+            res.reserve(length);
+            if (buffer.data_.index() == 1) {
+                char* pos = std::get<1>(buffer.data_).first;
+                for (size_t j = 0; j < length; j++) {
+                    uint32_t size;
+                    size = *reinterpret_cast<uint32_t*>(pos);
+                    pos += sizeof(uint32_t);
+                    res.emplace_back(ViewType(pos, size));
+                    pos += size;
+                }
+            } else {
+                auto elements = std::get<0>(buffer.data_);
+                for (auto& element : elements) {
+                    for (int i = element.start_; i < element.end_; i++) {
+                        res.emplace_back(ViewType(
+                            element.data_ + element.offsets_[i],
+                            element.offsets_[i + 1] - element.offsets_[i]));
+                    }
                 }
             }
+            return std::make_pair(res, chunk_info.second);
         }
-        return std::make_pair(res, chunk_info.second);
     }
 
     template <typename T>
@@ -221,7 +274,8 @@ class SegmentInternalInterface : public SegmentInterface {
     std::unique_ptr<SearchResult>
     Search(const query::Plan* Plan,
            const query::PlaceholderGroup* placeholder_group,
-           Timestamp timestamp) const override;
+           Timestamp timestamp,
+           const OpContext* op_context = nullptr) const override;
 
     void
     FillPrimaryKeys(const query::Plan* plan,
@@ -236,7 +290,8 @@ class SegmentInternalInterface : public SegmentInterface {
              const query::RetrievePlan* Plan,
              Timestamp timestamp,
              int64_t limit_size,
-             bool ignore_non_pk) const override;
+             bool ignore_non_pk,
+             const OpContext* op_context = nullptr) const override;
 
     std::unique_ptr<proto::segcore::RetrieveResults>
     Retrieve(tracer::TraceContext* trace_ctx,
@@ -244,6 +299,14 @@ class SegmentInternalInterface : public SegmentInterface {
              const int64_t* offsets,
              int64_t size) const override;
 
+    std::unique_ptr<proto::segcore::RetrieveResults>
+    RetrieveByCursor(tracer::TraceContext* trace_ctx,
+                     const query::RetrievePlan* Plan,
+                     Timestamp timestamp,
+                     int64_t cursor_id,
+                     int64_t limit_size,
+                     const OpContext* op_context = nullptr) const override;
+
     virtual bool
     HasIndex(FieldId field_id) const = 0;
 
@@ -268,6 +331,13 @@ class SegmentInternalInterface : public SegmentInterface {
         return false;
     }
 
+    // true if offsets of the segment are in primary key order, find_first
+    // then picks the first unfiltered offsets
+    virtual bool
+    is_sorted_by_pk() const {
+        return false;
+    }
+
     const SkipIndex&
     GetSkipIndex() const;
 
@@ -287,6 +357,20 @@ class SegmentInternalInterface : public SegmentInterface {
         skip_index_.LoadString(field_id, chunk_id, var_column);
     }
 
+    // paths of a JSON field extracted into typed columns when the segment
+    // is loaded, nullptr if none of them is
+    const ShreddedJsonField*
+    GetShreddedJsonField(FieldId field_id) const;
+
+    // extract the frequently present paths of a loaded JSON column into
+    // typed columns and load their zone maps into the skip index, returns
+    // the memory used by the typed columns
+    int64_t
+    LoadJsonShredding(FieldId field_id, const ChunkedColumnBase& column);
+
+    int64_t
+    LoadJsonShredding(FieldId field_id, const SingleChunkColumnBase& column);
+
     virtual DataType
     GetFieldDataType(FieldId fieldId) const = 0;
 
@@ -414,6 +498,33 @@ class SegmentInternalInterface : public SegmentInterface {
                      int64_t start_offset,
                      int64_t length) const = 0;
 
+    // internal API: return array views of rows located in
+    // [start_offset, start_offset + length) of the field chunk, views are
+    // built on demand over the packed chunk data
+    virtual std::pair<std::vector<ArrayView>, FixedVector<bool>>
+    chunk_array_views_impl(FieldId field_id,
+                           int64_t chunk_id,
+                           int64_t start_offset,
+                           int64_t length) const = 0;
+
+    // internal API: return json views of rows located in
+    // [start_offset, start_offset + length) of the field chunk, views carry
+    // the pre-parsed json binary built at load time
+    virtual std::pair<std::vector<Json>, FixedVector<bool>>
+    chunk_json_views_impl(FieldId field_id,
+                          int64_t chunk_id,
+                          int64_t start_offset,
+                          int64_t length) const = 0;
+
+    // internal API: return string values of rows located in
+    // [start_offset, start_offset + length) of the field chunk
+    virtual std::pair<StringBatchView, const bool*>
+    chunk_string_batch_impl(FieldId field_id,
+                            int64_t chunk_id,
+                            int64_t start_offset,
+                            int64_t length,
+                            std::vector<uint64_t>& offsets_buf) const = 0;
+
     // internal API: return chunk_index in span, support scalar index only
     virtual const index::IndexBase*
     chunk_index_impl(FieldId field_id, int64_t chunk_id) const = 0;
@@ -445,15 +556,37 @@ class SegmentInternalInterface : public SegmentInterface {
         const std::vector<std::string>& dynamic_field_names) const = 0;
 
  protected:
+    int64_t
+    LoadJsonShredding(FieldId field_id,
+                      const ShreddedJsonField::BatchVisitor& visitor,
+                      int64_t num_rows);
+
+    // drops the shredded paths of the json field and their zone maps,
+    // mutex_ must be held by the caller
+    void
+    DropJsonShredding(FieldId field_id);
+
+    // drops the cached filter results and the retrieve cursors of the
+    // segment
+    void
+    InvalidateFilterCache();
+
     mutable std::shared_mutex mutex_;
     // fieldID -> std::pair<num_rows, avg_size>
     std::unordered_map<FieldId, std::pair<int64_t, int64_t>>
         variable_fields_avg_size_;  // bytes;
     SkipIndex skip_index_;
 
+    // shredded paths of JSON fields of sealed segment
+    std::unordered_map<FieldId, std::unique_ptr<ShreddedJsonField>>
+        shredded_json_fields_;
+
     // text-indexes used to do match.
     std::unordered_map<FieldId, std::unique_ptr<index::TextMatchIndex>>
         text_indexes_;
+
+    std::atomic<int64_t> filter_cache_key_{
+        FilterResultCache::NextSegmentKey()};
 };
 
 }  // namespace milvus::segcore
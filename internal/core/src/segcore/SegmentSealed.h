@@ -16,6 +16,7 @@
 #include <tuple>
 
 #include "common/LoadInfo.h"
+#include "pb/clustering.pb.h"
 #include "pb/segcore.pb.h"
 #include "segcore/SegmentInterface.h"
 #include "segcore/Types.h"
@@ -52,6 +53,17 @@ class SegmentSealed : public SegmentInternalInterface {
     LoadTextIndex(FieldId field_id,
                   std::unique_ptr<index::TextMatchIndex> index) = 0;
 
+    // loads the clusters of the rows of a float vector field trained by
+    // clustering compaction, the searches on the raw data of the field
+    // skip the clusters which can't hold their results, and the searches on
+    // its indexes skip the clusters beyond their probe ratio
+    virtual void
+    LoadClusteringCentroids(
+        FieldId field_id,
+        const proto::clustering::ClusteringCentroidsStats& centroids,
+        const proto::clustering::ClusteringCentroidIdMappingStats&
+            id_mapping) = 0;
+
     SegmentType
     type() const override {
         return SegmentType::Sealed;
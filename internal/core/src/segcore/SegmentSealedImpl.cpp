@@ -116,6 +116,7 @@ SegmentSealedImpl::LoadIndex(const LoadIndexInfo& info) {
     } else {
         LoadScalarIndex(info);
     }
+    InvalidateFilterCache();
 }
 
 void
@@ -413,6 +414,7 @@ SegmentSealedImpl::LoadFieldData(FieldId field_id, FieldDataInfo& data) {
                     var_column->Seal();
                     stats_.mem_size += var_column->MemoryUsageBytes();
                     field_data_size = var_column->DataByteSize();
+                    stats_.mem_size += LoadJsonShredding(field_id, *var_column);
                     column = std::move(var_column);
                     break;
                 }
@@ -527,6 +529,7 @@ SegmentSealedImpl::LoadFieldData(FieldId field_id, FieldDataInfo& data) {
         std::unique_lock lck(mutex_);
         update_row_count(num_rows);
     }
+    InvalidateFilterCache();
 }
 
 void
@@ -546,7 +549,8 @@ SegmentSealedImpl::MapFieldData(const FieldId field_id, FieldDataInfo& data) {
     FieldDataPtr field_data;
     uint64_t total_written = 0;
     std::vector<uint64_t> indices{};
-    std::vector<std::vector<uint64_t>> element_indices{};
+    std::vector<uint64_t> element_offsets{};
+    std::vector<uint64_t> element_indices{};
     FixedVector<bool> valid_data{};
     while (data.channel->pop(field_data)) {
         WriteFieldData(file,
@@ -554,6 +558,7 @@ SegmentSealedImpl::MapFieldData(const FieldId field_id, FieldDataInfo& data) {
                        field_data,
                        total_written,
                        indices,
+                       element_offsets,
                        element_indices,
                        valid_data);
     }
@@ -589,6 +594,7 @@ SegmentSealedImpl::MapFieldData(const FieldId field_id, FieldDataInfo& data) {
                 auto arr_column = std::make_shared<SingleChunkArrayColumn>(
                     file, total_written, field_meta);
                 arr_column->Seal(std::move(indices),
+                                 std::move(element_offsets),
                                  std::move(element_indices));
                 column = std::move(arr_column);
                 break;
@@ -651,6 +657,7 @@ SegmentSealedImpl::MapFieldData(const FieldId field_id, FieldDataInfo& data) {
         std::unique_lock lck(mutex_);
         set_bit(field_data_ready_bitset_, field_id, true);
     }
+    InvalidateFilterCache();
 }
 
 void
@@ -759,6 +766,56 @@ SegmentSealedImpl::get_chunk_buffer(FieldId field_id,
               "get_chunk_buffer only used for  variable column field");
 }
 
+std::pair<std::vector<ArrayView>, FixedVector<bool>>
+SegmentSealedImpl::chunk_array_views_impl(FieldId field_id,
+                                          int64_t chunk_id,
+                                          int64_t start_offset,
+                                          int64_t length) const {
+    std::shared_lock lck(mutex_);
+    AssertInfo(get_bit(field_data_ready_bitset_, field_id),
+               "Can't get bitset element at " + std::to_string(field_id.get()));
+    if (auto it = fields_.find(field_id); it != fields_.end()) {
+        auto& field_data = it->second;
+        return field_data->ArrayViews(start_offset, length);
+    }
+    PanicInfo(ErrorCode::UnexpectedError,
+              "chunk_array_views_impl only used for array column field");
+}
+
+std::pair<std::vector<Json>, FixedVector<bool>>
+SegmentSealedImpl::chunk_json_views_impl(FieldId field_id,
+                                         int64_t chunk_id,
+                                         int64_t start_offset,
+                                         int64_t length) const {
+    std::shared_lock lck(mutex_);
+    AssertInfo(get_bit(field_data_ready_bitset_, field_id),
+               "Can't get bitset element at " + std::to_string(field_id.get()));
+    if (auto it = fields_.find(field_id); it != fields_.end()) {
+        auto& field_data = it->second;
+        return field_data->JsonViews(start_offset, length);
+    }
+    PanicInfo(ErrorCode::UnexpectedError,
+              "chunk_json_views_impl only used for json column field");
+}
+
+std::pair<StringBatchView, const bool*>
+SegmentSealedImpl::chunk_string_batch_impl(
+    FieldId field_id,
+    int64_t chunk_id,
+    int64_t start_offset,
+    int64_t length,
+    std::vector<uint64_t>& offsets_buf) const {
+    std::shared_lock lck(mutex_);
+    AssertInfo(get_bit(field_data_ready_bitset_, field_id),
+               "Can't get bitset element at " + std::to_string(field_id.get()));
+    if (auto it = fields_.find(field_id); it != fields_.end()) {
+        auto& field_data = it->second;
+        return field_data->StringBatch(start_offset, length, offsets_buf);
+    }
+    PanicInfo(ErrorCode::UnexpectedError,
+              "chunk_string_batch_impl only used for variable column field");
+}
+
 bool
 SegmentSealedImpl::is_mmap_field(FieldId field_id) const {
     std::shared_lock lck(mutex_);
@@ -947,6 +1004,25 @@ SegmentSealedImpl::vector_search(SearchInfo& search_info,
 
     AssertInfo(field_meta.is_vector(),
                "The meta type of vector field is not vector type");
+    auto clusters = GetClusteringCentroids(field_id);
+    // an index can't skip the clusters by their bounds, it is kept off the
+    // rows of the clusters the search doesn't probe instead
+    auto index_bitset = bitset;
+    BitsetType unprobed_bitset;
+    if (clusters != nullptr && num_rows_.has_value() &&
+        (get_bit(binlog_index_bitset_, field_id) ||
+         get_bit(index_ready_bitset_, field_id)) &&
+        query::FilterUnprobedClusters(
+            *schema_,
+            *clusters,
+            search_info,
+            query_data,
+            query_count,
+            bitset.empty() ? num_rows_.value() : bitset.size(),
+            bitset,
+            unprobed_bitset)) {
+        index_bitset = BitsetView(unprobed_bitset);
+    }
     if (get_bit(binlog_index_bitset_, field_id)) {
         AssertInfo(
             vec_binlog_config_.find(field_id) != vec_binlog_config_.end(),
@@ -962,7 +1038,7 @@ SegmentSealedImpl::vector_search(SearchInfo& search_info,
                                    binlog_search_info,
                                    query_data,
                                    query_count,
-                                   bitset,
+                                   index_bitset,
                                    output);
         milvus::tracer::AddEvent(
             "finish_searching_vector_temperate_binlog_index");
@@ -975,7 +1051,7 @@ SegmentSealedImpl::vector_search(SearchInfo& search_info,
                                    search_info,
                                    query_data,
                                    query_count,
-                                   bitset,
+                                   index_bitset,
                                    output);
         milvus::tracer::AddEvent("finish_searching_vector_index");
     } else {
@@ -985,6 +1061,22 @@ SegmentSealedImpl::vector_search(SearchInfo& search_info,
         AssertInfo(num_rows_.has_value(), "Can't get row count value");
         auto row_count = num_rows_.value();
         auto vec_data = fields_.at(field_id);
+        if (clusters != nullptr) {
+            auto data = reinterpret_cast<const float*>(vec_data->Data());
+            auto dim = field_meta.get_dim();
+            if (query::SearchOnSealedClusters(
+                    *schema_,
+                    *clusters,
+                    [&](int64_t offset) { return data + offset * dim; },
+                    search_info,
+                    query_data,
+                    query_count,
+                    bitset,
+                    output)) {
+                milvus::tracer::AddEvent("finish_searching_vector_clusters");
+                return;
+            }
+        }
         query::SearchOnSealed(*schema_,
                               vec_data->Data(),
                               search_info,
@@ -1092,7 +1184,7 @@ SegmentSealedImpl::get_vector(FieldId field_id,
         path_to_column.emplace(std::get<0>(tuple), nullptr);
     }
 
-    // read and prefetch
+    // read and prefetch, ahead of the downloads of loading segments
     auto& pool = ThreadPools::GetThreadPool(milvus::ThreadPoolPriority::HIGH);
     std::vector<std::future<
         std::tuple<std::string, std::shared_ptr<SingleChunkColumnBase>>>>
@@ -1100,8 +1192,11 @@ SegmentSealedImpl::get_vector(FieldId field_id,
     futures.reserve(path_to_column.size());
     for (const auto& iter : path_to_column) {
         const auto& data_path = iter.first;
-        futures.emplace_back(
-            pool.Submit(ReadFromChunkCache, cc, data_path, mmap_descriptor_));
+        futures.emplace_back(pool.SubmitWithPriority(TaskPriority::HIGH,
+                                                     ReadFromChunkCache,
+                                                     cc,
+                                                     data_path,
+                                                     mmap_descriptor_));
     }
 
     for (int i = 0; i < futures.size(); ++i) {
@@ -1172,6 +1267,19 @@ SegmentSealedImpl::DropFieldData(const FieldId field_id) {
         std::unique_lock lck(mutex_);
         if (get_bit(field_data_ready_bitset_, field_id)) {
             fields_.erase(field_id);
+            if (auto clusters = clustering_centroids_->find(field_id);
+                clusters != clustering_centroids_->end()) {
+                stats_.mem_size -= clusters->second->ByteSize();
+                auto updated =
+                    std::make_shared<ClusteringCentroidsMap>(
+                        *clustering_centroids_);
+                updated->erase(field_id);
+                std::atomic_store(
+                    &clustering_centroids_,
+                    std::shared_ptr<const ClusteringCentroidsMap>(
+                        std::move(updated)));
+            }
+            DropJsonShredding(field_id);
             set_bit(field_data_ready_bitset_, field_id, false);
         }
         if (get_bit(binlog_index_bitset_, field_id)) {
@@ -1180,6 +1288,7 @@ SegmentSealedImpl::DropFieldData(const FieldId field_id) {
         }
         lck.unlock();
     }
+    InvalidateFilterCache();
 }
 
 void
@@ -1195,6 +1304,7 @@ SegmentSealedImpl::DropIndex(const FieldId field_id) {
     std::unique_lock lck(mutex_);
     vector_indexings_.drop_field_indexing(field_id);
     set_bit(index_ready_bitset_, field_id, false);
+    InvalidateFilterCache();
 }
 
 void
@@ -1348,10 +1458,9 @@ SegmentSealedImpl::bulk_subscript_array_impl(
     int64_t count,
     google::protobuf::RepeatedPtrField<T>* dst) {
     auto field = reinterpret_cast<const SingleChunkArrayColumn*>(column);
-    for (int64_t i = 0; i < count; ++i) {
-        auto offset = seg_offsets[i];
-        dst->at(i) = std::move(field->RawAt(offset));
-    }
+    field->BulkRawAt(seg_offsets, count, [&](int64_t i, const ArrayView& view) {
+        dst->at(i) = view.output_data();
+    });
 }
 
 // for dense vector
@@ -1384,9 +1493,15 @@ SegmentSealedImpl::ClearData() {
         vector_indexings_.clear();
         insert_record_.clear();
         fields_.clear();
+        std::atomic_store(&clustering_centroids_,
+                          std::make_shared<const ClusteringCentroidsMap>());
+        while (!shredded_json_fields_.empty()) {
+            DropJsonShredding(shredded_json_fields_.begin()->first);
+        }
         variable_fields_avg_size_.clear();
         stats_.mem_size = 0;
     }
+    InvalidateFilterCache();
     auto cc = storage::MmapManager::GetInstance().GetChunkCache();
     if (cc == nullptr) {
         return;
@@ -1743,6 +1858,39 @@ SegmentSealedImpl::search_ids(const IdArray& id_array,
 std::pair<std::vector<OffsetMap::OffsetType>, bool>
 SegmentSealedImpl::find_first(int64_t limit, const BitsetType& bitset) const {
     if (!is_sorted_by_pk_) {
+        // few hits are cheaper to order by their pks than to be looked up
+        // while walking the pk index
+        auto pk_field_id =
+            schema_->get_primary_field_id().value_or(FieldId(-1));
+        auto it = fields_.find(pk_field_id);
+        int64_t hit_num = bitset.size() - bitset.count();
+        if (it != fields_.end() &&
+            prefer_find_first_by_heap(limit, hit_num, bitset.size())) {
+            auto& pk_column = it->second;
+            switch (schema_->get_fields().at(pk_field_id).get_data_type()) {
+                case DataType::INT64: {
+                    auto src =
+                        reinterpret_cast<const int64_t*>(pk_column->Data());
+                    return find_first_by_heap(
+                        limit, bitset, [src](int64_t offset) {
+                            return src[offset];
+                        });
+                }
+                case DataType::VARCHAR: {
+                    auto var_column = std::dynamic_pointer_cast<
+                        SingleChunkVariableColumn<std::string>>(pk_column);
+                    if (var_column == nullptr) {
+                        break;
+                    }
+                    return find_first_by_heap(
+                        limit, bitset, [&var_column](int64_t offset) {
+                            return var_column->RawAt(offset);
+                        });
+                }
+                default:
+                    break;
+            }
+        }
         return insert_record_.pk2offset_->find_first(limit, bitset);
     }
     if (limit == Unlimited || limit == NoLimit) {
@@ -2076,6 +2224,7 @@ SegmentSealedImpl::CreateTextIndex(FieldId field_id) {
                              field_meta.get_analyzer_params().c_str());
 
     text_indexes_[field_id] = std::move(index);
+    InvalidateFilterCache();
 }
 
 void
@@ -2086,6 +2235,52 @@ SegmentSealedImpl::LoadTextIndex(FieldId field_id,
     index->RegisterTokenizer("milvus_tokenizer",
                              field_meta.get_analyzer_params().c_str());
     text_indexes_[field_id] = std::move(index);
+    InvalidateFilterCache();
+}
+
+void
+SegmentSealedImpl::LoadClusteringCentroids(
+    FieldId field_id,
+    const proto::clustering::ClusteringCentroidsStats& centroids,
+    const proto::clustering::ClusteringCentroidIdMappingStats& id_mapping) {
+    std::unique_lock lck(mutex_);
+    auto& field_meta = schema_->operator[](field_id);
+    AssertInfo(field_meta.get_data_type() == DataType::VECTOR_FLOAT,
+               "clustering of field {} of type {}",
+               field_id.get(),
+               field_meta.get_data_type());
+    AssertInfo(num_rows_.has_value(), "Can't get row count value");
+    auto dim = field_meta.get_dim();
+    // a field only loaded as an index has no radii, its searches are only
+    // pruned by the probe ratio
+    query::VectorAt vector_at;
+    if (get_bit(field_data_ready_bitset_, field_id)) {
+        auto data =
+            reinterpret_cast<const float*>(fields_.at(field_id)->Data());
+        vector_at = [data, dim](int64_t offset) {
+            return data + offset * dim;
+        };
+    }
+    auto clusters = query::BuildClusteringCentroids(
+        centroids, id_mapping, dim, num_rows_.value(), vector_at);
+    auto updated =
+        std::make_shared<ClusteringCentroidsMap>(*clustering_centroids_);
+    auto& slot = (*updated)[field_id];
+    if (slot != nullptr) {
+        stats_.mem_size -= slot->ByteSize();
+    }
+    stats_.mem_size += clusters->ByteSize();
+    slot = std::move(clusters);
+    std::atomic_store(
+        &clustering_centroids_,
+        std::shared_ptr<const ClusteringCentroidsMap>(std::move(updated)));
+}
+
+query::ClusteringCentroidsPtr
+SegmentSealedImpl::GetClusteringCentroids(FieldId field_id) const {
+    auto clusters = std::atomic_load(&clustering_centroids_);
+    auto iter = clusters->find(field_id);
+    return iter == clusters->end() ? nullptr : iter->second;
 }
 
 }  // namespace milvus::segcore
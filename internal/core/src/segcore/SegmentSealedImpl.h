@@ -36,6 +36,7 @@
 #include "common/Types.h"
 #include "common/IndexMeta.h"
 #include "index/TextMatchIndex.h"
+#include "query/ClusteringPruning.h"
 
 namespace milvus::segcore {
 
@@ -100,6 +101,17 @@ class SegmentSealedImpl : public SegmentSealed {
     LoadTextIndex(FieldId field_id,
                   std::unique_ptr<index::TextMatchIndex> index) override;
 
+    void
+    LoadClusteringCentroids(
+        FieldId field_id,
+        const proto::clustering::ClusteringCentroidsStats& centroids,
+        const proto::clustering::ClusteringCentroidIdMappingStats& id_mapping)
+        override;
+
+    // the clusters of the vector field, nullptr if none is loaded
+    query::ClusteringCentroidsPtr
+    GetClusteringCentroids(FieldId field_id) const;
+
  public:
     size_t
     GetMemoryUsageInBytes() const override {
@@ -163,6 +175,11 @@ class SegmentSealedImpl : public SegmentSealed {
         return false;
     }
 
+    bool
+    is_sorted_by_pk() const override {
+        return is_sorted_by_pk_;
+    }
+
     std::pair<int64_t, int64_t>
     get_chunk_by_offset(FieldId field_id, int64_t offset) const override {
         PanicInfo(ErrorCode::Unsupported, "Not implemented");
@@ -218,6 +235,25 @@ class SegmentSealedImpl : public SegmentSealed {
                      int64_t start_offset,
                      int64_t length) const override;
 
+    std::pair<std::vector<ArrayView>, FixedVector<bool>>
+    chunk_array_views_impl(FieldId field_id,
+                           int64_t chunk_id,
+                           int64_t start_offset,
+                           int64_t length) const override;
+
+    std::pair<std::vector<Json>, FixedVector<bool>>
+    chunk_json_views_impl(FieldId field_id,
+                          int64_t chunk_id,
+                          int64_t start_offset,
+                          int64_t length) const override;
+
+    std::pair<StringBatchView, const bool*>
+    chunk_string_batch_impl(FieldId field_id,
+                            int64_t chunk_id,
+                            int64_t start_offset,
+                            int64_t length,
+                            std::vector<uint64_t>& offsets_buf) const override;
+
     const index::IndexBase*
     chunk_index_impl(FieldId field_id, int64_t chunk_id) const override;
 
@@ -384,6 +420,14 @@ class SegmentSealedImpl : public SegmentSealed {
 
     // whether the segment is sorted by the pk
     bool is_sorted_by_pk_ = false;
+
+    // clusters of the rows of the vector fields, dropped with their data.
+    // The map is immutable, it's replaced under mutex_ and read with
+    // std::atomic_load, as searches already hold mutex_ shared.
+    using ClusteringCentroidsMap =
+        std::unordered_map<FieldId, query::ClusteringCentroidsPtr>;
+    std::shared_ptr<const ClusteringCentroidsMap> clustering_centroids_ =
+        std::make_shared<const ClusteringCentroidsMap>();
 };
 
 inline SegmentSealedUPtr
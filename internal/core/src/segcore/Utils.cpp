@@ -12,6 +12,7 @@
 #include "segcore/Utils.h"
 #include <arrow/record_batch.h>
 
+#include <deque>
 #include <future>
 #include <memory>
 #include <string>
@@ -875,18 +876,28 @@ LoadArrowReaderFromRemote(const std::vector<std::string>& remote_files,
                        .GetRemoteChunkManager();
         auto& pool = ThreadPools::GetThreadPool(ThreadPoolPriority::HIGH);
 
-        std::vector<std::future<std::shared_ptr<milvus::ArrowDataWrapper>>>
+        // the files are downloaded a window at a time rather than all at
+        // once, the channel holds the decoded ones until they are consumed
+        auto parallel_degree = static_cast<uint64_t>(
+            DEFAULT_FIELD_MAX_MEMORY_LIMIT / FILE_SLICE_SIZE);
+        std::deque<std::future<std::shared_ptr<milvus::ArrowDataWrapper>>>
             futures;
-        futures.reserve(remote_files.size());
         for (const auto& file : remote_files) {
-            auto future = pool.Submit([&]() {
-                auto fileSize = rcm->Size(file);
-                auto buf = std::shared_ptr<uint8_t[]>(new uint8_t[fileSize]);
-                rcm->Read(file, buf.get(), fileSize);
+            if (futures.size() >= parallel_degree) {
+                channel->push(futures.front().get());
+                futures.pop_front();
+            }
+            auto reservation = storage::ReserveLoadMemory();
+            auto future = pool.Submit([rcm, file, reservation]() {
+                std::shared_ptr<uint8_t[]> buf;
+                auto fileSize = rcm->ReadAll(file, buf);
                 auto result =
                     storage::DeserializeFileData(buf, fileSize, false);
                 result->SetData(buf);
-                return result->GetReader();
+                // the reader keeps the buffer and decodes it as it's read
+                reservation->Resize(fileSize * 2);
+                return storage::HoldLoadMemory(result->GetReader(),
+                                               reservation);
             });
             futures.emplace_back(std::move(future));
         }
@@ -911,15 +922,23 @@ LoadFieldDatasFromRemote(const std::vector<std::string>& remote_files,
                        .GetRemoteChunkManager();
         auto& pool = ThreadPools::GetThreadPool(ThreadPoolPriority::HIGH);
 
-        std::vector<std::future<FieldDataPtr>> futures;
-        futures.reserve(remote_files.size());
+        auto parallel_degree = static_cast<uint64_t>(
+            DEFAULT_FIELD_MAX_MEMORY_LIMIT / FILE_SLICE_SIZE);
+        std::deque<std::future<FieldDataPtr>> futures;
         for (const auto& file : remote_files) {
-            auto future = pool.Submit([&]() {
-                auto fileSize = rcm->Size(file);
-                auto buf = std::shared_ptr<uint8_t[]>(new uint8_t[fileSize]);
-                rcm->Read(file, buf.get(), fileSize);
+            if (futures.size() >= parallel_degree) {
+                channel->push(futures.front().get());
+                futures.pop_front();
+            }
+            auto reservation = storage::ReserveLoadMemory();
+            auto future = pool.Submit([rcm, file, reservation]() {
+                std::shared_ptr<uint8_t[]> buf;
+                auto fileSize = rcm->ReadAll(file, buf);
                 auto result = storage::DeserializeFileData(buf, fileSize);
-                return result->GetFieldData();
+                auto field_data = result->GetFieldData();
+                reservation->Resize(field_data->Size());
+                return storage::HoldLoadMemory(std::move(field_data),
+                                               reservation);
             });
             futures.emplace_back(std::move(future));
         }
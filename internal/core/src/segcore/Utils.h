@@ -16,7 +16,9 @@
 #include <memory>
 #include <stdexcept>
 #include <cstdlib>
+#include <queue>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -212,4 +214,45 @@ upper_bound(const ConcurrentVector<Timestamp>& timestamps,
             int64_t first,
             int64_t last,
             Timestamp value);
+
+// The pk index walk of OffsetMap::find_first stops after limit hits, which
+// is about limit * num_rows / hit_num entries if hits spread evenly, while
+// find_first_by_heap visits every hit at a higher cost per hit.
+inline bool
+prefer_find_first_by_heap(int64_t limit, int64_t hit_num, int64_t num_rows) {
+    if (limit == Unlimited || limit == NoLimit || limit > hit_num) {
+        limit = hit_num;
+    }
+    return hit_num * hit_num * 8 < limit * num_rows;
+}
+
+// Same result as OffsetMap::find_first, selects the unfiltered offsets of
+// the smallest limit pks with a bounded heap, pk_at(offset) returns the pk
+// of the row at offset.
+template <typename PkAt>
+std::pair<std::vector<OffsetMap::OffsetType>, bool>
+find_first_by_heap(int64_t limit, const BitsetType& bitset, PkAt pk_at) {
+    using PkViewType = std::decay_t<decltype(pk_at(int64_t(0)))>;
+    auto hits = bitset.clone();
+    hits.flip();
+    int64_t hit_num = hits.count();
+    if (limit == Unlimited || limit == NoLimit) {
+        limit = hit_num;
+    }
+
+    std::priority_queue<std::pair<PkViewType, int64_t>> heap;
+    for (auto offset = hits.find_first(); offset.has_value();
+         offset = hits.find_next(offset.value())) {
+        heap.emplace(pk_at(offset.value()), offset.value());
+        if (static_cast<int64_t>(heap.size()) > limit) {
+            heap.pop();
+        }
+    }
+    std::vector<OffsetMap::OffsetType> seg_offsets(heap.size());
+    for (auto i = seg_offsets.size(); i > 0; i--) {
+        seg_offsets[i - 1] = heap.top().second;
+        heap.pop();
+    }
+    return {std::move(seg_offsets), hit_num > limit};
+}
 }  // namespace milvus::segcore
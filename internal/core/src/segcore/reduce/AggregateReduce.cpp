@@ -0,0 +1,37 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "segcore/reduce/AggregateReduce.h"
+
+#include "exec/operator/aggregate/AggregateTable.h"
+
+namespace milvus::segcore {
+
+std::vector<DataArray>
+MergePartialAggregates(
+    const std::shared_ptr<const plan::AggregationNode>& node,
+    const std::vector<const proto::segcore::RetrieveResults*>& results) {
+    exec::AggregateTable table(node);
+    for (auto result : results) {
+        table.MergePartial(result->fields_data());
+    }
+    return table.SerializePartial();
+}
+
+std::vector<DataArray>
+FinalizeAggregates(const std::shared_ptr<const plan::AggregationNode>& node,
+                   const std::vector<DataArray>& partial) {
+    exec::AggregateTable table(node);
+    table.MergePartial(partial);
+    return table.Finalize();
+}
+
+}  // namespace milvus::segcore
@@ -0,0 +1,38 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "common/Types.h"
+#include "pb/segcore.pb.h"
+#include "plan/PlanNode.h"
+
+namespace milvus::segcore {
+
+// Merges the partial aggregates the segments return in the fields data of
+// their retrieve results. The merged partial aggregate has the same layout,
+// so the merged results of several nodes can be merged again.
+std::vector<DataArray>
+MergePartialAggregates(
+    const std::shared_ptr<const plan::AggregationNode>& node,
+    const std::vector<const proto::segcore::RetrieveResults*>& results);
+
+// Computes the values of the aggregates from a partial aggregate: avg as
+// the quotient of the sum and the count, count distinct as the number of
+// the distinct values.
+std::vector<DataArray>
+FinalizeAggregates(const std::shared_ptr<const plan::AggregationNode>& node,
+                   const std::vector<DataArray>& partial);
+
+}  // namespace milvus::segcore
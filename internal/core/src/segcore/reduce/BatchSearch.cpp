@@ -0,0 +1,203 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "segcore/reduce/BatchSearch.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+#include "common/EasyAssert.h"
+#include "common/Utils.h"
+#include "futures/Executor.h"
+#include "segcore/reduce/StreamReduce.h"
+
+namespace milvus::segcore {
+
+namespace {
+
+struct BatchSearchState {
+    std::vector<SegmentInterface*> segments;
+    query::Plan* plan;
+    const query::PlaceholderGroup* placeholder_group;
+    Timestamp timestamp;
+    const OpContext* op_context;
+    StreamReducerHelper* reducer;
+
+    std::atomic<int64_t> next_segment{0};
+
+    std::mutex mutex;
+    std::condition_variable done_cv;
+    int64_t num_done{0};
+    std::exception_ptr error;
+    // results of the searched segments not merged yet
+    std::vector<std::unique_ptr<SearchResult>> pending;
+
+    // held by the thread merging into the reducer
+    std::mutex reduce_mutex;
+};
+
+void
+SetError(BatchSearchState& state) {
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (!state.error) {
+        state.error = std::current_exception();
+    }
+}
+
+// merges the pending results unless another thread is merging, that thread
+// picks up the results pushed before it releases the reducer
+void
+MergePending(BatchSearchState& state) {
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> reduce_lock(state.reduce_mutex,
+                                                     std::try_to_lock);
+            if (!reduce_lock.owns_lock()) {
+                return;
+            }
+            for (;;) {
+                std::vector<std::unique_ptr<SearchResult>> batch;
+                bool failed;
+                {
+                    std::lock_guard<std::mutex> lock(state.mutex);
+                    batch.swap(state.pending);
+                    failed = state.error != nullptr;
+                }
+                if (batch.empty()) {
+                    break;
+                }
+                if (failed) {
+                    continue;
+                }
+                std::vector<SearchResult*> results;
+                results.reserve(batch.size());
+                for (auto& result : batch) {
+                    results.push_back(result.get());
+                }
+                try {
+                    state.reducer->SetSearchResultsToMerge(results);
+                    state.reducer->MergeReduce();
+                } catch (...) {
+                    SetError(state);
+                }
+            }
+        }
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if (state.pending.empty()) {
+            return;
+        }
+    }
+}
+
+void
+SearchSegment(BatchSearchState& state, int64_t index) {
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if (state.error) {
+            return;
+        }
+    }
+    auto& search_info = state.plan->plan_node_->search_info_;
+    auto result = state.segments[index]->Search(state.plan,
+                                                state.placeholder_group,
+                                                state.timestamp,
+                                                state.op_context);
+    if (!PositivelyRelated(search_info.metric_type_)) {
+        for (auto& dis : result->distances_) {
+            dis *= -1;
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.pending.push_back(std::move(result));
+    }
+    MergePending(state);
+}
+
+// claims and searches segments until none is left
+void
+SearchSegments(BatchSearchState& state) {
+    for (;;) {
+        auto index = state.next_segment.fetch_add(1);
+        if (index >= int64_t(state.segments.size())) {
+            return;
+        }
+        try {
+            SearchSegment(state, index);
+        } catch (...) {
+            SetError(state);
+        }
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if (++state.num_done == int64_t(state.segments.size())) {
+            state.done_cv.notify_all();
+        }
+    }
+}
+
+}  // namespace
+
+std::unique_ptr<SearchResultDataBlobs>
+SearchSegmentsAndReduce(const std::vector<SegmentInterface*>& segments,
+                        query::Plan* plan,
+                        const query::PlaceholderGroup* placeholder_group,
+                        Timestamp timestamp,
+                        const std::vector<int64_t>& slice_nqs,
+                        const std::vector<int64_t>& slice_topKs,
+                        folly::Executor* executor,
+                        int64_t concurrency,
+                        const OpContext* op_context) {
+    AssertInfo(!segments.empty(), "no segment to search");
+    AssertInfo(slice_nqs.size() == slice_topKs.size(),
+               "unaligned slice_nqs and slice_topKs");
+    // the reducer copies the slices
+    StreamReducerHelper reducer(plan,
+                                const_cast<int64_t*>(slice_nqs.data()),
+                                const_cast<int64_t*>(slice_topKs.data()),
+                                slice_nqs.size());
+
+    auto state = std::make_shared<BatchSearchState>();
+    state->segments = segments;
+    state->plan = plan;
+    state->placeholder_group = placeholder_group;
+    state->timestamp = timestamp;
+    state->op_context = op_context;
+    state->reducer = &reducer;
+
+    // a helper starting after all the segments are claimed exits at once,
+    // it only touches the state it shares
+    auto num_helpers =
+        std::min<int64_t>(segments.size(), std::max<int64_t>(concurrency, 1)) -
+        1;
+    for (int64_t i = 0; i < num_helpers; i++) {
+        executor->addWithPriority([state]() { SearchSegments(*state); },
+                                  futures::ExecutePriority::HIGH);
+    }
+    SearchSegments(*state);
+    {
+        // the segments claimed by helpers are searched by running threads
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->done_cv.wait(lock, [&]() {
+            return state->num_done == int64_t(state->segments.size());
+        });
+    }
+    MergePending(*state);
+
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->pending.clear();
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
+    return std::unique_ptr<SearchResultDataBlobs>(
+        static_cast<SearchResultDataBlobs*>(reducer.SerializeMergedResult()));
+}
+
+}  // namespace milvus::segcore
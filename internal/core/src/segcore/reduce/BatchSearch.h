@@ -0,0 +1,46 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <folly/Executor.h>
+
+#include "common/OpContext.h"
+#include "query/PlanImpl.h"
+#include "segcore/SegmentInterface.h"
+#include "segcore/reduce/Reduce.h"
+
+namespace milvus::segcore {
+
+// Searches the segments with one plan and placeholder group and reduces
+// their results into the marshalled blobs of the slices.
+//
+// The segments are claimed one by one by the calling thread and by up to
+// concurrency - 1 helpers scheduled on executor. The result of every
+// segment is merged into a shared stream reducer as soon as the segment is
+// done, by whichever thread finds the reducer free, and released right
+// after, so at most the results of the segments in flight are kept besides
+// the merged top k.
+std::unique_ptr<SearchResultDataBlobs>
+SearchSegmentsAndReduce(const std::vector<SegmentInterface*>& segments,
+                        query::Plan* plan,
+                        const query::PlaceholderGroup* placeholder_group,
+                        Timestamp timestamp,
+                        const std::vector<int64_t>& slice_nqs,
+                        const std::vector<int64_t>& slice_topKs,
+                        folly::Executor* executor,
+                        int64_t concurrency,
+                        const OpContext* op_context = nullptr);
+
+}  // namespace milvus::segcore
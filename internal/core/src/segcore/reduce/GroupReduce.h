@@ -21,13 +21,15 @@ class GroupReduceHelper : public ReduceHelper {
                                int64_t* slice_nqs,
                                int64_t* slice_topKs,
                                int64_t slice_num,
-                               tracer::TraceContext* trace_ctx)
+                               tracer::TraceContext* trace_ctx,
+                               const OpContext* op_context = nullptr)
         : ReduceHelper(search_results,
                        plan,
                        slice_nqs,
                        slice_topKs,
                        slice_num,
-                       trace_ctx) {
+                       trace_ctx,
+                       op_context) {
     }
 
  protected:
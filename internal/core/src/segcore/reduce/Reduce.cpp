@@ -54,6 +54,7 @@ ReduceHelper::Initialize() {
 
 void
 ReduceHelper::Reduce() {
+    CheckCancellation(op_context_);
     FillPrimaryKey();
     ReduceResultData();
     RefreshSearchResults();
@@ -68,6 +69,7 @@ ReduceHelper::Marshal() {
         std::make_unique<milvus::segcore::SearchResultDataBlobs>();
     search_result_data_blobs_->blobs.resize(num_slices_);
     for (int i = 0; i < num_slices_; i++) {
+        CheckCancellation(op_context_, double(i) / num_slices_);
         auto proto = GetSearchResultDataSlice(i);
         search_result_data_blobs_->blobs[i] = proto;
     }
@@ -278,6 +280,9 @@ ReduceHelper::ReduceResultData() {
         // reduce search results
         int64_t offset = 0;
         for (int64_t qi = nq_begin; qi < nq_end; qi++) {
+            if ((qi - nq_begin) % REDUCE_CHECK_NQ_BLOCK == 0) {
+                CheckCancellation(op_context_, double(qi) / total_nq_);
+            }
             filtered_count += ReduceSearchResultForOneNQ(
                 qi, slice_topKs_[slice_index], offset);
         }
@@ -19,6 +19,7 @@
 #include <unordered_set>
 
 #include "common/type_c.h"
+#include "common/OpContext.h"
 #include "common/QueryResult.h"
 #include "query/PlanImpl.h"
 #include "segcore/ReduceStructure.h"
@@ -27,6 +28,9 @@
 
 namespace milvus::segcore {
 
+// the queries reduced between two checks of the deadline of a reduce
+constexpr int64_t REDUCE_CHECK_NQ_BLOCK = 64;
+
 // SearchResultDataBlobs contains the marshal blobs of many `milvus::proto::schema::SearchResultData`
 struct SearchResultDataBlobs {
     std::vector<std::vector<char>> blobs;
@@ -39,12 +43,14 @@ class ReduceHelper {
                           int64_t* slice_nqs,
                           int64_t* slice_topKs,
                           int64_t slice_num,
-                          tracer::TraceContext* trace_ctx)
+                          tracer::TraceContext* trace_ctx,
+                          const OpContext* op_context = nullptr)
         : search_results_(search_results),
           plan_(plan),
           slice_nqs_(slice_nqs, slice_nqs + slice_num),
           slice_topKs_(slice_topKs, slice_topKs + slice_num),
-          trace_ctx_(trace_ctx) {
+          trace_ctx_(trace_ctx),
+          op_context_(op_context) {
         Initialize();
     }
 
@@ -117,6 +123,8 @@ class ReduceHelper {
     // output
     std::unique_ptr<SearchResultDataBlobs> search_result_data_blobs_;
     tracer::TraceContext* trace_ctx_;
+    // checked between the slices and the blocks of queries
+    const OpContext* op_context_;
 };
 
 }  // namespace milvus::segcore
@@ -10,6 +10,8 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include <vector>
+#include "futures/Future.h"
+#include "segcore/reduce/BatchSearch.h"
 #include "segcore/reduce/Reduce.h"
 #include "segcore/reduce/GroupReduce.h"
 #include "common/QueryResult.h"
@@ -82,10 +84,14 @@ ReduceSearchResultsAndFillData(CTraceContext c_trace,
                                int64_t num_segments,
                                int64_t* slice_nqs,
                                int64_t* slice_topKs,
-                               int64_t num_slices) {
+                               int64_t num_slices,
+                               int64_t deadline_ms) {
     try {
         // get SearchResult and SearchPlan
         auto plan = static_cast<milvus::query::Plan*>(c_plan);
+        milvus::OpContext op_context(
+            folly::CancellationToken(),
+            milvus::OpContext::DeadlineFromUnixMs(deadline_ms));
         AssertInfo(num_segments > 0, "num_segments must be greater than 0");
         auto trace_ctx = milvus::tracer::TraceContext{
             c_trace.traceID, c_trace.spanID, c_trace.traceFlags};
@@ -105,7 +111,8 @@ ReduceSearchResultsAndFillData(CTraceContext c_trace,
                     slice_nqs,
                     slice_topKs,
                     num_slices,
-                    &trace_ctx);
+                    &trace_ctx,
+                    &op_context);
         } else {
             reduce_helper =
                 std::make_shared<milvus::segcore::ReduceHelper>(search_results,
@@ -113,7 +120,8 @@ ReduceSearchResultsAndFillData(CTraceContext c_trace,
                                                                 slice_nqs,
                                                                 slice_topKs,
                                                                 num_slices,
-                                                                &trace_ctx);
+                                                                &trace_ctx,
+                                                                &op_context);
         }
         reduce_helper->Reduce();
         reduce_helper->Marshal();
@@ -126,6 +134,73 @@ ReduceSearchResultsAndFillData(CTraceContext c_trace,
     }
 }
 
+CFuture*  // Future<SearchResultDataBlobs>
+AsyncSearchAndReduce(CTraceContext c_trace,
+                     CSegmentInterface* c_segments,
+                     int64_t num_segments,
+                     CSearchPlan c_plan,
+                     CPlaceholderGroup c_placeholder_group,
+                     uint64_t timestamp,
+                     int64_t deadline_ms,
+                     int64_t* slice_nqs,
+                     int64_t* slice_topKs,
+                     int64_t num_slices) {
+    // the arrays belong to the caller, which doesn't wait for the future
+    std::vector<milvus::segcore::SegmentInterface*> segments(num_segments);
+    for (int64_t i = 0; i < num_segments; i++) {
+        segments[i] =
+            static_cast<milvus::segcore::SegmentInterface*>(c_segments[i]);
+    }
+    std::vector<int64_t> nqs(slice_nqs, slice_nqs + num_slices);
+    std::vector<int64_t> topKs(slice_topKs, slice_topKs + num_slices);
+    auto plan = static_cast<milvus::query::Plan*>(c_plan);
+    auto phg_ptr = static_cast<const milvus::query::PlaceholderGroup*>(
+        c_placeholder_group);
+
+    auto future =
+        milvus::futures::Future<milvus::segcore::SearchResultDataBlobs>::async(
+            milvus::futures::getGlobalCPUExecutor(),
+            milvus::futures::ExecutePriority::HIGH,
+            [c_trace,
+             segments = std::move(segments),
+             plan,
+             phg_ptr,
+             timestamp,
+             deadline_ms,
+             nqs = std::move(nqs),
+             topKs = std::move(topKs)](
+                milvus::futures::CancellationToken cancel_token) {
+                milvus::OpContext op_context(
+                    std::move(cancel_token),
+                    milvus::OpContext::DeadlineFromUnixMs(deadline_ms));
+                auto& trace_ctx = plan->plan_node_->search_info_.trace_ctx_;
+                trace_ctx.traceID = c_trace.traceID;
+                trace_ctx.spanID = c_trace.spanID;
+                trace_ctx.traceFlags = c_trace.traceFlags;
+
+                auto span = milvus::tracer::StartSpan(
+                    "SegCoreSearchAndReduce", &trace_ctx);
+                milvus::tracer::SetRootSpan(span);
+
+                auto executor = milvus::futures::getGlobalCPUExecutor();
+                auto blobs = milvus::segcore::SearchSegmentsAndReduce(
+                    segments,
+                    plan,
+                    phg_ptr,
+                    timestamp,
+                    nqs,
+                    topKs,
+                    executor,
+                    executor->numThreads(),
+                    &op_context);
+                span->End();
+                milvus::tracer::CloseRootSpan();
+                return blobs.release();
+            });
+    return static_cast<CFuture*>(static_cast<void*>(
+        static_cast<milvus::futures::IFuture*>(future.release())));
+}
+
 CStatus
 GetSearchResultDataBlob(CProto* searchResultDataBlob,
                         CSearchResultDataBlobs cSearchResultDataBlobs,
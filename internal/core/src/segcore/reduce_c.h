@@ -36,6 +36,8 @@ CStatus
 GetStreamReduceResult(CSearchStreamReducer c_stream_reducer,
                       CSearchResultDataBlobs* c_search_result_data_blobs);
 
+// deadline_ms is a unix timestamp in milliseconds, 0 for no deadline, the
+// reduce stops between the slices and the blocks of queries past it
 CStatus
 ReduceSearchResultsAndFillData(CTraceContext c_trace,
                                CSearchResultDataBlobs* cSearchResultDataBlobs,
@@ -44,7 +46,22 @@ ReduceSearchResultsAndFillData(CTraceContext c_trace,
                                int64_t num_segments,
                                int64_t* slice_nqs,
                                int64_t* slice_topKs,
-                               int64_t num_slices);
+                               int64_t num_slices,
+                               int64_t deadline_ms);
+
+// searches the segments with one plan and reduces their results, the
+// result of the future is a CSearchResultDataBlobs
+CFuture*  // Future<SearchResultDataBlobs>
+AsyncSearchAndReduce(CTraceContext c_trace,
+                     CSegmentInterface* c_segments,
+                     int64_t num_segments,
+                     CSearchPlan c_plan,
+                     CPlaceholderGroup c_placeholder_group,
+                     uint64_t timestamp,
+                     int64_t deadline_ms,
+                     int64_t* slice_nqs,
+                     int64_t* slice_topKs,
+                     int64_t num_slices);
 
 CStatus
 GetSearchResultDataBlob(CProto* searchResultDataBlob,
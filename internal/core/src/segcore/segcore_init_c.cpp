@@ -53,6 +53,48 @@ SegcoreSetNprobe(const int64_t value) {
     config.set_nprobe(value);
 }
 
+extern "C" void
+SegcoreSetJsonShreddingMaxPaths(const int64_t value) {
+    milvus::segcore::SegcoreConfig& config =
+        milvus::segcore::SegcoreConfig::default_config();
+    config.set_json_shredding_max_paths(value);
+}
+
+extern "C" void
+SegcoreSetJsonShreddingMinPresenceRatio(const double value) {
+    milvus::segcore::SegcoreConfig& config =
+        milvus::segcore::SegcoreConfig::default_config();
+    config.set_json_shredding_min_presence_ratio(value);
+}
+
+extern "C" void
+SegcoreSetBruteForceFilterRatio(const double value) {
+    milvus::segcore::SegcoreConfig& config =
+        milvus::segcore::SegcoreConfig::default_config();
+    config.set_brute_force_filter_ratio(value);
+}
+
+extern "C" void
+SegcoreSetFilterCacheCapacity(const int64_t value) {
+    milvus::segcore::SegcoreConfig& config =
+        milvus::segcore::SegcoreConfig::default_config();
+    config.set_filter_cache_capacity(value);
+}
+
+extern "C" void
+SegcoreSetRetrieveCursorCapacity(const int64_t value) {
+    milvus::segcore::SegcoreConfig& config =
+        milvus::segcore::SegcoreConfig::default_config();
+    config.set_retrieve_cursor_capacity(value);
+}
+
+extern "C" void
+SegcoreSetRetrieveCursorTTL(const int64_t value) {
+    milvus::segcore::SegcoreConfig& config =
+        milvus::segcore::SegcoreConfig::default_config();
+    config.set_retrieve_cursor_ttl(value);
+}
+
 extern "C" void
 SegcoreSetKnowhereBuildThreadPoolNum(const uint32_t num_threads) {
     milvus::config::KnowhereInitBuildThreadPool(num_threads);
@@ -30,6 +30,24 @@ SegcoreSetNlist(const int64_t);
 void
 SegcoreSetNprobe(const int64_t);
 
+void
+SegcoreSetJsonShreddingMaxPaths(const int64_t);
+
+void
+SegcoreSetJsonShreddingMinPresenceRatio(const double);
+
+void
+SegcoreSetBruteForceFilterRatio(const double);
+
+void
+SegcoreSetFilterCacheCapacity(const int64_t);
+
+void
+SegcoreSetRetrieveCursorCapacity(const int64_t);
+
+void
+SegcoreSetRetrieveCursorTTL(const int64_t);
+
 // return value must be freed by the caller
 char*
 SegcoreSetSimdType(const char*);
@@ -26,6 +26,7 @@
 #include "log/Log.h"
 #include "mmap/Types.h"
 #include "segcore/Collection.h"
+#include "segcore/RetrieveCursor.h"
 #include "segcore/SegcoreConfig.h"
 #include "segcore/SegmentGrowingImpl.h"
 #include "segcore/SegmentSealedImpl.h"
@@ -106,12 +107,19 @@ DeleteSearchResult(CSearchResult search_result) {
     delete res;
 }
 
+const char*
+GetSearchResultProfile(CSearchResult search_result) {
+    auto res = static_cast<milvus::SearchResult*>(search_result);
+    return res->profile_.c_str();
+}
+
 CFuture*  // Future<milvus::SearchResult*>
 AsyncSearch(CTraceContext c_trace,
             CSegmentInterface c_segment,
             CSearchPlan c_plan,
             CPlaceholderGroup c_placeholder_group,
-            uint64_t timestamp) {
+            uint64_t timestamp,
+            int64_t deadline_ms) {
     auto segment = (milvus::segcore::SegmentInterface*)c_segment;
     auto plan = (milvus::query::Plan*)c_plan;
     auto phg_ptr = reinterpret_cast<const milvus::query::PlaceholderGroup*>(
@@ -120,8 +128,11 @@ AsyncSearch(CTraceContext c_trace,
     auto future = milvus::futures::Future<milvus::SearchResult>::async(
         milvus::futures::getGlobalCPUExecutor(),
         milvus::futures::ExecutePriority::HIGH,
-        [c_trace, segment, plan, phg_ptr, timestamp](
+        [c_trace, segment, plan, phg_ptr, timestamp, deadline_ms](
             milvus::futures::CancellationToken cancel_token) {
+            milvus::OpContext op_context(
+                std::move(cancel_token),
+                milvus::OpContext::DeadlineFromUnixMs(deadline_ms));
             // save trace context into search_info
             auto& trace_ctx = plan->plan_node_->search_info_.trace_ctx_;
             trace_ctx.traceID = c_trace.traceID;
@@ -131,7 +142,8 @@ AsyncSearch(CTraceContext c_trace,
             auto span = milvus::tracer::StartSpan("SegCoreSearch", &trace_ctx);
             milvus::tracer::SetRootSpan(span);
 
-            auto search_result = segment->Search(plan, phg_ptr, timestamp);
+            auto search_result =
+                segment->Search(plan, phg_ptr, timestamp, &op_context);
             if (!milvus::PositivelyRelated(
                     plan->plan_node_->search_info_.metric_type_)) {
                 for (auto& dis : search_result->distances_) {
@@ -179,21 +191,34 @@ AsyncRetrieve(CTraceContext c_trace,
               CRetrievePlan c_plan,
               uint64_t timestamp,
               int64_t limit_size,
-              bool ignore_non_pk) {
+              bool ignore_non_pk,
+              int64_t deadline_ms) {
     auto segment = static_cast<milvus::segcore::SegmentInterface*>(c_segment);
     auto plan = static_cast<const milvus::query::RetrievePlan*>(c_plan);
 
     auto future = milvus::futures::Future<CRetrieveResult>::async(
         milvus::futures::getGlobalCPUExecutor(),
         milvus::futures::ExecutePriority::HIGH,
-        [c_trace, segment, plan, timestamp, limit_size, ignore_non_pk](
-            milvus::futures::CancellationToken cancel_token) {
+        [c_trace,
+         segment,
+         plan,
+         timestamp,
+         limit_size,
+         ignore_non_pk,
+         deadline_ms](milvus::futures::CancellationToken cancel_token) {
+            milvus::OpContext op_context(
+                std::move(cancel_token),
+                milvus::OpContext::DeadlineFromUnixMs(deadline_ms));
             auto trace_ctx = milvus::tracer::TraceContext{
                 c_trace.traceID, c_trace.spanID, c_trace.traceFlags};
             milvus::tracer::AutoSpan span("SegCoreRetrieve", &trace_ctx, true);
 
-            auto retrieve_result = segment->Retrieve(
-                &trace_ctx, plan, timestamp, limit_size, ignore_non_pk);
+            auto retrieve_result = segment->Retrieve(&trace_ctx,
+                                                     plan,
+                                                     timestamp,
+                                                     limit_size,
+                                                     ignore_non_pk,
+                                                     &op_context);
 
             return CreateLeakedCRetrieveResultFromProto(
                 std::move(retrieve_result));
@@ -231,6 +256,54 @@ AsyncRetrieveByOffsets(CTraceContext c_trace,
         static_cast<milvus::futures::IFuture*>(future.release())));
 }
 
+CFuture*  // Future<CRetrieveResult>
+AsyncRetrieveByCursor(CTraceContext c_trace,
+                      CSegmentInterface c_segment,
+                      CRetrievePlan c_plan,
+                      uint64_t timestamp,
+                      int64_t cursor_id,
+                      int64_t limit_size,
+                      int64_t deadline_ms) {
+    auto segment = static_cast<milvus::segcore::SegmentInterface*>(c_segment);
+    auto plan = static_cast<const milvus::query::RetrievePlan*>(c_plan);
+
+    auto future = milvus::futures::Future<CRetrieveResult>::async(
+        milvus::futures::getGlobalCPUExecutor(),
+        milvus::futures::ExecutePriority::HIGH,
+        [c_trace,
+         segment,
+         plan,
+         timestamp,
+         cursor_id,
+         limit_size,
+         deadline_ms](milvus::futures::CancellationToken cancel_token) {
+            milvus::OpContext op_context(
+                std::move(cancel_token),
+                milvus::OpContext::DeadlineFromUnixMs(deadline_ms));
+            auto trace_ctx = milvus::tracer::TraceContext{
+                c_trace.traceID, c_trace.spanID, c_trace.traceFlags};
+            milvus::tracer::AutoSpan span(
+                "SegCoreRetrieveByCursor", &trace_ctx, true);
+
+            auto retrieve_result = segment->RetrieveByCursor(&trace_ctx,
+                                                             plan,
+                                                             timestamp,
+                                                             cursor_id,
+                                                             limit_size,
+                                                             &op_context);
+
+            return CreateLeakedCRetrieveResultFromProto(
+                std::move(retrieve_result));
+        });
+    return static_cast<CFuture*>(static_cast<void*>(
+        static_cast<milvus::futures::IFuture*>(future.release())));
+}
+
+void
+CloseRetrieveCursor(int64_t cursor_id) {
+    milvus::segcore::RetrieveCursorManager::GetInstance().Close(cursor_id);
+}
+
 int64_t
 GetMemoryUsageInBytes(CSegmentInterface c_segment) {
     auto segment = static_cast<milvus::segcore::SegmentInterface*>(c_segment);
@@ -479,6 +552,37 @@ LoadTextIndex(CSegmentInterface c_segment,
     }
 }
 
+CStatus
+LoadClusteringCentroids(CSegmentInterface c_segment,
+                        int64_t field_id,
+                        const uint8_t* serialized_centroids,
+                        const uint64_t centroids_len,
+                        const uint8_t* serialized_id_mapping,
+                        const uint64_t id_mapping_len) {
+    try {
+        auto segment_interface =
+            reinterpret_cast<milvus::segcore::SegmentInterface*>(c_segment);
+        auto segment =
+            dynamic_cast<milvus::segcore::SegmentSealed*>(segment_interface);
+        AssertInfo(segment != nullptr, "segment conversion failed");
+
+        milvus::proto::clustering::ClusteringCentroidsStats centroids;
+        AssertInfo(
+            centroids.ParseFromArray(serialized_centroids, centroids_len),
+            "failed to parse clustering centroids");
+        milvus::proto::clustering::ClusteringCentroidIdMappingStats
+            id_mapping;
+        AssertInfo(id_mapping.ParseFromArray(serialized_id_mapping,
+                                             id_mapping_len),
+                   "failed to parse clustering centroid id mapping");
+        segment->LoadClusteringCentroids(
+            milvus::FieldId(field_id), centroids, id_mapping);
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(&e);
+    }
+}
+
 CStatus
 UpdateFieldRawDataSize(CSegmentInterface c_segment,
                        int64_t field_id,
@@ -45,12 +45,18 @@ ClearSegmentData(CSegmentInterface c_segment);
 void
 DeleteSearchResult(CSearchResult search_result);
 
+// execution stats of the segment as json, empty unless the plan is
+// profiled, valid until the result is deleted
+const char*
+GetSearchResultProfile(CSearchResult search_result);
+
 CFuture*  // Future<CSearchResultBody>
 AsyncSearch(CTraceContext c_trace,
             CSegmentInterface c_segment,
             CSearchPlan c_plan,
             CPlaceholderGroup c_placeholder_group,
-            uint64_t timestamp);
+            uint64_t timestamp,
+            int64_t deadline_ms);
 
 void
 DeleteRetrieveResult(CRetrieveResult* retrieve_result);
@@ -61,7 +67,8 @@ AsyncRetrieve(CTraceContext c_trace,
               CRetrievePlan c_plan,
               uint64_t timestamp,
               int64_t limit_size,
-              bool ignore_non_pk);
+              bool ignore_non_pk,
+              int64_t deadline_ms);
 
 CFuture*  // Future<CRetrieveResult>
 AsyncRetrieveByOffsets(CTraceContext c_trace,
@@ -70,6 +77,21 @@ AsyncRetrieveByOffsets(CTraceContext c_trace,
                        int64_t* offsets,
                        int64_t len);
 
+// the next page of the paged retrieve of the cursor id, the pages of a
+// cursor must be retrieved one at a time at the same timestamp
+CFuture*  // Future<CRetrieveResult>
+AsyncRetrieveByCursor(CTraceContext c_trace,
+                      CSegmentInterface c_segment,
+                      CRetrievePlan c_plan,
+                      uint64_t timestamp,
+                      int64_t cursor_id,
+                      int64_t limit_size,
+                      int64_t deadline_ms);
+
+// drops the cursors of the id on all the segments
+void
+CloseRetrieveCursor(int64_t cursor_id);
+
 int64_t
 GetMemoryUsageInBytes(CSegmentInterface c_segment);
 
@@ -122,6 +144,14 @@ LoadTextIndex(CSegmentInterface c_segment,
               const uint8_t* serialized_load_text_index_info,
               const uint64_t len);
 
+CStatus
+LoadClusteringCentroids(CSegmentInterface c_segment,
+                        int64_t field_id,
+                        const uint8_t* serialized_centroids,
+                        const uint64_t centroids_len,
+                        const uint8_t* serialized_id_mapping,
+                        const uint64_t id_mapping_len);
+
 CStatus
 UpdateFieldRawDataSize(CSegmentInterface c_segment,
                        int64_t field_id,
@@ -16,14 +16,73 @@
 
 #pragma once
 
+#include <cstring>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <map>
 
 namespace milvus::storage {
 
+/**
+ * @brief MultipartWriter writes a file in parts numbered from 1, which may
+ * be written in any order and concurrently. All parts but the last one
+ * should be at least 5MB, the minimum part size of S3. The file shows up
+ * once Complete is called, Abort drops the parts written.
+ */
+class MultipartWriter {
+ public:
+    virtual ~MultipartWriter() = default;
+
+    virtual void
+    WritePart(int part_number, const void* buf, uint64_t len) = 0;
+
+    virtual void
+    Complete() = 0;
+
+    virtual void
+    Abort() = 0;
+};
+
+class ChunkManager;
+
+/**
+ * @brief Keeps the parts in memory and writes the file at once on Complete,
+ * for chunk managers without multipart uploads
+ */
+class BufferedMultipartWriter : public MultipartWriter {
+ public:
+    BufferedMultipartWriter(ChunkManager* chunk_manager,
+                            const std::string& filepath)
+        : chunk_manager_(chunk_manager), filepath_(filepath) {
+    }
+
+    void
+    WritePart(int part_number, const void* buf, uint64_t len) override {
+        std::vector<uint8_t> part(len);
+        std::memcpy(part.data(), buf, len);
+        std::lock_guard<std::mutex> lock(mutex_);
+        parts_[part_number] = std::move(part);
+    }
+
+    void
+    Complete() override;
+
+    void
+    Abort() override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        parts_.clear();
+    }
+
+ private:
+    ChunkManager* chunk_manager_;
+    std::string filepath_;
+    std::mutex mutex_;
+    std::map<int, std::vector<uint8_t>> parts_;
+};
+
 /**
  * @brief This ChunkManager is abstract interface for milvus that
  * used to manager operation and interaction with storage
@@ -79,6 +138,32 @@ class ChunkManager {
          void* buf,
          uint64_t len) = 0;
 
+    /**
+     * @brief Read the whole file to a newly allocated buffer, chunk managers
+     * able to learn the size while reading override it to save the extra
+     * request of Size
+     * @param filepath
+     * @param buf
+     * @return uint64_t size of the file
+     */
+    virtual uint64_t
+    ReadAll(const std::string& filepath, std::shared_ptr<uint8_t[]>& buf) {
+        auto size = Size(filepath);
+        buf = std::shared_ptr<uint8_t[]>(new uint8_t[size]);
+        return Read(filepath, buf.get(), size);
+    }
+
+    /**
+     * @brief Create a writer of the file in parts, chunk managers of object
+     * storages override it with multipart uploads
+     * @param filepath
+     * @return std::unique_ptr<MultipartWriter>
+     */
+    virtual std::unique_ptr<MultipartWriter>
+    CreateMultipartWriter(const std::string& filepath) {
+        return std::make_unique<BufferedMultipartWriter>(this, filepath);
+    }
+
     /**
      * @brief Write buffer to file with offset
      * @param filepath
@@ -125,6 +210,23 @@ class ChunkManager {
 
 using ChunkManagerPtr = std::shared_ptr<ChunkManager>;
 
+inline void
+BufferedMultipartWriter::Complete() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t size = 0;
+    for (auto& [_, part] : parts_) {
+        size += part.size();
+    }
+    std::vector<uint8_t> buf(size);
+    uint64_t offset = 0;
+    for (auto& [_, part] : parts_) {
+        std::memcpy(buf.data() + offset, part.data(), part.size());
+        offset += part.size();
+    }
+    parts_.clear();
+    chunk_manager_->Write(filepath_, buf.data(), size);
+}
+
 enum class ChunkManagerType : int8_t {
     None = 0,
     Local = 1,
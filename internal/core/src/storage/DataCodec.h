@@ -76,6 +76,11 @@ class DataCodec {
         return field_data_;
     }
 
+    void
+    SetFieldData(FieldDataPtr data) {
+        field_data_ = std::move(data);
+    }
+
     virtual std::shared_ptr<ArrowDataWrapper>
     GetReader() {
         auto ret = std::make_shared<ArrowDataWrapper>();
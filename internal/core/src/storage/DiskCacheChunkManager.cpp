@@ -0,0 +1,497 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/DiskCacheChunkManager.h"
+
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+
+#include <boost/crc.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/system/error_code.hpp>
+
+#include "common/EasyAssert.h"
+#include "log/Log.h"
+
+namespace milvus::storage {
+
+namespace {
+
+constexpr uint32_t CACHE_FILE_MAGIC = 0x4d564443;
+constexpr const char* CACHE_FILE_SUFFIX = ".cache";
+constexpr const char* TEMP_FILE_SUFFIX = ".tmp";
+
+// a cache file is the header, the path of the cached file and its data
+struct CacheFileHeader {
+    uint32_t magic;
+    uint32_t path_size;
+    uint64_t data_size;
+    uint32_t checksum;
+    uint32_t reserved;
+};
+
+uint32_t
+Checksum(const void* data, uint64_t size) {
+    boost::crc_32_type crc;
+    crc.process_bytes(data, size);
+    return crc.checksum();
+}
+
+uint64_t
+DataOffset(const CacheFileHeader& header) {
+    return sizeof(CacheFileHeader) + header.path_size;
+}
+
+bool
+ReadHeader(std::ifstream& in, CacheFileHeader& header, std::string& path) {
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        header.magic != CACHE_FILE_MAGIC) {
+        return false;
+    }
+    path.resize(header.path_size);
+    return static_cast<bool>(in.read(path.data(), header.path_size));
+}
+
+void
+RemoveFile(const std::string& file) {
+    boost::system::error_code err;
+    boost::filesystem::remove(file, err);
+    if (err) {
+        LOG_WARN("failed to remove cache file {}: {}", file, err.message());
+    }
+}
+
+void
+RemoveFiles(const std::vector<std::string>& files) {
+    for (auto& file : files) {
+        RemoveFile(file);
+    }
+}
+
+}  // namespace
+
+DiskCacheChunkManager::DiskCacheChunkManager(ChunkManagerPtr remote,
+                                             const std::string& cache_path,
+                                             int64_t capacity)
+    : remote_(std::move(remote)),
+      cache_path_(cache_path),
+      capacity_(capacity) {
+    AssertInfo(remote_ != nullptr, "remote chunk manager is null");
+    AssertInfo(capacity > 0,
+               "invalid capacity {} of disk cache chunk manager",
+               capacity);
+    boost::filesystem::create_directories(cache_path_);
+    Rescan();
+    LOG_INFO("init disk cache of {} at {}, {} files of {} bytes cached",
+             remote_->GetName(),
+             cache_path_,
+             entries_.size(),
+             used_size_);
+}
+
+void
+DiskCacheChunkManager::Rescan() {
+    struct Found {
+        std::time_t mtime;
+        std::string path;
+        std::string file;
+        uint64_t size;
+        uint64_t file_size;
+    };
+    std::vector<Found> found;
+    uint64_t max_file_id = 0;
+    for (auto& item : boost::filesystem::directory_iterator(cache_path_)) {
+        if (!boost::filesystem::is_regular_file(item.status())) {
+            continue;
+        }
+        auto file = item.path().string();
+        // left by a crash in the middle of an insert
+        if (item.path().extension() != CACHE_FILE_SUFFIX) {
+            RemoveFile(file);
+            continue;
+        }
+        try {
+            max_file_id = std::max<uint64_t>(
+                max_file_id, std::stoull(item.path().stem().string()));
+        } catch (std::exception&) {
+            RemoveFile(file);
+            continue;
+        }
+
+        std::ifstream in(file, std::ios::binary);
+        CacheFileHeader header;
+        std::string path;
+        boost::system::error_code err;
+        auto file_size = boost::filesystem::file_size(item.path(), err);
+        if (err || !ReadHeader(in, header, path) ||
+            file_size != DataOffset(header) + header.data_size) {
+            LOG_WARN("remove corrupted cache file {}", file);
+            RemoveFile(file);
+            continue;
+        }
+        found.push_back({boost::filesystem::last_write_time(item.path()),
+                         std::move(path),
+                         file,
+                         header.data_size,
+                         file_size});
+    }
+    next_file_id_ = max_file_id + 1;
+
+    // the last access of a copy touches its file
+    std::sort(found.begin(), found.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.mtime > rhs.mtime;
+    });
+    std::vector<std::string> removed;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& item : found) {
+            if (entries_.count(item.path) > 0 ||
+                used_size_ + item.file_size > capacity_) {
+                removed.push_back(item.file);
+                continue;
+            }
+            lru_.push_back(item.path);
+            entries_.emplace(item.path,
+                             Entry{item.file,
+                                   item.size,
+                                   item.file_size,
+                                   std::prev(lru_.end()),
+                                   false});
+            used_size_ += item.file_size;
+        }
+    }
+    RemoveFiles(removed);
+}
+
+void
+DiskCacheChunkManager::Drop(const std::string& filepath,
+                            const std::string& file) {
+    std::vector<std::string> removed;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = entries_.find(filepath);
+        if (iter != entries_.end() && iter->second.file == file) {
+            RemoveLocked(iter, removed);
+        }
+    }
+    RemoveFiles(removed);
+}
+
+bool
+DiskCacheChunkManager::Validate(const std::string& filepath,
+                                const std::string& file,
+                                uint64_t size) {
+    bool valid = false;
+    try {
+        valid = remote_->Size(filepath) == size;
+    } catch (std::exception&) {
+        // the remote file is gone, its copy is dropped
+    }
+    if (!valid) {
+        LOG_INFO("drop stale cache file {} of {}", file, filepath);
+        Drop(filepath, file);
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = entries_.find(filepath);
+    if (iter == entries_.end() || iter->second.file != file) {
+        return false;
+    }
+    iter->second.validated = true;
+    return true;
+}
+
+std::optional<uint64_t>
+DiskCacheChunkManager::ReadCached(const std::string& filepath,
+                                  uint64_t offset,
+                                  void* buf,
+                                  uint64_t len) {
+    std::string file;
+    uint64_t size;
+    bool validated;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = entries_.find(filepath);
+        if (iter == entries_.end() || offset > iter->second.size) {
+            return std::nullopt;
+        }
+        auto& entry = iter->second;
+        lru_.splice(lru_.begin(), lru_, entry.lru);
+        file = entry.file;
+        size = entry.size;
+        validated = entry.validated;
+    }
+    if (!validated && !Validate(filepath, file, size)) {
+        return std::nullopt;
+    }
+
+    // cache file names are never reused, if the copy is evicted before it's
+    // opened, the open fails and the read is a miss
+    std::ifstream in(file, std::ios::binary);
+    if (in.fail()) {
+        Drop(filepath, file);
+        return std::nullopt;
+    }
+    CacheFileHeader header;
+    std::string path;
+    auto read = std::min(len, size - offset);
+    bool valid = ReadHeader(in, header, path) && path == filepath &&
+                 header.data_size == size &&
+                 in.seekg(DataOffset(header) + offset) &&
+                 in.read(static_cast<char*>(buf), read);
+    // only a read of the whole file can be checked against the checksum
+    if (valid && offset == 0 && read == size) {
+        valid = Checksum(buf, read) == header.checksum;
+    }
+    if (!valid) {
+        LOG_WARN("drop corrupted cache file {} of {}", file, filepath);
+        in.close();
+        Drop(filepath, file);
+        return std::nullopt;
+    }
+
+    boost::system::error_code err;
+    boost::filesystem::last_write_time(file, std::time(nullptr), err);
+    return read;
+}
+
+void
+DiskCacheChunkManager::Insert(const std::string& filepath,
+                              const void* data,
+                              uint64_t size) {
+    CacheFileHeader header{CACHE_FILE_MAGIC,
+                           static_cast<uint32_t>(filepath.size()),
+                           size,
+                           Checksum(data, size),
+                           0};
+    auto file_size = DataOffset(header) + size;
+    if (file_size > capacity_) {
+        return;
+    }
+
+    // written aside and renamed, a crash never leaves a partial cache file
+    auto file_id = std::to_string(next_file_id_.fetch_add(1));
+    auto file = (boost::filesystem::path(cache_path_) /
+                 (file_id + CACHE_FILE_SUFFIX))
+                    .string();
+    auto temp_file = (boost::filesystem::path(cache_path_) /
+                      (file_id + TEMP_FILE_SUFFIX))
+                         .string();
+    {
+        std::ofstream out(temp_file, std::ios::binary);
+        if (!out.write(reinterpret_cast<const char*>(&header),
+                       sizeof(header)) ||
+            !out.write(filepath.data(), filepath.size()) ||
+            !out.write(static_cast<const char*>(data), size) ||
+            !out.flush()) {
+            LOG_WARN("failed to write cache file {} of {}", file, filepath);
+            out.close();
+            RemoveFile(temp_file);
+            return;
+        }
+    }
+
+    // the file is renamed before it's added to the entries, a crash in
+    // between leaves a copy the rescan picks up
+    boost::system::error_code err;
+    boost::filesystem::rename(temp_file, file, err);
+    if (err) {
+        LOG_WARN("failed to rename cache file {}: {}", file, err.message());
+        RemoveFile(temp_file);
+        return;
+    }
+
+    std::vector<std::string> removed;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = entries_.find(filepath);
+        if (iter != entries_.end()) {
+            RemoveLocked(iter, removed);
+        }
+        EvictLocked(file_size, removed);
+        lru_.push_front(filepath);
+        entries_.emplace(filepath,
+                         Entry{file, size, file_size, lru_.begin(), true});
+        used_size_ += file_size;
+    }
+    RemoveFiles(removed);
+}
+
+void
+DiskCacheChunkManager::Invalidate(const std::string& filepath) {
+    std::vector<std::string> removed;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = entries_.find(filepath);
+        if (iter != entries_.end()) {
+            RemoveLocked(iter, removed);
+        }
+    }
+    RemoveFiles(removed);
+}
+
+void
+DiskCacheChunkManager::EvictLocked(uint64_t size,
+                                   std::vector<std::string>& removed) {
+    while (!lru_.empty() && used_size_ + size > capacity_) {
+        RemoveLocked(entries_.find(lru_.back()), removed);
+    }
+}
+
+void
+DiskCacheChunkManager::RemoveLocked(
+    std::unordered_map<std::string, Entry>::iterator iter,
+    std::vector<std::string>& removed) {
+    auto& entry = iter->second;
+    removed.push_back(entry.file);
+    used_size_ -= entry.file_size;
+    lru_.erase(entry.lru);
+    entries_.erase(iter);
+}
+
+bool
+DiskCacheChunkManager::IsCached(const std::string& filepath) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.count(filepath) > 0;
+}
+
+int64_t
+DiskCacheChunkManager::GetUsedSize() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return used_size_;
+}
+
+bool
+DiskCacheChunkManager::Exist(const std::string& filepath) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = entries_.find(filepath);
+        if (iter != entries_.end() && iter->second.validated) {
+            return true;
+        }
+    }
+    return remote_->Exist(filepath);
+}
+
+uint64_t
+DiskCacheChunkManager::Size(const std::string& filepath) {
+    std::optional<Entry> entry;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = entries_.find(filepath);
+        if (iter != entries_.end()) {
+            entry = iter->second;
+        }
+    }
+    if (entry.has_value() &&
+        (entry->validated || Validate(filepath, entry->file, entry->size))) {
+        return entry->size;
+    }
+    return remote_->Size(filepath);
+}
+
+uint64_t
+DiskCacheChunkManager::Read(const std::string& filepath,
+                            void* buf,
+                            uint64_t len) {
+    auto cached = ReadCached(filepath, 0, buf, len);
+    if (cached.has_value()) {
+        return cached.value();
+    }
+    // the size of the file comes with the read of the whole of it, instead
+    // of a separate size request to the remote
+    std::shared_ptr<uint8_t[]> data;
+    auto size = remote_->ReadAll(filepath, data);
+    Insert(filepath, data.get(), size);
+    auto read = std::min(len, size);
+    std::memcpy(buf, data.get(), read);
+    return read;
+}
+
+uint64_t
+DiskCacheChunkManager::Read(const std::string& filepath,
+                            uint64_t offset,
+                            void* buf,
+                            uint64_t len) {
+    auto cached = ReadCached(filepath, offset, buf, len);
+    if (cached.has_value()) {
+        return cached.value();
+    }
+    return remote_->Read(filepath, offset, buf, len);
+}
+
+uint64_t
+DiskCacheChunkManager::ReadAll(const std::string& filepath,
+                               std::shared_ptr<uint8_t[]>& buf) {
+    std::optional<uint64_t> size;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = entries_.find(filepath);
+        if (iter != entries_.end()) {
+            size = iter->second.size;
+        }
+    }
+    if (size.has_value()) {
+        auto data = std::shared_ptr<uint8_t[]>(new uint8_t[size.value()]);
+        auto cached = ReadCached(filepath, 0, data.get(), size.value());
+        if (cached.has_value() && cached.value() == size.value()) {
+            buf = std::move(data);
+            return size.value();
+        }
+    }
+
+    auto read = remote_->ReadAll(filepath, buf);
+    Insert(filepath, buf.get(), read);
+    return read;
+}
+
+void
+DiskCacheChunkManager::Write(const std::string& filepath,
+                             void* buf,
+                             uint64_t len) {
+    Invalidate(filepath);
+    remote_->Write(filepath, buf, len);
+}
+
+void
+DiskCacheChunkManager::Write(const std::string& filepath,
+                             uint64_t offset,
+                             void* buf,
+                             uint64_t len) {
+    Invalidate(filepath);
+    remote_->Write(filepath, offset, buf, len);
+}
+
+std::unique_ptr<MultipartWriter>
+DiskCacheChunkManager::CreateMultipartWriter(const std::string& filepath) {
+    Invalidate(filepath);
+    return remote_->CreateMultipartWriter(filepath);
+}
+
+std::vector<std::string>
+DiskCacheChunkManager::ListWithPrefix(const std::string& filepath) {
+    return remote_->ListWithPrefix(filepath);
+}
+
+void
+DiskCacheChunkManager::Remove(const std::string& filepath) {
+    Invalidate(filepath);
+    remote_->Remove(filepath);
+}
+
+}  // namespace milvus::storage
@@ -0,0 +1,193 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "storage/ChunkManager.h"
+
+namespace milvus::storage {
+
+/**
+ * @brief DiskCacheChunkManager keeps copies of the files read from the
+ * wrapped chunk manager on local disk and serves later reads of them from
+ * there. The copies are bounded by capacity bytes and evicted in LRU
+ * order, and they are found again by a rescan of the cache directory when
+ * the chunk manager is created, so a restarted node reloads its segments
+ * from local disk.
+ *
+ * Remote files are immutable once written, binlogs and index files carry
+ * unique ids in their paths, so the copies are keyed by path and size.
+ * Writes and removes through this chunk manager drop the copy of the path,
+ * and the copies found by the rescan are checked against the size of the
+ * remote file on their first use, as it may have changed while the node
+ * was down.
+ * Every copy is stored with a checksum of its data, which is verified when
+ * the whole file is read, a corrupted copy is dropped and read again from
+ * the wrapped chunk manager.
+ */
+class DiskCacheChunkManager : public ChunkManager {
+ public:
+    DiskCacheChunkManager(ChunkManagerPtr remote,
+                          const std::string& cache_path,
+                          int64_t capacity);
+
+    DiskCacheChunkManager(const DiskCacheChunkManager&) = delete;
+    DiskCacheChunkManager&
+    operator=(const DiskCacheChunkManager&) = delete;
+
+    virtual ~DiskCacheChunkManager() {
+    }
+
+    virtual bool
+    Exist(const std::string& filepath);
+
+    virtual uint64_t
+    Size(const std::string& filepath);
+
+    /**
+     * @brief Read file to buffer, a miss reads and caches the whole file
+     */
+    virtual uint64_t
+    Read(const std::string& filepath, void* buf, uint64_t len);
+
+    virtual void
+    Write(const std::string& filepath, void* buf, uint64_t len);
+
+    /**
+     * @brief Read file to buffer with offset, a miss doesn't cache the file
+     */
+    virtual uint64_t
+    Read(const std::string& filepath,
+         uint64_t offset,
+         void* buf,
+         uint64_t len);
+
+    virtual void
+    Write(const std::string& filepath,
+          uint64_t offset,
+          void* buf,
+          uint64_t len);
+
+    virtual uint64_t
+    ReadAll(const std::string& filepath, std::shared_ptr<uint8_t[]>& buf);
+
+    virtual std::unique_ptr<MultipartWriter>
+    CreateMultipartWriter(const std::string& filepath);
+
+    virtual std::vector<std::string>
+    ListWithPrefix(const std::string& filepath);
+
+    virtual void
+    Remove(const std::string& filepath);
+
+    virtual std::string
+    GetName() const {
+        return "DiskCacheChunkManager";
+    }
+
+    virtual std::string
+    GetRootPath() const {
+        return remote_->GetRootPath();
+    }
+
+    ChunkManagerPtr
+    GetRemoteChunkManager() const {
+        return remote_;
+    }
+
+    bool
+    IsCached(const std::string& filepath) const;
+
+    // bytes taken by the cache files
+    int64_t
+    GetUsedSize() const;
+
+ private:
+    struct Entry {
+        std::string file;
+        // size of the cached file, and of the cache file holding it
+        uint64_t size;
+        uint64_t file_size;
+        std::list<std::string>::iterator lru;
+        // false for a copy found by the rescan until it's checked against
+        // the remote file
+        bool validated;
+    };
+
+    // reads the cached copy of filepath, nullopt on a miss
+    std::optional<uint64_t>
+    ReadCached(const std::string& filepath,
+               uint64_t offset,
+               void* buf,
+               uint64_t len);
+
+    void
+    Insert(const std::string& filepath, const void* data, uint64_t size);
+
+    void
+    Invalidate(const std::string& filepath);
+
+    // drops the copy of filepath if it's still kept in file
+    void
+    Drop(const std::string& filepath, const std::string& file);
+
+    // checks the copy of filepath kept in file against the size of the
+    // remote file, drops it on a mismatch
+    bool
+    Validate(const std::string& filepath,
+             const std::string& file,
+             uint64_t size);
+
+    void
+    Rescan();
+
+    // the *Locked methods only update the entries, the files of the
+    // dropped copies are added to removed and must be removed by the
+    // caller once the lock is released
+
+    // drops the least recently used copies until size bytes fit
+    void
+    EvictLocked(uint64_t size, std::vector<std::string>& removed);
+
+    void
+    RemoveLocked(std::unordered_map<std::string, Entry>::iterator iter,
+                 std::vector<std::string>& removed);
+
+ private:
+    ChunkManagerPtr remote_;
+    std::string cache_path_;
+    uint64_t capacity_;
+    std::atomic<uint64_t> next_file_id_{0};
+
+    mutable std::mutex mutex_;
+    uint64_t used_size_{0};
+    // paths of the copies, most recently used first
+    std::list<std::string> lru_;
+    std::unordered_map<std::string, Entry> entries_;
+};
+
+using DiskCacheChunkManagerPtr = std::shared_ptr<DiskCacheChunkManager>;
+
+}  // namespace milvus::storage
@@ -21,6 +21,41 @@
 
 namespace milvus::storage {
 
+std::vector<uint8_t>
+SerializeIndexDescriptorEvent(const FieldDataMeta& field_data_meta,
+                              const IndexMeta& index_meta,
+                              std::pair<Timestamp, Timestamp> time_range,
+                              DataType data_type,
+                              int64_t origin_size) {
+    // create descriptor event
+    DescriptorEvent descriptor_event;
+    auto& des_event_data = descriptor_event.event_data;
+    auto& des_fix_part = des_event_data.fix_part;
+    des_fix_part.collection_id = field_data_meta.collection_id;
+    des_fix_part.partition_id = field_data_meta.partition_id;
+    des_fix_part.segment_id = field_data_meta.segment_id;
+    des_fix_part.field_id = field_data_meta.field_id;
+    des_fix_part.start_timestamp = time_range.first;
+    des_fix_part.end_timestamp = time_range.second;
+    des_fix_part.data_type = milvus::proto::schema::DataType(data_type);
+    for (auto i = int8_t(EventType::DescriptorEvent);
+         i < int8_t(EventType::EventTypeEnd);
+         i++) {
+        des_event_data.post_header_lengths.push_back(
+            GetEventFixPartSize(EventType(i)));
+    }
+    des_event_data.extras[ORIGIN_SIZE_KEY] = std::to_string(origin_size);
+    des_event_data.extras[INDEX_BUILD_ID_KEY] =
+        std::to_string(index_meta.build_id);
+
+    auto& des_event_header = descriptor_event.event_header;
+    // TODO :: set timestamp
+    des_event_header.timestamp_ = 0;
+
+    // serialize descriptor event data
+    return descriptor_event.Serialize();
+}
+
 void
 IndexData::SetFieldDataMeta(const FieldDataMeta& meta) {
     AssertInfo(!field_data_meta_.has_value(), "field meta has been inited");
@@ -52,36 +87,12 @@ IndexData::serialize_to_remote_file() {
     AssertInfo(index_meta_.has_value(), "index meta not exist");
     AssertInfo(field_data_ != nullptr, "empty field data");
 
-    DataType data_type = field_data_->get_data_type();
-
-    // create descriptor event
-    DescriptorEvent descriptor_event;
-    auto& des_event_data = descriptor_event.event_data;
-    auto& des_fix_part = des_event_data.fix_part;
-    des_fix_part.collection_id = field_data_meta_->collection_id;
-    des_fix_part.partition_id = field_data_meta_->partition_id;
-    des_fix_part.segment_id = field_data_meta_->segment_id;
-    des_fix_part.field_id = field_data_meta_->field_id;
-    des_fix_part.start_timestamp = time_range_.first;
-    des_fix_part.end_timestamp = time_range_.second;
-    des_fix_part.data_type = milvus::proto::schema::DataType(data_type);
-    for (auto i = int8_t(EventType::DescriptorEvent);
-         i < int8_t(EventType::EventTypeEnd);
-         i++) {
-        des_event_data.post_header_lengths.push_back(
-            GetEventFixPartSize(EventType(i)));
-    }
-    des_event_data.extras[ORIGIN_SIZE_KEY] =
-        std::to_string(field_data_->Size());
-    des_event_data.extras[INDEX_BUILD_ID_KEY] =
-        std::to_string(index_meta_->build_id);
-
-    auto& des_event_header = descriptor_event.event_header;
-    // TODO :: set timestamp
-    des_event_header.timestamp_ = 0;
-
-    // serialize descriptor event data
-    auto des_event_bytes = descriptor_event.Serialize();
+    auto des_event_bytes =
+        SerializeIndexDescriptorEvent(field_data_meta_.value(),
+                                      index_meta_.value(),
+                                      time_range_,
+                                      field_data_->get_data_type(),
+                                      field_data_->Size());
 
     // create index event
     IndexEvent index_event;
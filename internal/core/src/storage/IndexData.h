@@ -24,6 +24,14 @@
 
 namespace milvus::storage {
 
+// the descriptor event heading the remote file of an index slice
+std::vector<uint8_t>
+SerializeIndexDescriptorEvent(const FieldDataMeta& field_data_meta,
+                              const IndexMeta& index_meta,
+                              std::pair<Timestamp, Timestamp> time_range,
+                              DataType data_type,
+                              int64_t origin_size);
+
 // TODO :: indexParams storage in a single file
 class IndexData : public DataCodec {
  public:
@@ -0,0 +1,202 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/LoadMemoryGovernor.h"
+
+#include <chrono>
+
+#include "common/Common.h"
+#include "common/EasyAssert.h"
+#include "monitor/prometheus_client.h"
+
+namespace milvus::storage {
+
+LoadMemoryReservation::LoadMemoryReservation(
+    LoadMemoryReservation&& other) noexcept
+    : governor_(other.governor_), owner_(other.owner_), bytes_(other.bytes_) {
+    other.governor_ = nullptr;
+    other.bytes_ = 0;
+}
+
+LoadMemoryReservation&
+LoadMemoryReservation::operator=(LoadMemoryReservation&& other) noexcept {
+    if (this != &other) {
+        Release();
+        governor_ = other.governor_;
+        owner_ = other.owner_;
+        bytes_ = other.bytes_;
+        other.governor_ = nullptr;
+        other.bytes_ = 0;
+    }
+    return *this;
+}
+
+LoadMemoryReservation::~LoadMemoryReservation() {
+    Release();
+}
+
+void
+LoadMemoryReservation::Release() {
+    if (governor_ != nullptr) {
+        governor_->Release(owner_, bytes_);
+        governor_ = nullptr;
+    }
+    bytes_ = 0;
+}
+
+void
+LoadMemoryReservation::Resize(int64_t bytes) {
+    AssertInfo(bytes >= 0, "resize load memory to negative {}", bytes);
+    if (governor_ != nullptr) {
+        governor_->Resize(owner_, bytes_, bytes);
+        bytes_ = bytes;
+    }
+}
+
+LoadMemoryGovernor&
+LoadMemoryGovernor::GetInstance() {
+    static LoadMemoryGovernor instance;
+    return instance;
+}
+
+bool
+LoadMemoryGovernor::enabled() const {
+    return LOAD_MEMORY_LIMIT > 0;
+}
+
+LoadMemoryReservation
+LoadMemoryGovernor::Reserve(int64_t bytes, std::thread::id owner) {
+    AssertInfo(bytes >= 0, "reserve negative load memory {}", bytes);
+    if (!enabled()) {
+        return LoadMemoryReservation();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lck(mutex_);
+    if (owners_.empty() && Fits(bytes)) {
+        reserved_ += bytes;
+        held_[owner] += bytes;
+        UpdateMetrics();
+        return LoadMemoryReservation(this, owner, bytes);
+    }
+
+    Request request{bytes, std::this_thread::get_id()};
+    auto& queue = requests_[owner];
+    if (queue.empty()) {
+        owners_.push_back(owner);
+    }
+    queue.push_back(&request);
+    ++num_waiting_;
+    ++blocked_threads_[request.thread_];
+    GrantRequests();
+    cv_.wait(lck, [&request] { return request.granted_; });
+    lck.unlock();
+
+    monitor::internal_storage_wait_memory_duration.Observe(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count());
+    return LoadMemoryReservation(this, owner, bytes);
+}
+
+int64_t
+LoadMemoryGovernor::reserved_bytes() const {
+    std::unique_lock<std::mutex> lck(mutex_);
+    return reserved_;
+}
+
+void
+LoadMemoryGovernor::Release(std::thread::id owner, int64_t bytes) {
+    std::unique_lock<std::mutex> lck(mutex_);
+    reserved_ -= bytes;
+    auto held = held_.find(owner);
+    if (held != held_.end()) {
+        held->second -= bytes;
+        if (held->second <= 0) {
+            held_.erase(held);
+        }
+    }
+    GrantRequests();
+}
+
+void
+LoadMemoryGovernor::Resize(std::thread::id owner,
+                           int64_t old_bytes,
+                           int64_t new_bytes) {
+    std::unique_lock<std::mutex> lck(mutex_);
+    reserved_ += new_bytes - old_bytes;
+    held_[owner] += new_bytes - old_bytes;
+    GrantRequests();
+}
+
+void
+LoadMemoryGovernor::GrantRequests() {
+    bool granted = false;
+    while (!owners_.empty()) {
+        auto owner = owners_.front();
+        auto queue = requests_.find(owner);
+        auto request = queue->second.front();
+        if (!Fits(request->bytes_) && !AllHoldersWaiting()) {
+            break;
+        }
+        request->granted_ = true;
+        reserved_ += request->bytes_;
+        held_[owner] += request->bytes_;
+        --num_waiting_;
+        auto blocked = blocked_threads_.find(request->thread_);
+        if (--blocked->second == 0) {
+            blocked_threads_.erase(blocked);
+        }
+        granted = true;
+
+        queue->second.pop_front();
+        owners_.pop_front();
+        if (queue->second.empty()) {
+            requests_.erase(queue);
+        } else {
+            owners_.push_back(owner);
+        }
+    }
+    UpdateMetrics();
+    if (granted) {
+        cv_.notify_all();
+    }
+}
+
+bool
+LoadMemoryGovernor::Fits(int64_t bytes) const {
+    // the limit may be lowered to 0 while requests are waiting
+    return LOAD_MEMORY_LIMIT <= 0 || reserved_ == 0 ||
+           reserved_ + bytes <= LOAD_MEMORY_LIMIT;
+}
+
+bool
+LoadMemoryGovernor::AllHoldersWaiting() const {
+    for (auto& [owner, bytes] : held_) {
+        if (bytes > 0 && blocked_threads_.count(owner) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+LoadMemoryGovernor::UpdateMetrics() {
+    monitor::internal_storage_load_memory_reserved.Set(reserved_);
+    monitor::internal_storage_load_memory_waiting.Set(num_waiting_);
+}
+
+}  // namespace milvus::storage
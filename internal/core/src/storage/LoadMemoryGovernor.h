@@ -0,0 +1,153 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace milvus::storage {
+
+class LoadMemoryGovernor;
+
+// bytes granted by the load memory governor, given back on destruction
+class LoadMemoryReservation {
+ public:
+    LoadMemoryReservation() = default;
+
+    LoadMemoryReservation(LoadMemoryReservation&& other) noexcept;
+
+    LoadMemoryReservation&
+    operator=(LoadMemoryReservation&& other) noexcept;
+
+    LoadMemoryReservation(const LoadMemoryReservation&) = delete;
+
+    LoadMemoryReservation&
+    operator=(const LoadMemoryReservation&) = delete;
+
+    ~LoadMemoryReservation();
+
+    void
+    Release();
+
+    // sets the reserved bytes to the ones actually taken, without waiting
+    // even if they go beyond the limit, the next requests wait for them
+    void
+    Resize(int64_t bytes);
+
+    int64_t
+    bytes() const {
+        return bytes_;
+    }
+
+ private:
+    friend class LoadMemoryGovernor;
+
+    LoadMemoryReservation(LoadMemoryGovernor* governor,
+                          std::thread::id owner,
+                          int64_t bytes)
+        : governor_(governor), owner_(owner), bytes_(bytes) {
+    }
+
+    LoadMemoryGovernor* governor_ = nullptr;
+    std::thread::id owner_;
+    int64_t bytes_ = 0;
+};
+
+// Bounds the memory of the files being downloaded and decoded by all the
+// loads of the process to LOAD_MEMORY_LIMIT. A loader reserves an estimate
+// of the memory of a file before it submits its download, resizes it to the
+// memory actually taken once the file is decoded, and the reservation is
+// given back when the decoded data is released by its consumer.
+//
+// A loader may wait for memory while it holds the data of its earlier
+// files, so the head request is granted beyond the limit once the threads of
+// all the owners holding reserved bytes are blocked on requests themselves,
+// as none of them would release anything.
+//
+// The requests beyond the limit wait in a queue per owner, the thread which
+// drives a load, and the owners are served round robin so that a segment
+// with many files doesn't hold back the others. The head request blocks the
+// ones behind it, so large requests are not starved by small ones, and a
+// request above the limit is granted once nothing else is reserved.
+class LoadMemoryGovernor {
+ public:
+    static LoadMemoryGovernor&
+    GetInstance();
+
+    // false if LOAD_MEMORY_LIMIT is 0, reservations are granted at once
+    bool
+    enabled() const;
+
+    // waits until the bytes fit in the limit
+    LoadMemoryReservation
+    Reserve(int64_t bytes,
+            std::thread::id owner = std::this_thread::get_id());
+
+    int64_t
+    reserved_bytes() const;
+
+ private:
+    friend class LoadMemoryReservation;
+
+    struct Request {
+        int64_t bytes_;
+        // the thread blocked on the request
+        std::thread::id thread_;
+        bool granted_ = false;
+    };
+
+    LoadMemoryGovernor() = default;
+
+    void
+    Release(std::thread::id owner, int64_t bytes);
+
+    // changes the bytes of a granted reservation without waiting
+    void
+    Resize(std::thread::id owner, int64_t old_bytes, int64_t new_bytes);
+
+    // grants the requests at the heads of the owner queues in turn, until
+    // the next one doesn't fit
+    void
+    GrantRequests();
+
+    bool
+    Fits(int64_t bytes) const;
+
+    bool
+    AllHoldersWaiting() const;
+
+    void
+    UpdateMetrics();
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    int64_t reserved_ = 0;
+    int64_t num_waiting_ = 0;
+    // owners with waiting requests, the next one to be served first
+    std::deque<std::thread::id> owners_;
+    std::unordered_map<std::thread::id, std::deque<Request*>> requests_;
+    // bytes granted to every owner and not released yet
+    std::unordered_map<std::thread::id, int64_t> held_;
+    // the number of requests each thread is blocked on
+    std::unordered_map<std::thread::id, int64_t> blocked_threads_;
+};
+
+}  // namespace milvus::storage
@@ -16,12 +16,21 @@
 
 #include "storage/MinioChunkManager.h"
 
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
 #include <fstream>
+#include <optional>
 #include <aws/core/auth/AWSCredentials.h>
 #include <aws/core/auth/AWSCredentialsProviderChain.h>
 #include <aws/core/auth/STSCredentialsProvider.h>
 #include <aws/core/utils/logging/ConsoleLogSystem.h>
+#include <aws/core/utils/stream/PreallocatedStreamBuf.h>
+#include <aws/s3/model/AbortMultipartUploadRequest.h>
+#include <aws/s3/model/CompleteMultipartUploadRequest.h>
 #include <aws/s3/model/CreateBucketRequest.h>
+#include <aws/s3/model/CreateMultipartUploadRequest.h>
 #include <aws/s3/model/DeleteBucketRequest.h>
 #include <aws/s3/model/DeleteObjectRequest.h>
 #include <aws/s3/model/GetObjectRequest.h>
@@ -29,11 +38,13 @@
 #include <aws/s3/model/HeadObjectRequest.h>
 #include <aws/s3/model/ListObjectsRequest.h>
 #include <aws/s3/model/PutObjectRequest.h>
+#include <aws/s3/model/UploadPartRequest.h>
 
 #include "storage/AliyunSTSClient.h"
 #include "storage/AliyunCredentialsProvider.h"
 #include "storage/TencentCloudSTSClient.h"
 #include "storage/TencentCloudCredentialsProvider.h"
+#include "storage/ThreadPools.h"
 #include "monitor/prometheus_client.h"
 #include "common/EasyAssert.h"
 #include "log/Log.h"
@@ -45,6 +56,70 @@ namespace milvus::storage {
 std::atomic<size_t> MinioChunkManager::init_count_(0);
 std::mutex MinioChunkManager::client_mutex_;
 
+namespace {
+// weight of the latest sample in the throughput averages
+constexpr double RANGE_READ_THROUGHPUT_ALPHA = 0.2;
+}  // namespace
+
+uint64_t
+RangeReadTuner::PartSize() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (part_throughput_ == 0) {
+        return DEFAULT_RANGE_READ_PART_SIZE;
+    }
+    auto size =
+        static_cast<uint64_t>(part_throughput_ * RANGE_READ_TARGET_PART_MS);
+    // whole MBs
+    size = size >> 20 << 20;
+    return std::clamp(
+        size, MIN_RANGE_READ_PART_SIZE, MAX_RANGE_READ_PART_SIZE);
+}
+
+int
+RangeReadTuner::Concurrency() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return concurrency_;
+}
+
+void
+RangeReadTuner::ObservePart(uint64_t bytes, double elapsed_ms) {
+    // the time of small reads is mostly the time to first byte
+    if (bytes < MIN_RANGE_READ_PART_SIZE) {
+        return;
+    }
+    auto throughput = bytes / std::max(elapsed_ms, 1.0);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (part_throughput_ == 0) {
+        part_throughput_ = throughput;
+        return;
+    }
+    part_throughput_ = part_throughput_ * (1 - RANGE_READ_THROUGHPUT_ALPHA) +
+                       throughput * RANGE_READ_THROUGHPUT_ALPHA;
+}
+
+void
+RangeReadTuner::ObserveRead(uint64_t bytes,
+                            double elapsed_ms,
+                            int concurrency) {
+    auto throughput = bytes / std::max(elapsed_ms, 1.0);
+    std::lock_guard<std::mutex> lock(mutex_);
+    // reads of fewer parts than the current concurrency say nothing of it
+    if (concurrency != concurrency_) {
+        return;
+    }
+    if (read_throughput_ == 0) {
+        read_throughput_ = throughput;
+        return;
+    }
+    if (throughput > read_throughput_ * 1.1) {
+        concurrency_ = std::min(concurrency_ + 1, MAX_RANGE_READ_CONCURRENCY);
+    } else if (throughput < read_throughput_ * 0.8) {
+        concurrency_ = std::max(concurrency_ - 1, 1);
+    }
+    read_throughput_ = read_throughput_ * (1 - RANGE_READ_THROUGHPUT_ALPHA) +
+                       throughput * RANGE_READ_THROUGHPUT_ALPHA;
+}
+
 static void
 SwallowHandler(int signal) {
 #pragma GCC diagnostic push
@@ -392,7 +467,66 @@ MinioChunkManager::ListWithPrefix(const std::string& filepath) {
 
 uint64_t
 MinioChunkManager::Read(const std::string& filepath, void* buf, uint64_t size) {
-    return GetObjectBuffer(default_bucket_name_, filepath, buf, size);
+    if (size == 0) {
+        return 0;
+    }
+    return GetObjectRangeParallel(default_bucket_name_, filepath, 0, buf, size);
+}
+
+uint64_t
+MinioChunkManager::Read(const std::string& filepath,
+                        uint64_t offset,
+                        void* buf,
+                        uint64_t len) {
+    if (len == 0) {
+        return 0;
+    }
+    return GetObjectRangeParallel(
+        default_bucket_name_, filepath, offset, buf, len);
+}
+
+uint64_t
+MinioChunkManager::ReadAll(const std::string& filepath,
+                           std::shared_ptr<uint8_t[]>& buf) {
+    // the size of the object comes with the response of the first part
+    // instead of a HEAD request, the first part is allocated to the bytes
+    // received, which is min(object size, part size)
+    auto part_size = range_read_tuner_->PartSize();
+    std::shared_ptr<uint8_t[]> first_part;
+    uint64_t size = 0;
+    auto read = GetObjectRange(default_bucket_name_,
+                               filepath,
+                               0,
+                               nullptr,
+                               part_size,
+                               &size,
+                               &first_part);
+    AssertInfo(read == std::min(size, part_size),
+               "read {} bytes of the first part of {}, object size {}",
+               read,
+               filepath,
+               size);
+    if (size == read) {
+        buf = std::move(first_part);
+        return size;
+    }
+
+    buf = std::shared_ptr<uint8_t[]>(new uint8_t[size]);
+    std::memcpy(buf.get(), first_part.get(), read);
+    first_part.reset();
+    if (size > read) {
+        auto rest = GetObjectRangeParallel(default_bucket_name_,
+                                           filepath,
+                                           read,
+                                           buf.get() + read,
+                                           size - read);
+        AssertInfo(rest == size - read,
+                   "read {} bytes of {}, expected {}",
+                   read + rest,
+                   filepath,
+                   size);
+    }
+    return size;
 }
 
 void
@@ -402,6 +536,123 @@ MinioChunkManager::Write(const std::string& filepath,
     PutObjectBuffer(default_bucket_name_, filepath, buf, size);
 }
 
+class MinioMultipartWriter : public MultipartWriter {
+ public:
+    MinioMultipartWriter(std::shared_ptr<Aws::S3::S3Client> client,
+                         const std::string& bucket_name,
+                         const std::string& object_name)
+        : client_(std::move(client)),
+          bucket_name_(bucket_name),
+          object_name_(object_name) {
+        Aws::S3::Model::CreateMultipartUploadRequest request;
+        request.SetBucket(bucket_name_.c_str());
+        request.SetKey(object_name_.c_str());
+        auto outcome = client_->CreateMultipartUpload(request);
+        if (!outcome.IsSuccess()) {
+            monitor::internal_storage_op_count_put_fail.Increment();
+            ThrowS3Error("CreateMultipartUpload",
+                         outcome.GetError(),
+                         "params, bucket={}, object={}",
+                         bucket_name_,
+                         object_name_);
+        }
+        upload_id_ = outcome.GetResult().GetUploadId();
+    }
+
+    void
+    WritePart(int part_number, const void* buf, uint64_t len) override {
+        Aws::S3::Model::UploadPartRequest request;
+        request.SetBucket(bucket_name_.c_str());
+        request.SetKey(object_name_.c_str());
+        request.SetUploadId(upload_id_);
+        request.SetPartNumber(part_number);
+        request.SetContentLength(len);
+        // the body is read from buf in place
+        Aws::Utils::Stream::PreallocatedStreamBuf stream_buf(
+            static_cast<unsigned char*>(const_cast<void*>(buf)), len);
+        request.SetBody(Aws::MakeShared<Aws::IOStream>("", &stream_buf));
+
+        auto start = std::chrono::system_clock::now();
+        auto outcome = client_->UploadPart(request);
+        monitor::internal_storage_request_latency_put.Observe(
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now() - start)
+                .count());
+        monitor::internal_storage_kv_size_put.Observe(len);
+        if (!outcome.IsSuccess()) {
+            monitor::internal_storage_op_count_put_fail.Increment();
+            ThrowS3Error("UploadPart",
+                         outcome.GetError(),
+                         "params, bucket={}, object={}, part={}",
+                         bucket_name_,
+                         object_name_,
+                         part_number);
+        }
+        monitor::internal_storage_op_count_put_suc.Increment();
+
+        Aws::S3::Model::CompletedPart part;
+        part.SetPartNumber(part_number);
+        part.SetETag(outcome.GetResult().GetETag());
+        std::lock_guard<std::mutex> lock(mutex_);
+        parts_[part_number] = std::move(part);
+    }
+
+    void
+    Complete() override {
+        Aws::S3::Model::CompletedMultipartUpload upload;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto& [_, part] : parts_) {
+                upload.AddParts(part);
+            }
+        }
+        Aws::S3::Model::CompleteMultipartUploadRequest request;
+        request.SetBucket(bucket_name_.c_str());
+        request.SetKey(object_name_.c_str());
+        request.SetUploadId(upload_id_);
+        request.SetMultipartUpload(std::move(upload));
+        auto outcome = client_->CompleteMultipartUpload(request);
+        if (!outcome.IsSuccess()) {
+            monitor::internal_storage_op_count_put_fail.Increment();
+            ThrowS3Error("CompleteMultipartUpload",
+                         outcome.GetError(),
+                         "params, bucket={}, object={}",
+                         bucket_name_,
+                         object_name_);
+        }
+    }
+
+    void
+    Abort() override {
+        Aws::S3::Model::AbortMultipartUploadRequest request;
+        request.SetBucket(bucket_name_.c_str());
+        request.SetKey(object_name_.c_str());
+        request.SetUploadId(upload_id_);
+        auto outcome = client_->AbortMultipartUpload(request);
+        if (!outcome.IsSuccess()) {
+            ThrowS3Error("AbortMultipartUpload",
+                         outcome.GetError(),
+                         "params, bucket={}, object={}",
+                         bucket_name_,
+                         object_name_);
+        }
+    }
+
+ private:
+    std::shared_ptr<Aws::S3::S3Client> client_;
+    std::string bucket_name_;
+    std::string object_name_;
+    Aws::String upload_id_;
+    std::mutex mutex_;
+    std::map<int, Aws::S3::Model::CompletedPart> parts_;
+};
+
+std::unique_ptr<MultipartWriter>
+MinioChunkManager::CreateMultipartWriter(const std::string& filepath) {
+    return std::make_unique<MinioMultipartWriter>(
+        client_, default_bucket_name_, filepath);
+}
+
 bool
 MinioChunkManager::BucketExists(const std::string& bucket_name) {
     Aws::S3::Model::HeadBucketRequest request;
@@ -638,6 +889,35 @@ class AwsResponseStream : public Aws::IOStream {
     AwsStreambuf aws_streambuf;
 };
 
+// the response body is written straight into buf
+static Aws::IOStream*
+CreateResponseStream(void* buf, uint64_t size) {
+    // For macOs, pubsetbuf interface not implemented
+#ifdef __linux__
+    std::unique_ptr<Aws::StringStream> stream(Aws::New<Aws::StringStream>(""));
+    stream->rdbuf()->pubsetbuf(static_cast<char*>(buf), size);
+#else
+    std::unique_ptr<Aws::IOStream> stream(Aws::New<AwsResponseStream>(
+        "AwsResponseStream", static_cast<char*>(buf), size));
+#endif
+    return stream.release();
+}
+
+// the total size in a content range like "bytes 0-99/1000"
+static std::optional<uint64_t>
+ParseObjectSize(const Aws::String& content_range) {
+    auto pos = content_range.rfind('/');
+    if (pos == Aws::String::npos || pos + 1 == content_range.size() ||
+        content_range[pos + 1] == '*') {
+        return std::nullopt;
+    }
+    try {
+        return std::stoull(content_range.substr(pos + 1).c_str());
+    } catch (std::exception&) {
+        return std::nullopt;
+    }
+}
+
 uint64_t
 MinioChunkManager::GetObjectBuffer(const std::string& bucket_name,
                                    const std::string& object_name,
@@ -647,18 +927,8 @@ MinioChunkManager::GetObjectBuffer(const std::string& bucket_name,
     request.SetBucket(bucket_name.c_str());
     request.SetKey(object_name.c_str());
 
-    request.SetResponseStreamFactory([buf, size]() {
-    // For macOs, pubsetbuf interface not implemented
-#ifdef __linux__
-        std::unique_ptr<Aws::StringStream> stream(
-            Aws::New<Aws::StringStream>(""));
-        stream->rdbuf()->pubsetbuf(static_cast<char*>(buf), size);
-#else
-        std::unique_ptr<Aws::IOStream> stream(Aws::New<AwsResponseStream>(
-            "AwsResponseStream", static_cast<char*>(buf), size));
-#endif
-        return stream.release();
-    });
+    request.SetResponseStreamFactory(
+        [buf, size]() { return CreateResponseStream(buf, size); });
     auto start = std::chrono::system_clock::now();
     auto outcome = client_->GetObject(request);
     monitor::internal_storage_request_latency_get.Observe(
@@ -680,6 +950,190 @@ MinioChunkManager::GetObjectBuffer(const std::string& bucket_name,
     return size;
 }
 
+uint64_t
+MinioChunkManager::GetObjectRange(const std::string& bucket_name,
+                                  const std::string& object_name,
+                                  uint64_t offset,
+                                  void* buf,
+                                  uint64_t size,
+                                  uint64_t* object_size,
+                                  std::shared_ptr<uint8_t[]>* body) {
+    AssertInfo(size > 0, "empty range of object {}", object_name);
+    AssertInfo(buf != nullptr || body != nullptr,
+               "no buffer to read object {} into",
+               object_name);
+    Aws::S3::Model::GetObjectRequest request;
+    request.SetBucket(bucket_name.c_str());
+    request.SetKey(object_name.c_str());
+    request.SetRange(
+        fmt::format("bytes={}-{}", offset, offset + size - 1).c_str());
+    // without a buffer, the sdk keeps the body in its own stream, which
+    // grows with the bytes received instead of reserving size upfront
+    if (buf != nullptr) {
+        request.SetResponseStreamFactory(
+            [buf, size]() { return CreateResponseStream(buf, size); });
+    }
+
+    auto start = std::chrono::system_clock::now();
+    auto outcome = client_->GetObject(request);
+    auto elapsed = std::chrono::duration<double, std::milli>(
+                       std::chrono::system_clock::now() - start)
+                       .count();
+    monitor::internal_storage_request_latency_get.Observe(elapsed);
+
+    if (!outcome.IsSuccess()) {
+        const auto& err = outcome.GetError();
+        // the range starts at or past the end of the object
+        if (err.GetResponseCode() ==
+            Aws::Http::HttpResponseCode::REQUESTED_RANGE_NOT_SATISFIABLE) {
+            monitor::internal_storage_op_count_get_suc.Increment();
+            if (object_size != nullptr) {
+                *object_size =
+                    offset == 0 ? 0 : GetObjectSize(bucket_name, object_name);
+            }
+            if (buf == nullptr) {
+                body->reset(new uint8_t[0]);
+            }
+            return 0;
+        }
+        monitor::internal_storage_op_count_get_fail.Increment();
+        ThrowS3Error("GetObjectRange",
+                     err,
+                     "params, bucket={}, object={}, offset={}, size={}",
+                     bucket_name,
+                     object_name,
+                     offset,
+                     size);
+    }
+    monitor::internal_storage_op_count_get_suc.Increment();
+
+    auto& result = outcome.GetResult();
+    auto content_length = static_cast<uint64_t>(result.GetContentLength());
+    auto total_size = ParseObjectSize(result.GetContentRange());
+    // servers ignoring the range return the whole object
+    if (!total_size.has_value() && offset == 0) {
+        total_size = content_length;
+    }
+    if (object_size != nullptr) {
+        *object_size = total_size.has_value()
+                           ? total_size.value()
+                           : GetObjectSize(bucket_name, object_name);
+    }
+    auto read = std::min(content_length, size);
+    if (buf == nullptr) {
+        body->reset(new uint8_t[read]);
+        result.GetBody().read(reinterpret_cast<char*>(body->get()), read);
+    }
+    monitor::internal_storage_kv_size_get.Observe(read);
+    range_read_tuner_->ObservePart(read, elapsed);
+    return read;
+}
+
+uint64_t
+MinioChunkManager::GetObjectRangeParallel(const std::string& bucket_name,
+                                          const std::string& object_name,
+                                          uint64_t offset,
+                                          void* buf,
+                                          uint64_t size) {
+    uint64_t part_size = range_read_tuner_->PartSize();
+    uint64_t num_parts = (size + part_size - 1) / part_size;
+    if (num_parts <= 1) {
+        return GetObjectRange(bucket_name, object_name, offset, buf, size);
+    }
+    auto concurrency = static_cast<int>(std::min<uint64_t>(
+        num_parts, range_read_tuner_->Concurrency()));
+
+    struct State {
+        std::atomic<uint64_t> next_part{0};
+        std::atomic<bool> failed{false};
+        std::mutex mutex;
+        std::condition_variable cv;
+        uint64_t finished_parts{0};
+        std::vector<uint64_t> read_sizes;
+        std::exception_ptr error;
+    };
+    auto state = std::make_shared<State>();
+    state->read_sizes.resize(num_parts, 0);
+
+    // the parts are claimed by the calling thread and the helpers alike,
+    // the caller only waits for the parts claimed by a running helper, so
+    // a helper queued behind busy workers never blocks the read. A helper
+    // starting after all parts are claimed returns without touching this
+    // or buf.
+    auto read_parts = [this,
+                       state,
+                       bucket_name,
+                       object_name,
+                       offset,
+                       buf,
+                       size,
+                       part_size,
+                       num_parts]() {
+        while (true) {
+            auto part = state->next_part.fetch_add(1);
+            if (part >= num_parts) {
+                return;
+            }
+            auto part_offset = part * part_size;
+            auto part_len = std::min(part_size, size - part_offset);
+            uint64_t read = 0;
+            std::exception_ptr error;
+            if (!state->failed.load()) {
+                try {
+                    read = GetObjectRange(bucket_name,
+                                          object_name,
+                                          offset + part_offset,
+                                          static_cast<char*>(buf) + part_offset,
+                                          part_len);
+                } catch (...) {
+                    error = std::current_exception();
+                    state->failed.store(true);
+                }
+            }
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->read_sizes[part] = read;
+            if (error != nullptr && state->error == nullptr) {
+                state->error = error;
+            }
+            if (++state->finished_parts == num_parts) {
+                state->cv.notify_all();
+            }
+        }
+    };
+
+    auto start = std::chrono::system_clock::now();
+    auto& pool = ThreadPools::GetThreadPool(ThreadPoolPriority::HIGH);
+    for (int i = 1; i < concurrency; i++) {
+        pool.SubmitWithPriority(TaskPriority::HIGH, read_parts);
+    }
+    read_parts();
+    {
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->cv.wait(lock,
+                       [&]() { return state->finished_parts == num_parts; });
+        if (state->error != nullptr) {
+            std::rethrow_exception(state->error);
+        }
+    }
+
+    // a short part ends the object
+    uint64_t total = 0;
+    for (uint64_t part = 0; part < num_parts; part++) {
+        auto part_len = std::min(part_size, size - part * part_size);
+        total += state->read_sizes[part];
+        if (state->read_sizes[part] < part_len) {
+            break;
+        }
+    }
+    range_read_tuner_->ObserveRead(
+        total,
+        std::chrono::duration<double, std::milli>(
+            std::chrono::system_clock::now() - start)
+            .count(),
+        concurrency);
+    return total;
+}
+
 std::vector<std::string>
 MinioChunkManager::ListObjects(const std::string& bucket_name,
                                const std::string& prefix) {
@@ -18,6 +18,7 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -91,6 +92,46 @@ class AwsLogger : public Aws::Utils::Logging::FormattedLogSystem {
     ProcessFormattedStatement(Aws::String&& statement) override;
 };
 
+// bounds of the byte ranges a large GET is split into
+constexpr uint64_t MIN_RANGE_READ_PART_SIZE = 4 << 20;
+constexpr uint64_t MAX_RANGE_READ_PART_SIZE = 64 << 20;
+constexpr uint64_t DEFAULT_RANGE_READ_PART_SIZE = 16 << 20;
+constexpr int MAX_RANGE_READ_CONCURRENCY = 16;
+constexpr int DEFAULT_RANGE_READ_CONCURRENCY = 4;
+// a part is sized to take about this long at the observed throughput, long
+// enough to amortize the time to first byte of the request
+constexpr double RANGE_READ_TARGET_PART_MS = 250;
+
+/**
+ * @brief Picks the part size and the number of concurrent range GETs of
+ * large reads from the throughput observed on the previous ones
+ */
+class RangeReadTuner {
+ public:
+    uint64_t
+    PartSize() const;
+
+    int
+    Concurrency() const;
+
+    // a single range GET of the given bytes finished
+    void
+    ObservePart(uint64_t bytes, double elapsed_ms);
+
+    // a read split into concurrent range GETs finished, the concurrency
+    // keeps growing while it raises the total throughput and backs off
+    // when it hurts it
+    void
+    ObserveRead(uint64_t bytes, double elapsed_ms, int concurrency);
+
+ private:
+    mutable std::mutex mutex_;
+    // bytes per ms, 0 until the first observation
+    double part_throughput_{0};
+    double read_throughput_{0};
+    int concurrency_{DEFAULT_RANGE_READ_CONCURRENCY};
+};
+
 /**
  * @brief This MinioChunkManager is responsible for read and write file in S3.
  */
@@ -117,9 +158,7 @@ class MinioChunkManager : public ChunkManager {
     Read(const std::string& filepath,
          uint64_t offset,
          void* buf,
-         uint64_t len) {
-        PanicInfo(NotImplemented, GetName() + "Read with offset not implement");
-    }
+         uint64_t len);
 
     virtual void
     Write(const std::string& filepath,
@@ -133,6 +172,12 @@ class MinioChunkManager : public ChunkManager {
     virtual uint64_t
     Read(const std::string& filepath, void* buf, uint64_t len);
 
+    virtual uint64_t
+    ReadAll(const std::string& filepath, std::shared_ptr<uint8_t[]>& buf);
+
+    virtual std::unique_ptr<MultipartWriter>
+    CreateMultipartWriter(const std::string& filepath);
+
     virtual void
     Write(const std::string& filepath, void* buf, uint64_t len);
 
@@ -194,6 +239,27 @@ class MinioChunkManager : public ChunkManager {
                     const std::string& object_name,
                     void* buf,
                     uint64_t size);
+    // reads [offset, offset + size) of the object with a single GET, the
+    // total size of the object is set if object_size is not nullptr,
+    // returns the number of bytes read, which is less than size if the
+    // range runs past the end of the object. If buf is nullptr, the bytes
+    // are returned in body, allocated to the number of bytes read.
+    uint64_t
+    GetObjectRange(const std::string& bucket_name,
+                   const std::string& object_name,
+                   uint64_t offset,
+                   void* buf,
+                   uint64_t size,
+                   uint64_t* object_size = nullptr,
+                   std::shared_ptr<uint8_t[]>* body = nullptr);
+    // same as GetObjectRange, but large ranges are split into parts read
+    // by concurrent GETs
+    uint64_t
+    GetObjectRangeParallel(const std::string& bucket_name,
+                           const std::string& object_name,
+                           uint64_t offset,
+                           void* buf,
+                           uint64_t size);
 
     std::vector<std::string>
     ListObjects(const std::string& bucket_name, const std::string& prefix = "");
@@ -232,6 +298,8 @@ class MinioChunkManager : public ChunkManager {
     std::shared_ptr<Aws::S3::S3Client> client_;
     std::string default_bucket_name_;
     std::string remote_root_path_;
+    std::shared_ptr<RangeReadTuner> range_read_tuner_ =
+        std::make_shared<RangeReadTuner>();
 };
 
 class AwsChunkManager : public MinioChunkManager {
@@ -0,0 +1,235 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/MultipartUpload.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <thread>
+
+#include <arrow/array.h>
+#include <arrow/buffer.h>
+#include <arrow/table.h>
+#include <parquet/arrow/writer.h>
+
+#include "common/EasyAssert.h"
+#include "log/Log.h"
+#include "storage/Event.h"
+#include "storage/IndexData.h"
+#include "storage/ThreadPools.h"
+#include "storage/Util.h"
+
+namespace milvus::storage {
+
+void
+WritePartWithRetry(MultipartWriter& writer,
+                   int part_number,
+                   const void* buf,
+                   uint64_t len) {
+    for (int attempt = 1;; attempt++) {
+        try {
+            writer.WritePart(part_number, buf, len);
+            return;
+        } catch (std::exception& e) {
+            if (attempt >= MULTIPART_UPLOAD_RETRY_TIMES) {
+                throw;
+            }
+            LOG_WARN("failed to write part {}, attempt {}: {}",
+                     part_number,
+                     attempt,
+                     e.what());
+            std::this_thread::sleep_for(
+                std::chrono::milliseconds(100 << attempt));
+        }
+    }
+}
+
+MultipartOutputStream::MultipartOutputStream(MultipartWriter& writer,
+                                             uint64_t part_size)
+    : writer_(writer), part_size_(part_size) {
+    first_part_.reserve(part_size_);
+}
+
+MultipartOutputStream::~MultipartOutputStream() noexcept {
+    // the parts being uploaded refer to the writer
+    for (auto& part : pending_parts_) {
+        part.wait();
+    }
+}
+
+arrow::Status
+MultipartOutputStream::Close() {
+    closed_ = true;
+    return arrow::Status::OK();
+}
+
+arrow::Result<int64_t>
+MultipartOutputStream::Tell() const {
+    return arrow::Result<int64_t>(written_);
+}
+
+bool
+MultipartOutputStream::closed() const {
+    return closed_;
+}
+
+arrow::Status
+MultipartOutputStream::Write(const void* data, int64_t nbytes) {
+    auto bytes = static_cast<const uint8_t*>(data);
+    try {
+        while (nbytes > 0) {
+            auto& part = first_part_.size() < part_size_ ? first_part_
+                                                         : current_part_;
+            auto len = std::min<uint64_t>(nbytes, part_size_ - part.size());
+            part.insert(part.end(), bytes, bytes + len);
+            bytes += len;
+            nbytes -= len;
+            written_ += len;
+            if (current_part_.size() == part_size_) {
+                UploadCurrentPart();
+            }
+        }
+    } catch (std::exception& e) {
+        return arrow::Status::IOError(e.what());
+    }
+    return arrow::Status::OK();
+}
+
+arrow::Status
+MultipartOutputStream::Flush() {
+    return arrow::Status::OK();
+}
+
+void
+MultipartOutputStream::UploadCurrentPart() {
+    WaitPendingParts(MULTIPART_UPLOAD_MAX_PENDING_PARTS - 1);
+    auto part = std::make_shared<std::vector<uint8_t>>();
+    part->swap(current_part_);
+    current_part_.reserve(part_size_);
+
+    auto& pool = ThreadPools::GetThreadPool(ThreadPoolPriority::HIGH);
+    pending_parts_.push_back(pool.Submit(
+        [&writer = writer_, part_number = next_part_number_++, part]() {
+            WritePartWithRetry(writer, part_number, part->data(), part->size());
+        }));
+}
+
+void
+MultipartOutputStream::WaitPendingParts(size_t max_pending) {
+    while (pending_parts_.size() > max_pending) {
+        auto part = std::move(pending_parts_.front());
+        pending_parts_.pop_front();
+        part.get();
+    }
+}
+
+uint64_t
+MultipartOutputStream::Finish(const std::vector<uint8_t>& header) {
+    if (!current_part_.empty()) {
+        UploadCurrentPart();
+    }
+    std::vector<uint8_t> first_part(header.size() + first_part_.size());
+    std::memcpy(first_part.data(), header.data(), header.size());
+    std::memcpy(first_part.data() + header.size(),
+                first_part_.data(),
+                first_part_.size());
+    std::vector<uint8_t>().swap(first_part_);
+    WritePartWithRetry(writer_, 1, first_part.data(), first_part.size());
+    WaitPendingParts(0);
+    writer_.Complete();
+    return header.size() + written_;
+}
+
+uint64_t
+UploadIndexSliceMultipart(ChunkManager* chunk_manager,
+                          const uint8_t* data,
+                          int64_t size,
+                          const IndexMeta& index_meta,
+                          const FieldDataMeta& field_meta,
+                          const std::string& object_key) {
+    auto writer = chunk_manager->CreateMultipartWriter(object_key);
+    try {
+        auto stream = std::make_shared<MultipartOutputStream>(
+            *writer, MULTIPART_UPLOAD_PART_SIZE);
+        {
+            // the array refers to the slice, arrow doesn't copy it
+            auto array = std::make_shared<arrow::Int8Array>(
+                size, std::make_shared<arrow::Buffer>(data, size));
+            auto table = arrow::Table::Make(
+                CreateArrowSchema(DataType::INT8, false), {array});
+            // dictionary pages are written after the data pages they
+            // encode, which would keep all the pages of the slice in memory
+            auto ast = parquet::arrow::WriteTable(
+                *table,
+                arrow::default_memory_pool(),
+                stream,
+                1024 * 1024 * 1024,
+                parquet::WriterProperties::Builder()
+                    .compression(arrow::Compression::ZSTD)
+                    ->compression_level(3)
+                    ->disable_dictionary()
+                    ->build());
+            AssertInfo(ast.ok(), ast.ToString());
+        }
+
+        // same layout as serialize_to_remote_file: the descriptor event,
+        // then the index event header, its timestamps and the payload
+        auto header = SerializeIndexDescriptorEvent(
+            field_meta, index_meta, {0, 0}, DataType::INT8, size);
+        Timestamp start_timestamp = 0;
+        Timestamp end_timestamp = 0;
+        EventHeader event_header;
+        event_header.timestamp_ = 0;
+        event_header.event_type_ = EventType::IndexFileEvent;
+        auto event_length = GetEventHeaderSize(event_header) +
+                            sizeof(start_timestamp) + sizeof(end_timestamp) +
+                            stream->Tell().ValueOrDie();
+        AssertInfo(event_length + header.size() <=
+                       std::numeric_limits<int32_t>::max(),
+                   "index slice {} of {} bytes is too large",
+                   object_key,
+                   size);
+        event_header.event_length_ = event_length;
+        event_header.next_position_ = event_length + header.size();
+        auto event_header_bytes = event_header.Serialize();
+        header.insert(header.end(),
+                      event_header_bytes.begin(),
+                      event_header_bytes.end());
+        auto timestamps = header.size();
+        header.resize(timestamps + sizeof(start_timestamp) +
+                      sizeof(end_timestamp));
+        std::memcpy(
+            header.data() + timestamps, &start_timestamp, sizeof(Timestamp));
+        std::memcpy(header.data() + timestamps + sizeof(Timestamp),
+                    &end_timestamp,
+                    sizeof(Timestamp));
+
+        return stream->Finish(header);
+    } catch (...) {
+        try {
+            writer->Abort();
+        } catch (std::exception& e) {
+            LOG_WARN("failed to abort multipart upload of {}: {}",
+                     object_key,
+                     e.what());
+        }
+        throw;
+    }
+}
+
+}  // namespace milvus::storage
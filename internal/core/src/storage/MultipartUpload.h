@@ -0,0 +1,102 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <deque>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <arrow/io/interfaces.h>
+
+#include "storage/ChunkManager.h"
+#include "storage/Types.h"
+
+namespace milvus::storage {
+
+// above the 5MB minimum part size of S3
+constexpr uint64_t MULTIPART_UPLOAD_PART_SIZE = 8 << 20;
+// parts being uploaded at once by a stream, bounding its memory
+constexpr int MULTIPART_UPLOAD_MAX_PENDING_PARTS = 4;
+constexpr int MULTIPART_UPLOAD_RETRY_TIMES = 3;
+
+// writes the part, retrying it with backoff on failures
+void
+WritePartWithRetry(MultipartWriter& writer,
+                   int part_number,
+                   const void* buf,
+                   uint64_t len);
+
+/**
+ * @brief An arrow output stream cutting the bytes written to it into parts
+ * uploaded concurrently. The first part is held back until Finish, so a
+ * header depending on the length of the rest, like the event header of a
+ * binlog, can be put in front of it.
+ */
+class MultipartOutputStream : public arrow::io::OutputStream {
+ public:
+    MultipartOutputStream(MultipartWriter& writer, uint64_t part_size);
+    ~MultipartOutputStream() noexcept;
+
+    arrow::Status
+    Close() override;
+    arrow::Result<int64_t>
+    Tell() const override;
+    bool
+    closed() const override;
+    arrow::Status
+    Write(const void* data, int64_t nbytes) override;
+    arrow::Status
+    Flush() override;
+
+    // uploads the header followed by the bytes held back, waits for the
+    // other parts and completes the upload, returns the size of the file
+    uint64_t
+    Finish(const std::vector<uint8_t>& header);
+
+ private:
+    void
+    UploadCurrentPart();
+
+    void
+    WaitPendingParts(size_t max_pending);
+
+ private:
+    MultipartWriter& writer_;
+    uint64_t part_size_;
+    std::vector<uint8_t> first_part_;
+    std::vector<uint8_t> current_part_;
+    int next_part_number_{2};
+    int64_t written_{0};
+    std::deque<std::future<void>> pending_parts_;
+    bool closed_{false};
+};
+
+// writes the remote file of an index slice like
+// IndexData::serialize_to_remote_file does, with the payload encoded
+// straight into the parts of a multipart upload instead of copies of the
+// whole slice, returns the size of the file
+uint64_t
+UploadIndexSliceMultipart(ChunkManager* chunk_manager,
+                          const uint8_t* data,
+                          int64_t size,
+                          const IndexMeta& index_meta,
+                          const FieldDataMeta& field_meta,
+                          const std::string& object_key);
+
+}  // namespace milvus::storage
@@ -19,6 +19,7 @@
 #include <memory>
 #include <shared_mutex>
 
+#include "storage/DiskCacheChunkManager.h"
 #include "storage/Util.h"
 
 namespace milvus::storage {
@@ -46,6 +47,18 @@ class RemoteChunkManagerSingleton {
         }
     }
 
+    // keeps the files read from the remote chunk manager on local disk,
+    // at most capacity bytes of them
+    void
+    InitLocalCache(const std::string& cache_path, int64_t capacity) {
+        AssertInfo(rcm_ != nullptr, "remote chunk manager not initialized");
+        if (capacity > 0 &&
+            std::dynamic_pointer_cast<DiskCacheChunkManager>(rcm_) == nullptr) {
+            rcm_ = std::make_shared<DiskCacheChunkManager>(
+                rcm_, cache_path, capacity);
+        }
+    }
+
     void
     Release() {
     }
@@ -16,84 +16,148 @@
 
 #include "ThreadPool.h"
 
+#include "common/EasyAssert.h"
+
 namespace milvus {
 
-void
-ThreadPool::Init() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    for (int i = 0; i < min_threads_size_; i++) {
-        std::thread t(&ThreadPool::Worker, this);
-        assert(threads_.find(t.get_id()) == threads_.end());
-        threads_[t.get_id()] = std::move(t);
-        current_threads_size_++;
+namespace {
+
+// the worker running on the current thread, used to keep the tasks it
+// submits on its own deque
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local size_t current_worker_id = 0;
+
+}  // namespace
+
+ThreadPool::ThreadPool(const int thread_core_coefficient, std::string name)
+    : name_(std::move(name)),
+      queue_depth_(monitor::internal_thread_pool_queue_depth_family.Add(
+          {{"pool", name_}})),
+      wait_latency_(monitor::internal_thread_pool_wait_latency_family.Add(
+          {{"pool", name_}}, monitor::buckets)) {
+    max_threads_size_ = CPU_NUM * thread_core_coefficient;
+    // only IO pool will set large limit, but the CPU helps nothing to IO operations,
+    // we need to limit the max thread num, each thread will download 16~64 MiB data,
+    // according to our benchmark, 16 threads is enough to saturate the network bandwidth.
+    if (max_threads_size_ > 16) {
+        max_threads_size_ = 16;
+    }
+    if (max_threads_size_ < 1) {
+        max_threads_size_ = 1;
+    }
+    LOG_INFO(
+        "Init thread pool:{} with worker num:{}", name_, max_threads_size_);
+
+    for (int i = 0; i < max_threads_size_; i++) {
+        queues_.emplace_back(std::make_unique<WorkerQueue>());
+    }
+    for (int i = 0; i < max_threads_size_; i++) {
+        threads_.emplace_back(&ThreadPool::Worker, this, i);
     }
 }
 
 void
 ThreadPool::ShutDown() {
+    if (shutdown_.exchange(true)) {
+        return;
+    }
     LOG_INFO("Start shutting down {}", name_);
     {
-        std::lock_guard<std::mutex> lock(mutex_);
-        shutdown_ = true;
+        std::lock_guard<std::mutex> lock(idle_mutex_);
+        idle_cv_.notify_all();
     }
-    condition_lock_.notify_all();
     for (auto& thread : threads_) {
-        if (thread.second.joinable()) {
-            thread.second.join();
+        if (thread.joinable()) {
+            thread.join();
         }
     }
     LOG_INFO("Finish shutting down {}", name_);
 }
 
 void
-ThreadPool::FinishThreads() {
-    while (!need_finish_threads_.empty()) {
-        std::thread::id id;
-        auto dequeue = need_finish_threads_.dequeue(id);
-        if (dequeue) {
-            auto iter = threads_.find(id);
-            assert(iter != threads_.end());
-            if (iter->second.joinable()) {
-                iter->second.join();
+ThreadPool::Enqueue(TaskPriority priority, std::function<void()> func) {
+    AssertInfo(
+        !shutdown_, "submit task to thread pool {} after shutdown", name_);
+    auto id = current_pool == this
+                  ? current_worker_id
+                  : next_queue_.fetch_add(1) % queues_.size();
+    auto& queue = *queues_[id];
+    auto level = static_cast<int>(priority);
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks[level].push_back(
+            Task{std::move(func), std::chrono::steady_clock::now()});
+        queue.sizes[level]++;
+    }
+    pending_++;
+    queue_depth_.Increment();
+
+    // a worker going idle registers itself before checking pending_, so
+    // either it sees the task or it's woken up here
+    if (idle_threads_size_.load() > 0) {
+        std::lock_guard<std::mutex> lock(idle_mutex_);
+        idle_cv_.notify_one();
+    }
+}
+
+bool
+ThreadPool::TryPop(WorkerQueue& queue, int priority, Task& task) {
+    if (queue.sizes[priority].load() == 0) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    auto& tasks = queue.tasks[priority];
+    if (tasks.empty()) {
+        return false;
+    }
+    task = std::move(tasks.front());
+    tasks.pop_front();
+    queue.sizes[priority]--;
+    return true;
+}
+
+bool
+ThreadPool::Take(size_t worker_id, Task& task) {
+    auto num_queues = queues_.size();
+    for (int priority = 0; priority < TASK_PRIORITY_NUM; priority++) {
+        for (size_t i = 0; i < num_queues; i++) {
+            auto& queue = *queues_[(worker_id + i) % num_queues];
+            if (TryPop(queue, priority, task)) {
+                pending_--;
+                queue_depth_.Decrement();
+                return true;
             }
-            threads_.erase(iter);
         }
     }
+    return false;
 }
 
 void
-ThreadPool::Worker() {
-    std::function<void()> func;
-    bool dequeue;
-    while (!shutdown_) {
-        std::unique_lock<std::mutex> lock(mutex_);
+ThreadPool::Worker(size_t worker_id) {
+    current_pool = this;
+    current_worker_id = worker_id;
+    Task task;
+    while (true) {
+        if (Take(worker_id, task)) {
+            auto wait = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - task.submit_time);
+            wait_latency_.Observe(wait.count());
+            task.func();
+            task.func = nullptr;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(idle_mutex_);
         idle_threads_size_++;
-        auto is_timeout = !condition_lock_.wait_for(
-            lock, std::chrono::seconds(WAIT_SECONDS), [this]() {
-                return shutdown_ || !work_queue_.empty();
-            });
+        idle_cv_.wait(lock,
+                      [this]() { return shutdown_ || pending_.load() > 0; });
         idle_threads_size_--;
-        if (work_queue_.empty()) {
-            // Dynamic reduce thread number
-            if (shutdown_) {
-                current_threads_size_--;
-                return;
-            }
-            if (is_timeout) {
-                FinishThreads();
-                if (current_threads_size_ > min_threads_size_) {
-                    need_finish_threads_.enqueue(std::this_thread::get_id());
-                    current_threads_size_--;
-                    return;
-                }
-                continue;
-            }
-        }
-        dequeue = work_queue_.dequeue(func);
-        lock.unlock();
-        if (dequeue) {
-            func();
+        // the queued tasks are still run after shutdown so no future is
+        // left without a result
+        if (shutdown_ && pending_.load() == 0) {
+            return;
         }
     }
 }
-};  // namespace milvus
+
+}  // namespace milvus
@@ -16,44 +16,45 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <functional>
 #include <future>
-#include <mutex>
 #include <memory>
-#include <queue>
+#include <mutex>
+#include <string>
 #include <thread>
-#include <vector>
 #include <utility>
+#include <vector>
 
-#include "SafeQueue.h"
 #include "common/Common.h"
 #include "log/Log.h"
+#include "monitor/prometheus_client.h"
 
 namespace milvus {
 
+// Tasks of a higher priority are always taken before the ones of a lower
+// priority queued in the same pool, e.g. the reads of a search go ahead of
+// the downloads of a segment being loaded.
+enum class TaskPriority {
+    HIGH = 0,
+    NORMAL = 1,
+    LOW = 2,
+};
+
+constexpr int TASK_PRIORITY_NUM = 3;
+
+// A fixed set of workers, each owning a deque per priority. Tasks submitted
+// from outside the pool are spread over the deques round robin, tasks
+// submitted by a worker go to its own deque. An idle worker first drains
+// its own deque and then steals from the others, so submitting and taking
+// tasks don't contend on a single queue lock.
 class ThreadPool {
  public:
-    explicit ThreadPool(const int thread_core_coefficient, std::string name)
-        : shutdown_(false), name_(std::move(name)) {
-        idle_threads_size_ = 0;
-        current_threads_size_ = 0;
-        min_threads_size_ = CPU_NUM;
-        max_threads_size_ = CPU_NUM * thread_core_coefficient;
-
-        // only IO pool will set large limit, but the CPU helps nothing to IO operations,
-        // we need to limit the max thread num, each thread will download 16~64 MiB data,
-        // according to our benchmark, 16 threads is enough to saturate the network bandwidth.
-        if (min_threads_size_ > 16) {
-            min_threads_size_ = 16;
-        }
-        if (max_threads_size_ > 16) {
-            max_threads_size_ = 16;
-        }
-        LOG_INFO("Init thread pool:{}", name_)
-            << " with min worker num:" << min_threads_size_
-            << " and max worker num:" << max_threads_size_;
-        Init();
-    }
+    explicit ThreadPool(const int thread_core_coefficient, std::string name);
 
     ~ThreadPool() {
         ShutDown();
@@ -66,16 +67,13 @@ class ThreadPool {
     ThreadPool&
     operator=(ThreadPool&&) = delete;
 
-    void
-    Init();
-
+    // runs the queued tasks and stops the workers
     void
     ShutDown();
 
     size_t
     GetThreadNum() {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return current_threads_size_;
+        return threads_.size();
     }
 
     size_t
@@ -83,80 +81,121 @@ class ThreadPool {
         return max_threads_size_;
     }
 
+    // number of tasks waiting for a worker
+    int64_t
+    GetQueueDepth() const {
+        return pending_.load();
+    }
+
     template <typename F, typename... Args>
     auto
-    // Submit(F&& f, Args&&... args) -> std::future<decltype(f(args...))>;
     Submit(F&& f, Args&&... args) -> std::future<decltype(f(args...))> {
+        return SubmitWithPriority(TaskPriority::NORMAL,
+                                  std::forward<F>(f),
+                                  std::forward<Args>(args)...);
+    }
+
+    template <typename F, typename... Args>
+    auto
+    SubmitWithPriority(TaskPriority priority, F&& f, Args&&... args)
+        -> std::future<decltype(f(args...))> {
         std::function<decltype(f(args...))()> func =
             std::bind(std::forward<F>(f), std::forward<Args>(args)...);
         auto task_ptr =
             std::make_shared<std::packaged_task<decltype(f(args...))()>>(func);
+        auto future = task_ptr->get_future();
 
-        std::function<void()> wrap_func = [task_ptr]() { (*task_ptr)(); };
+        Enqueue(priority, [task_ptr]() { (*task_ptr)(); });
 
-        work_queue_.enqueue(wrap_func);
-
-        std::lock_guard<std::mutex> lock(mutex_);
+        return future;
+    }
 
-        if (idle_threads_size_ > 0) {
-            condition_lock_.notify_one();
-        } else if (current_threads_size_ < max_threads_size_) {
-            // Dynamic increase thread number
-            std::thread t(&ThreadPool::Worker, this);
-            assert(threads_.find(t.get_id()) == threads_.end());
-            threads_[t.get_id()] = std::move(t);
-            current_threads_size_++;
+    // calls f(i) for i in [0, n) on the caller and up to n - 1 workers, and
+    // rethrows the first exception once all of them are done. The indexes
+    // are claimed one by one, the caller never waits for a task queued
+    // behind it, so a worker of this pool may call it too. A helper
+    // starting after all the indexes are claimed exits at once and only
+    // touches the state it shares.
+    template <typename F>
+    void
+    ParallelFor(size_t n, TaskPriority priority, const F& f) {
+        struct State {
+            std::atomic<size_t> next{0};
+            std::mutex mutex;
+            std::condition_variable done_cv;
+            size_t num_done{0};
+            std::exception_ptr error;
+        };
+        auto state = std::make_shared<State>();
+        auto run = [state, n, &f]() {
+            for (size_t i = state->next++; i < n; i = state->next++) {
+                std::exception_ptr error;
+                try {
+                    f(i);
+                } catch (...) {
+                    error = std::current_exception();
+                }
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (error && !state->error) {
+                    state->error = error;
+                }
+                if (++state->num_done == n) {
+                    state->done_cv.notify_all();
+                }
+            }
+        };
+        for (size_t i = 1; i < n; i++) {
+            Enqueue(priority, run);
+        }
+        run();
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->done_cv.wait(lock, [&]() { return state->num_done == n; });
+        if (state->error) {
+            std::rethrow_exception(state->error);
         }
-
-        return task_ptr->get_future();
     }
 
-    void
-    Worker();
+ private:
+    struct Task {
+        std::function<void()> func;
+        std::chrono::steady_clock::time_point submit_time;
+    };
 
-    void
-    FinishThreads();
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks[TASK_PRIORITY_NUM];
+        // sizes of the deques, checked before locking them
+        std::atomic<int64_t> sizes[TASK_PRIORITY_NUM] = {};
+    };
 
- public:
-    int min_threads_size_;
-    int idle_threads_size_;
-    int current_threads_size_;
-    int max_threads_size_;
-    bool shutdown_;
-    static constexpr size_t WAIT_SECONDS = 2;
-    SafeQueue<std::function<void()>> work_queue_;
-    std::unordered_map<std::thread::id, std::thread> threads_;
-    SafeQueue<std::thread::id> need_finish_threads_;
-    std::mutex mutex_;
-    std::condition_variable condition_lock_;
-    std::string name_;
-};
+    void
+    Enqueue(TaskPriority priority, std::function<void()> func);
 
-class Worker {
- private:
-    int id_;
-    ThreadPool* pool_;
+    bool
+    TryPop(WorkerQueue& queue, int priority, Task& task);
 
- public:
-    Worker(ThreadPool* pool, const int id) : pool_(pool), id_(id) {
-    }
+    // takes the task of the highest priority, from its own deque first
+    bool
+    Take(size_t worker_id, Task& task);
 
     void
-    operator()() {
-        std::function<void()> func;
-        bool dequeue;
-        while (!pool_->shutdown_) {
-            std::unique_lock<std::mutex> lock(pool_->mutex_);
-            if (pool_->work_queue_.empty()) {
-                pool_->condition_lock_.wait(lock);
-            }
-            dequeue = pool_->work_queue_.dequeue(func);
-            lock.unlock();
-            if (dequeue) {
-                func();
-            }
-        }
-    }
+    Worker(size_t worker_id);
+
+ private:
+    std::string name_;
+    int max_threads_size_;
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::vector<std::thread> threads_;
+    std::atomic<size_t> next_queue_{0};
+    std::atomic<int64_t> pending_{0};
+
+    std::atomic<bool> shutdown_{false};
+    std::atomic<int> idle_threads_size_{0};
+    std::mutex idle_mutex_;
+    std::condition_variable idle_cv_;
+
+    prometheus::Gauge& queue_depth_;
+    prometheus::Histogram& wait_latency_;
 };
 
 }  // namespace milvus
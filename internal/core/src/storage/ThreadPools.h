@@ -17,6 +17,11 @@
 #ifndef MILVUS_THREADPOOLS_H
 #define MILVUS_THREADPOOLS_H
 
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+
 #include "ThreadPool.h"
 #include "common/Common.h"
 
@@ -22,6 +22,7 @@
 #include "fmt/format.h"
 #include "log/Log.h"
 
+#include "common/Common.h"
 #include "common/Consts.h"
 #include "common/EasyAssert.h"
 #include "common/FieldData.h"
@@ -38,6 +39,7 @@
 #include "storage/LocalChunkManager.h"
 #include "storage/MemFileManagerImpl.h"
 #include "storage/MinioChunkManager.h"
+#include "storage/MultipartUpload.h"
 #ifdef USE_OPENDAL
 #include "storage/opendal/OpenDALChunkManager.h"
 #endif
@@ -553,15 +555,24 @@ std::unique_ptr<DataCodec>
 DownloadAndDecodeRemoteFile(ChunkManager* chunk_manager,
                             const std::string& file,
                             bool is_field_data) {
-    auto fileSize = chunk_manager->Size(file);
-    auto buf = std::shared_ptr<uint8_t[]>(new uint8_t[fileSize]);
-    chunk_manager->Read(file, buf.get(), fileSize);
+    std::shared_ptr<uint8_t[]> buf;
+    auto fileSize = chunk_manager->ReadAll(file, buf);
 
     auto res = DeserializeFileData(buf, fileSize, is_field_data);
     res->SetData(buf);
     return res;
 }
 
+std::shared_ptr<LoadMemoryReservation>
+ReserveLoadMemory() {
+    auto& governor = LoadMemoryGovernor::GetInstance();
+    if (!governor.enabled()) {
+        return std::make_shared<LoadMemoryReservation>();
+    }
+    return std::make_shared<LoadMemoryReservation>(
+        governor.Reserve(FILE_SLICE_SIZE));
+}
+
 std::pair<std::string, size_t>
 EncodeAndUploadIndexSlice(ChunkManager* chunk_manager,
                           uint8_t* buf,
@@ -569,6 +580,14 @@ EncodeAndUploadIndexSlice(ChunkManager* chunk_manager,
                           IndexMeta index_meta,
                           FieldDataMeta field_meta,
                           std::string object_key) {
+    // large slices are encoded straight into the parts of a multipart
+    // upload, without copies of the whole slice
+    if (batch_size > MULTIPART_UPLOAD_PART_SIZE) {
+        auto size = UploadIndexSliceMultipart(
+            chunk_manager, buf, batch_size, index_meta, field_meta, object_key);
+        return std::make_pair(std::move(object_key), size);
+    }
+
     // index not use valid_data, so no need to set nullable==true
     auto field_data = CreateFieldData(DataType::INT8, false);
     field_data->FillFieldData(buf, batch_size);
@@ -613,8 +632,21 @@ GetObjectData(ChunkManager* remote_chunk_manager,
     std::vector<std::future<std::unique_ptr<DataCodec>>> futures;
     futures.reserve(remote_files.size());
     for (auto& file : remote_files) {
-        futures.emplace_back(pool.Submit(
-            DownloadAndDecodeRemoteFile, remote_chunk_manager, file, true));
+        auto reservation = ReserveLoadMemory();
+        futures.emplace_back(
+            pool.Submit([remote_chunk_manager, file, reservation]() {
+                std::shared_ptr<uint8_t[]> buf;
+                auto size = remote_chunk_manager->ReadAll(file, buf);
+                auto result = DeserializeFileData(buf, size, true);
+                // the buffer is dropped along with the codec, the field
+                // data is kept by the caller
+                auto field_data = result->GetFieldData();
+                reservation->Resize(field_data->Size());
+                result->SetFieldData(
+                    HoldLoadMemory(std::move(field_data), reservation));
+                result->SetData(buf);
+                return result;
+            }));
     }
     return futures;
 }
@@ -30,6 +30,7 @@
 #include "storage/BinlogReader.h"
 #include "storage/ChunkManager.h"
 #include "storage/DataCodec.h"
+#include "storage/LoadMemoryGovernor.h"
 #include "storage/Types.h"
 
 namespace milvus::storage {
@@ -105,6 +106,30 @@ DownloadAndDecodeRemoteFile(ChunkManager* chunk_manager,
                             const std::string& file,
                             bool is_field_data = true);
 
+// waits for the load memory governor to grant the memory a file takes while
+// it is downloaded and decoded. The sizes of the files are not known before
+// their download, so FILE_SLICE_SIZE is reserved for every file, and the
+// task loading the file resizes the reservation to the memory it took. Must
+// be called by the thread driving the load before it submits the download,
+// never by a task of the pool the downloads run on.
+std::shared_ptr<LoadMemoryReservation>
+ReserveLoadMemory();
+
+// the data, which holds the reservation until its consumer drops the last
+// reference to it
+template <typename T>
+std::shared_ptr<T>
+HoldLoadMemory(std::shared_ptr<T> data,
+               std::shared_ptr<LoadMemoryReservation> reservation) {
+    if (data == nullptr || reservation->bytes() == 0) {
+        return data;
+    }
+    auto holder = std::make_shared<
+        std::pair<std::shared_ptr<T>, std::shared_ptr<LoadMemoryReservation>>>(
+        std::move(data), std::move(reservation));
+    return std::shared_ptr<T>(holder, holder->first.get());
+}
+
 std::pair<std::string, size_t>
 EncodeAndUploadIndexSlice(ChunkManager* chunk_manager,
                           uint8_t* buf,
@@ -87,6 +87,19 @@ InitRemoteChunkManagerSingleton(CStorageConfig c_storage_config) {
     }
 }
 
+CStatus
+InitRemoteChunkManagerLocalCache(const char* c_path, int64_t capacity) {
+    try {
+        std::string path(c_path);
+        milvus::storage::RemoteChunkManagerSingleton::GetInstance()
+            .InitLocalCache(path, capacity);
+
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(&e);
+    }
+}
+
 CStatus
 InitMmapManager(CMmapConfig c_mmap_config) {
     try {
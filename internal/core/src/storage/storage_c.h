@@ -30,6 +30,9 @@ InitLocalChunkManagerSingleton(const char* path);
 CStatus
 InitRemoteChunkManagerSingleton(CStorageConfig c_storage_config);
 
+CStatus
+InitRemoteChunkManagerLocalCache(const char* c_path, int64_t capacity);
+
 CStatus
 InitMmapManager(CMmapConfig c_mmap_config);
 
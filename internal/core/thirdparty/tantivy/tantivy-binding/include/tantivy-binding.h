@@ -42,6 +42,8 @@ uint32_t tantivy_index_count(void *ptr);
 
 RustArray tantivy_term_query_i64(void *ptr, int64_t term);
 
+RustArray tantivy_terms_query_i64(void *ptr, const int64_t *terms, uintptr_t len);
+
 RustArray tantivy_lower_bound_range_query_i64(void *ptr, int64_t lower_bound, bool inclusive);
 
 RustArray tantivy_upper_bound_range_query_i64(void *ptr, int64_t upper_bound, bool inclusive);
@@ -54,6 +56,8 @@ RustArray tantivy_range_query_i64(void *ptr,
 
 RustArray tantivy_term_query_f64(void *ptr, double term);
 
+RustArray tantivy_terms_query_f64(void *ptr, const double *terms, uintptr_t len);
+
 RustArray tantivy_lower_bound_range_query_f64(void *ptr, double lower_bound, bool inclusive);
 
 RustArray tantivy_upper_bound_range_query_f64(void *ptr, double upper_bound, bool inclusive);
@@ -66,8 +70,12 @@ RustArray tantivy_range_query_f64(void *ptr,
 
 RustArray tantivy_term_query_bool(void *ptr, bool term);
 
+RustArray tantivy_terms_query_bool(void *ptr, const bool *terms, uintptr_t len);
+
 RustArray tantivy_term_query_keyword(void *ptr, const char *term);
 
+RustArray tantivy_terms_query_keyword(void *ptr, const char *const *terms, uintptr_t len);
+
 RustArray tantivy_lower_bound_range_query_keyword(void *ptr,
                                                   const char *lower_bound,
                                                   bool inclusive);
@@ -1,7 +1,7 @@
 use std::ops::Bound;
 use std::sync::Arc;
 
-use tantivy::query::{Query, RangeQuery, RegexQuery, TermQuery};
+use tantivy::query::{Query, RangeQuery, RegexQuery, TermQuery, TermSetQuery};
 use tantivy::schema::{Field, IndexRecordOption};
 use tantivy::{Index, IndexReader, ReloadPolicy, Term};
 
@@ -87,6 +87,17 @@ impl IndexReaderWrapper {
         self.search(&q)
     }
 
+    // one query of all the terms, their postings are looked up in a single
+    // walk over the sorted term dictionary
+    pub fn terms_query_i64(&self, terms: &[i64]) -> Vec<u32> {
+        let q = TermSetQuery::new(
+            terms
+                .iter()
+                .map(|term| Term::from_field_i64(self.field, *term)),
+        );
+        self.search(&q)
+    }
+
     pub fn lower_bound_range_query_i64(&self, lower_bound: i64, inclusive: bool) -> Vec<u32> {
         let q = RangeQuery::new_i64_bounds(
             self.field_name.to_string(),
@@ -126,6 +137,15 @@ impl IndexReaderWrapper {
         self.search(&q)
     }
 
+    pub fn terms_query_f64(&self, terms: &[f64]) -> Vec<u32> {
+        let q = TermSetQuery::new(
+            terms
+                .iter()
+                .map(|term| Term::from_field_f64(self.field, *term)),
+        );
+        self.search(&q)
+    }
+
     pub fn lower_bound_range_query_f64(&self, lower_bound: f64, inclusive: bool) -> Vec<u32> {
         let q = RangeQuery::new_f64_bounds(
             self.field_name.to_string(),
@@ -165,6 +185,15 @@ impl IndexReaderWrapper {
         self.search(&q)
     }
 
+    pub fn terms_query_bool(&self, terms: &[bool]) -> Vec<u32> {
+        let q = TermSetQuery::new(
+            terms
+                .iter()
+                .map(|term| Term::from_field_bool(self.field, *term)),
+        );
+        self.search(&q)
+    }
+
     pub fn term_query_keyword(&self, term: &str) -> Vec<u32> {
         let q = TermQuery::new(
             Term::from_field_text(self.field, term),
@@ -173,6 +202,15 @@ impl IndexReaderWrapper {
         self.search(&q)
     }
 
+    pub fn terms_query_keyword(&self, terms: &[&str]) -> Vec<u32> {
+        let q = TermSetQuery::new(
+            terms
+                .iter()
+                .map(|term| Term::from_field_text(self.field, term)),
+        );
+        self.search(&q)
+    }
+
     pub fn lower_bound_range_query_keyword(&self, lower_bound: &str, inclusive: bool) -> Vec<u32> {
         let q = RangeQuery::new_str_bounds(
             self.field_name.to_string(),
@@ -1,3 +1,4 @@
+use core::slice;
 use std::ffi::{c_char, c_void, CStr};
 
 use crate::{
@@ -44,6 +45,20 @@ pub extern "C" fn tantivy_term_query_i64(ptr: *mut c_void, term: i64) -> RustArr
     }
 }
 
+#[no_mangle]
+pub extern "C" fn tantivy_terms_query_i64(
+    ptr: *mut c_void,
+    terms: *const i64,
+    len: usize,
+) -> RustArray {
+    let real = ptr as *mut IndexReaderWrapper;
+    unsafe {
+        let arr = slice::from_raw_parts(terms, len);
+        let hits = (*real).terms_query_i64(arr);
+        RustArray::from_vec(hits)
+    }
+}
+
 #[no_mangle]
 pub extern "C" fn tantivy_lower_bound_range_query_i64(
     ptr: *mut c_void,
@@ -94,6 +109,20 @@ pub extern "C" fn tantivy_term_query_f64(ptr: *mut c_void, term: f64) -> RustArr
     }
 }
 
+#[no_mangle]
+pub extern "C" fn tantivy_terms_query_f64(
+    ptr: *mut c_void,
+    terms: *const f64,
+    len: usize,
+) -> RustArray {
+    let real = ptr as *mut IndexReaderWrapper;
+    unsafe {
+        let arr = slice::from_raw_parts(terms, len);
+        let hits = (*real).terms_query_f64(arr);
+        RustArray::from_vec(hits)
+    }
+}
+
 #[no_mangle]
 pub extern "C" fn tantivy_lower_bound_range_query_f64(
     ptr: *mut c_void,
@@ -144,6 +173,20 @@ pub extern "C" fn tantivy_term_query_bool(ptr: *mut c_void, term: bool) -> RustA
     }
 }
 
+#[no_mangle]
+pub extern "C" fn tantivy_terms_query_bool(
+    ptr: *mut c_void,
+    terms: *const bool,
+    len: usize,
+) -> RustArray {
+    let real = ptr as *mut IndexReaderWrapper;
+    unsafe {
+        let arr = slice::from_raw_parts(terms, len);
+        let hits = (*real).terms_query_bool(arr);
+        RustArray::from_vec(hits)
+    }
+}
+
 #[no_mangle]
 pub extern "C" fn tantivy_term_query_keyword(ptr: *mut c_void, term: *const c_char) -> RustArray {
     let real = ptr as *mut IndexReaderWrapper;
@@ -154,6 +197,24 @@ pub extern "C" fn tantivy_term_query_keyword(ptr: *mut c_void, term: *const c_ch
     }
 }
 
+#[no_mangle]
+pub extern "C" fn tantivy_terms_query_keyword(
+    ptr: *mut c_void,
+    terms: *const *const c_char,
+    len: usize,
+) -> RustArray {
+    let real = ptr as *mut IndexReaderWrapper;
+    unsafe {
+        let arr = slice::from_raw_parts(terms, len);
+        let terms: Vec<&str> = arr
+            .iter()
+            .map(|term| CStr::from_ptr(*term).to_str().unwrap())
+            .collect();
+        let hits = (*real).terms_query_keyword(&terms);
+        RustArray::from_vec(hits)
+    }
+}
+
 #[no_mangle]
 pub extern "C" fn tantivy_lower_bound_range_query_keyword(
     ptr: *mut c_void,
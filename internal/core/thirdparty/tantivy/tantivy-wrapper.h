@@ -310,6 +310,51 @@ struct TantivyIndexWrapper {
         return RustArrayWrapper(array);
     }
 
+    // the hits of any of the terms, in a single query
+    template <typename T>
+    RustArrayWrapper
+    terms_query(const T* terms, uintptr_t len) {
+        auto array = [&]() {
+            if constexpr (std::is_same_v<T, bool>) {
+                return tantivy_terms_query_bool(reader_, terms, len);
+            }
+
+            if constexpr (std::is_same_v<T, int64_t>) {
+                return tantivy_terms_query_i64(reader_, terms, len);
+            }
+
+            if constexpr (std::is_integral_v<T>) {
+                std::vector<int64_t> i64_terms(terms, terms + len);
+                return tantivy_terms_query_i64(
+                    reader_, i64_terms.data(), i64_terms.size());
+            }
+
+            if constexpr (std::is_same_v<T, double>) {
+                return tantivy_terms_query_f64(reader_, terms, len);
+            }
+
+            if constexpr (std::is_floating_point_v<T>) {
+                std::vector<double> f64_terms(terms, terms + len);
+                return tantivy_terms_query_f64(
+                    reader_, f64_terms.data(), f64_terms.size());
+            }
+
+            if constexpr (std::is_same_v<T, std::string>) {
+                std::vector<const char*> keywords(len);
+                for (uintptr_t i = 0; i < len; i++) {
+                    keywords[i] = terms[i].c_str();
+                }
+                return tantivy_terms_query_keyword(
+                    reader_, keywords.data(), keywords.size());
+            }
+
+            throw fmt::format(
+                "InvertedIndex.terms_query: unsupported data type: {}",
+                typeid(T).name());
+        }();
+        return RustArrayWrapper(array);
+    }
+
     template <typename T>
     RustArrayWrapper
     lower_bound_range_query(T lower_bound, bool inclusive) {
@@ -44,6 +44,12 @@ run() {
         hits.debug();
     }
 
+    {
+        T terms[] = {2, 5, 7};
+        auto hits = w.terms_query<T>(terms, sizeof(terms) / sizeof(T));
+        hits.debug();
+    }
+
     {
         auto hits = w.lower_bound_range_query<T>(1, false);
         hits.debug();
@@ -129,6 +135,12 @@ run<std::string>() {
         hits.debug();
     }
 
+    {
+        std::vector<std::string> terms = {"a", "abbb", "c"};
+        auto hits = w.terms_query<std::string>(terms.data(), terms.size());
+        hits.debug();
+    }
+
     {
         auto hits = w.lower_bound_range_query<std::string>("aa", true);
         hits.debug();
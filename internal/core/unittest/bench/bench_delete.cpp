@@ -0,0 +1,100 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "segcore/DeletedRecord.h"
+#include "segcore/InsertRecord.h"
+#include "segcore/Record.h"
+#include "segcore/Utils.h"
+#include "test_utils/DataGen.h"
+
+using namespace milvus;
+using namespace milvus::segcore;
+
+namespace {
+
+constexpr int64_t kNumRows = 256 * 1024;
+
+const auto delete_schema = []() {
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 4, knowhere::metric::L2);
+    auto pk_fid = schema->AddDebugField("pk", DataType::INT64);
+    schema->set_primary_field_id(pk_fid);
+    return schema;
+}();
+
+// rows with pks 0..kNumRows - 1 inserted at timestamps 1..kNumRows
+template <bool is_sealed>
+const InsertRecord<is_sealed>&
+DeleteInsertRecord() {
+    static auto record = []() {
+        auto record = std::make_unique<InsertRecord<is_sealed>>(
+            *delete_schema, kNumRows);
+        std::vector<Timestamp> timestamps(kNumRows);
+        for (int64_t i = 0; i < kNumRows; ++i) {
+            record->insert_pk(PkType(i), i);
+            timestamps[i] = i + 1;
+        }
+        if constexpr (is_sealed) {
+            record->seal_pks();
+        }
+        record->timestamps_.set_data_raw(0, timestamps.data(), kNumRows);
+        return record;
+    }();
+    return *record;
+}
+
+// the deleted bits of a segment with a delete of the per mille of its rows
+// in range(0), spread over them, none of the bitmaps cached
+template <bool is_sealed>
+void
+DeleteBitmap(benchmark::State& state) {
+    auto& insert_record = DeleteInsertRecord<is_sealed>();
+    auto num_deletes = kNumRows * state.range(0) / 1000;
+    std::vector<PkType> pks;
+    for (int64_t i = 0; i < num_deletes; ++i) {
+        pks.emplace_back(i * kNumRows / num_deletes);
+    }
+    Timestamp query_timestamp = kNumRows + 1;
+    std::vector<Timestamp> timestamps(num_deletes, query_timestamp);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto deleted_record = std::make_unique<DeletedRecord>();
+        deleted_record->push(pks, timestamps.data());
+        state.ResumeTiming();
+
+        auto del_barrier = get_barrier(*deleted_record, query_timestamp);
+        auto bitmap = get_deleted_bitmap(del_barrier,
+                                         kNumRows,
+                                         *deleted_record,
+                                         insert_record,
+                                         query_timestamp);
+        benchmark::DoNotOptimize(bitmap);
+
+        state.PauseTiming();
+        bitmap.reset();
+        deleted_record.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * num_deletes);
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(DeleteBitmap, false)->Arg(1)->Arg(10)->Arg(100)->Arg(500);
+BENCHMARK_TEMPLATE(DeleteBitmap, true)->Arg(1)->Arg(10)->Arg(100)->Arg(500);
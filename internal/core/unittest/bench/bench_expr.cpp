@@ -0,0 +1,248 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "bench/bench_utils.h"
+#include "exec/expression/function/FunctionFactory.h"
+#include "expr/ITypeExpr.h"
+#include "plan/PlanNode.h"
+#include "query/ExecPlanNodeVisitor.h"
+
+using namespace milvus;
+using namespace milvus::query;
+using namespace milvus::segcore;
+
+namespace {
+
+constexpr int64_t kNumBatches = 4;
+constexpr int64_t kBatchRows = 16 * 1024;
+
+// i64 holds 0..kBatchRows - 1 in every batch, i32 values are uniform in
+// [0, 2 * kBatchRows) and the json int ones in [0, INT32_MAX)
+const auto expr_schema = []() {
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 4, knowhere::metric::L2);
+    auto pk_fid = schema->AddDebugField("pk", DataType::INT64);
+    schema->set_primary_field_id(pk_fid);
+    schema->AddDebugField("i64", DataType::INT64);
+    schema->AddDebugField("i32", DataType::INT32);
+    schema->AddDebugField("f64", DataType::DOUBLE);
+    schema->AddDebugField("str", DataType::VARCHAR);
+    schema->AddDebugField("json", DataType::JSON);
+    return schema;
+}();
+
+expr::ColumnInfo
+Column(const std::string& name, std::vector<std::string> path = {}) {
+    auto field_id = expr_schema->get_field_id(FieldName(name));
+    auto data_type = (*expr_schema)[field_id].get_data_type();
+    return expr::ColumnInfo(field_id, data_type, std::move(path));
+}
+
+proto::plan::GenericValue
+Int64Value(int64_t value) {
+    proto::plan::GenericValue generic;
+    generic.set_int64_val(value);
+    return generic;
+}
+
+expr::TypedExprPtr
+I32LessThan(double selectivity) {
+    return std::make_shared<expr::UnaryRangeFilterExpr>(
+        Column("i32"),
+        proto::plan::OpType::LessThan,
+        Int64Value(selectivity * 2 * kBatchRows));
+}
+
+// builds the filter passing about selectivity of the rows
+using ExprFactory = std::function<expr::TypedExprPtr(double selectivity)>;
+
+struct ExprCase {
+    std::string name_;
+    ExprFactory factory_;
+    // false if the rows passing the filter don't depend on selectivity
+    bool with_selectivity_ = true;
+};
+
+const std::vector<ExprCase>&
+ExprCases() {
+    static const std::vector<ExprCase> cases = {
+        {"UnaryRange", I32LessThan},
+        {"BinaryRange",
+         [](double selectivity) {
+             return std::make_shared<expr::BinaryRangeFilterExpr>(
+                 Column("i64"),
+                 Int64Value(0),
+                 Int64Value(selectivity * kBatchRows),
+                 true,
+                 false);
+         }},
+        {"Term",
+         [](double selectivity) {
+             std::vector<proto::plan::GenericValue> values;
+             for (int64_t i = 0; i < selectivity * kBatchRows; ++i) {
+                 values.push_back(Int64Value(i));
+             }
+             return std::make_shared<expr::TermFilterExpr>(Column("i64"),
+                                                           values);
+         }},
+        {"BinaryArithOpEvalRange",
+         [](double selectivity) {
+             return std::make_shared<expr::BinaryArithOpEvalRangeExpr>(
+                 Column("i32"),
+                 proto::plan::OpType::LessThan,
+                 proto::plan::ArithOpType::Add,
+                 Int64Value(selectivity * 2 * kBatchRows + 1),
+                 Int64Value(1));
+         }},
+        {"LogicalBinary",
+         [](double selectivity) {
+             proto::plan::GenericValue lower;
+             lower.set_float_val(std::numeric_limits<float>::lowest());
+             auto all = std::make_shared<expr::UnaryRangeFilterExpr>(
+                 Column("f64"), proto::plan::OpType::GreaterThan, lower);
+             return std::make_shared<expr::LogicalBinaryExpr>(
+                 expr::LogicalBinaryExpr::OpType::And,
+                 I32LessThan(selectivity),
+                 all);
+         }},
+        {"LogicalUnary",
+         [](double selectivity) {
+             auto rest = std::make_shared<expr::UnaryRangeFilterExpr>(
+                 Column("i32"),
+                 proto::plan::OpType::GreaterEqual,
+                 Int64Value(selectivity * 2 * kBatchRows));
+             return std::make_shared<expr::LogicalUnaryExpr>(
+                 expr::LogicalUnaryExpr::OpType::LogicalNot, rest);
+         }},
+        {"JsonUnaryRange",
+         [](double selectivity) {
+             return std::make_shared<expr::UnaryRangeFilterExpr>(
+                 Column("json", {"int"}),
+                 proto::plan::OpType::LessThan,
+                 Int64Value(selectivity *
+                            std::numeric_limits<int32_t>::max()));
+         }},
+        // about a quarter of the rows
+        {"Compare",
+         [](double) {
+             auto i32 = Column("i32");
+             auto i64 = Column("i64");
+             return std::make_shared<expr::CompareExpr>(
+                 i32.field_id_,
+                 i64.field_id_,
+                 DataType::INT32,
+                 DataType::INT64,
+                 proto::plan::OpType::LessThan);
+         },
+         false},
+        // all the rows
+        {"Exists",
+         [](double) {
+             return std::make_shared<expr::ExistsExpr>(
+                 Column("json", {"int"}));
+         },
+         false},
+        // all the rows
+        {"JsonContains",
+         [](double) {
+             return std::make_shared<expr::JsonContainsExpr>(
+                 Column("json", {"array"}),
+                 proto::plan::JSONContainsExpr_JSONOp_ContainsAny,
+                 true,
+                 std::vector<proto::plan::GenericValue>{Int64Value(1)});
+         },
+         false},
+        // none of the rows
+        {"Call",
+         [](double) {
+             auto& factory =
+                 exec::expression::FunctionFactory::Instance();
+             factory.Initialize();
+             auto empty = factory.GetFilterFunction(
+                 exec::expression::FilterFunctionRegisterKey{
+                     "empty", {DataType::VARCHAR}});
+             std::vector<expr::TypedExprPtr> parameters{
+                 std::make_shared<expr::ColumnExpr>(Column("str"))};
+             return std::make_shared<expr::CallExpr>(
+                 "empty", parameters, empty);
+         },
+         false},
+        {"AlwaysTrue",
+         [](double) { return std::make_shared<expr::AlwaysTrueExpr>(); },
+         false},
+    };
+    return cases;
+}
+
+const SegmentInternalInterface*
+ExprSegment(BenchSegmentKind kind) {
+    static const auto batches =
+        BenchDataGen(expr_schema, kNumBatches, kBatchRows);
+    static std::map<BenchSegmentKind,
+                    std::unique_ptr<SegmentInternalInterface>>
+        segments;
+    auto& segment = segments[kind];
+    if (segment == nullptr) {
+        segment = CreateBenchSegment(kind, expr_schema, batches);
+    }
+    return segment.get();
+}
+
+void
+Filter(benchmark::State& state,
+       BenchSegmentKind kind,
+       const ExprCase& expr_case) {
+    DisableFilterCache();
+    auto selectivity =
+        expr_case.with_selectivity_ ? state.range(0) / 1000.0 : 0;
+    auto plan = std::make_shared<plan::FilterBitsNode>(
+        DEFAULT_PLANNODE_ID, expr_case.factory_(selectivity));
+    auto segment = ExprSegment(kind);
+    auto num_rows = segment->get_active_count(MAX_TIMESTAMP);
+
+    int64_t num_hits = 0;
+    for (auto _ : state) {
+        auto bitset =
+            ExecuteQueryExpr(plan, segment, num_rows, MAX_TIMESTAMP);
+        num_hits = bitset.count();
+        benchmark::DoNotOptimize(bitset);
+    }
+    state.SetItemsProcessed(state.iterations() * num_rows);
+    state.counters["hit_ratio"] = static_cast<double>(num_hits) / num_rows;
+}
+
+// Filter/<expr>/<segment kind>/<selectivity in per mille>
+const auto registered = []() {
+    for (auto& expr_case : ExprCases()) {
+        for (auto kind : kBenchSegmentKinds) {
+            auto name = "Filter/" + expr_case.name_ + "/" +
+                        BenchSegmentKindName(kind);
+            auto bench = benchmark::RegisterBenchmark(
+                name.c_str(), Filter, kind, expr_case);
+            if (expr_case.with_selectivity_) {
+                bench->Arg(1)->Arg(100)->Arg(500);
+            }
+        }
+    }
+    return true;
+}();
+
+}  // namespace
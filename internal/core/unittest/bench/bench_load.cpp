@@ -0,0 +1,123 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "bench/bench_utils.h"
+
+using namespace milvus;
+using namespace milvus::segcore;
+
+namespace {
+
+constexpr int64_t kNumBatches = 8;
+constexpr int64_t kBatchRows = 16 * 1024;
+
+const auto load_schema = []() {
+    auto schema = std::make_shared<Schema>();
+    auto pk_fid = schema->AddDebugField("pk", DataType::INT64);
+    schema->set_primary_field_id(pk_fid);
+    schema->AddDebugField("int32", DataType::INT32);
+    schema->AddDebugField("double", DataType::DOUBLE);
+    schema->AddDebugField("varchar", DataType::VARCHAR);
+    schema->AddDebugField("json", DataType::JSON);
+    schema->AddDebugField("array", DataType::ARRAY, DataType::INT64);
+    schema->AddDebugField(
+        "float_vector", DataType::VECTOR_FLOAT, 128, knowhere::metric::L2);
+    return schema;
+}();
+
+// the field data of the binlogs of every field, by field id
+const std::map<FieldId, std::vector<FieldDataPtr>>&
+LoadFieldDatas() {
+    static const auto field_datas = []() {
+        auto batches = BenchDataGen(load_schema, kNumBatches, kBatchRows);
+        std::map<FieldId, std::vector<FieldDataPtr>> field_datas;
+        for (auto field_id : BenchLoadFieldIds(load_schema)) {
+            field_datas[field_id] = BenchFieldData(batches, field_id);
+        }
+        return field_datas;
+    }();
+    return field_datas;
+}
+
+// loads every field of a segment from its decoded binlogs, the decoding of
+// the binlogs is not timed. Loading into a growing segment is an insert, so
+// growing segments are left out.
+void
+LoadFieldData(benchmark::State& state, BenchSegmentKind kind) {
+    auto& field_datas = LoadFieldDatas();
+    auto chunked = kind == BenchSegmentKind::CHUNKED;
+    auto with_mmap = kind == BenchSegmentKind::MMAP;
+    int64_t row_count = kNumBatches * kBatchRows;
+    int64_t bytes = 0;
+    for (auto& [field_id, datas] : field_datas) {
+        for (auto& data : datas) {
+            bytes += data->Size();
+        }
+    }
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto segment = CreateSealedSegment(load_schema,
+                                           nullptr,
+                                           0,
+                                           SegcoreConfig::default_config(),
+                                           false,
+                                           false,
+                                           chunked);
+        // the arrow readers are consumed by the load
+        std::map<FieldId, std::vector<std::shared_ptr<ArrowDataWrapper>>>
+            readers;
+        if (chunked) {
+            for (auto& [field_id, datas] : field_datas) {
+                readers[field_id] = BenchArrowReaders(datas, field_id);
+            }
+        }
+        state.ResumeTiming();
+
+        for (auto& [field_id, datas] : field_datas) {
+            if (chunked) {
+                BenchLoadChunked(
+                    *segment, field_id, readers[field_id], row_count, false);
+            } else {
+                BenchLoadSealed(
+                    *segment, field_id, datas, row_count, with_mmap);
+            }
+        }
+
+        state.PauseTiming();
+        segment.reset();
+        state.ResumeTiming();
+    }
+    state.SetBytesProcessed(state.iterations() * bytes);
+    state.SetItemsProcessed(state.iterations() * row_count);
+}
+
+// LoadFieldData/<segment kind>
+const auto registered = []() {
+    for (auto kind : kBenchSegmentKinds) {
+        if (kind == BenchSegmentKind::GROWING) {
+            continue;
+        }
+        auto name = "LoadFieldData/" + BenchSegmentKindName(kind);
+        benchmark::RegisterBenchmark(name.c_str(), LoadFieldData, kind)
+            ->Unit(benchmark::kMillisecond);
+    }
+    return true;
+}();
+
+}  // namespace
@@ -0,0 +1,120 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "segcore/SegmentSealed.h"
+#include "segcore/reduce/Reduce.h"
+#include "test_utils/DataGen.h"
+
+using namespace milvus;
+using namespace milvus::query;
+using namespace milvus::segcore;
+
+namespace {
+
+constexpr int kDim = 16;
+constexpr int64_t kSegmentRows = 8 * 1024;
+
+const auto reduce_schema = []() {
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, kDim, knowhere::metric::L2);
+    auto pk_fid = schema->AddDebugField("pk", DataType::INT64);
+    schema->set_primary_field_id(pk_fid);
+    return schema;
+}();
+
+// sealed segments with random pks, so that few of them are duplicated
+const std::vector<SegmentSealedUPtr>&
+ReduceSegments(int64_t num_segments) {
+    static std::vector<SegmentSealedUPtr> segments;
+    while (static_cast<int64_t>(segments.size()) < num_segments) {
+        auto segment = CreateSealedSegment(reduce_schema);
+        SealedLoadFieldData(DataGen(reduce_schema,
+                                    kSegmentRows,
+                                    42 + segments.size(),
+                                    0,
+                                    1,
+                                    10,
+                                    true),
+                            *segment);
+        segments.push_back(std::move(segment));
+    }
+    return segments;
+}
+
+std::unique_ptr<Plan>
+ReducePlan(int64_t topk) {
+    auto raw_plan = R"(vector_anns: <
+                         field_id: 100
+                         query_info: <
+                           topk: )" +
+                    std::to_string(topk) + R"(
+                           round_decimal: -1
+                           metric_type: "L2"
+                           search_params: "{\"nprobe\": 10}"
+                         >
+                         placeholder_tag: "$0"
+                       >)";
+    auto plan_str = translate_text_plan_to_binary_plan(raw_plan.c_str());
+    return CreateSearchPlanByExpr(
+        *reduce_schema, plan_str.data(), plan_str.size());
+}
+
+// merges the results of range(2) segments for range(0) queries of top
+// range(1), the search of the segments is not timed
+void
+Reduce_Sealed(benchmark::State& state) {
+    auto nq = state.range(0);
+    auto topk = state.range(1);
+    auto& segments = ReduceSegments(state.range(2));
+    auto plan = ReducePlan(topk);
+    auto ph_group_raw = CreatePlaceholderGroup(nq, kDim, 1024);
+    auto ph_group =
+        ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::vector<std::unique_ptr<SearchResult>> results;
+        std::vector<SearchResult*> result_ptrs;
+        for (int64_t i = 0; i < state.range(2); ++i) {
+            results.push_back(segments[i]->Search(
+                plan.get(), ph_group.get(), MAX_TIMESTAMP));
+            result_ptrs.push_back(results.back().get());
+        }
+        state.ResumeTiming();
+
+        ReduceHelper reduce_helper(
+            result_ptrs, plan.get(), &nq, &topk, 1, nullptr);
+        reduce_helper.Reduce();
+        reduce_helper.Marshal();
+        auto blobs = std::unique_ptr<SearchResultDataBlobs>(
+            static_cast<SearchResultDataBlobs*>(
+                reduce_helper.GetSearchResultDataBlobs()));
+        benchmark::DoNotOptimize(blobs);
+
+        state.PauseTiming();
+        blobs.reset();
+        results.clear();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * nq * topk * state.range(2));
+}
+
+}  // namespace
+
+BENCHMARK(Reduce_Sealed)->ArgsProduct({{1, 16, 128}, {10, 100}, {2, 8}});
@@ -0,0 +1,71 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <cstdint>
+#include <benchmark/benchmark.h>
+#include <string>
+#include "segcore/SegmentSealed.h"
+#include "test_utils/DataGen.h"
+
+using namespace milvus;
+using namespace milvus::query;
+using namespace milvus::segcore;
+
+namespace {
+
+// 20 output fields of fixed and variable width
+const auto wide_schema = []() {
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto pk_fid = schema->AddDebugField("pk", DataType::INT64);
+    schema->set_primary_field_id(pk_fid);
+    for (int i = 0; i < 5; ++i) {
+        auto suffix = std::to_string(i);
+        schema->AddDebugField("int64_" + suffix, DataType::INT64);
+        schema->AddDebugField("double_" + suffix, DataType::DOUBLE);
+        schema->AddDebugField("varchar_" + suffix, DataType::VARCHAR);
+        schema->AddDebugField("json_" + suffix, DataType::JSON);
+    }
+    return schema;
+}();
+
+}  // namespace
+
+static void
+Retrieve_WideSchema(benchmark::State& state) {
+    static int64_t N = 64 * 1024;
+    static auto segment = [] {
+        auto segment = CreateSealedSegment(wide_schema);
+        SealedLoadFieldData(DataGen(wide_schema, N), *segment);
+        return segment;
+    }();
+
+    auto plan = std::make_unique<RetrievePlan>(*wide_schema);
+    for (auto& [field_id, field_meta] : wide_schema->get_fields()) {
+        if (!IsVectorDataType(field_meta.get_data_type())) {
+            plan->field_ids_.push_back(field_id);
+        }
+    }
+    // every fourth row, in the order of the segment
+    std::vector<int64_t> offsets(state.range(0));
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        offsets[i] = i * 4 % N;
+    }
+
+    for (auto _ : state) {
+        auto results = segment->Retrieve(
+            nullptr, plan.get(), offsets.data(), offsets.size());
+        benchmark::DoNotOptimize(results);
+    }
+}
+
+BENCHMARK(Retrieve_WideSchema)->Arg(1024)->Arg(16 * 1024);
@@ -0,0 +1,112 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench/bench_utils.h"
+
+using namespace milvus;
+using namespace milvus::segcore;
+
+namespace {
+
+constexpr int64_t kNumBatches = 4;
+constexpr int64_t kBatchRows = 16 * 1024;
+
+// a field of every data type read by retrieves
+const auto subscript_schema = []() {
+    auto schema = std::make_shared<Schema>();
+    auto pk_fid = schema->AddDebugField("pk", DataType::INT64);
+    schema->set_primary_field_id(pk_fid);
+    schema->AddDebugField("bool", DataType::BOOL);
+    schema->AddDebugField("int8", DataType::INT8);
+    schema->AddDebugField("int16", DataType::INT16);
+    schema->AddDebugField("int32", DataType::INT32);
+    schema->AddDebugField("float", DataType::FLOAT);
+    schema->AddDebugField("double", DataType::DOUBLE);
+    schema->AddDebugField("varchar", DataType::VARCHAR);
+    schema->AddDebugField("json", DataType::JSON);
+    schema->AddDebugField("array", DataType::ARRAY, DataType::INT64);
+    schema->AddDebugField(
+        "float_vector", DataType::VECTOR_FLOAT, 128, knowhere::metric::L2);
+    schema->AddDebugField("binary_vector",
+                          DataType::VECTOR_BINARY,
+                          128,
+                          knowhere::metric::JACCARD);
+    schema->AddDebugField(
+        "float16_vector", DataType::VECTOR_FLOAT16, 128, knowhere::metric::L2);
+    return schema;
+}();
+
+const SegmentInternalInterface*
+SubscriptSegment(BenchSegmentKind kind) {
+    static const auto batches =
+        BenchDataGen(subscript_schema, kNumBatches, kBatchRows);
+    static std::map<BenchSegmentKind,
+                    std::unique_ptr<SegmentInternalInterface>>
+        segments;
+    auto& segment = segments[kind];
+    if (segment == nullptr) {
+        segment = CreateBenchSegment(kind, subscript_schema, batches);
+    }
+    return segment.get();
+}
+
+// reads the field of range(0) random rows, in no particular order as the
+// rows of a retrieve in pk order
+void
+BulkSubscript(benchmark::State& state,
+              BenchSegmentKind kind,
+              FieldId field_id) {
+    auto segment = SubscriptSegment(kind);
+    std::vector<int64_t> offsets(state.range(0));
+    std::default_random_engine random(42);
+    std::uniform_int_distribution<int64_t> distribution(
+        0, kNumBatches * kBatchRows - 1);
+    std::generate(offsets.begin(), offsets.end(), [&]() {
+        return distribution(random);
+    });
+
+    for (auto _ : state) {
+        auto data =
+            segment->bulk_subscript(field_id, offsets.data(), offsets.size());
+        benchmark::DoNotOptimize(data);
+    }
+    state.SetItemsProcessed(state.iterations() * offsets.size());
+}
+
+// BulkSubscript/<data type>/<segment kind>/<number of rows>
+const auto registered = []() {
+    for (auto& [field_id, field_meta] : subscript_schema->get_fields()) {
+        if (SystemProperty::Instance().IsSystem(field_id)) {
+            continue;
+        }
+        for (auto kind : kBenchSegmentKinds) {
+            auto name = "BulkSubscript/" +
+                        GetDataTypeName(field_meta.get_data_type()) + "/" +
+                        BenchSegmentKindName(kind);
+            benchmark::RegisterBenchmark(
+                name.c_str(), BulkSubscript, kind, field_id)
+                ->Arg(1024)
+                ->Arg(16 * 1024);
+        }
+    }
+    return true;
+}();
+
+}  // namespace
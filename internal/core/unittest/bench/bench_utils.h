@@ -0,0 +1,221 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "segcore/SegcoreConfig.h"
+#include "segcore/SegmentGrowingImpl.h"
+#include "segcore/SegmentSealedImpl.h"
+#include "storage/DataCodec.h"
+#include "storage/InsertData.h"
+#include "test_utils/DataGen.h"
+
+namespace milvus::segcore {
+
+// the kinds of segments the benchmarks run on, with the same rows
+enum class BenchSegmentKind {
+    SEALED = 0,
+    CHUNKED = 1,
+    MMAP = 2,
+    GROWING = 3,
+};
+
+constexpr BenchSegmentKind kBenchSegmentKinds[] = {BenchSegmentKind::SEALED,
+                                                   BenchSegmentKind::CHUNKED,
+                                                   BenchSegmentKind::MMAP,
+                                                   BenchSegmentKind::GROWING};
+
+constexpr char kBenchMmapPath[] = "/tmp/milvus/bench_mmap";
+
+inline std::string
+BenchSegmentKindName(BenchSegmentKind kind) {
+    switch (kind) {
+        case BenchSegmentKind::SEALED:
+            return "Sealed";
+        case BenchSegmentKind::CHUNKED:
+            return "Chunked";
+        case BenchSegmentKind::MMAP:
+            return "Mmap";
+        case BenchSegmentKind::GROWING:
+            return "Growing";
+    }
+    return "Unknown";
+}
+
+// the rows of a benchmark segment, generated in batches, one binlog each
+inline std::vector<GeneratedData>
+BenchDataGen(SchemaPtr schema, int64_t num_batches, int64_t batch_rows) {
+    std::vector<GeneratedData> batches;
+    batches.reserve(num_batches);
+    for (int64_t i = 0; i < num_batches; ++i) {
+        batches.push_back(DataGen(schema, batch_rows, 42 + i, i * batch_rows));
+    }
+    return batches;
+}
+
+// the batches of a field as the field data of its binlogs, system fields
+// included
+inline std::vector<FieldDataPtr>
+BenchFieldData(const std::vector<GeneratedData>& batches, FieldId field_id) {
+    std::vector<FieldDataPtr> field_datas;
+    for (auto& batch : batches) {
+        auto row_count = batch.row_ids_.size();
+        if (field_id == RowFieldID || field_id == TimestampFieldID) {
+            auto field_data = std::make_shared<milvus::FieldData<int64_t>>(
+                DataType::INT64, false);
+            auto data = field_id == RowFieldID
+                            ? batch.row_ids_.data()
+                            : reinterpret_cast<const int64_t*>(
+                                  batch.timestamps_.data());
+            field_data->FillFieldData(data, row_count);
+            field_datas.push_back(field_data);
+            continue;
+        }
+        for (auto& data : batch.raw_->fields_data()) {
+            if (data.field_id() == field_id.get()) {
+                auto& field_meta = batch.schema_->operator[](field_id);
+                field_datas.push_back(
+                    CreateFieldDataFromDataArray(row_count, &data, field_meta));
+            }
+        }
+    }
+    return field_datas;
+}
+
+// the binlogs of a field decoded into the arrow readers chunked segments
+// load, as the loads of segment_c do
+inline std::vector<std::shared_ptr<ArrowDataWrapper>>
+BenchArrowReaders(const std::vector<FieldDataPtr>& field_datas,
+                  FieldId field_id) {
+    std::vector<std::shared_ptr<ArrowDataWrapper>> readers;
+    for (auto& field_data : field_datas) {
+        storage::InsertData insert_data(field_data);
+        insert_data.SetFieldDataMeta({1, 2, 3, field_id.get()});
+        auto serialized = insert_data.serialize_to_remote_file();
+        auto buf = std::shared_ptr<uint8_t[]>(new uint8_t[serialized.size()]);
+        std::copy(serialized.begin(), serialized.end(), buf.get());
+        auto codec =
+            storage::DeserializeFileData(buf, serialized.size(), false);
+        codec->SetData(buf);
+        readers.push_back(codec->GetReader());
+    }
+    return readers;
+}
+
+inline std::vector<FieldId>
+BenchLoadFieldIds(const SchemaPtr& schema) {
+    std::vector<FieldId> field_ids{RowFieldID, TimestampFieldID};
+    for (auto& [field_id, field_meta] : schema->get_fields()) {
+        if (!SystemProperty::Instance().IsSystem(field_id)) {
+            field_ids.push_back(field_id);
+        }
+    }
+    return field_ids;
+}
+
+// loads the field data into a sealed segment, into mmapped files if
+// with_mmap
+inline void
+BenchLoadSealed(SegmentSealed& segment,
+                FieldId field_id,
+                const std::vector<FieldDataPtr>& field_datas,
+                int64_t row_count,
+                bool with_mmap) {
+    FieldDataInfo info(field_id.get(), row_count, field_datas);
+    if (with_mmap && !SystemProperty::Instance().IsSystem(field_id)) {
+        info.mmap_dir_path = kBenchMmapPath;
+        segment.MapFieldData(field_id, info);
+    } else {
+        segment.LoadFieldData(field_id, info);
+    }
+}
+
+// loads the arrow readers into a chunked segment, into mmapped files if
+// with_mmap
+inline void
+BenchLoadChunked(
+    SegmentSealed& segment,
+    FieldId field_id,
+    const std::vector<std::shared_ptr<ArrowDataWrapper>>& readers,
+    int64_t row_count,
+    bool with_mmap) {
+    FieldDataInfo info(field_id.get(), row_count, readers);
+    if (with_mmap && !SystemProperty::Instance().IsSystem(field_id)) {
+        info.mmap_dir_path = kBenchMmapPath;
+        segment.MapFieldData(field_id, info);
+    } else {
+        segment.LoadFieldData(field_id, info);
+    }
+}
+
+// a segment of the kind holding the batches. Sealed and mmap segments are
+// SegmentSealedImpl, the mmap one maps its fields to files, chunked ones
+// are ChunkedSegmentSealedImpl with a chunk per batch.
+inline std::unique_ptr<SegmentInternalInterface>
+CreateBenchSegment(BenchSegmentKind kind,
+                   SchemaPtr schema,
+                   const std::vector<GeneratedData>& batches) {
+    int64_t row_count = 0;
+    for (auto& batch : batches) {
+        row_count += batch.row_ids_.size();
+    }
+    if (kind == BenchSegmentKind::GROWING) {
+        auto segment = CreateGrowingSegment(schema, empty_index_meta);
+        for (auto& batch : batches) {
+            auto offset = segment->PreInsert(batch.row_ids_.size());
+            segment->Insert(offset,
+                            batch.row_ids_.size(),
+                            batch.row_ids_.data(),
+                            batch.timestamps_.data(),
+                            batch.raw_);
+        }
+        return segment;
+    }
+
+    auto chunked = kind == BenchSegmentKind::CHUNKED;
+    auto segment = CreateSealedSegment(schema,
+                                       nullptr,
+                                       0,
+                                       SegcoreConfig::default_config(),
+                                       false,
+                                       false,
+                                       chunked);
+    for (auto field_id : BenchLoadFieldIds(schema)) {
+        auto field_datas = BenchFieldData(batches, field_id);
+        if (chunked) {
+            BenchLoadChunked(*segment,
+                             field_id,
+                             BenchArrowReaders(field_datas, field_id),
+                             row_count,
+                             false);
+        } else {
+            BenchLoadSealed(*segment,
+                            field_id,
+                            field_datas,
+                            row_count,
+                            kind == BenchSegmentKind::MMAP);
+        }
+    }
+    return segment;
+}
+
+// repeated filters of sealed segments would hit the filter result cache
+inline void
+DisableFilterCache() {
+    SegcoreConfig::default_config().set_filter_cache_capacity(0);
+}
+
+}  // namespace milvus::segcore
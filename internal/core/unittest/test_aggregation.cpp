@@ -0,0 +1,272 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <google/protobuf/text_format.h>
+
+#include <limits>
+#include <map>
+#include <set>
+
+#include "pb/plan.pb.h"
+#include "query/PlanProto.h"
+#include "segcore/reduce/AggregateReduce.h"
+#include "test_utils/DataGen.h"
+
+using namespace milvus;
+using namespace milvus::query;
+using namespace milvus::segcore;
+
+namespace {
+
+std::unique_ptr<RetrievePlan>
+ParseRetrievePlan(const Schema& schema, const std::string& text) {
+    proto::plan::PlanNode plan_node;
+    auto ok =
+        google::protobuf::TextFormat::ParseFromString(text, &plan_node);
+    AssertInfo(ok, "invalid plan: {}", text);
+    return ProtoParser(schema).CreateRetrievePlan(plan_node);
+}
+
+}  // namespace
+
+TEST(Aggregation, GroupByMergedSegments) {
+    auto schema = std::make_shared<Schema>();
+    auto pk_fid = schema->AddDebugField("pk", DataType::INT64);
+    auto flag_fid = schema->AddDebugField("flag", DataType::BOOL);
+    auto tag_fid = schema->AddDebugField("tag", DataType::INT8);
+    auto i32_fid = schema->AddDebugField("i32", DataType::INT32);
+    auto double_fid = schema->AddDebugField("double", DataType::DOUBLE);
+    auto str_fid = schema->AddDebugField("str", DataType::VARCHAR);
+    schema->AddDebugField(
+        "vec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    schema->set_primary_field_id(pk_fid);
+
+    int64_t N = 3000;
+    auto sealed_data = DataGen(schema, N, 42);
+    auto sealed = CreateSealedSegment(schema);
+    SealedLoadFieldData(sealed_data, *sealed);
+    auto growing_data = DataGen(schema, N, 43);
+    auto growing = CreateGrowingSegment(schema, empty_index_meta);
+    growing->PreInsert(N);
+    growing->Insert(0,
+                    N,
+                    growing_data.row_ids_.data(),
+                    growing_data.timestamps_.data(),
+                    growing_data.raw_);
+
+    auto plan = ParseRetrievePlan(
+        *schema,
+        fmt::format(R"(query: <
+            aggregates: < op: Count >
+            aggregates: < op: Sum field_id: {} >
+            aggregates: < op: Min field_id: {} >
+            aggregates: < op: Max field_id: {} >
+            aggregates: < op: Avg field_id: {} >
+            aggregates: < op: CountDistinct field_id: {} >
+            group_by_field_ids: {}
+            group_by_field_ids: {}
+        >)",
+                    i32_fid.get(),
+                    double_fid.get(),
+                    pk_fid.get(),
+                    double_fid.get(),
+                    str_fid.get(),
+                    flag_fid.get(),
+                    tag_fid.get()));
+    auto node = plan->plan_node_->aggregation_;
+    ASSERT_NE(node, nullptr);
+
+    struct Expected {
+        int64_t count = 0;
+        int64_t sum = 0;
+        double min = std::numeric_limits<double>::max();
+        int64_t max = std::numeric_limits<int64_t>::min();
+        double double_sum = 0;
+        std::set<std::string> distincts;
+    };
+    std::map<std::pair<bool, int64_t>, Expected> expected;
+    for (auto dataset : {&sealed_data, &growing_data}) {
+        auto pks = dataset->get_col<int64_t>(pk_fid);
+        auto flags = dataset->get_col<bool>(flag_fid);
+        auto tags = dataset->get_col<int8_t>(tag_fid);
+        auto i32s = dataset->get_col<int32_t>(i32_fid);
+        auto doubles = dataset->get_col<double>(double_fid);
+        auto strs = dataset->get_col(str_fid)->scalars().string_data().data();
+        for (int64_t i = 0; i < N; ++i) {
+            auto& group = expected[{flags[i], tags[i]}];
+            ++group.count;
+            group.sum += i32s[i];
+            group.min = std::min(group.min, doubles[i]);
+            group.max = std::max(group.max, pks[i]);
+            group.double_sum += doubles[i];
+            group.distincts.insert(strs[i]);
+        }
+    }
+
+    std::vector<std::unique_ptr<proto::segcore::RetrieveResults>> results;
+    for (auto segment : std::vector<SegmentInternalInterface*>{
+             sealed.get(),
+             dynamic_cast<SegmentInternalInterface*>(growing.get())}) {
+        results.push_back(segment->Retrieve(nullptr,
+                                            plan.get(),
+                                            MAX_TIMESTAMP,
+                                            DEFAULT_MAX_OUTPUT_SIZE,
+                                            false));
+    }
+    auto merged =
+        MergePartialAggregates(node, {results[0].get(), results[1].get()});
+    auto output = FinalizeAggregates(node, merged);
+    ASSERT_EQ(output.size(), 8);
+
+    auto& flags = output[0].scalars().bool_data().data();
+    auto& tags = output[1].scalars().int_data().data();
+    ASSERT_EQ(flags.size(), static_cast<int>(expected.size()));
+    for (int i = 0; i < flags.size(); ++i) {
+        auto it = expected.find({flags[i], tags[i]});
+        ASSERT_NE(it, expected.end());
+        auto& group = it->second;
+        EXPECT_EQ(output[2].scalars().long_data().data(i), group.count);
+        EXPECT_EQ(output[3].scalars().long_data().data(i), group.sum);
+        EXPECT_EQ(output[4].scalars().double_data().data(i), group.min);
+        EXPECT_EQ(output[5].scalars().long_data().data(i), group.max);
+        EXPECT_NEAR(output[6].scalars().double_data().data(i),
+                    group.double_sum / group.count,
+                    1e-6);
+        EXPECT_EQ(output[7].scalars().long_data().data(i),
+                  static_cast<int64_t>(group.distincts.size()));
+    }
+}
+
+TEST(Aggregation, FilteredWithEmptySegment) {
+    auto schema = std::make_shared<Schema>();
+    auto pk_fid = schema->AddDebugField("pk", DataType::INT64);
+    auto i32_fid = schema->AddDebugField("i32", DataType::INT32);
+    schema->AddDebugField(
+        "vec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    schema->set_primary_field_id(pk_fid);
+
+    int64_t N = 1000;
+    auto dataset = DataGen(schema, N);
+    auto sealed = CreateSealedSegment(schema);
+    SealedLoadFieldData(dataset, *sealed);
+    auto empty = CreateGrowingSegment(schema, empty_index_meta);
+
+    auto plan = ParseRetrievePlan(
+        *schema,
+        fmt::format(R"(query: <
+            predicates: <
+                unary_range_expr: <
+                    column_info: < field_id: {} data_type: Int64 >
+                    op: LessThan
+                    value: < int64_val: {} >
+                >
+            >
+            aggregates: < op: Count >
+            aggregates: < op: Sum field_id: {} >
+        >)",
+                    pk_fid.get(),
+                    N / 2,
+                    i32_fid.get()));
+    auto node = plan->plan_node_->aggregation_;
+
+    auto empty_result = empty->Retrieve(
+        nullptr, plan.get(), MAX_TIMESTAMP, DEFAULT_MAX_OUTPUT_SIZE, false);
+    auto empty_output = FinalizeAggregates(
+        node,
+        MergePartialAggregates(node, {empty_result.get()}));
+    ASSERT_EQ(empty_output[0].scalars().long_data().data(0), 0);
+    // the sum of no value is null
+    ASSERT_FALSE(empty_output[1].valid_data(0));
+
+    auto pks = dataset.get_col<int64_t>(pk_fid);
+    auto i32s = dataset.get_col<int32_t>(i32_fid);
+    int64_t count = 0;
+    int64_t sum = 0;
+    for (int64_t i = 0; i < N; ++i) {
+        if (pks[i] < N / 2) {
+            ++count;
+            sum += i32s[i];
+        }
+    }
+    auto result = sealed->Retrieve(
+        nullptr, plan.get(), MAX_TIMESTAMP, DEFAULT_MAX_OUTPUT_SIZE, false);
+    auto output = FinalizeAggregates(
+        node,
+        MergePartialAggregates(node, {result.get(), empty_result.get()}));
+    ASSERT_EQ(output[0].scalars().long_data().data(0), count);
+    ASSERT_EQ(output[1].scalars().long_data().data(0), sum);
+    ASSERT_TRUE(output[1].valid_data(0));
+}
+
+TEST(Aggregation, IndexedFieldsWithoutFieldData) {
+    auto schema = std::make_shared<Schema>();
+    auto pk_fid = schema->AddDebugField("pk", DataType::INT64);
+    auto tag_fid = schema->AddDebugField("tag", DataType::INT32);
+    auto str_fid = schema->AddDebugField("str", DataType::VARCHAR);
+    schema->AddDebugField(
+        "vec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    schema->set_primary_field_id(pk_fid);
+
+    int64_t N = 3000;
+    auto dataset = DataGen(schema, N);
+    auto sealed = CreateSealedSegment(schema);
+    // the sort indexes keep the raw data, so no field data is loaded
+    SealedLoadFieldData(dataset, *sealed, {tag_fid.get(), str_fid.get()});
+    auto tags = dataset.get_col<int32_t>(tag_fid);
+    LoadIndexInfo tag_index;
+    tag_index.field_id = tag_fid.get();
+    tag_index.field_type = DataType::INT32;
+    tag_index.index_params["index_type"] = "sort";
+    tag_index.index = GenScalarIndexing<int32_t>(N, tags.data());
+    sealed->LoadIndex(tag_index);
+    auto strs = dataset.get_col<std::string>(str_fid);
+    LoadIndexInfo str_index;
+    str_index.field_id = str_fid.get();
+    str_index.field_type = DataType::VARCHAR;
+    str_index.index_params["index_type"] = "sort";
+    str_index.index = GenScalarIndexing<std::string>(N, strs.data());
+    sealed->LoadIndex(str_index);
+    ASSERT_FALSE(sealed->HasFieldData(tag_fid));
+    ASSERT_FALSE(sealed->HasFieldData(str_fid));
+
+    auto plan = ParseRetrievePlan(
+        *schema,
+        fmt::format(R"(query: <
+            aggregates: < op: Count >
+            aggregates: < op: CountDistinct field_id: {} >
+            group_by_field_ids: {}
+        >)",
+                    str_fid.get(),
+                    tag_fid.get()));
+    auto node = plan->plan_node_->aggregation_;
+
+    std::map<int32_t, std::pair<int64_t, std::set<std::string>>> expected;
+    for (int64_t i = 0; i < N; ++i) {
+        auto& group = expected[tags[i]];
+        ++group.first;
+        group.second.insert(strs[i]);
+    }
+    auto result = sealed->Retrieve(
+        nullptr, plan.get(), MAX_TIMESTAMP, DEFAULT_MAX_OUTPUT_SIZE, false);
+    auto output =
+        FinalizeAggregates(node, MergePartialAggregates(node, {result.get()}));
+    ASSERT_EQ(output.size(), 3);
+    auto& groups = output[0].scalars().int_data().data();
+    ASSERT_EQ(groups.size(), static_cast<int>(expected.size()));
+    for (int i = 0; i < groups.size(); ++i) {
+        auto it = expected.find(groups[i]);
+        ASSERT_NE(it, expected.end());
+        EXPECT_EQ(output[1].scalars().long_data().data(i), it->second.first);
+        EXPECT_EQ(output[2].scalars().long_data().data(i),
+                  static_cast<int64_t>(it->second.second.size()));
+    }
+}
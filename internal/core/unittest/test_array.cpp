@@ -48,9 +48,10 @@ TEST(Array, TestConstructArray) {
     ASSERT_EQ(int_array.length(), int_16_array.length());
     ASSERT_TRUE(int_array_tmp == int_array);
     auto int_array_view = ArrayView(const_cast<char*>(int_array.data()),
+                                    int_array.length(),
                                     int_array.byte_size(),
                                     int_array.get_element_type(),
-                                    {});
+                                    nullptr);
     ASSERT_EQ(int_array.length(), int_array_view.length());
     ASSERT_EQ(int_array.byte_size(), int_array_view.byte_size());
     ASSERT_EQ(int_array.get_element_type(), int_array_view.get_element_type());
@@ -75,9 +76,10 @@ TEST(Array, TestConstructArray) {
                                 {});
     ASSERT_TRUE(long_array_tmp == long_array);
     auto long_array_view = ArrayView(const_cast<char*>(long_array.data()),
+                                     long_array.length(),
                                      long_array.byte_size(),
                                      long_array.get_element_type(),
-                                     {});
+                                     nullptr);
     ASSERT_EQ(long_array.length(), long_array_view.length());
     ASSERT_EQ(long_array.byte_size(), long_array_view.byte_size());
     ASSERT_EQ(long_array.get_element_type(),
@@ -112,11 +114,16 @@ TEST(Array, TestConstructArray) {
                                   std::move(string_element_offsets));
     ASSERT_TRUE(string_array_tmp == string_array);
     auto string_array_view = ArrayView(const_cast<char*>(string_array.data()),
+                                       string_array.length(),
                                        string_array.byte_size(),
                                        string_array.get_element_type(),
-                                       std::move(string_view_element_offsets));
+                                       string_view_element_offsets.data());
     ASSERT_EQ(string_array.length(), string_array_view.length());
     ASSERT_EQ(string_array.byte_size(), string_array_view.byte_size());
+    for (int i = 0; i < N; ++i) {
+        ASSERT_EQ(string_array_view.get_data<std::string_view>(i),
+                  std::to_string(i));
+    }
     ASSERT_EQ(string_array.get_element_type(),
               string_array_view.get_element_type());
 
@@ -140,9 +147,10 @@ TEST(Array, TestConstructArray) {
                                 {});
     ASSERT_TRUE(bool_array_tmp == bool_array);
     auto bool_array_view = ArrayView(const_cast<char*>(bool_array.data()),
+                                     bool_array.length(),
                                      bool_array.byte_size(),
                                      bool_array.get_element_type(),
-                                     {});
+                                     nullptr);
     ASSERT_EQ(bool_array.length(), bool_array_view.length());
     ASSERT_EQ(bool_array.byte_size(), bool_array_view.byte_size());
     ASSERT_EQ(bool_array.get_element_type(),
@@ -168,9 +176,10 @@ TEST(Array, TestConstructArray) {
                                  {});
     ASSERT_TRUE(float_array_tmp == float_array);
     auto float_array_view = ArrayView(const_cast<char*>(float_array.data()),
+                                      float_array.length(),
                                       float_array.byte_size(),
                                       float_array.get_element_type(),
-                                      {});
+                                      nullptr);
     ASSERT_EQ(float_array.length(), float_array_view.length());
     ASSERT_EQ(float_array.byte_size(), float_array_view.byte_size());
     ASSERT_EQ(float_array.get_element_type(),
@@ -197,9 +206,10 @@ TEST(Array, TestConstructArray) {
                                   {});
     ASSERT_TRUE(double_array_tmp == double_array);
     auto double_array_view = ArrayView(const_cast<char*>(double_array.data()),
+                                       double_array.length(),
                                        double_array.byte_size(),
                                        double_array.get_element_type(),
-                                       {});
+                                       nullptr);
     ASSERT_EQ(double_array.length(), double_array_view.length());
     ASSERT_EQ(double_array.byte_size(), double_array_view.byte_size());
     ASSERT_EQ(double_array.get_element_type(),
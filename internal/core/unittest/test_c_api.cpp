@@ -69,7 +69,7 @@ CRetrieve(CSegmentInterface c_segment,
           uint64_t timestamp,
           CRetrieveResult** result) {
     auto future = AsyncRetrieve(
-        {}, c_segment, c_plan, timestamp, DEFAULT_MAX_OUTPUT_SIZE, false);
+        {}, c_segment, c_plan, timestamp, DEFAULT_MAX_OUTPUT_SIZE, false, 0);
     auto futurePtr = static_cast<milvus::futures::IFuture*>(
         static_cast<void*>(static_cast<CFuture*>(future)));
 
@@ -1673,6 +1673,7 @@ TEST(CApiTest, ReduceNullResult) {
         ASSERT_EQ(status.error_code, Success);
         results.push_back(res);
         CSearchResultDataBlobs cSearchResultData;
+        // a reduce past its deadline stops before it touches the results
         status = ReduceSearchResultsAndFillData({},
                                                 &cSearchResultData,
                                                 plan,
@@ -1680,7 +1681,19 @@ TEST(CApiTest, ReduceNullResult) {
                                                 results.size(),
                                                 slice_nqs.data(),
                                                 slice_topKs.data(),
-                                                slice_nqs.size());
+                                                slice_nqs.size(),
+                                                1);
+        ASSERT_EQ(status.error_code, FollyCancel);
+        free((char*)status.error_msg);
+        status = ReduceSearchResultsAndFillData({},
+                                                &cSearchResultData,
+                                                plan,
+                                                results.data(),
+                                                results.size(),
+                                                slice_nqs.data(),
+                                                slice_topKs.data(),
+                                                slice_nqs.size(),
+                                                0);
         ASSERT_EQ(status.error_code, Success);
 
         auto search_result = (SearchResult*)results[0];
@@ -1774,7 +1787,8 @@ TEST(CApiTest, ReduceRemoveDuplicates) {
                                                 results.size(),
                                                 slice_nqs.data(),
                                                 slice_topKs.data(),
-                                                slice_nqs.size());
+                                                slice_nqs.size(),
+                                                0);
         ASSERT_EQ(status.error_code, Success);
         // TODO:: insert no duplicate pks and check reduce results
         CheckSearchResultDuplicate(results);
@@ -1811,7 +1825,8 @@ TEST(CApiTest, ReduceRemoveDuplicates) {
                                                 results.size(),
                                                 slice_nqs.data(),
                                                 slice_topKs.data(),
-                                                slice_nqs.size());
+                                                slice_nqs.size(),
+                                                0);
         ASSERT_EQ(status.error_code, Success);
         // TODO:: insert no duplicate pks and check reduce results
         CheckSearchResultDuplicate(results);
@@ -1955,7 +1970,8 @@ testReduceSearchWithExpr(int N,
                                             results.size(),
                                             slice_nqs.data(),
                                             slice_topKs.data(),
-                                            slice_nqs.size());
+                                            slice_nqs.size(),
+                                            0);
     ASSERT_EQ(status.error_code, Success);
 
     auto search_result_data_blobs =
@@ -3650,7 +3666,8 @@ TEST(CApiTest, Indexing_With_binary_Predicate_Term) {
                                             results.size(),
                                             slice_nqs.data(),
                                             slice_topKs.data(),
-                                            slice_nqs.size());
+                                            slice_nqs.size(),
+                                            0);
     ASSERT_EQ(status.error_code, Success);
 
     //    status = ReduceSearchResultsAndFillData(plan, results.data(), results.size());
@@ -3847,7 +3864,8 @@ TEST(CApiTest, Indexing_Expr_With_binary_Predicate_Term) {
                                             results.size(),
                                             slice_nqs.data(),
                                             slice_topKs.data(),
-                                            slice_nqs.size());
+                                            slice_nqs.size(),
+                                            0);
     ASSERT_EQ(status.error_code, Success);
 
     auto search_result_on_bigIndex = (SearchResult*)c_search_result_on_bigIndex;
@@ -321,4 +321,144 @@ TEST(CApiTest, StreamReduceGroupBY) {
     DeleteSegment(segment);
     DeleteStreamSearchReducer(c_search_stream_reducer);
     DeleteStreamSearchReducer(nullptr);
-}
\ No newline at end of file
+}
+
+TEST(CApiTest, SearchAndReduce) {
+    int N = 300;
+    int topK = 10;
+    int num_queries = 4;
+    int num_segments = 5;
+    auto collection = NewCollection(get_default_schema_config());
+    auto schema = ((milvus::segcore::Collection*)collection)->get_schema();
+
+    std::vector<CSegmentInterface> segments(num_segments);
+    for (int i = 0; i < num_segments; i++) {
+        auto status = NewSegment(collection, Growing, i, &segments[i], false);
+        ASSERT_EQ(status.error_code, Success);
+        auto dataset = DataGen(schema, N, 42 + i, i * N, 1, 10, true);
+        int64_t offset;
+        PreInsert(segments[i], N, &offset);
+        auto insert_data = serialize(dataset.raw_);
+        status = Insert(segments[i],
+                        offset,
+                        N,
+                        dataset.row_ids_.data(),
+                        dataset.timestamps_.data(),
+                        insert_data.data(),
+                        insert_data.size());
+        ASSERT_EQ(status.error_code, Success);
+    }
+
+    auto fmt = boost::format(R"(vector_anns: <
+                                            field_id: 100
+                                            query_info: <
+                                                topk: %1%
+                                                metric_type: "L2"
+                                                search_params: "{\"nprobe\": 10}"
+                                            >
+                                            placeholder_tag: "$0">
+                                            output_field_ids: 100)") %
+               topK;
+    auto serialized_expr_plan = fmt.str();
+    auto blob = generate_query_data(num_queries);
+    void* plan = nullptr;
+    auto binary_plan =
+        translate_text_plan_to_binary_plan(serialized_expr_plan.data());
+    auto status = CreateSearchPlanByExpr(
+        collection, binary_plan.data(), binary_plan.size(), &plan);
+    ASSERT_EQ(status.error_code, Success);
+    void* placeholderGroup = nullptr;
+    status = ParsePlaceholderGroup(
+        plan, blob.data(), blob.length(), &placeholderGroup);
+    ASSERT_EQ(status.error_code, Success);
+
+    auto slice_nqs = std::vector<int64_t>{num_queries / 2, num_queries / 2};
+    auto slice_topKs = std::vector<int64_t>{topK, topK};
+
+    // the segments searched one by one and reduced by the stream reducer
+    CSearchStreamReducer c_search_stream_reducer;
+    status = NewStreamReducer(plan,
+                              slice_nqs.data(),
+                              slice_topKs.data(),
+                              slice_nqs.size(),
+                              &c_search_stream_reducer);
+    ASSERT_EQ(status.error_code, Success);
+    std::vector<CSearchResult> results(num_segments);
+    for (int i = 0; i < num_segments; i++) {
+        status = CSearch(segments[i],
+                         plan,
+                         placeholderGroup,
+                         MAX_TIMESTAMP,
+                         &results[i]);
+        ASSERT_EQ(status.error_code, Success);
+        status = StreamReduce(c_search_stream_reducer, &results[i], 1);
+        ASSERT_EQ(status.error_code, Success);
+    }
+    CSearchResultDataBlobs expected_blobs;
+    status = GetStreamReduceResult(c_search_stream_reducer, &expected_blobs);
+    ASSERT_EQ(status.error_code, Success);
+
+    auto search_and_reduce = [&](int64_t deadline_ms) {
+        auto future = AsyncSearchAndReduce({},
+                                           segments.data(),
+                                           num_segments,
+                                           plan,
+                                           placeholderGroup,
+                                           MAX_TIMESTAMP,
+                                           deadline_ms,
+                                           slice_nqs.data(),
+                                           slice_topKs.data(),
+                                           slice_nqs.size());
+        auto futurePtr = static_cast<milvus::futures::IFuture*>(
+            static_cast<void*>(static_cast<CFuture*>(future)));
+        std::mutex mu;
+        mu.lock();
+        futurePtr->registerReadyCallback(
+            [](CLockedGoMutex* mutex) { ((std::mutex*)(mutex))->unlock(); },
+            (CLockedGoMutex*)(&mu));
+        mu.lock();
+        auto result = futurePtr->leakyGet();
+        future_destroy(future);
+        return result;
+    };
+
+    auto [blobs, search_status] = search_and_reduce(0);
+    ASSERT_EQ(search_status.error_code, Success);
+    auto expected = (SearchResultDataBlobs*)expected_blobs;
+    auto actual = (SearchResultDataBlobs*)blobs;
+    ASSERT_EQ(actual->blobs.size(), slice_nqs.size());
+    for (size_t i = 0; i < slice_nqs.size(); i++) {
+        milvus::proto::schema::SearchResultData expected_data;
+        milvus::proto::schema::SearchResultData actual_data;
+        ASSERT_TRUE(expected_data.ParseFromArray(
+            expected->blobs[i].data(), expected->blobs[i].size()));
+        ASSERT_TRUE(actual_data.ParseFromArray(actual->blobs[i].data(),
+                                               actual->blobs[i].size()));
+        ASSERT_EQ(actual_data.num_queries(), slice_nqs[i]);
+        ASSERT_EQ(actual_data.topks_size(), expected_data.topks_size());
+        for (int j = 0; j < actual_data.topks_size(); j++) {
+            ASSERT_EQ(actual_data.topks(j), expected_data.topks(j));
+        }
+        // ties may be merged in another order, the scores must match
+        ASSERT_EQ(actual_data.scores_size(), expected_data.scores_size());
+        for (int j = 0; j < actual_data.scores_size(); j++) {
+            ASSERT_FLOAT_EQ(actual_data.scores(j), expected_data.scores(j));
+        }
+    }
+    DeleteSearchResultDataBlobs(blobs);
+
+    // past the deadline
+    auto [no_blobs, cancel_status] = search_and_reduce(1);
+    ASSERT_EQ(cancel_status.error_code, milvus::FollyCancel);
+    free((char*)cancel_status.error_msg);
+
+    DeleteSearchResultDataBlobs(expected_blobs);
+    DeleteStreamSearchReducer(c_search_stream_reducer);
+    for (int i = 0; i < num_segments; i++) {
+        DeleteSearchResult(results[i]);
+        DeleteSegment(segments[i]);
+    }
+    DeleteSearchPlan(plan);
+    DeletePlaceholderGroup(placeholderGroup);
+    DeleteCollection(collection);
+}
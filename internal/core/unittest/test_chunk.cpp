@@ -99,6 +99,14 @@ TEST(chunk, test_variable_field) {
     for (size_t i = 0; i < data.size(); ++i) {
         EXPECT_EQ(views.first[i], data[i]);
     }
+
+    auto string_chunk = std::dynamic_pointer_cast<StringChunk>(chunk);
+    EXPECT_EQ(string_chunk->ValidData(), nullptr);
+    auto batch = string_chunk->StringBatch(1, 3);
+    for (size_t i = 0; i < 3; ++i) {
+        EXPECT_EQ(batch[i], data[i + 1]);
+        EXPECT_EQ(batch.value_size(i), data[i + 1].size());
+    }
 }
 
 TEST(chunk, test_null_field) {
@@ -177,9 +185,9 @@ TEST(chunk, test_array) {
                          DataType::STRING,
                          false);
     auto chunk = create_chunk(field_meta, 1, rb_reader);
-    auto span = std::dynamic_pointer_cast<ArrayChunk>(chunk)->Span();
-    EXPECT_EQ(span.row_count(), 1);
-    auto arr = *(ArrayView*)span.data();
+    auto array_chunk = std::dynamic_pointer_cast<ArrayChunk>(chunk);
+    EXPECT_EQ(array_chunk->RowNums(), 1);
+    auto arr = array_chunk->View(0);
     for (size_t i = 0; i < arr.length(); ++i) {
         auto str = arr.get_data<std::string>(i);
         EXPECT_EQ(str, field_string_data.string_data().data(i));
@@ -366,3 +366,114 @@ TEST_F(TestChunkSegment, TestCompareExpr) {
         plan, segment.get(), chunk_num * test_data_count, MAX_TIMESTAMP);
     ASSERT_EQ(chunk_num * test_data_count, final.count());
 }
+
+TEST_F(TestChunkSegment, TestRetrieveByOffsets) {
+    // runs of consecutive rows, one crossing the chunks, and scattered rows,
+    // enough of them for the fields to be filled in parallel
+    std::vector<int64_t> offsets;
+    for (int64_t i = 9000; i < 11000; ++i) {
+        offsets.push_back(i);
+    }
+    for (int64_t i = 0; i < 500; ++i) {
+        offsets.push_back(i * 7919 % (chunk_num * test_data_count));
+    }
+    auto plan = std::make_unique<query::RetrievePlan>(segment->get_schema());
+    plan->field_ids_ = {fields.at("int64"), fields.at("string1")};
+    auto results = segment->Retrieve(
+        nullptr, plan.get(), offsets.data(), offsets.size());
+    ASSERT_EQ(results->fields_data_size(), 2);
+    auto& ints = results->fields_data(0).scalars().long_data();
+    auto& strs = results->fields_data(1).scalars().string_data();
+    ASSERT_EQ(ints.data_size(), offsets.size());
+    ASSERT_EQ(strs.data_size(), offsets.size());
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        EXPECT_EQ(ints.data(i), offsets[i] + 1);
+        EXPECT_EQ(strs.data(i),
+                  "test" + std::to_string(offsets[i] % test_data_count));
+    }
+}
+
+TEST(test_chunk_segment, TestCompareExprUnalignedChunks) {
+    auto schema = std::make_shared<Schema>();
+    auto left_fid = schema->AddDebugField("left", DataType::INT64);
+    auto right_fid = schema->AddDebugField("right", DataType::INT32, true);
+    auto pk_fid = schema->AddDebugField("pk", DataType::INT64);
+    schema->AddField(FieldName("ts"), TimestampFieldID, DataType::INT64);
+    schema->set_primary_field_id(pk_fid);
+    auto segment =
+        segcore::CreateSealedSegment(schema,
+                                     nullptr,
+                                     -1,
+                                     segcore::SegcoreConfig::default_config(),
+                                     false,
+                                     false,
+                                     true);
+
+    // the fields are split into chunks at different rows, and the batches
+    // of the expression cross the chunks of both sides
+    int64_t row_count = 20000;
+    auto load = [&](FieldId fid,
+                    const std::vector<int64_t>& chunk_rows,
+                    auto append) {
+        FieldDataInfo field_info;
+        field_info.field_id = fid.get();
+        field_info.row_count = row_count;
+        int64_t start = 0;
+        for (auto rows : chunk_rows) {
+            auto array = append(start, rows);
+            auto arrow_schema = std::make_shared<arrow::Schema>(
+                arrow::FieldVector(1, arrow::field("f", array->type())));
+            auto record_batch =
+                arrow::RecordBatch::Make(arrow_schema, rows, {array});
+            auto reader = arrow::RecordBatchReader::Make({record_batch});
+            ASSERT_TRUE(reader.ok());
+            field_info.arrow_reader_channel->push(
+                std::make_shared<ArrowDataWrapper>(
+                    reader.ValueOrDie(), nullptr, nullptr));
+            start += rows;
+        }
+        field_info.arrow_reader_channel->close();
+        segment->LoadFieldData(fid, field_info);
+    };
+    auto append_int64 = [](int64_t modulo) {
+        return [modulo](int64_t start, int64_t rows) {
+            arrow::Int64Builder builder;
+            for (int64_t i = start; i < start + rows; ++i) {
+                EXPECT_TRUE(builder.Append(modulo > 0 ? i % modulo : i).ok());
+            }
+            return builder.Finish().ValueOrDie();
+        };
+    };
+    load(left_fid, {3000, 7000, 10000}, append_int64(7));
+    load(right_fid, {12000, 8000}, [](int64_t start, int64_t rows) {
+        arrow::Int32Builder builder;
+        for (int64_t i = start; i < start + rows; ++i) {
+            EXPECT_TRUE((i % 11 == 0 ? builder.AppendNull()
+                                     : builder.Append(i % 5))
+                            .ok());
+        }
+        std::shared_ptr<arrow::Array> array = builder.Finish().ValueOrDie();
+        return array;
+    });
+    load(pk_fid, {row_count}, append_int64(0));
+    load(TimestampFieldID, {row_count}, append_int64(0));
+
+    int64_t expected = 0;
+    for (int64_t i = 0; i < row_count; ++i) {
+        if (i % 11 != 0 && i % 7 < i % 5) {
+            ++expected;
+        }
+    }
+    auto expr =
+        std::make_shared<expr::CompareExpr>(left_fid,
+                                            right_fid,
+                                            DataType::INT64,
+                                            DataType::INT32,
+                                            proto::plan::OpType::LessThan);
+    auto plan =
+        std::make_shared<plan::FilterBitsNode>(DEFAULT_PLANNODE_ID, expr);
+    BitsetType final =
+        query::ExecuteQueryExpr(plan, segment.get(), row_count, MAX_TIMESTAMP);
+    ASSERT_EQ(final.size(), row_count);
+    ASSERT_EQ(final.count(), expected);
+}
@@ -15,11 +15,17 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <random>
 #include <string>
 
 #include "storage/DataCodec.h"
 #include "storage/InsertData.h"
 #include "storage/IndexData.h"
+#include "storage/LocalChunkManagerSingleton.h"
+#include "storage/MultipartUpload.h"
 #include "storage/Util.h"
 #include "common/Consts.h"
 #include "common/Json.h"
@@ -680,6 +686,100 @@ TEST(storage, IndexData) {
     ASSERT_EQ(data, new_data);
 }
 
+TEST(storage, IndexDataMultipart) {
+    auto lcm = storage::LocalChunkManagerSingleton::GetInstance()
+                   .GetChunkManager();
+    auto path = lcm->GetRootPath() + "/index-multipart-test/slice";
+    storage::FieldDataMeta field_data_meta{100, 101, 102, 103};
+    storage::IndexMeta index_meta{102, 103, 104, 1};
+
+    // random bytes don't compress, so the payload spans several parts, the
+    // last one partial
+    std::vector<uint8_t> data(storage::MULTIPART_UPLOAD_PART_SIZE * 3 + 1000);
+    std::mt19937 random(42);
+    std::uniform_int_distribution<int> byte(0, 255);
+    for (auto& b : data) {
+        b = byte(random);
+    }
+    auto [key, size] = storage::EncodeAndUploadIndexSlice(lcm.get(),
+                                                          data.data(),
+                                                          data.size(),
+                                                          index_meta,
+                                                          field_data_meta,
+                                                          path);
+    ASSERT_EQ(key, path);
+    ASSERT_EQ(size, lcm->Size(path));
+    ASSERT_GT(size, storage::MULTIPART_UPLOAD_PART_SIZE * 3);
+
+    auto new_index_data =
+        storage::DownloadAndDecodeRemoteFile(lcm.get(), path, false);
+    ASSERT_EQ(new_index_data->GetCodecType(), storage::IndexDataType);
+    auto new_field_data = new_index_data->GetFieldData();
+    ASSERT_EQ(new_field_data->get_data_type(), storage::DataType::INT8);
+    ASSERT_EQ(new_field_data->Size(), data.size());
+    ASSERT_EQ(memcmp(new_field_data->Data(), data.data(), data.size()), 0);
+    lcm->RemoveDir(lcm->GetRootPath() + "/index-multipart-test");
+}
+
+namespace {
+
+// keeps the parts written to it
+class RecordingMultipartWriter : public storage::MultipartWriter {
+ public:
+    void
+    WritePart(int part_number, const void* buf, uint64_t len) override {
+        std::lock_guard<std::mutex> lck(mutex_);
+        auto bytes = static_cast<const uint8_t*>(buf);
+        parts_[part_number].assign(bytes, bytes + len);
+    }
+
+    void
+    Complete() override {
+        completed_ = true;
+    }
+
+    void
+    Abort() override {
+    }
+
+    std::mutex mutex_;
+    std::map<int, std::vector<uint8_t>> parts_;
+    bool completed_ = false;
+};
+
+}  // namespace
+
+TEST(storage, MultipartOutputStreamParts) {
+    RecordingMultipartWriter writer;
+    std::vector<uint8_t> data(3500);
+    std::iota(data.begin(), data.end(), 0);
+    std::vector<uint8_t> header(10, 0xff);
+    {
+        storage::MultipartOutputStream stream(writer, 1000);
+        for (size_t offset = 0; offset < data.size(); offset += 300) {
+            auto len = std::min<size_t>(300, data.size() - offset);
+            ASSERT_TRUE(stream.Write(data.data() + offset, len).ok());
+        }
+        ASSERT_EQ(stream.Finish(header), header.size() + data.size());
+    }
+    ASSERT_TRUE(writer.completed_);
+
+    // the first part held back with the header in front, then two full
+    // parts and the partial last one
+    ASSERT_EQ(writer.parts_.size(), 4);
+    ASSERT_EQ(writer.parts_[1].size(), header.size() + 1000);
+    ASSERT_EQ(writer.parts_[2].size(), 1000);
+    ASSERT_EQ(writer.parts_[3].size(), 1000);
+    ASSERT_EQ(writer.parts_[4].size(), 500);
+    auto expected = header;
+    expected.insert(expected.end(), data.begin(), data.end());
+    std::vector<uint8_t> uploaded;
+    for (auto& [part_number, part] : writer.parts_) {
+        uploaded.insert(uploaded.end(), part.begin(), part.end());
+    }
+    ASSERT_EQ(uploaded, expected);
+}
+
 TEST(storage, InsertDataStringArray) {
     milvus::proto::schema::ScalarField field_string_data;
     field_string_data.mutable_string_data()->add_data("test_array1");
@@ -0,0 +1,157 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "storage/DiskCacheChunkManager.h"
+#include "storage/LocalChunkManagerSingleton.h"
+
+using namespace std;
+using namespace milvus;
+using namespace milvus::storage;
+
+class DiskCacheChunkManagerTest : public testing::Test {
+ public:
+    void
+    SetUp() override {
+        lcm_ = LocalChunkManagerSingleton::GetInstance().GetChunkManager();
+        remote_dir_ = lcm_->GetRootPath() + "/disk-cache-test-remote/";
+        cache_dir_ = lcm_->GetRootPath() + "/disk-cache-test-cache/";
+        lcm_->RemoveDir(remote_dir_);
+        lcm_->RemoveDir(cache_dir_);
+    }
+
+    void
+    TearDown() override {
+        lcm_->RemoveDir(remote_dir_);
+        lcm_->RemoveDir(cache_dir_);
+    }
+
+    string
+    WriteRemote(const string& name, char value, size_t size) {
+        vector<char> data(size, value);
+        auto path = remote_dir_ + name;
+        lcm_->Write(path, data.data(), data.size());
+        return path;
+    }
+
+ protected:
+    LocalChunkManagerSPtr lcm_;
+    string remote_dir_;
+    string cache_dir_;
+};
+
+TEST_F(DiskCacheChunkManagerTest, ReadThrough) {
+    auto a = WriteRemote("a", 'a', 1000);
+    auto b = WriteRemote("b", 'b', 1000);
+    DiskCacheChunkManager cm(lcm_, cache_dir_, 1 << 20);
+
+    shared_ptr<uint8_t[]> buf;
+    EXPECT_FALSE(cm.IsCached(a));
+    EXPECT_EQ(cm.ReadAll(a, buf), 1000);
+    EXPECT_TRUE(cm.IsCached(a));
+    EXPECT_EQ(buf[999], 'a');
+
+    // served from the cache once the remote file is gone
+    lcm_->Remove(a);
+    buf.reset();
+    EXPECT_EQ(cm.ReadAll(a, buf), 1000);
+    EXPECT_EQ(buf[0], 'a');
+    EXPECT_TRUE(cm.Exist(a));
+    EXPECT_EQ(cm.Size(a), 1000);
+    char part[10];
+    EXPECT_EQ(cm.Read(a, 995, part, sizeof(part)), 5);
+    EXPECT_EQ(part[4], 'a');
+
+    // a miss caches the whole file, even for a partial read
+    EXPECT_EQ(cm.Read(b, part, sizeof(part)), sizeof(part));
+    EXPECT_EQ(part[9], 'b');
+    EXPECT_TRUE(cm.IsCached(b));
+    vector<char> data(1000);
+    EXPECT_EQ(cm.Read(b, data.data(), data.size()), 1000);
+    EXPECT_EQ(data[999], 'b');
+
+    cm.Remove(b);
+    EXPECT_FALSE(cm.IsCached(b));
+    EXPECT_FALSE(cm.Exist(b));
+}
+
+TEST_F(DiskCacheChunkManagerTest, EvictAndRescan) {
+    vector<string> paths;
+    for (int i = 0; i < 4; i++) {
+        paths.push_back(WriteRemote(to_string(i), 'a' + i, 1000));
+    }
+    {
+        // room for 3 files and their headers
+        DiskCacheChunkManager cm(lcm_, cache_dir_, 3500);
+        shared_ptr<uint8_t[]> buf;
+        for (auto& path : paths) {
+            cm.ReadAll(path, buf);
+        }
+        EXPECT_FALSE(cm.IsCached(paths[0]));
+        for (int i = 1; i < 4; i++) {
+            EXPECT_TRUE(cm.IsCached(paths[i]));
+        }
+        EXPECT_LE(cm.GetUsedSize(), 3500);
+    }
+
+    {
+        // a restart finds the cached files again
+        DiskCacheChunkManager cm(lcm_, cache_dir_, 3500);
+        for (int i = 1; i < 4; i++) {
+            EXPECT_TRUE(cm.IsCached(paths[i]));
+        }
+        // they are checked against the remote files on their first use, a
+        // file rewritten while the node was down is read again
+        WriteRemote("2", 'x', 500);
+        shared_ptr<uint8_t[]> buf;
+        EXPECT_EQ(cm.ReadAll(paths[2], buf), 500);
+        EXPECT_EQ(buf[0], 'x');
+        EXPECT_EQ(cm.ReadAll(paths[3], buf), 1000);
+        // a checked copy is served once the remote file is gone
+        for (auto& path : paths) {
+            lcm_->Remove(path);
+        }
+        buf.reset();
+        EXPECT_EQ(cm.ReadAll(paths[3], buf), 1000);
+        EXPECT_EQ(buf[0], 'd');
+    }
+
+    // a smaller capacity drops the files beyond it
+    DiskCacheChunkManager small(lcm_, cache_dir_, 1500);
+    EXPECT_LE(small.GetUsedSize(), 1500);
+}
+
+TEST_F(DiskCacheChunkManagerTest, Corrupted) {
+    auto a = WriteRemote("a", 'a', 1000);
+    DiskCacheChunkManager cm(lcm_, cache_dir_, 1 << 20);
+    shared_ptr<uint8_t[]> buf;
+    cm.ReadAll(a, buf);
+    ASSERT_TRUE(cm.IsCached(a));
+
+    // flip the last byte of the cached data
+    for (auto& item : boost::filesystem::directory_iterator(cache_dir_)) {
+        fstream stream(item.path().string(), ios::in | ios::out | ios::binary);
+        stream.seekp(-1, ios::end);
+        stream.put('x');
+    }
+    buf.reset();
+    EXPECT_EQ(cm.ReadAll(a, buf), 1000);
+    EXPECT_EQ(buf[999], 'a');
+    // read again from the remote file and cached
+    EXPECT_TRUE(cm.IsCached(a));
+}
@@ -202,6 +202,46 @@ TEST_F(DiskAnnFileManagerTest, TestThreadPoolException) {
     }
 }
 
+TEST_F(DiskAnnFileManagerTest, TestThreadPoolPriority) {
+    // a single worker, so the queued tasks run one by one
+    auto thread_pool = std::make_shared<milvus::ThreadPool>(0, "test");
+    EXPECT_EQ(thread_pool->GetThreadNum(), 1);
+
+    std::promise<void> gate;
+    auto gate_future = gate.get_future().share();
+    auto blocker = thread_pool->Submit([gate_future]() { gate_future.wait(); });
+
+    std::mutex mutex;
+    std::vector<int> order;
+    auto record = [&](int id) {
+        std::lock_guard<std::mutex> lock(mutex);
+        order.push_back(id);
+    };
+    std::vector<std::future<void>> futures;
+    futures.push_back(thread_pool->SubmitWithPriority(
+        milvus::TaskPriority::LOW, record, 0));
+    futures.push_back(thread_pool->Submit(record, 1));
+    futures.push_back(thread_pool->Submit(record, 2));
+    futures.push_back(thread_pool->SubmitWithPriority(
+        milvus::TaskPriority::HIGH, record, 3));
+    // the blocker may not have been taken by the worker yet
+    EXPECT_GE(thread_pool->GetQueueDepth(), 4);
+
+    gate.set_value();
+    blocker.get();
+    for (auto& future : futures) {
+        future.get();
+    }
+    EXPECT_EQ(order, std::vector<int>({3, 1, 2, 0}));
+    EXPECT_EQ(thread_pool->GetQueueDepth(), 0);
+
+    // tasks submitted by a worker are queued on the worker's own deque
+    auto nested = thread_pool->Submit([&]() {
+        return thread_pool->Submit(compute, 1);
+    });
+    EXPECT_EQ(nested.get().get(), 11);
+}
+
 namespace {
 const int64_t kOptFieldId = 123456;
 const std::string kOptFieldName = "opt_field_name";
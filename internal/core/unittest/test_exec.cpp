@@ -255,6 +255,74 @@ TEST_P(TaskTest, LogicalExpr) {
     EXPECT_EQ(num_rows, num_rows_);
 }
 
+TEST_P(TaskTest, ProfileLogicalExpr) {
+    ::milvus::proto::plan::GenericValue value;
+    value.set_int64_val(0);
+    auto left = std::make_shared<milvus::expr::UnaryRangeFilterExpr>(
+        expr::ColumnInfo(field_map_["int64"], DataType::INT64),
+        proto::plan::OpType::LessThan,
+        value);
+    auto right = std::make_shared<milvus::expr::UnaryRangeFilterExpr>(
+        expr::ColumnInfo(field_map_["int32"], DataType::INT32),
+        proto::plan::OpType::GreaterThan,
+        value);
+    auto top = std::make_shared<milvus::expr::LogicalBinaryExpr>(
+        expr::LogicalBinaryExpr::OpType::Or, left, right);
+    std::vector<milvus::plan::PlanNodePtr> sources;
+    auto filter_node = std::make_shared<milvus::plan::FilterBitsNode>(
+        "plannode id 1", top, sources);
+    auto plan = plan::PlanFragment(filter_node);
+    auto query_context = std::make_shared<milvus::exec::QueryContext>(
+        "test1",
+        segment_.get(),
+        num_rows_,
+        MAX_TIMESTAMP,
+        std::make_shared<milvus::exec::QueryConfig>(
+            std::unordered_map<std::string, std::string>{
+                {QueryConfig::kProfileEnabled, "true"}}));
+
+    auto task = Task::Create("task_profile", plan, 0, query_context);
+    int64_t num_rows = 0;
+    int64_t num_filtered = 0;
+    for (;;) {
+        auto result = task->Next();
+        if (!result) {
+            break;
+        }
+        auto col_vec =
+            std::dynamic_pointer_cast<ColumnVector>(result->child(0));
+        TargetBitmapView view(col_vec->GetRawData(), col_vec->size());
+        num_rows += view.size();
+        num_filtered += view.count();
+    }
+    EXPECT_EQ(num_rows, num_rows_);
+
+    auto profile = nlohmann::json::parse(query_context->GetProfile());
+    EXPECT_EQ(profile["active_count"], num_rows_);
+    auto& operators = profile["operators"];
+    ASSERT_EQ(operators.size(), 1);
+    EXPECT_EQ(operators[0]["operator"], "PhyFilterBitsNode");
+    EXPECT_EQ(operators[0]["output_rows"], num_rows_);
+    EXPECT_GT(operators[0]["output_batches"], 0);
+
+    auto& expr = operators[0]["exprs"][0];
+    EXPECT_EQ(expr["rows"], num_rows_);
+    EXPECT_EQ(expr["true_rows"], num_rows_ - num_filtered);
+    ASSERT_EQ(expr["inputs"].size(), 2);
+    EXPECT_EQ(expr["inputs"][0]["field_id"], field_map_["int64"].get());
+    EXPECT_EQ(expr["inputs"][1]["field_id"], field_map_["int32"].get());
+    for (auto& input : expr["inputs"]) {
+        EXPECT_EQ(input["path"], "raw");
+        EXPECT_LE(input["batches"], expr["batches"]);
+        EXPECT_LE(input["true_rows"], expr["true_rows"]);
+    }
+
+    // no profile unless asked for
+    auto plain_context = std::make_shared<milvus::exec::QueryContext>(
+        "test2", segment_.get(), num_rows_, MAX_TIMESTAMP);
+    EXPECT_TRUE(plain_context->GetProfile().empty());
+}
+
 TEST_P(TaskTest, CompileInputs_and) {
     using namespace milvus;
     using namespace milvus::query;
@@ -0,0 +1,243 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+
+#include "expr/ITypeExpr.h"
+#include "plan/PlanNode.h"
+#include "query/ExecPlanNodeVisitor.h"
+#include "query/ExprOptimizer.h"
+#include "test_utils/DataGen.h"
+
+using namespace milvus;
+using namespace milvus::query;
+using proto::plan::OpType;
+
+namespace {
+
+const FieldId kInt64Field(101);
+const FieldId kInt32Field(102);
+const FieldId kStringField(103);
+
+proto::plan::GenericValue
+Int(int64_t value) {
+    proto::plan::GenericValue result;
+    result.set_int64_val(value);
+    return result;
+}
+
+expr::TypedExprPtr
+Range(FieldId field, DataType type, OpType op, int64_t value) {
+    return std::make_shared<expr::UnaryRangeFilterExpr>(
+        expr::ColumnInfo(field, type), op, Int(value));
+}
+
+expr::TypedExprPtr
+Int64Range(OpType op, int64_t value) {
+    return Range(kInt64Field, DataType::INT64, op, value);
+}
+
+expr::TypedExprPtr
+And(const expr::TypedExprPtr& left, const expr::TypedExprPtr& right) {
+    return std::make_shared<expr::LogicalBinaryExpr>(
+        expr::LogicalBinaryExpr::OpType::And, left, right);
+}
+
+expr::TypedExprPtr
+Or(const expr::TypedExprPtr& left, const expr::TypedExprPtr& right) {
+    return std::make_shared<expr::LogicalBinaryExpr>(
+        expr::LogicalBinaryExpr::OpType::Or, left, right);
+}
+
+expr::TypedExprPtr
+Not(const expr::TypedExprPtr& child) {
+    return std::make_shared<expr::LogicalUnaryExpr>(
+        expr::LogicalUnaryExpr::OpType::LogicalNot, child);
+}
+
+template <typename T>
+std::shared_ptr<const T>
+As(const expr::TypedExprPtr& expr) {
+    return std::dynamic_pointer_cast<const T>(expr);
+}
+
+}  // namespace
+
+TEST(ExprOptimizer, PushDownNot) {
+    auto result = PushDownNot(Not(Int64Range(OpType::LessThan, 3)));
+    auto range = As<expr::UnaryRangeFilterExpr>(result);
+    ASSERT_NE(range, nullptr);
+    EXPECT_EQ(range->op_type_, OpType::GreaterEqual);
+    EXPECT_EQ(range->val_.int64_val(), 3);
+
+    auto inner = Int64Range(OpType::Equal, 3);
+    result = PushDownNot(Not(Not(inner)));
+    EXPECT_EQ(result->ToString(), inner->ToString());
+
+    // NaN fails both x < 3 and x >= 3, the NOT stays
+    auto float_not = Not(std::make_shared<expr::UnaryRangeFilterExpr>(
+        expr::ColumnInfo(kInt64Field, DataType::FLOAT),
+        OpType::LessThan,
+        Int(3)));
+    EXPECT_EQ(PushDownNot(float_not), float_not);
+}
+
+TEST(ExprOptimizer, FoldConstants) {
+    auto always_true = std::make_shared<expr::AlwaysTrueExpr>();
+    auto range = Int64Range(OpType::LessThan, 3);
+    EXPECT_EQ(FoldConstants(And(always_true, range)), range);
+    EXPECT_EQ(FoldConstants(Or(range, always_true)), always_true);
+    // the valid bits of a chain below a NOT come from its first operand
+    auto negated = Not(And(always_true, range));
+    EXPECT_EQ(FoldConstants(negated), negated);
+}
+
+TEST(ExprOptimizer, DeduplicateExprs) {
+    auto range = Int64Range(OpType::LessThan, 3);
+    auto other = Int64Range(OpType::GreaterThan, 1);
+    auto result = DeduplicateExprs(
+        And(And(range, other), Int64Range(OpType::LessThan, 3)));
+    auto chain = As<expr::LogicalBinaryExpr>(result);
+    ASSERT_NE(chain, nullptr);
+    EXPECT_EQ(chain->inputs()[0], range);
+    EXPECT_EQ(chain->inputs()[1], other);
+
+    // the json paths a,b and a/b print the same but are different columns
+    auto json_range = [](std::vector<std::string> path) {
+        return std::make_shared<expr::UnaryRangeFilterExpr>(
+            expr::ColumnInfo(kStringField, DataType::JSON, std::move(path)),
+            OpType::Equal,
+            Int(1));
+    };
+    auto joined = json_range({"a,b"});
+    auto nested = json_range({"a", "b"});
+    ASSERT_EQ(joined->ToString(), nested->ToString());
+    chain = As<expr::LogicalBinaryExpr>(DeduplicateExprs(Or(joined, nested)));
+    ASSERT_NE(chain, nullptr);
+    EXPECT_EQ(chain->inputs()[0], joined);
+    EXPECT_EQ(chain->inputs()[1], nested);
+}
+
+TEST(ExprOptimizer, MergeEqualsIntoTerm) {
+    expr::TypedExprPtr chain = Int64Range(OpType::Equal, 0);
+    for (int i = 1; i < 500; ++i) {
+        chain = Or(chain, Int64Range(OpType::Equal, i % 250));
+    }
+    auto other = Range(kInt32Field, DataType::INT32, OpType::Equal, 7);
+    chain = Or(chain, other);
+    auto result = As<expr::LogicalBinaryExpr>(MergeEqualsIntoTerm(chain));
+    ASSERT_NE(result, nullptr);
+    auto term = As<expr::TermFilterExpr>(result->inputs()[0]);
+    ASSERT_NE(term, nullptr);
+    EXPECT_EQ(term->column_.field_id_, kInt64Field);
+    EXPECT_EQ(term->vals_.size(), 250);
+    // a single equality of a column is left as is
+    EXPECT_EQ(result->inputs()[1], other);
+
+    // not merged in an and
+    auto conjunct =
+        And(Int64Range(OpType::Equal, 1), Int64Range(OpType::Equal, 2));
+    EXPECT_EQ(MergeEqualsIntoTerm(conjunct), conjunct);
+}
+
+TEST(ExprOptimizer, MergeRanges) {
+    auto result = MergeRanges(And(And(Int64Range(OpType::GreaterThan, 1),
+                                      Int64Range(OpType::LessEqual, 10)),
+                                  Int64Range(OpType::GreaterThan, 3)));
+    auto range = As<expr::BinaryRangeFilterExpr>(result);
+    ASSERT_NE(range, nullptr);
+    EXPECT_EQ(range->lower_val_.int64_val(), 3);
+    EXPECT_FALSE(range->lower_inclusive_);
+    EXPECT_EQ(range->upper_val_.int64_val(), 10);
+    EXPECT_TRUE(range->upper_inclusive_);
+
+    // the exclusive bound is the tighter of two equal ones
+    result = MergeRanges(And(Int64Range(OpType::LessEqual, 5),
+                             Int64Range(OpType::LessThan, 5)));
+    auto upper = As<expr::UnaryRangeFilterExpr>(result);
+    ASSERT_NE(upper, nullptr);
+    EXPECT_EQ(upper->op_type_, OpType::LessThan);
+
+    // ranges of different columns are kept apart
+    auto apart = And(Int64Range(OpType::GreaterThan, 1),
+                     Range(kInt32Field, DataType::INT32, OpType::LessThan, 5));
+    EXPECT_EQ(MergeRanges(apart), apart);
+}
+
+TEST(ExprOptimizer, OrderByCost) {
+    auto string_range = std::make_shared<expr::UnaryRangeFilterExpr>(
+        expr::ColumnInfo(kStringField, DataType::VARCHAR),
+        OpType::PrefixMatch,
+        proto::plan::GenericValue());
+    auto compare = std::make_shared<expr::CompareExpr>(kInt64Field,
+                                                       kInt32Field,
+                                                       DataType::INT64,
+                                                       DataType::INT32,
+                                                       OpType::LessThan);
+    auto range = Int64Range(OpType::LessThan, 3);
+    EXPECT_LT(EstimateCost(range), EstimateCost(compare));
+    EXPECT_LT(EstimateCost(compare), EstimateCost(string_range));
+
+    auto result = As<expr::LogicalBinaryExpr>(
+        OrderByCost(And(And(string_range, compare), range)));
+    ASSERT_NE(result, nullptr);
+    auto first = As<expr::LogicalBinaryExpr>(result->inputs()[0]);
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(first->inputs()[0], range);
+    EXPECT_EQ(first->inputs()[1], compare);
+    EXPECT_EQ(result->inputs()[1], string_range);
+}
+
+TEST(ExprOptimizer, SameRowsAsUnoptimized) {
+    auto schema = std::make_shared<Schema>();
+    auto vec_fid = schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto i64_fid = schema->AddDebugField("int64", DataType::INT64);
+    auto i32_fid = schema->AddDebugField("int32", DataType::INT32, true);
+    schema->set_primary_field_id(i64_fid);
+    ASSERT_EQ(i64_fid, kInt64Field);
+    ASSERT_EQ(i32_fid, kInt32Field);
+
+    int64_t N = 10000;
+    auto dataset = DataGen(schema, N);
+    auto segment = CreateSealedSegment(schema);
+    SealedLoadFieldData(dataset, *segment);
+
+    auto i32 = [](OpType op, int64_t value) {
+        return Range(kInt32Field, DataType::INT32, op, value);
+    };
+    expr::TypedExprPtr equals = i32(OpType::Equal, 0);
+    for (int i = 1; i < 50; ++i) {
+        equals = Or(equals, i32(OpType::Equal, i * 7 % 100 - 50));
+    }
+    std::vector<expr::TypedExprPtr> exprs{
+        equals,
+        And(i32(OpType::GreaterThan, -20), i32(OpType::LessThan, 30)),
+        Not(And(i32(OpType::GreaterThan, -20), i32(OpType::LessThan, 30))),
+        Not(Not(i32(OpType::LessEqual, 0))),
+        Not(i32(OpType::LessEqual, 0)),
+        And(std::make_shared<expr::AlwaysTrueExpr>(),
+            Or(i32(OpType::NotEqual, 3), i32(OpType::NotEqual, 3))),
+        And(Or(equals, Int64Range(OpType::GreaterThan, 0)),
+            And(i32(OpType::GreaterEqual, -40), i32(OpType::GreaterEqual, 10))),
+    };
+    for (auto& expr : exprs) {
+        auto execute = [&](const expr::TypedExprPtr& filter) {
+            auto plan = std::make_shared<plan::FilterBitsNode>(
+                DEFAULT_PLANNODE_ID, filter);
+            return ExecuteQueryExpr(plan, segment.get(), N, MAX_TIMESTAMP);
+        };
+        auto expected = execute(expr);
+        auto optimized = execute(OptimizeExpr(expr));
+        ASSERT_EQ(expected.size(), optimized.size());
+        EXPECT_TRUE(expected == optimized) << expr->ToString();
+    }
+}
@@ -517,6 +517,77 @@ TEST(GroupBY, SealedData) {
     }
 }
 
+TEST(GroupBY, SealedDataMultipleQueries) {
+    int dim = 64;
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, dim, knowhere::metric::L2);
+    schema->AddDebugField("string1", DataType::VARCHAR);
+    auto int64_fid = schema->AddDebugField("int64", DataType::INT64);
+    schema->set_primary_field_id(int64_fid);
+    auto segment = CreateSealedSegment(schema);
+    size_t N = 1000;
+
+    auto raw_data = DataGen(schema, N, 42, 0, 8, 10, false, false);
+    auto fields = schema->get_fields();
+    for (auto field_data : raw_data.raw_->fields_data()) {
+        int64_t field_id = field_data.field_id();
+        auto info = FieldDataInfo(field_data.field_id(), N);
+        auto field_meta = fields.at(FieldId(field_id));
+        info.channel->push(
+            CreateFieldDataFromDataArray(N, &field_data, field_meta));
+        info.channel->close();
+        segment->LoadFieldData(FieldId(field_id), info);
+    }
+    prepareSegmentSystemFieldData(segment, N, raw_data);
+
+    const char* raw_plan = R"(vector_anns: <
+                                        field_id: 100
+                                        query_info: <
+                                          topk: 10
+                                          metric_type: "L2"
+                                          search_params: "{\"ef\": 10}"
+                                          group_by_field_id: 101,
+                                          group_size: 3,
+                                        >
+                                        placeholder_tag: "$0"
+
+         >)";
+    auto plan_str = translate_text_plan_to_binary_plan(raw_plan);
+    auto plan =
+        CreateSearchPlanByExpr(*schema, plan_str.data(), plan_str.size());
+    auto search = [&](int num_queries, const float* queries) {
+        auto ph_group_raw =
+            CreatePlaceholderGroupFromBlob(num_queries, dim, queries);
+        auto ph_group =
+            ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+        return segment->Search(plan.get(), ph_group.get(), 1L << 63);
+    };
+
+    int num_queries = 20;
+    std::vector<float> queries(num_queries * dim);
+    std::default_random_engine rng(1024);
+    std::normal_distribution<float> dist(0, 1);
+    for (auto& value : queries) {
+        value = dist(rng);
+    }
+    // the queries grouped in parallel have the results of their own search
+    auto result = search(num_queries, queries.data());
+    CheckGroupBySearchResult(*result, 10, num_queries, false);
+    auto& group_by_values = result->group_by_values_.value();
+    for (int i = 0; i < num_queries; i++) {
+        auto single = search(1, queries.data() + i * dim);
+        auto begin = result->topk_per_nq_prefix_sum_[i];
+        auto size = result->topk_per_nq_prefix_sum_[i + 1] - begin;
+        ASSERT_EQ(size, single->seg_offsets_.size());
+        for (size_t j = 0; j < size; j++) {
+            EXPECT_EQ(result->seg_offsets_[begin + j], single->seg_offsets_[j]);
+            EXPECT_TRUE(group_by_values[begin + j] ==
+                        single->group_by_values_.value()[j]);
+        }
+    }
+}
+
 TEST(GroupBY, Reduce) {
     using namespace milvus;
     using namespace milvus::query;
@@ -640,7 +711,8 @@ TEST(GroupBY, Reduce) {
                                             results.size(),
                                             slice_nqs.data(),
                                             slice_topKs.data(),
-                                            slice_nqs.size());
+                                            slice_nqs.size(),
+                                            0);
     CheckSearchResultDuplicate(results, group_size);
     DeleteSearchResult(c_search_res_1);
     DeleteSearchResult(c_search_res_2);
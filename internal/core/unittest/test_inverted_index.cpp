@@ -259,6 +259,19 @@ test_run() {
                 }
             }
 
+            {
+                // an empty list matches no row, and all the valid rows
+                // when negated
+                auto in = real_index->In(0, nullptr);
+                auto not_in = real_index->NotIn(0, nullptr);
+                ASSERT_EQ(cnt, in.size());
+                ASSERT_EQ(cnt, not_in.size());
+                ASSERT_TRUE(in.none());
+                for (size_t i = 0; i < not_in.size(); i++) {
+                    ASSERT_EQ(not_in[i], !nullable || valid_data[i]);
+                }
+            }
+
             {
                 auto bitset = real_index->IsNull();
                 ASSERT_EQ(cnt, bitset.size());
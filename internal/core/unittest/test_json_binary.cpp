@@ -0,0 +1,82 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "common/Json.h"
+#include "common/JsonBinary.h"
+
+using namespace milvus;
+
+template <typename T>
+void
+ExpectSameAt(const Json& text, const Json& binary, const std::string& pointer) {
+    auto expected = text.at<T>(pointer);
+    auto actual = binary.at<T>(pointer);
+    ASSERT_EQ(expected.error() == simdjson::SUCCESS,
+              actual.error() == simdjson::SUCCESS)
+        << pointer;
+    if (expected.error() == simdjson::SUCCESS) {
+        ASSERT_EQ(expected.value(), actual.value()) << pointer;
+    }
+}
+
+TEST(JsonBinary, MatchTextLookup) {
+    std::string str = R"({"int": 10, "double": 1.5, "bool": true,
+        "string": "a\"b", "null": null, "big": 18446744073709551615,
+        "nested": {"z": 1, "a": {"b": "deep"}, "a/b": 2, "m~n": 3},
+        "array": [1, 2.5, "x", [4], {"k": false}]})";
+    simdjson::padded_string padded(str);
+    Json text(padded.data(), padded.size());
+
+    std::string binary;
+    ASSERT_TRUE(EncodeJsonBinary(str, binary));
+    Json json(padded.data(), padded.size(), binary.data());
+
+    std::vector<std::string> pointers = {"",
+                                         "/int",
+                                         "/double",
+                                         "/bool",
+                                         "/string",
+                                         "/null",
+                                         "/big",
+                                         "/nested/z",
+                                         "/nested/a/b",
+                                         "/nested/a~1b",
+                                         "/nested/m~0n",
+                                         "/array/0",
+                                         "/array/1",
+                                         "/array/2",
+                                         "/array/3/0",
+                                         "/array/4/k",
+                                         "/array/5",
+                                         "/array/01",
+                                         "/array/00",
+                                         "/missing",
+                                         "/int/a"};
+    for (auto& pointer : pointers) {
+        ExpectSameAt<int64_t>(text, json, pointer);
+        ExpectSameAt<double>(text, json, pointer);
+        ExpectSameAt<bool>(text, json, pointer);
+        ExpectSameAt<std::string_view>(text, json, pointer);
+        ASSERT_EQ(text.exist(pointer), json.exist(pointer)) << pointer;
+    }
+}
+
+TEST(JsonBinary, Invalid) {
+    std::string binary;
+    ASSERT_FALSE(EncodeJsonBinary("", binary));
+    ASSERT_FALSE(EncodeJsonBinary("{\"a\":", binary));
+    ASSERT_TRUE(binary.empty());
+}
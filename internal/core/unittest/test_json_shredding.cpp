@@ -0,0 +1,231 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "common/Json.h"
+#include "common/JsonBinary.h"
+#include "expr/ITypeExpr.h"
+#include "query/ExecPlanNodeVisitor.h"
+#include "segcore/JsonShredding.h"
+#include "segcore/SegcoreConfig.h"
+#include "test_utils/DataGen.h"
+
+using namespace milvus;
+using namespace milvus::query;
+using namespace milvus::segcore;
+
+namespace {
+
+std::unique_ptr<ShreddedJsonField>
+BuildShreddedField(const std::vector<std::string>& rows,
+                   int64_t max_paths,
+                   double min_presence_ratio) {
+    std::vector<simdjson::padded_string> texts;
+    std::vector<std::string> binaries(rows.size());
+    std::vector<Json> views;
+    for (size_t i = 0; i < rows.size(); i++) {
+        texts.emplace_back(rows[i]);
+        EncodeJsonBinary(rows[i], binaries[i]);
+    }
+    for (size_t i = 0; i < rows.size(); i++) {
+        views.emplace_back(texts[i].data(),
+                           texts[i].size(),
+                           binaries[i].empty() ? nullptr : binaries[i].data());
+    }
+    auto visitor = [&](const ShreddedJsonField::BatchCallback& func) {
+        func(views.data(), nullptr, views.size());
+    };
+    return ShreddedJsonField::Build(
+        visitor, rows.size(), max_paths, min_presence_ratio);
+}
+
+}  // namespace
+
+TEST(JsonShredding, Build) {
+    std::vector<std::string> rows = {
+        R"({"id": 1, "price": 1.5, "name": "a", "tag": 1, "obj": {"k": 10}})",
+        R"({"id": 2, "price": 2.5, "name": "b", "tag": "x", "obj": {"k": 20}})",
+        R"({"id": 3, "price": 3.5, "obj": {"k": 30}})",
+        R"({"id": 4, "name": "d"})",
+    };
+
+    auto field = BuildShreddedField(rows, 8, 0.5);
+    ASSERT_NE(field, nullptr);
+    ASSERT_EQ(field->paths().size(), 4);
+    ASSERT_EQ(field->valid_data(), nullptr);
+    // mixed types and objects are not shredded
+    ASSERT_EQ(field->GetPath("/tag"), nullptr);
+    ASSERT_EQ(field->GetPath("/obj"), nullptr);
+
+    auto id = field->GetPath("/id");
+    ASSERT_NE(id, nullptr);
+    ASSERT_EQ(id->data_type(), DataType::INT64);
+    for (int i = 0; i < 4; i++) {
+        ASSERT_TRUE(id->presence()[i]);
+        ASSERT_EQ(id->data<int64_t>()[i], i + 1);
+    }
+
+    auto price = field->GetPath("/price");
+    ASSERT_NE(price, nullptr);
+    ASSERT_EQ(price->data_type(), DataType::DOUBLE);
+    ASSERT_FALSE(price->presence()[3]);
+    ASSERT_EQ(price->data<double>()[2], 3.5);
+
+    auto name = field->GetPath("/name");
+    ASSERT_NE(name, nullptr);
+    ASSERT_EQ(name->data_type(), DataType::VARCHAR);
+    ASSERT_FALSE(name->presence()[2]);
+    ASSERT_EQ(name->string_data()[1], "b");
+    ASSERT_EQ(name->string_data()[2], "");
+    ASSERT_EQ(name->string_data()[3], "d");
+
+    auto nested = field->GetPath("/obj/k");
+    ASSERT_NE(nested, nullptr);
+    ASSERT_EQ(nested->data<int64_t>()[1], 20);
+
+    // budget keeps the most present paths
+    field = BuildShreddedField(rows, 1, 0.5);
+    ASSERT_NE(field, nullptr);
+    ASSERT_EQ(field->paths().size(), 1);
+    ASSERT_NE(field->GetPath("/id"), nullptr);
+
+    field = BuildShreddedField(rows, 8, 0.9);
+    ASSERT_NE(field, nullptr);
+    ASSERT_EQ(field->paths().size(), 1);
+
+    ASSERT_EQ(BuildShreddedField(rows, 0, 0.5), nullptr);
+    ASSERT_EQ(BuildShreddedField({R"([1, 2])", R"("x")"}, 8, 0.5), nullptr);
+}
+
+TEST(JsonShredding, MatchJsonLookup) {
+    auto schema = std::make_shared<Schema>();
+    auto i64_fid = schema->AddDebugField("id", DataType::INT64);
+    auto json_fid = schema->AddDebugField("json", DataType::JSON, true);
+    schema->AddDebugField(
+        "vec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    schema->set_primary_field_id(i64_fid);
+
+    // spans several blocks of the zone maps
+    int N = 20000;
+    auto dataset = DataGen(schema, N);
+    for (auto& field_data : *dataset.raw_->mutable_fields_data()) {
+        if (field_data.field_id() != json_fid.get()) {
+            continue;
+        }
+        auto json_data = field_data.mutable_scalars()->mutable_json_data();
+        for (int i = 0; i < N; i++) {
+            std::string row = R"({"id": )" + std::to_string(i);
+            if (i % 3 != 0) {
+                row += R"(, "price": )" + std::to_string(i % 100) + ".5";
+            }
+            if (i % 5 != 0) {
+                row += R"(, "name": "n)" + std::to_string(i % 37) + "\"";
+            }
+            row += R"(, "mixed": )" +
+                   (i % 2 == 0 ? std::to_string(i) : "\"x\"") + "}";
+            json_data->set_data(i, row);
+        }
+    }
+
+    auto& config = SegcoreConfig::default_config();
+    auto max_paths = config.get_json_shredding_max_paths();
+    config.set_json_shredding_max_paths(8);
+    auto shredded = SealedCreator(schema, dataset);
+    config.set_json_shredding_max_paths(0);
+    auto plain = SealedCreator(schema, dataset);
+    config.set_json_shredding_max_paths(max_paths);
+
+    auto shredded_field = shredded->GetShreddedJsonField(json_fid);
+    ASSERT_NE(shredded_field, nullptr);
+    ASSERT_NE(shredded_field->GetPath("/id"), nullptr);
+    ASSERT_NE(shredded_field->GetPath("/price"), nullptr);
+    ASSERT_NE(shredded_field->GetPath("/name"), nullptr);
+    ASSERT_EQ(shredded_field->GetPath("/mixed"), nullptr);
+    ASSERT_EQ(plain->GetShreddedJsonField(json_fid), nullptr);
+
+    auto check = [&](const expr::TypedExprPtr& expr) {
+        auto plan =
+            std::make_shared<plan::FilterBitsNode>(DEFAULT_PLANNODE_ID, expr);
+        auto expected = ExecuteQueryExpr(plan, plain.get(), N, MAX_TIMESTAMP);
+        auto actual = ExecuteQueryExpr(plan, shredded.get(), N, MAX_TIMESTAMP);
+        ASSERT_EQ(expected.size(), N);
+        ASSERT_EQ(actual.size(), N);
+        for (int i = 0; i < N; i++) {
+            ASSERT_EQ(expected[i], actual[i]) << i;
+        }
+    };
+
+    std::vector<proto::plan::OpType> ops{
+        proto::plan::OpType::Equal,
+        proto::plan::OpType::NotEqual,
+        proto::plan::OpType::GreaterThan,
+        proto::plan::OpType::GreaterEqual,
+        proto::plan::OpType::LessThan,
+        proto::plan::OpType::LessEqual,
+    };
+    proto::plan::GenericValue int_val;
+    int_val.set_int64_val(50);
+    proto::plan::GenericValue float_val;
+    float_val.set_float_val(30.5);
+    proto::plan::GenericValue string_val;
+    string_val.set_string_val("n2");
+    proto::plan::GenericValue bool_val;
+    bool_val.set_bool_val(true);
+    for (auto& path : {"id", "price", "name", "mixed"}) {
+        for (auto& op : ops) {
+            for (auto& val : {int_val, float_val, string_val, bool_val}) {
+                check(std::make_shared<expr::UnaryRangeFilterExpr>(
+                    expr::ColumnInfo(json_fid, DataType::JSON, {path}),
+                    op,
+                    val));
+            }
+        }
+        check(std::make_shared<expr::UnaryRangeFilterExpr>(
+            expr::ColumnInfo(json_fid, DataType::JSON, {path}),
+            proto::plan::OpType::PrefixMatch,
+            string_val));
+        check(std::make_shared<expr::ExistsExpr>(
+            expr::ColumnInfo(json_fid, DataType::JSON, {path})));
+    }
+
+    proto::plan::GenericValue lower;
+    proto::plan::GenericValue upper;
+    lower.set_int64_val(100);
+    upper.set_int64_val(15000);
+    check(std::make_shared<expr::BinaryRangeFilterExpr>(
+        expr::ColumnInfo(json_fid, DataType::JSON, {"id"}),
+        lower,
+        upper,
+        true,
+        false));
+    check(std::make_shared<expr::BinaryRangeFilterExpr>(
+        expr::ColumnInfo(json_fid, DataType::JSON, {"price"}),
+        lower,
+        upper,
+        false,
+        true));
+    lower.set_string_val("n1");
+    upper.set_string_val("n3");
+    check(std::make_shared<expr::BinaryRangeFilterExpr>(
+        expr::ColumnInfo(json_fid, DataType::JSON, {"name"}),
+        lower,
+        upper,
+        true,
+        true));
+
+    // the shredded paths go away with the raw field
+    shredded->DropFieldData(json_fid);
+    ASSERT_EQ(shredded->GetShreddedJsonField(json_fid), nullptr);
+}
@@ -0,0 +1,134 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "common/Common.h"
+#include "monitor/prometheus_client.h"
+#include "storage/LoadMemoryGovernor.h"
+
+using namespace milvus;
+using namespace milvus::storage;
+
+namespace {
+
+constexpr int64_t MB = 1 << 20;
+
+void
+WaitForWaiting(int64_t num_waiting) {
+    while (monitor::internal_storage_load_memory_waiting.Value() !=
+           num_waiting) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+}  // namespace
+
+class LoadMemoryGovernorTest : public ::testing::Test {
+ protected:
+    void
+    SetUp() override {
+        SetLoadMemoryLimit(1);
+    }
+
+    void
+    TearDown() override {
+        SetLoadMemoryLimit(0);
+    }
+};
+
+TEST_F(LoadMemoryGovernorTest, Disabled) {
+    SetLoadMemoryLimit(0);
+    auto& governor = LoadMemoryGovernor::GetInstance();
+    auto reservation = governor.Reserve(10 * MB);
+    EXPECT_EQ(reservation.bytes(), 0);
+    EXPECT_EQ(governor.reserved_bytes(), 0);
+}
+
+TEST_F(LoadMemoryGovernorTest, WaitsForLimit) {
+    auto& governor = LoadMemoryGovernor::GetInstance();
+    auto first = governor.Reserve(MB / 2);
+    auto second = governor.Reserve(MB / 2);
+    EXPECT_EQ(governor.reserved_bytes(), MB);
+
+    std::atomic<bool> granted{false};
+    std::thread waiter([&] {
+        auto third = governor.Reserve(MB / 2);
+        granted = true;
+    });
+    WaitForWaiting(1);
+    EXPECT_FALSE(granted);
+    first.Release();
+    waiter.join();
+    EXPECT_TRUE(granted);
+    EXPECT_EQ(governor.reserved_bytes(), MB / 2);
+
+    // moving keeps the bytes reserved once
+    auto moved = std::move(second);
+    EXPECT_EQ(moved.bytes(), MB / 2);
+    EXPECT_EQ(governor.reserved_bytes(), MB / 2);
+    moved.Release();
+
+    // granted above the limit once nothing else is reserved
+    auto large = governor.Reserve(4 * MB);
+    EXPECT_EQ(governor.reserved_bytes(), 4 * MB);
+}
+
+TEST_F(LoadMemoryGovernorTest, RoundRobinOverOwners) {
+    auto& governor = LoadMemoryGovernor::GetInstance();
+    auto main_owner = std::this_thread::get_id();
+    auto held = governor.Reserve(MB);
+
+    std::mutex mutex;
+    std::vector<int> order;
+    std::vector<std::thread> threads;
+    auto reserve = [&](int id, std::thread::id owner) {
+        auto reservation = governor.Reserve(MB, owner);
+        std::unique_lock<std::mutex> lck(mutex);
+        order.push_back(id);
+    };
+    // two requests of the main owner queue before one of another owner
+    threads.emplace_back(reserve, 0, main_owner);
+    WaitForWaiting(1);
+    threads.emplace_back(reserve, 1, main_owner);
+    WaitForWaiting(2);
+    threads.emplace_back([&] { reserve(2, std::this_thread::get_id()); });
+    WaitForWaiting(3);
+
+    held.Release();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(order, std::vector<int>({0, 2, 1}));
+    EXPECT_EQ(governor.reserved_bytes(), 0);
+}
+
+TEST_F(LoadMemoryGovernorTest, GrantsLoaderHoldingItsData) {
+    auto& governor = LoadMemoryGovernor::GetInstance();
+    // a loader holding the data of its earlier files would wait for itself
+    auto held = governor.Reserve(MB);
+    auto next = governor.Reserve(MB);
+    EXPECT_EQ(governor.reserved_bytes(), 2 * MB);
+
+    // resized to the memory the file took, without waiting
+    next.Resize(3 * MB);
+    EXPECT_EQ(next.bytes(), 3 * MB);
+    EXPECT_EQ(governor.reserved_bytes(), 4 * MB);
+    next.Release();
+    held.Release();
+    EXPECT_EQ(governor.reserved_bytes(), 0);
+}
@@ -211,6 +211,71 @@ TEST_F(MinioChunkManagerTest, ReadPositive) {
     chunk_manager_->DeleteBucket(testBucketName);
 }
 
+TEST_F(MinioChunkManagerTest, ReadRange) {
+    string testBucketName = configs_.bucket_name;
+    chunk_manager_->SetBucketName(testBucketName);
+    if (!chunk_manager_->BucketExists(testBucketName)) {
+        chunk_manager_->CreateBucket(testBucketName);
+    }
+
+    // large enough to be split into several range GETs
+    std::vector<uint8_t> data(DEFAULT_RANGE_READ_PART_SIZE * 2 + 123);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = i % 251;
+    }
+    string path = "1/4/7";
+    chunk_manager_->Write(path, data.data(), data.size());
+
+    std::vector<uint8_t> readdata(data.size());
+    auto size = chunk_manager_->Read(path, readdata.data(), readdata.size());
+    EXPECT_EQ(size, data.size());
+    EXPECT_EQ(readdata, data);
+
+    uint8_t part[10] = {0};
+    size = chunk_manager_->Read(path, 1000, part, sizeof(part));
+    EXPECT_EQ(size, sizeof(part));
+    for (int i = 0; i < 10; i++) {
+        EXPECT_EQ(part[i], data[1000 + i]);
+    }
+    // ranges past the end are cut short
+    size = chunk_manager_->Read(path, data.size() - 3, part, sizeof(part));
+    EXPECT_EQ(size, 3);
+    EXPECT_EQ(chunk_manager_->Read(path, data.size(), part, sizeof(part)), 0);
+
+    std::shared_ptr<uint8_t[]> buf;
+    size = chunk_manager_->ReadAll(path, buf);
+    EXPECT_EQ(size, data.size());
+    EXPECT_EQ(memcmp(buf.get(), data.data(), size), 0);
+
+    chunk_manager_->Remove(path);
+    chunk_manager_->DeleteBucket(testBucketName);
+}
+
+TEST(RangeReadTuner, Adapt) {
+    RangeReadTuner tuner;
+    EXPECT_EQ(tuner.PartSize(), DEFAULT_RANGE_READ_PART_SIZE);
+    EXPECT_EQ(tuner.Concurrency(), DEFAULT_RANGE_READ_CONCURRENCY);
+
+    // fast streams get larger parts, slow ones smaller
+    tuner.ObservePart(MAX_RANGE_READ_PART_SIZE, 10);
+    EXPECT_EQ(tuner.PartSize(), MAX_RANGE_READ_PART_SIZE);
+    RangeReadTuner slow;
+    slow.ObservePart(MIN_RANGE_READ_PART_SIZE, 10000);
+    EXPECT_EQ(slow.PartSize(), MIN_RANGE_READ_PART_SIZE);
+
+    // concurrency grows while the throughput does
+    for (int i = 1; i <= 4; i++) {
+        tuner.ObserveRead(100 << 20, 1000.0 / i, tuner.Concurrency());
+    }
+    EXPECT_GT(tuner.Concurrency(), DEFAULT_RANGE_READ_CONCURRENCY);
+    auto concurrency = tuner.Concurrency();
+    tuner.ObserveRead(100 << 20, 10000, concurrency);
+    EXPECT_EQ(tuner.Concurrency(), concurrency - 1);
+    // reads of fewer parts are ignored
+    tuner.ObserveRead(100 << 20, 10000, 1);
+    EXPECT_EQ(tuner.Concurrency(), concurrency - 1);
+}
+
 TEST_F(MinioChunkManagerTest, ReadNotExist) {
     string testBucketName = configs_.bucket_name;
     chunk_manager_->SetBucketName(testBucketName);
@@ -11,6 +11,8 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+
 #include "common/Types.h"
 #include "knowhere/comp/index_param.h"
 #include "test_utils/DataGen.h"
@@ -565,3 +567,281 @@ TEST_P(RetrieveTest, Delete) {
         }
     }
 }
+
+TEST_P(RetrieveTest, LimitStopEarly) {
+    auto schema = std::make_shared<Schema>();
+    auto fid_64 = schema->AddDebugField("i64", DataType::INT64);
+    auto DIM = 16;
+    schema->AddDebugField("vector_64", data_type, DIM, metric_type);
+    schema->set_primary_field_id(fid_64);
+
+    // spans several batches of the expression
+    int64_t N = 3 * 8192 + 100;
+    int64_t limit = 100;
+    auto retrieve_pks = [&](SegmentSealed* segment,
+                            const expr::TypedExprPtr& expr) {
+        auto plan = std::make_unique<query::RetrievePlan>(*schema);
+        plan->plan_node_ = std::make_unique<query::RetrievePlanNode>();
+        plan->plan_node_->plannodes_ =
+            milvus::test::CreateRetrievePlanByExpr(expr);
+        plan->plan_node_->is_count_ = false;
+        plan->plan_node_->limit_ = limit;
+        plan->field_ids_ = {fid_64};
+        auto retrieve_results = RetrieveUsingDefaultOutputSize(
+            segment, plan.get(), MAX_TIMESTAMP);
+        auto data = retrieve_results->fields_data(0).scalars().long_data();
+        return std::vector<int64_t>(data.data().begin(), data.data().end());
+    };
+    proto::plan::GenericValue lower;
+    lower.set_int64_val(10000);
+    auto range_expr = std::make_shared<expr::UnaryRangeFilterExpr>(
+        expr::ColumnInfo(fid_64, DataType::INT64), OpType::GreaterEqual, lower);
+
+    // pks are in offset order, evaluation stops after the first batch
+    auto dataset = DataGen(schema, N);
+    auto sorted_segment = CreateSealedSegment(
+        schema, nullptr, 0, SegcoreConfig::default_config(), false, true);
+    SealedLoadFieldData(dataset, *sorted_segment);
+    auto pks = retrieve_pks(sorted_segment.get(), range_expr);
+    ASSERT_EQ(pks.size(), limit);
+    for (int i = 0; i < limit; i++) {
+        ASSERT_EQ(pks[i], 10000 + i);
+    }
+
+    int64_t delete_count = 10;
+    std::vector<idx_t> delete_pks;
+    for (int i = 0; i < delete_count; i++) {
+        delete_pks.push_back(10000 + i);
+    }
+    auto ids = std::make_unique<IdArray>();
+    ids->mutable_int_id()->mutable_data()->Add(delete_pks.begin(),
+                                               delete_pks.end());
+    std::vector<Timestamp> delete_timestamps(delete_count, N * 2);
+    sorted_segment->Delete(sorted_segment->get_deleted_count(),
+                           delete_count,
+                           ids.get(),
+                           delete_timestamps.data());
+    pks = retrieve_pks(sorted_segment.get(), range_expr);
+    ASSERT_EQ(pks.size(), limit);
+    for (int i = 0; i < limit; i++) {
+        ASSERT_EQ(pks[i], 10000 + delete_count + i);
+    }
+
+    // random pks, results are still the smallest pks passing the filter
+    dataset = DataGen(schema, N, 42, 0, 1, 10, true);
+    auto segment = CreateSealedSegment(schema);
+    SealedLoadFieldData(dataset, *segment);
+    auto i64_col = dataset.get_col<int64_t>(fid_64);
+
+    std::vector<int64_t> expected;
+    for (auto pk : i64_col) {
+        if (pk >= 10000) {
+            expected.push_back(pk);
+        }
+    }
+    std::sort(expected.begin(), expected.end());
+    expected.resize(limit);
+    ASSERT_EQ(retrieve_pks(segment.get(), range_expr), expected);
+
+    // few hits are ordered with a heap instead of walking the pk index
+    std::vector<proto::plan::GenericValue> values;
+    expected.clear();
+    for (int i = 0; i < N; i += 997) {
+        proto::plan::GenericValue val;
+        val.set_int64_val(i64_col[i]);
+        values.push_back(val);
+        expected.push_back(i64_col[i]);
+    }
+    std::sort(expected.begin(), expected.end());
+    limit = 10;
+    expected.resize(limit);
+    auto term_expr = std::make_shared<expr::TermFilterExpr>(
+        expr::ColumnInfo(fid_64, DataType::INT64), values);
+    ASSERT_EQ(retrieve_pks(segment.get(), term_expr), expected);
+}
+
+TEST(Retrieve, Cancelled) {
+    auto schema = std::make_shared<Schema>();
+    auto fid_64 = schema->AddDebugField("i64", DataType::INT64);
+    schema->AddDebugField(
+        "vector_64", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    schema->set_primary_field_id(fid_64);
+
+    int64_t N = 100;
+    auto dataset = DataGen(schema, N);
+    auto segment = CreateSealedSegment(schema);
+    SealedLoadFieldData(dataset, *segment);
+
+    auto plan = std::make_unique<query::RetrievePlan>(*schema);
+    proto::plan::GenericValue val;
+    val.set_int64_val(0);
+    auto expr = std::make_shared<milvus::expr::UnaryRangeFilterExpr>(
+        milvus::expr::ColumnInfo(
+            fid_64, DataType::INT64, std::vector<std::string>()),
+        proto::plan::OpType::GreaterEqual,
+        val);
+    plan->plan_node_ = std::make_unique<query::RetrievePlanNode>();
+    plan->plan_node_->plannodes_ =
+        milvus::test::CreateRetrievePlanByExpr(expr);
+    plan->field_ids_ = {fid_64};
+
+    auto retrieve = [&](const OpContext& op_context) {
+        return segment->Retrieve(nullptr,
+                                 plan.get(),
+                                 MAX_TIMESTAMP,
+                                 DEFAULT_MAX_OUTPUT_SIZE,
+                                 false,
+                                 &op_context);
+    };
+    auto expect_cancelled = [&](const OpContext& op_context) {
+        try {
+            retrieve(op_context);
+            FAIL() << "retrieve should be cancelled";
+        } catch (SegcoreError& e) {
+            ASSERT_EQ(e.get_error_code(), FollyCancel);
+        }
+    };
+
+    folly::CancellationSource source;
+    auto results = retrieve(OpContext(source.getToken()));
+    ASSERT_EQ(results->fields_data(0).scalars().long_data().data_size(), N);
+
+    source.requestCancellation();
+    expect_cancelled(OpContext(source.getToken()));
+
+    folly::CancellationSource no_cancel;
+    expect_cancelled(OpContext(no_cancel.getToken(),
+                               OpContext::Clock::now() -
+                                   std::chrono::milliseconds(1)));
+    auto past = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::system_clock::now().time_since_epoch())
+                    .count() -
+                1000;
+    expect_cancelled(OpContext(no_cancel.getToken(),
+                               OpContext::DeadlineFromUnixMs(past)));
+    results = retrieve(
+        OpContext(no_cancel.getToken(), OpContext::DeadlineFromUnixMs(0)));
+    ASSERT_EQ(results->fields_data(0).scalars().long_data().data_size(), N);
+}
+
+TEST(Retrieve, Cursor) {
+    auto schema = std::make_shared<Schema>();
+    auto fid_64 = schema->AddDebugField("i64", DataType::INT64);
+    schema->AddDebugField(
+        "vector_64", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    schema->set_primary_field_id(fid_64);
+
+    int64_t N = 1000;
+    int64_t page_size = 30;
+    proto::plan::GenericValue val;
+    val.set_int64_val(100);
+    auto expr = std::make_shared<milvus::expr::UnaryRangeFilterExpr>(
+        milvus::expr::ColumnInfo(fid_64, DataType::INT64),
+        proto::plan::OpType::GreaterEqual,
+        val);
+    auto plan = std::make_unique<query::RetrievePlan>(*schema);
+    plan->plan_node_ = std::make_unique<query::RetrievePlanNode>();
+    plan->plan_node_->plannodes_ =
+        milvus::test::CreateRetrievePlanByExpr(expr);
+    plan->field_ids_ = {fid_64};
+
+    auto& cursors = RetrieveCursorManager::GetInstance();
+    auto retrieve_pages = [&](SegmentInterface* segment, int64_t cursor_id) {
+        std::vector<int64_t> pks;
+        for (bool has_more = true; has_more;) {
+            auto results = segment->RetrieveByCursor(nullptr,
+                                                     plan.get(),
+                                                     MAX_TIMESTAMP,
+                                                     cursor_id,
+                                                     DEFAULT_MAX_OUTPUT_SIZE);
+            auto data = results->fields_data(0).scalars().long_data().data();
+            EXPECT_LE(data.size(), page_size);
+            pks.insert(pks.end(), data.begin(), data.end());
+            has_more = results->has_more_result();
+            // the cursor is kept until its last page
+            EXPECT_EQ(cursors.bytes() > 0, has_more);
+        }
+        return pks;
+    };
+
+    // the offsets of a sorted segment are ascending, the others are not
+    auto sorted_segment = CreateSealedSegment(
+        schema, nullptr, 0, SegcoreConfig::default_config(), false, true);
+    SealedLoadFieldData(DataGen(schema, N), *sorted_segment);
+    auto segment = CreateSealedSegment(schema);
+    SealedLoadFieldData(DataGen(schema, N, 42, 0, 1, 10, true), *segment);
+    for (auto seg : {sorted_segment.get(), segment.get()}) {
+        plan->plan_node_->limit_ = Unlimited;
+        auto all =
+            RetrieveUsingDefaultOutputSize(seg, plan.get(), MAX_TIMESTAMP);
+        auto data = all->fields_data(0).scalars().long_data().data();
+        std::vector<int64_t> expected(data.begin(), data.end());
+        ASSERT_GT(expected.size(), page_size);
+
+        plan->plan_node_->limit_ = page_size;
+        ASSERT_EQ(retrieve_pages(seg, 1), expected);
+    }
+
+    // a closed cursor is opened again from the start
+    plan->plan_node_->limit_ = page_size;
+    auto first = segment->RetrieveByCursor(
+        nullptr, plan.get(), MAX_TIMESTAMP, 2, DEFAULT_MAX_OUTPUT_SIZE);
+    ASSERT_GT(cursors.bytes(), 0);
+    cursors.Close(2);
+    ASSERT_EQ(cursors.bytes(), 0);
+    auto again = segment->RetrieveByCursor(
+        nullptr, plan.get(), MAX_TIMESTAMP, 2, DEFAULT_MAX_OUTPUT_SIZE);
+    ASSERT_EQ(again->offset(0), first->offset(0));
+
+    // a cursor is not read by a plan with another filter
+    sorted_segment->RetrieveByCursor(
+        nullptr, plan.get(), MAX_TIMESTAMP, 3, DEFAULT_MAX_OUTPUT_SIZE);
+    val.set_int64_val(500);
+    auto other_plan = std::make_unique<query::RetrievePlan>(*schema);
+    other_plan->plan_node_ = std::make_unique<query::RetrievePlanNode>();
+    other_plan->plan_node_->plannodes_ = milvus::test::CreateRetrievePlanByExpr(
+        std::make_shared<milvus::expr::UnaryRangeFilterExpr>(
+            milvus::expr::ColumnInfo(fid_64, DataType::INT64),
+            proto::plan::OpType::GreaterEqual,
+            val));
+    other_plan->plan_node_->limit_ = page_size;
+    other_plan->field_ids_ = {fid_64};
+    auto other = sorted_segment->RetrieveByCursor(
+        nullptr, other_plan.get(), MAX_TIMESTAMP, 3, DEFAULT_MAX_OUTPUT_SIZE);
+    auto other_pks = other->fields_data(0).scalars().long_data().data();
+    ASSERT_EQ(other_pks.size(), page_size);
+    for (auto pk : other_pks) {
+        EXPECT_GE(pk, 500);
+    }
+    cursors.Close(3);
+
+    // a page over the size limit is read again by the next retrieve
+    auto page = [](const auto& results) {
+        auto data = results->fields_data(0).scalars().long_data().data();
+        return std::vector<int64_t>(data.begin(), data.end());
+    };
+    plan->plan_node_->limit_ = Unlimited;
+    auto all = page(RetrieveUsingDefaultOutputSize(
+        segment.get(), plan.get(), MAX_TIMESTAMP));
+    plan->plan_node_->limit_ = page_size;
+    auto first_page = page(segment->RetrieveByCursor(
+        nullptr, plan.get(), MAX_TIMESTAMP, 4, DEFAULT_MAX_OUTPUT_SIZE));
+    ASSERT_EQ(first_page,
+              std::vector<int64_t>(all.begin(), all.begin() + page_size));
+    EXPECT_ANY_THROW(
+        segment->RetrieveByCursor(nullptr, plan.get(), MAX_TIMESTAMP, 4, 1));
+    auto second_page = page(segment->RetrieveByCursor(
+        nullptr, plan.get(), MAX_TIMESTAMP, 4, DEFAULT_MAX_OUTPUT_SIZE));
+    ASSERT_EQ(second_page,
+              std::vector<int64_t>(all.begin() + page_size,
+                                   all.begin() + 2 * page_size));
+    cursors.Close(4);
+
+    // expired cursors are dropped on the next lookup
+    auto& config = SegcoreConfig::default_config();
+    auto ttl = config.get_retrieve_cursor_ttl();
+    config.set_retrieve_cursor_ttl(0);
+    ASSERT_EQ(cursors.Take(segment->filter_cache_key(), 2), nullptr);
+    ASSERT_EQ(cursors.bytes(), 0);
+    config.set_retrieve_cursor_ttl(ttl);
+}
@@ -18,6 +18,7 @@
 #include "index/BitmapIndex.h"
 #include "index/InvertedIndexTantivy.h"
 #include "index/ScalarIndex.h"
+#include "index/ScalarIndexSort.h"
 #include "common/CDataType.h"
 #include "common/Types.h"
 #include "knowhere/comp/index_param.h"
@@ -592,3 +593,118 @@ TEST(ScalarTest, test_function_range) {
     TestIndexSearchRange<float>();
     TestIndexSearchRange<double>();
 }
+
+namespace {
+// rows of values in [0, 1000), every tenth of them null
+struct SortIndexRows {
+    SortIndexRows() : values(20000), valid_data(values.size()) {
+        std::default_random_engine random(42);
+        for (size_t i = 0; i < values.size(); ++i) {
+            values[i] = random() % 1000;
+            valid_data[i] = i % 10 != 0;
+        }
+    }
+
+    template <typename Pred>
+    void
+    AssertBitmap(const milvus::TargetBitmap& bitmap, Pred pred) const {
+        ASSERT_EQ(bitmap.size(), values.size());
+        for (size_t i = 0; i < values.size(); ++i) {
+            ASSERT_EQ(bool(bitmap[i]), valid_data[i] && pred(values[i])) << i;
+        }
+    }
+
+    void
+    AssertIndex(milvus::index::ScalarIndexSort<int64_t>& index) const {
+        using milvus::OpType;
+        ASSERT_EQ(index.Count(), int64_t(values.size()));
+        std::vector<int64_t> terms{-1, 0, 7, 999, 1000};
+        AssertBitmap(index.In(terms.size(), terms.data()), [&](int64_t v) {
+            return std::find(terms.begin(), terms.end(), v) != terms.end();
+        });
+        AssertBitmap(index.NotIn(terms.size(), terms.data()), [&](int64_t v) {
+            return std::find(terms.begin(), terms.end(), v) == terms.end();
+        });
+        AssertBitmap(index.Range(10, OpType::LessThan),
+                     [](int64_t v) { return v < 10; });
+        AssertBitmap(index.Range(10, OpType::GreaterEqual),
+                     [](int64_t v) { return v >= 10; });
+        AssertBitmap(index.Range(100, false, 900, true),
+                     [](int64_t v) { return v > 100 && v <= 900; });
+        AssertBitmap(index.Range(500, true, 500, true),
+                     [](int64_t v) { return v == 500; });
+        AssertBitmap(index.IsNotNull(), [](int64_t) { return true; });
+        for (size_t i = 0; i < values.size(); ++i) {
+            auto value = index.Reverse_Lookup(i);
+            ASSERT_EQ(value.has_value(), valid_data[i]);
+            if (valid_data[i]) {
+                ASSERT_EQ(value.value(), values[i]);
+            }
+        }
+    }
+
+    std::vector<int64_t> values;
+    milvus::FixedVector<bool> valid_data;
+};
+}  // namespace
+
+TEST(ScalarIndexSort, MmapLoad) {
+    SortIndexRows rows;
+    milvus::index::ScalarIndexSort<int64_t> index;
+    index.Build(rows.values.size(), rows.values.data(), rows.valid_data.data());
+    rows.AssertIndex(index);
+    auto binary_set = index.Serialize(nullptr);
+    // older nodes of the same scalar index version load the legacy layout
+    ASSERT_EQ(binary_set.binary_map_.count(milvus::index::SORT_INDEX_DATA), 1);
+    ASSERT_EQ(binary_set.binary_map_.count(milvus::index::SORT_INDEX_VALUES),
+              0);
+
+    milvus::test::TmpPath tmp_path;
+    milvus::Config config;
+    config[milvus::index::MMAP_FILE_PATH] =
+        (tmp_path.get() / "sort_index").string();
+    milvus::index::ScalarIndexSort<int64_t> mmap_index;
+    mmap_index.Load(binary_set, config);
+    ASSERT_TRUE(mmap_index.IsMmapSupported());
+    rows.AssertIndex(mmap_index);
+}
+
+TEST(ScalarIndexSort, LoadLegacyLayout) {
+    using milvus::index::IndexStructure;
+    SortIndexRows rows;
+    std::vector<IndexStructure<int64_t>> data;
+    for (size_t i = 0; i < rows.values.size(); ++i) {
+        if (rows.valid_data[i]) {
+            data.emplace_back(rows.values[i], i);
+        }
+    }
+    std::sort(data.begin(), data.end());
+    auto data_size = data.size() * sizeof(IndexStructure<int64_t>);
+    std::shared_ptr<uint8_t[]> index_data(new uint8_t[data_size]);
+    memcpy(index_data.get(), data.data(), data_size);
+    size_t index_length = data.size();
+    std::shared_ptr<uint8_t[]> length(new uint8_t[sizeof(size_t)]);
+    memcpy(length.get(), &index_length, sizeof(size_t));
+    size_t num_rows = rows.values.size();
+    std::shared_ptr<uint8_t[]> rows_data(new uint8_t[sizeof(size_t)]);
+    memcpy(rows_data.get(), &num_rows, sizeof(size_t));
+
+    milvus::test::TmpPath tmp_path;
+    for (auto with_mmap : {false, true}) {
+        milvus::BinarySet binary_set;
+        binary_set.Append(
+            milvus::index::SORT_INDEX_DATA, index_data, data_size);
+        binary_set.Append(
+            milvus::index::SORT_INDEX_LENGTH, length, sizeof(size_t));
+        binary_set.Append(
+            milvus::index::SORT_INDEX_NUM_ROWS, rows_data, sizeof(size_t));
+        milvus::Config config;
+        if (with_mmap) {
+            config[milvus::index::MMAP_FILE_PATH] =
+                (tmp_path.get() / "legacy_sort_index").string();
+        }
+        milvus::index::ScalarIndexSort<int64_t> index;
+        index.Load(binary_set, config);
+        rows.AssertIndex(index);
+    }
+}
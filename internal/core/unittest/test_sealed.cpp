@@ -11,11 +11,17 @@
 
 #include <boost/format.hpp>
 #include <gtest/gtest.h>
+#include <set>
 
 #include "common/Types.h"
 #include "common/Tracer.h"
+#include "expr/ITypeExpr.h"
 #include "index/IndexFactory.h"
 #include "knowhere/version.h"
+#include "monitor/prometheus_client.h"
+#include "plan/PlanNode.h"
+#include "query/ExecPlanNodeVisitor.h"
+#include "segcore/FilterResultCache.h"
 #include "segcore/SegmentSealedImpl.h"
 #include "storage/MmapManager.h"
 #include "storage/MinioChunkManager.h"
@@ -391,6 +397,329 @@ TEST(Sealed, with_predicate_filter_all) {
     EXPECT_EQ(sr2->get_total_result_count(), 0);
 }
 
+TEST(Sealed, BruteForceSelectiveFilter) {
+    auto schema = std::make_shared<Schema>();
+    auto dim = 16;
+    auto topK = 5;
+    auto fake_id = schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, dim, knowhere::metric::L2);
+    auto i64_fid = schema->AddDebugField("counter", DataType::INT64);
+    schema->set_primary_field_id(i64_fid);
+    // keeps 0.2% of the rows, the only cluster probed holds few of them
+    const char* raw_plan = R"(vector_anns: <
+                                field_id: 100
+                                predicates: <
+                                  unary_range_expr: <
+                                    column_info: <
+                                      field_id: 101
+                                      data_type: Int64
+                                    >
+                                    op: LessThan
+                                    value: <
+                                      int64_val: 20
+                                    >
+                                  >
+                                >
+                                query_info: <
+                                  topk: 5
+                                  round_decimal: -1
+                                  metric_type: "L2"
+                                  search_params: "{\"nprobe\": 1}"
+                                >
+                                placeholder_tag: "$0"
+     >)";
+
+    auto N = ROW_COUNT;
+    auto dataset = DataGen(schema, N);
+    auto vec_col = dataset.get_col<float>(fake_id);
+    auto counters = dataset.get_col<int64_t>(i64_fid);
+    auto query_ptr = vec_col.data() + BIAS * dim;
+    auto plan_str = translate_text_plan_to_binary_plan(raw_plan);
+    auto plan =
+        CreateSearchPlanByExpr(*schema, plan_str.data(), plan_str.size());
+    auto num_queries = 5;
+    auto ph_group_raw =
+        CreatePlaceholderGroupFromBlob(num_queries, dim, query_ptr);
+    auto ph_group =
+        ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+
+    milvus::index::CreateIndexInfo create_index_info;
+    create_index_info.field_type = DataType::VECTOR_FLOAT;
+    create_index_info.metric_type = knowhere::metric::L2;
+    create_index_info.index_type = knowhere::IndexEnum::INDEX_FAISS_IVFFLAT;
+    create_index_info.index_engine_version =
+        knowhere::Version::GetCurrentVersion().VersionNumber();
+    auto indexing = milvus::index::IndexFactory::GetInstance().CreateIndex(
+        create_index_info, milvus::storage::FileManagerContext());
+    auto build_conf =
+        knowhere::Json{{knowhere::meta::DIM, std::to_string(dim)},
+                       {knowhere::indexparam::NLIST, "100"},
+                       {knowhere::meta::METRIC_TYPE, knowhere::metric::L2}};
+    indexing->BuildWithDataset(knowhere::GenDataSet(N, dim, vec_col.data()),
+                               build_conf);
+    ASSERT_TRUE(dynamic_cast<index::VectorIndex*>(indexing.get())
+                    ->HasRawData());
+
+    LoadIndexInfo load_info;
+    load_info.field_id = fake_id.get();
+    load_info.index = std::move(indexing);
+    load_info.index_params["metric_type"] = "L2";
+    auto segment = SealedCreator(schema, dataset);
+    segment->DropFieldData(fake_id);
+    segment->LoadIndex(load_info);
+
+    auto sr = segment->Search(plan.get(), ph_group.get(), MAX_TIMESTAMP);
+    ASSERT_EQ(sr->unity_topK_, topK);
+    for (int q = 0; q < num_queries; ++q) {
+        std::vector<std::pair<float, int64_t>> expected;
+        for (int64_t i = 0; i < N; ++i) {
+            if (counters[i] >= 20) {
+                continue;
+            }
+            float dis = 0;
+            for (int d = 0; d < dim; ++d) {
+                auto diff = vec_col[i * dim + d] - query_ptr[q * dim + d];
+                dis += diff * diff;
+            }
+            expected.emplace_back(dis, i);
+        }
+        ASSERT_GE(expected.size(), static_cast<size_t>(topK));
+        std::sort(expected.begin(), expected.end());
+        for (int k = 0; k < topK; ++k) {
+            auto offset = sr->seg_offsets_[q * topK + k];
+            ASSERT_GE(offset, 0);
+            EXPECT_LT(counters[offset], 20);
+            EXPECT_NEAR(sr->distances_[q * topK + k],
+                        expected[k].first,
+                        1e-3 * std::max(1.0f, expected[k].first));
+        }
+    }
+
+    // the index is searched if the filter keeps too many rows
+    auto& config = SegcoreConfig::default_config();
+    auto ratio = config.get_brute_force_filter_ratio();
+    config.set_brute_force_filter_ratio(0);
+    auto index_sr = segment->Search(plan.get(), ph_group.get(), MAX_TIMESTAMP);
+    config.set_brute_force_filter_ratio(ratio);
+    for (auto offset : index_sr->seg_offsets_) {
+        if (offset != -1) {
+            EXPECT_LT(counters[offset], 20);
+        }
+    }
+}
+
+TEST(Sealed, ClusteringCentroidsPruning) {
+    auto schema = std::make_shared<Schema>();
+    auto dim = 16;
+    auto topK = 5;
+    auto fake_id = schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, dim, knowhere::metric::L2);
+    auto i64_fid = schema->AddDebugField("counter", DataType::INT64);
+    schema->set_primary_field_id(i64_fid);
+    const char* raw_plan = R"(vector_anns: <
+                                field_id: 100
+                                query_info: <
+                                  topk: 5
+                                  round_decimal: -1
+                                  metric_type: "L2"
+                                  search_params: "{}"
+                                >
+                                placeholder_tag: "$0"
+     >)";
+
+    auto N = ROW_COUNT;
+    auto dataset = DataGen(schema, N);
+    auto vec_col = dataset.get_col<float>(fake_id);
+    auto query_ptr = vec_col.data() + BIAS * dim;
+    auto plan_str = translate_text_plan_to_binary_plan(raw_plan);
+    auto plan =
+        CreateSearchPlanByExpr(*schema, plan_str.data(), plan_str.size());
+    auto num_queries = 5;
+    auto ph_group_raw =
+        CreatePlaceholderGroupFromBlob(num_queries, dim, query_ptr);
+    auto ph_group =
+        ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+
+    // the first rows are the centroids, every row belongs to the nearest
+    int num_clusters = 16;
+    proto::clustering::ClusteringCentroidsStats centroids;
+    for (int c = 0; c < num_clusters; ++c) {
+        auto centroid = centroids.add_centroids();
+        centroid->set_dim(dim);
+        centroid->mutable_float_vector()->mutable_data()->Add(
+            vec_col.begin() + c * dim, vec_col.begin() + (c + 1) * dim);
+    }
+    proto::clustering::ClusteringCentroidIdMappingStats id_mapping;
+    for (int64_t i = 0; i < N; ++i) {
+        int nearest = 0;
+        float nearest_dis = std::numeric_limits<float>::max();
+        for (int c = 0; c < num_clusters; ++c) {
+            float dis = 0;
+            for (int d = 0; d < dim; ++d) {
+                auto diff = vec_col[i * dim + d] - vec_col[c * dim + d];
+                dis += diff * diff;
+            }
+            if (dis < nearest_dis) {
+                nearest = c;
+                nearest_dis = dis;
+            }
+        }
+        id_mapping.add_centroid_id_mapping(nearest);
+    }
+
+    auto segment = SealedCreator(schema, dataset);
+    auto expected = segment->Search(plan.get(), ph_group.get(), MAX_TIMESTAMP);
+    segment->LoadClusteringCentroids(fake_id, centroids, id_mapping);
+    auto sr = segment->Search(plan.get(), ph_group.get(), MAX_TIMESTAMP);
+    ASSERT_EQ(sr->unity_topK_, topK);
+    ASSERT_EQ(sr->seg_offsets_.size(), expected->seg_offsets_.size());
+    for (size_t i = 0; i < sr->seg_offsets_.size(); ++i) {
+        EXPECT_NEAR(sr->distances_[i],
+                    expected->distances_[i],
+                    1e-3 * std::max(1.0f, expected->distances_[i]));
+    }
+
+    // probing a single cluster of a search returns no better row than the
+    // exact search
+    auto probe_plan_str = translate_text_plan_to_binary_plan(R"(vector_anns: <
+                                field_id: 100
+                                query_info: <
+                                  topk: 5
+                                  round_decimal: -1
+                                  metric_type: "L2"
+                                  search_params: "{\"cluster_probe_ratio\": 0.01}"
+                                >
+                                placeholder_tag: "$0"
+     >)");
+    auto probe_plan = CreateSearchPlanByExpr(
+        *schema, probe_plan_str.data(), probe_plan_str.size());
+    auto probe_sr =
+        segment->Search(probe_plan.get(), ph_group.get(), MAX_TIMESTAMP);
+    ASSERT_EQ(probe_sr->seg_offsets_.size(), expected->seg_offsets_.size());
+    for (size_t i = 0; i < probe_sr->seg_offsets_.size(); ++i) {
+        if (probe_sr->seg_offsets_[i] != -1) {
+            EXPECT_GE(probe_sr->distances_[i] + 1e-3,
+                      expected->distances_[i]);
+        }
+    }
+
+    // an index only searches the rows of the clusters of the nearest
+    // centroids of the queries, which are rows of the segment
+    auto indexed = CreateSealedSegment(schema);
+    SealedLoadFieldData(dataset, *indexed, {fake_id.get()});
+    LoadIndexInfo vec_info;
+    vec_info.field_id = fake_id.get();
+    vec_info.field_type = DataType::VECTOR_FLOAT;
+    vec_info.index = GenVecIndexing(
+        N, dim, vec_col.data(), knowhere::IndexEnum::INDEX_FAISS_IDMAP);
+    vec_info.index_params["metric_type"] = knowhere::metric::L2;
+    indexed->LoadIndex(vec_info);
+    indexed->LoadClusteringCentroids(fake_id, centroids, id_mapping);
+    std::set<int64_t> probed;
+    for (int q = 0; q < num_queries; ++q) {
+        probed.insert(id_mapping.centroid_id_mapping(BIAS + q));
+    }
+    auto index_sr =
+        indexed->Search(probe_plan.get(), ph_group.get(), MAX_TIMESTAMP);
+    ASSERT_EQ(index_sr->seg_offsets_.size(), expected->seg_offsets_.size());
+    for (auto offset : index_sr->seg_offsets_) {
+        if (offset != -1) {
+            EXPECT_TRUE(probed.count(id_mapping.centroid_id_mapping(offset)));
+        }
+    }
+}
+
+TEST(Sealed, FilterResultCache) {
+    auto schema = std::make_shared<Schema>();
+    auto vec_fid = schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto i64_fid = schema->AddDebugField("int64", DataType::INT64);
+    auto i32_fid = schema->AddDebugField("int32", DataType::INT32, true);
+    schema->set_primary_field_id(i64_fid);
+
+    int64_t N = 10000;
+    auto dataset = DataGen(schema, N);
+    auto segment = CreateSealedSegment(schema);
+    SealedLoadFieldData(dataset, *segment);
+
+    // the cache is disabled by default
+    auto& config = SegcoreConfig::default_config();
+    auto capacity = config.get_filter_cache_capacity();
+    config.set_filter_cache_capacity(64 * 1024 * 1024);
+    auto& cache = FilterResultCache::GetInstance();
+    auto& hits = monitor::internal_core_filter_cache_requests_hit;
+    auto execute = [&](const expr::TypedExprPtr& filter) {
+        auto plan =
+            std::make_shared<plan::FilterBitsNode>(DEFAULT_PLANNODE_ID, filter);
+        return ExecuteQueryExpr(plan, segment.get(), N, MAX_TIMESTAMP);
+    };
+    proto::plan::GenericValue value;
+    value.set_int64_val(0);
+    auto filter = std::make_shared<expr::UnaryRangeFilterExpr>(
+        expr::ColumnInfo(i32_fid, DataType::INT32),
+        proto::plan::OpType::LessThan,
+        value);
+
+    auto bytes = cache.bytes();
+    auto hit_count = hits.Value();
+    auto first = execute(filter);
+    EXPECT_GT(cache.bytes(), bytes);
+    auto second = execute(filter);
+    EXPECT_EQ(hits.Value(), hit_count + 1);
+    EXPECT_TRUE(first == second);
+
+    // the ids of the primary key are looked up at the query timestamp
+    auto term = std::make_shared<expr::TermFilterExpr>(
+        expr::ColumnInfo(i64_fid, DataType::INT64),
+        std::vector<proto::plan::GenericValue>{value});
+    auto cached_bytes = cache.bytes();
+    execute(term);
+    execute(term);
+    EXPECT_EQ(cache.bytes(), cached_bytes);
+    EXPECT_EQ(hits.Value(), hit_count + 1);
+
+    // any change of the data of the segment drops its results
+    segment->DropFieldData(vec_fid);
+    EXPECT_EQ(cache.bytes(), bytes);
+    auto evaluated = execute(filter);
+    EXPECT_EQ(hits.Value(), hit_count + 1);
+    EXPECT_TRUE(first == evaluated);
+
+    segment.reset();
+    EXPECT_EQ(cache.bytes(), bytes);
+
+    // sparse, mostly set and dense bits are all returned as they were put
+    auto key = FilterResultCache::NextSegmentKey();
+    auto current_key = [&]() { return key; };
+    for (auto [init, step] : std::vector<std::pair<bool, int64_t>>{
+             {false, 1000}, {true, 1000}, {false, 3}}) {
+        TargetBitmap bits(N, init);
+        TargetBitmap valid(N, true);
+        for (int64_t i = 0; i < N; i += step) {
+            bits.set(i, !init);
+            valid.reset(i);
+        }
+        auto name = fmt::format("{}-{}", init, step);
+        cache.Put(key, current_key, name, bits, valid);
+        TargetBitmap result;
+        TargetBitmap valid_result;
+        ASSERT_TRUE(cache.Get(key, name, N, result, valid_result));
+        EXPECT_TRUE(result == bits);
+        EXPECT_TRUE(valid_result == valid);
+        EXPECT_FALSE(cache.Get(key, name, N + 1, result, valid_result));
+    }
+    cache.EraseSegment(key);
+    EXPECT_EQ(cache.bytes(), bytes);
+
+    // bits evaluated before the segment took a new key are not cached
+    auto stale_key = key;
+    key = FilterResultCache::NextSegmentKey();
+    TargetBitmap bits(N, true);
+    cache.Put(stale_key, current_key, "stale", bits, bits);
+    EXPECT_EQ(cache.bytes(), bytes);
+    config.set_filter_cache_capacity(capacity);
+}
+
 TEST(Sealed, LoadFieldData) {
     auto dim = 16;
     auto topK = 5;
@@ -21,6 +21,8 @@
 #include "query/Utils.h"
 #include "query/PlanNodeVisitor.h"
 #include "query/ExecPlanNodeVisitor.h"
+#include "expr/ITypeExpr.h"
+#include "plan/PlanNode.h"
 #include "segcore/SegmentGrowingImpl.h"
 #include "test_utils/DataGen.h"
 #include "test_utils/GenExprProto.h"
@@ -1358,3 +1360,117 @@ TEST(AlwaysTrueStringPlan, QueryWithOutputFieldsNullable) {
               N / 2);
     ASSERT_EQ(retrieved->fields_data(0).valid_data().size(), N / 2);
 }
+
+// string predicates on sealed segments are evaluated in place over the
+// offsets of the column, check them against the raw values for a nullable
+// and a non-nullable field, loaded both in memory and with mmap.
+TEST(StringExpr, SealedInPlace) {
+    auto schema = std::make_shared<Schema>();
+    auto str_fid = schema->AddDebugField("str", DataType::VARCHAR, true);
+    auto another_str_fid =
+        schema->AddDebugField("another_str", DataType::VARCHAR);
+    schema->AddDebugField(
+        "fvec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto pk = schema->AddDebugField("int64", DataType::INT64);
+    schema->set_primary_field_id(pk);
+
+    int N = 10000;
+    auto raw_data = DataGen(schema, N);
+
+    for (auto with_mmap : {false, true}) {
+        auto seg = CreateSealedSegment(schema);
+        SealedLoadFieldData(raw_data, *seg, {}, with_mmap);
+
+        for (auto field_id : {str_fid, another_str_fid}) {
+            auto str_col = raw_data.get_col<std::string>(field_id);
+            auto nullable = field_id == str_fid;
+            FixedVector<bool> valid_data;
+            if (nullable) {
+                valid_data = raw_data.get_col_valid(field_id);
+            }
+            auto check = [&](const expr::TypedExprPtr& expr,
+                             std::function<bool(const std::string&)> ref_func) {
+                auto plan = std::make_shared<plan::FilterBitsNode>(
+                    DEFAULT_PLANNODE_ID, expr);
+                auto final =
+                    ExecuteQueryExpr(plan, seg.get(), N, MAX_TIMESTAMP);
+                ASSERT_EQ(final.size(), N);
+                for (int i = 0; i < N; ++i) {
+                    if (nullable && !valid_data[i]) {
+                        ASSERT_FALSE(final[i]) << "@" << i;
+                        continue;
+                    }
+                    ASSERT_EQ(final[i], ref_func(str_col[i]))
+                        << "@" << i << "!!" << str_col[i];
+                }
+            };
+            auto column = expr::ColumnInfo(field_id, DataType::VARCHAR);
+
+            // the value of a row, the row is valid even for nullable field
+            std::string existing;
+            for (int i = 0; i < N; ++i) {
+                if (!nullable || valid_data[i]) {
+                    existing = str_col[i];
+                    break;
+                }
+            }
+            std::vector<std::tuple<proto::plan::OpType,
+                                   std::string,
+                                   std::function<bool(const std::string&)>>>
+                unary_testcases{
+                    {proto::plan::OpType::Equal,
+                     existing,
+                     [&](const std::string& val) { return val == existing; }},
+                    {proto::plan::OpType::NotEqual,
+                     existing,
+                     [&](const std::string& val) { return val != existing; }},
+                    {proto::plan::OpType::GreaterThan,
+                     "2000",
+                     [](const std::string& val) { return val > "2000"; }},
+                    {proto::plan::OpType::LessEqual,
+                     "3000",
+                     [](const std::string& val) { return val <= "3000"; }},
+                    {proto::plan::OpType::PrefixMatch,
+                     "1",
+                     [](const std::string& val) {
+                         return PrefixMatch(val, "1");
+                     }},
+                    {proto::plan::OpType::Match,
+                     "%12%",
+                     [](const std::string& val) {
+                         return val.find("12") != std::string::npos;
+                     }},
+                };
+            for (const auto& [op, value, ref_func] : unary_testcases) {
+                proto::plan::GenericValue val;
+                val.set_string_val(value);
+                check(std::make_shared<expr::UnaryRangeFilterExpr>(
+                          column, op, val),
+                      ref_func);
+            }
+
+            proto::plan::GenericValue lower;
+            lower.set_string_val("2000");
+            proto::plan::GenericValue upper;
+            upper.set_string_val("3000");
+            check(std::make_shared<expr::BinaryRangeFilterExpr>(
+                      column, lower, upper, true, false),
+                  [](const std::string& val) {
+                      return "2000" <= val && val < "3000";
+                  });
+
+            std::vector<std::string> terms{existing, str_col[N / 2], "abc"};
+            std::vector<proto::plan::GenericValue> term_vals;
+            for (auto& term : terms) {
+                proto::plan::GenericValue val;
+                val.set_string_val(term);
+                term_vals.push_back(val);
+            }
+            check(std::make_shared<expr::TermFilterExpr>(column, term_vals),
+                  [&](const std::string& val) {
+                      return std::find(terms.begin(), terms.end(), val) !=
+                             terms.end();
+                  });
+        }
+    }
+}
@@ -56,6 +56,16 @@ func HandleCStatus(ctx context.Context, status *C.CStatus, extraInfo string, fie
 	return err
 }
 
+// deadlineMs returns the deadline of ctx as a unix timestamp in milliseconds,
+// segcore stops the work of a search or retrieve past it, 0 for no deadline
+func deadlineMs(ctx context.Context) int64 {
+	deadline, ok := ctx.Deadline()
+	if !ok {
+		return 0
+	}
+	return deadline.UnixMilli()
+}
+
 // UnmarshalCProto unmarshal the proto from C memory
 func UnmarshalCProto(cRes *C.CProto, msg proto.Message) error {
 	blob := (*(*[math.MaxInt32]byte)(cRes.proto_blob))[:int(cRes.proto_size):int(cRes.proto_size)]
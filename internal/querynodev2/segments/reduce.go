@@ -153,7 +153,7 @@ func ReduceSearchResultsAndFillData(ctx context.Context, plan *SearchPlan, searc
 	var cSearchResultDataBlobs SearchResultDataBlobs
 	traceCtx := ParseCTraceContext(ctx)
 	status := C.ReduceSearchResultsAndFillData(traceCtx.ctx, &cSearchResultDataBlobs, plan.cSearchPlan, cSearchResultPtr,
-		cNumSegments, cSliceNQSPtr, cSliceTopKSPtr, cNumSlices)
+		cNumSegments, cSliceNQSPtr, cSliceTopKSPtr, cNumSlices, C.int64_t(deadlineMs(ctx)))
 	if err := HandleCStatus(ctx, &status, "ReduceSearchResultsAndFillData failed"); err != nil {
 		return nil, err
 	}
@@ -538,6 +538,7 @@ func (s *LocalSegment) Search(ctx context.Context, searchReq *SearchRequest) (*S
 				searchReq.plan.cSearchPlan,
 				searchReq.cPlaceholderGroup,
 				C.uint64_t(searchReq.mvccTimestamp),
+				C.int64_t(deadlineMs(ctx)),
 			))
 		},
 		cgo.WithName("search"),
@@ -588,6 +589,7 @@ func (s *LocalSegment) Retrieve(ctx context.Context, plan *RetrievePlan) (*segco
 				C.uint64_t(plan.Timestamp),
 				C.int64_t(maxLimitSize),
 				C.bool(plan.ignoreNonPk),
+				C.int64_t(deadlineMs(ctx)),
 			))
 		},
 		cgo.WithName("retrieve"),
@@ -1293,6 +1295,28 @@ func (s *LocalSegment) LoadTextIndex(ctx context.Context, textLogs *datapb.TextI
 	return HandleCStatus(ctx, &status, "LoadTextIndex failed")
 }
 
+// LoadClusteringCentroids loads the clustering centroids of a vector field and the centroid id of every row,
+// the searches on the field skip the clusters which can't hold their results.
+func (s *LocalSegment) LoadClusteringCentroids(ctx context.Context, fieldID int64, centroids []byte, idMapping []byte) error {
+	log.Ctx(ctx).Info("load clustering centroids", zap.Int64("segmentID", s.ID()), zap.Int64("fieldID", fieldID))
+	if len(centroids) == 0 || len(idMapping) == 0 {
+		return merr.WrapErrParameterInvalidMsg("empty clustering centroids of field %d", fieldID)
+	}
+
+	var status C.CStatus
+	_, _ = GetLoadPool().Submit(func() (any, error) {
+		status = C.LoadClusteringCentroids(s.ptr,
+			C.int64_t(fieldID),
+			(*C.uint8_t)(unsafe.Pointer(&centroids[0])),
+			(C.uint64_t)(len(centroids)),
+			(*C.uint8_t)(unsafe.Pointer(&idMapping[0])),
+			(C.uint64_t)(len(idMapping)))
+		return nil, nil
+	}).Await()
+
+	return HandleCStatus(ctx, &status, "LoadClusteringCentroids failed")
+}
+
 func (s *LocalSegment) UpdateIndexInfo(ctx context.Context, indexInfo *querypb.FieldIndexInfo, info *LoadIndexInfo) error {
 	log := log.Ctx(ctx).With(
 		zap.Int64("collectionID", s.Collection()),
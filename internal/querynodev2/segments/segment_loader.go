@@ -807,6 +807,11 @@ func (loader *segmentLoader) loadSealedSegment(ctx context.Context, loadInfo *qu
 		}
 	}
 
+	// load the clustering centroids of the vector clustering keys
+	if err := loader.loadClusteringCentroids(ctx, segment, loadInfo); err != nil {
+		return err
+	}
+
 	// 4. rectify entries number for binlog in very rare cases
 	// https://github.com/milvus-io/milvus/23654
 	// legacy entry num = 0
@@ -824,6 +829,19 @@ func (loader *segmentLoader) loadSealedSegment(ctx context.Context, loadInfo *qu
 	return nil
 }
 
+func (loader *segmentLoader) loadClusteringCentroids(ctx context.Context, segment *LocalSegment, loadInfo *querypb.SegmentLoadInfo) error {
+	for fieldID, files := range loadInfo.GetClusteringCentroidFiles() {
+		values, err := loader.cm.MultiRead(ctx, []string{files.GetCentroidsFile(), files.GetIdMappingFile()})
+		if err != nil {
+			return err
+		}
+		if err := segment.LoadClusteringCentroids(ctx, fieldID, values[0], values[1]); err != nil {
+			return err
+		}
+	}
+	return nil
+}
+
 func (loader *segmentLoader) LoadSegment(ctx context.Context,
 	seg Segment,
 	loadInfo *querypb.SegmentLoadInfo,
@@ -205,6 +205,23 @@ func (node *QueryNode) InitSegcore() error {
 	nprobe := C.int64_t(paramtable.Get().QueryNodeCfg.InterimIndexNProbe.GetAsInt64())
 	C.SegcoreSetNprobe(nprobe)
 
+	jsonShreddingMaxPaths := C.int64_t(paramtable.Get().QueryNodeCfg.JSONShreddingMaxPaths.GetAsInt64())
+	C.SegcoreSetJsonShreddingMaxPaths(jsonShreddingMaxPaths)
+
+	jsonShreddingMinPresenceRatio := C.double(paramtable.Get().QueryNodeCfg.JSONShreddingMinPresenceRatio.GetAsFloat())
+	C.SegcoreSetJsonShreddingMinPresenceRatio(jsonShreddingMinPresenceRatio)
+
+	bruteForceFilterRatio := C.double(paramtable.Get().QueryNodeCfg.BruteForceFilterRatio.GetAsFloat())
+	C.SegcoreSetBruteForceFilterRatio(bruteForceFilterRatio)
+
+	filterCacheCapacity := C.int64_t(paramtable.Get().QueryNodeCfg.FilterCacheCapacityMB.GetAsInt64() * 1024 * 1024)
+	C.SegcoreSetFilterCacheCapacity(filterCacheCapacity)
+
+	retrieveCursorCapacity := C.int64_t(paramtable.Get().QueryNodeCfg.RetrieveCursorCapacityMB.GetAsInt64() * 1024 * 1024)
+	C.SegcoreSetRetrieveCursorCapacity(retrieveCursorCapacity)
+	retrieveCursorTTL := C.int64_t(paramtable.Get().QueryNodeCfg.RetrieveCursorTTLSeconds.GetAsInt64())
+	C.SegcoreSetRetrieveCursorTTL(retrieveCursorTTL)
+
 	// override segcore SIMD type
 	cSimdType := C.CString(paramtable.Get().CommonCfg.SimdType.GetValue())
 	C.SegcoreSetSimdType(cSimdType)
@@ -241,6 +258,9 @@ func (node *QueryNode) InitSegcore() error {
 	cExprBatchSize := C.int64_t(paramtable.Get().QueryNodeCfg.ExprEvalBatchSize.GetAsInt64())
 	C.InitDefaultExprEvalBatchSize(cExprBatchSize)
 
+	cLoadMemoryLimit := C.int64_t(paramtable.Get().QueryNodeCfg.LoadMemoryLimitMB.GetAsInt64())
+	C.InitLoadMemoryLimit(cLoadMemoryLimit)
+
 	cGpuMemoryPoolInitSize := C.uint32_t(paramtable.Get().GpuConfig.InitSize.GetAsUint32())
 	cGpuMemoryPoolMaxSize := C.uint32_t(paramtable.Get().GpuConfig.MaxSize.GetAsUint32())
 	C.SegcoreSetKnowhereGpuMemoryPoolSize(cGpuMemoryPoolInitSize, cGpuMemoryPoolMaxSize)
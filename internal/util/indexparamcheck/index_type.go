@@ -61,6 +61,7 @@ func IsDiskIndex(indexType IndexType) bool {
 
 func IsScalarMmapIndex(indexType IndexType) bool {
 	return indexType == IndexINVERTED ||
+		indexType == IndexSTLSORT ||
 		indexType == IndexBitmap ||
 		indexType == IndexHybrid
 }
@@ -30,6 +30,11 @@ func TestIsScalarMmapIndex(t *testing.T) {
 	t.Run("inverted index", func(t *testing.T) {
 		assert.True(t, IsScalarMmapIndex(IndexINVERTED))
 	})
+
+	t.Run("sort index", func(t *testing.T) {
+		assert.True(t, IsScalarMmapIndex(IndexSTLSORT))
+		assert.False(t, IsScalarMmapIndex(IndexTRIE))
+	})
 }
 
 func TestIsVectorMmapIndex(t *testing.T) {
@@ -171,7 +171,18 @@ func InitRemoteChunkManager(params *paramtable.ComponentParam) error {
 	}
 
 	status := C.InitRemoteChunkManagerSingleton(storageConfig)
-	return HandleCStatus(&status, "InitRemoteChunkManagerSingleton failed")
+	if err := HandleCStatus(&status, "InitRemoteChunkManagerSingleton failed"); err != nil {
+		return err
+	}
+
+	cacheCapacity := params.QueryNodeCfg.RemoteCacheCapacityMB.GetAsInt64() * 1024 * 1024
+	if cacheCapacity <= 0 {
+		return nil
+	}
+	cCacheDirPath := C.CString(params.QueryNodeCfg.RemoteCacheDirPath.GetValue())
+	defer C.free(unsafe.Pointer(cCacheDirPath))
+	status = C.InitRemoteChunkManagerLocalCache(cCacheDirPath, C.int64_t(cacheCapacity))
+	return HandleCStatus(&status, "InitRemoteChunkManagerLocalCache failed")
 }
 
 func InitMmapManager(params *paramtable.ComponentParam) error {
@@ -2369,6 +2369,15 @@ type queryNodeConfig struct {
 	InterimIndexMemExpandRate     ParamItem `refreshable:"false"`
 	InterimIndexBuildParallelRate ParamItem `refreshable:"false"`
 	MultipleChunkedEnable         ParamItem `refreshable:"false"`
+	JSONShreddingMaxPaths         ParamItem `refreshable:"false"`
+	JSONShreddingMinPresenceRatio ParamItem `refreshable:"false"`
+	BruteForceFilterRatio         ParamItem `refreshable:"false"`
+	FilterCacheCapacityMB         ParamItem `refreshable:"false"`
+	RetrieveCursorCapacityMB      ParamItem `refreshable:"false"`
+	RetrieveCursorTTLSeconds      ParamItem `refreshable:"false"`
+	LoadMemoryLimitMB             ParamItem `refreshable:"false"`
+	RemoteCacheDirPath            ParamItem `refreshable:"false"`
+	RemoteCacheCapacityMB         ParamItem `refreshable:"false"`
 
 	KnowhereScoreConsistency ParamItem `refreshable:"false"`
 
@@ -2588,6 +2597,93 @@ This defaults to true, indicating that Milvus creates temporary index for growin
 	}
 	p.MultipleChunkedEnable.Init(base.mgr)
 
+	p.JSONShreddingMaxPaths = ParamItem{
+		Key:          "queryNode.segcore.jsonShredding.maxPaths",
+		Version:      "2.5.0",
+		DefaultValue: "0",
+		Doc:          "Max number of paths of a JSON field extracted into typed columns when a sealed segment is loaded, 0 disables json shredding",
+		Export:       true,
+	}
+	p.JSONShreddingMaxPaths.Init(base.mgr)
+
+	p.JSONShreddingMinPresenceRatio = ParamItem{
+		Key:          "queryNode.segcore.jsonShredding.minPresenceRatio",
+		Version:      "2.5.0",
+		DefaultValue: "0.5",
+		Doc:          "A JSON path is only extracted if it holds a value in at least this ratio of the rows of the segment",
+		Export:       true,
+	}
+	p.JSONShreddingMinPresenceRatio.Init(base.mgr)
+
+	p.BruteForceFilterRatio = ParamItem{
+		Key:          "queryNode.segcore.bruteForceFilterRatio",
+		Version:      "2.5.0",
+		DefaultValue: "0.01",
+		Doc:          "A search on an indexed sealed segment scans the vectors of the rows passing its filter exactly instead of searching the index if they are at most this ratio of the rows, 0 always searches the index",
+		Export:       true,
+	}
+	p.BruteForceFilterRatio.Init(base.mgr)
+
+	p.FilterCacheCapacityMB = ParamItem{
+		Key:          "queryNode.segcore.filterCacheCapacityMB",
+		Version:      "2.5.0",
+		DefaultValue: "0",
+		Doc:          "Memory in MB the filter results of sealed segments reused by the queries with the same filter may take, 0 disables the cache",
+		Export:       true,
+	}
+	p.FilterCacheCapacityMB.Init(base.mgr)
+
+	p.RetrieveCursorCapacityMB = ParamItem{
+		Key:          "queryNode.segcore.retrieveCursorCapacityMB",
+		Version:      "2.5.0",
+		DefaultValue: "256",
+		Doc:          "Memory in MB the cursors of paged queries may take, a query whose cursor was evicted evaluates its filter again, 0 disables the cursors",
+		Export:       true,
+	}
+	p.RetrieveCursorCapacityMB.Init(base.mgr)
+
+	p.RetrieveCursorTTLSeconds = ParamItem{
+		Key:          "queryNode.segcore.retrieveCursorTTLSeconds",
+		Version:      "2.5.0",
+		DefaultValue: "600",
+		Doc:          "Seconds the cursor of a paged query is kept while no page is read from it",
+		Export:       true,
+	}
+	p.RetrieveCursorTTLSeconds.Init(base.mgr)
+
+	p.LoadMemoryLimitMB = ParamItem{
+		Key:          "queryNode.segcore.loadMemoryLimitMB",
+		Version:      "2.5.0",
+		DefaultValue: "2048",
+		Doc:          "Memory in MB the files being downloaded and decoded by all the segment and index loads of the node may take at once, the loads wait for their turn beyond it, 0 means no limit",
+		Export:       true,
+	}
+	p.LoadMemoryLimitMB.Init(base.mgr)
+
+	p.RemoteCacheDirPath = ParamItem{
+		Key:          "queryNode.remoteCache.dirPath",
+		Version:      "2.5.0",
+		DefaultValue: "",
+		Doc:          "The folder keeping local copies of the binlogs and index files read from object storage, defaults to remote_cache under localStorage.path",
+		Formatter: func(v string) string {
+			if len(v) == 0 {
+				return path.Join(base.Get("localStorage.path"), "remote_cache")
+			}
+			return v
+		},
+		Export: true,
+	}
+	p.RemoteCacheDirPath.Init(base.mgr)
+
+	p.RemoteCacheCapacityMB = ParamItem{
+		Key:          "queryNode.remoteCache.capacityMB",
+		Version:      "2.5.0",
+		DefaultValue: "0",
+		Doc:          "Max size in MB of the local copies of the files read from object storage, which let a restarted query node load its segments from local disk, 0 disables the cache",
+		Export:       true,
+	}
+	p.RemoteCacheCapacityMB.Init(base.mgr)
+
 	p.InterimIndexNProbe = ParamItem{
 		Key:     "queryNode.segcore.interimIndex.nprobe",
 		Version: "2.0.0",
@@ -0,0 +1,57 @@
+#!/usr/bin/env bash
+
+# Licensed to the LF AI & Data foundation under one
+# or more contributor license agreements. See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership. The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License. You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Runs the segcore benchmarks and writes their results as json, to be
+# compared across commits, e.g. with google benchmark's tools/compare.py.
+#
+# Usage: run_cpp_benchmark.sh [output file] [benchmark filter]
+
+set -e
+
+SOURCE="${BASH_SOURCE[0]}"
+while [ -h "$SOURCE" ]; do # resolve $SOURCE until the file is no longer a symlink
+  DIR="$( cd -P "$( dirname "$SOURCE" )" && pwd )"
+  SOURCE="$(readlink "$SOURCE")"
+  [[ $SOURCE != /* ]] && SOURCE="$DIR/$SOURCE" # if $SOURCE was a relative symlink, we need to resolve it relative to the path where the symlink file was located
+done
+SCRIPTS_DIR="$( cd -P "$( dirname "$SOURCE" )" && pwd )"
+
+MILVUS_CORE_DIR="${SCRIPTS_DIR}/../internal/core"
+CORE_INSTALL_PREFIX="${MILVUS_CORE_DIR}/output"
+BENCH_BIN="${CORE_INSTALL_PREFIX}/unittest/all_bench"
+
+# currently core will install target lib to "internal/core/output/lib"
+if [ -d "${CORE_INSTALL_PREFIX}/lib" ]; then
+    export LD_LIBRARY_PATH=$LD_LIBRARY_PATH:${CORE_INSTALL_PREFIX}/lib
+fi
+
+if [ ! -f "${BENCH_BIN}" ]; then
+  echo "The benchmark binary ${BENCH_BIN} does not exist!"
+  exit 1
+fi
+
+OUTPUT_FILE="${1:-${MILVUS_CORE_DIR}/output/benchmark.json}"
+FILTER="${2:-.}"
+
+echo "Running benchmarks matching ${FILTER} into ${OUTPUT_FILE} ..."
+${BENCH_BIN} \
+  --benchmark_filter="${FILTER}" \
+  --benchmark_repetitions=3 \
+  --benchmark_report_aggregates_only=true \
+  --benchmark_out="${OUTPUT_FILE}" \
+  --benchmark_out_format=json